@@ -29,32 +29,38 @@ if __name__ == "__main__":
 
   inPath = os.getenv("PWD")
 
-  os.chdir(inPath+"/PlotStyle");
-
-  if options.vclean : os.system("rm Util_cxx.so ; rm PlotUtils_cxx.so");
-  
-  ROOT.gROOT.ProcessLine(".L Util.cxx+");
-  ROOT.gSystem.Load("Util_cxx.so");
-
-  ROOT.gROOT.ProcessLine(".L PlotUtils.cxx+");
-  ROOT.gSystem.Load("PlotUtils_cxx.so");
- 
   os.chdir(inPath+"/PDFs");
 
-  if options.vclean : os.system("rm PdfDiagonalizer_cc.so ; rm HWWLVJRooPdfs_cxx.so ; rm MakePdf_cxx.so");
+  if options.vclean : os.system("rm PdfDiagonalizer_cc.so ; rm VectorMath_cxx.so ; rm HWWLVJRooPdfs_cxx.so ; rm RooBatchNLL_cxx.so ; rm MakePdf_cxx.so");
 
   ROOT.gROOT.ProcessLine(".L PdfDiagonalizer.cc+");
   ROOT.gSystem.Load("PdfDiagonalizer_cc.so");
 
+  ROOT.gROOT.ProcessLine(".L VectorMath.cxx+");
+  ROOT.gSystem.Load("VectorMath_cxx.so");
   ROOT.gROOT.ProcessLine(".L HWWLVJRooPdfs.cxx+");
   ROOT.gSystem.Load("HWWLVJRooPdfs_cxx.so");
 
   #Add this line - Michael
   ROOT.gSystem.Load("$ROOFITSYS/lib/libRooFit.so")
 
+  ROOT.gROOT.ProcessLine(".L RooBatchNLL.cxx+");
+  ROOT.gSystem.Load("RooBatchNLL_cxx.so");
+
   ROOT.gROOT.ProcessLine(".L MakePdf.cxx+");
   ROOT.gSystem.Load("MakePdf_cxx.so");
 
+  # after the PDFs: the toy bands of Util.cxx evaluate the pdfs through RooBatchNLL
+  os.chdir(inPath+"/PlotStyle");
+
+  if options.vclean : os.system("rm Util_cxx.so ; rm PlotUtils_cxx.so");
+  
+  ROOT.gROOT.ProcessLine(".L Util.cxx+");
+  ROOT.gSystem.Load("Util_cxx.so");
+
+  ROOT.gROOT.ProcessLine(".L PlotUtils.cxx+");
+  ROOT.gSystem.Load("PlotUtils_cxx.so");
+
   os.chdir(inPath+"/BiasStudy");
 
   if options.vclean : os.system("rm BiasUtils_cxx.so");
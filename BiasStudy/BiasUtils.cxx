@@ -15,6 +15,7 @@ biasModelAnalysis::biasModelAnalysis( RooArgSet* observables, RooAbsPdf * genera
   else{ std::cout<<" null number of toys --> terminate"<<std::endl; std::terminate(); }
 
   isMC_        = isMC;  
+  workspace_   = NULL;
 }
 
 biasModelAnalysis::biasModelAnalysis( const biasModelAnalysis & other){
@@ -25,6 +26,7 @@ biasModelAnalysis::biasModelAnalysis( const biasModelAnalysis & other){
   (*this).nexp_        = other.nexp_ ;
   (*this).isMC_        = other.isMC_;
   (*this).tree_        = other.tree_;
+  (*this).workspace_   = other.workspace_;
 } 
 
 biasModelAnalysis::~biasModelAnalysis(){
@@ -63,6 +65,10 @@ void biasModelAnalysis::setFittingModel( RooAbsPdf* fitting_model){
 
 }
 
+void biasModelAnalysis::setWorkspace( RooWorkspace* workspace){
+  workspace_ = workspace ;
+}
+
 void biasModelAnalysis::setPdfInformation(const std::string & mlvjregion, const std::string & spectrum, const std::string & channel, const std::string & label){
 
   mlvjregion_ = mlvjregion ;
@@ -120,15 +126,18 @@ void biasModelAnalysis::generateAndFitToys(int nevents, const std::string & fitR
   
   fitRange_ = fitRange ;
 
+  // generation from the tabulated pdf in tabulated mode, the toys are always fitted with the exact model
+  RooAbsPdf* model_generation = GetTabulatedPdf((*this).workspace_,(*this).model_generation_,dynamic_cast<RooRealVar*>((*this).observables_->first()));
+
   if((*this).isMC_){
-   mc_study_ = new RooMCStudy(*((*this).model_generation_), 
+   mc_study_ = new RooMCStudy(*model_generation, 
                               *((*this).observables_),                                                                                                            
 	 	              RooFit::FitModel(*((*this).model_fit_)),
                               RooFit::FitOptions(RooFit::Save(kTRUE),RooFit::SumW2Error(kTRUE),RooFit::Minimizer("Minuit2"),RooFit::Extended(kTRUE),RooFit::Range(fitRange.c_str())),
                               RooFit::Extended(kTRUE));
   }
   else{
-    mc_study_ = new RooMCStudy(*((*this).model_generation_), 
+    mc_study_ = new RooMCStudy(*model_generation, 
                                *((*this).observables_),                                                                                                            
 	   	               RooFit::FitModel(*((*this).model_fit_)),
                                RooFit::FitOptions(RooFit::Save(kTRUE),RooFit::SumW2Error(kFALSE),RooFit::Minimizer("Minuit2"),RooFit::Extended(kTRUE),RooFit::Range(fitRange.c_str())),
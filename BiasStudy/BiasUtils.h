@@ -30,6 +30,7 @@
 #include "TLine.h"
 
 #include "../PlotStyle/PlotUtils.h"
+#include "../PDFs/MakePdf.h"
 
 class biasModelAnalysis{
 
@@ -46,6 +47,7 @@ class biasModelAnalysis{
   void fillBranches(const int &, const int &, RooWorkspace&, std::map<std::string,std::string> &,const std::string & ="");
 
   void setFittingModel(RooAbsPdf*);
+  void setWorkspace(RooWorkspace*); // toys generated from GetTabulatedPdf when the workspace is in tabulated mode
   void setTree(TTree*);
   void setNToys(const int &);
   void setIsMC(const int &);
@@ -62,6 +64,7 @@ class biasModelAnalysis{
    RooAbsPdf*    model_generation_ ;
    RooAbsPdf*    model_fit_;
    RooAbsPdf*    model_bkg_data_;
+   RooWorkspace* workspace_;
    RooArgSet*    observables_;
    RooDataSet*   generated_dataset_;
    RooChi2MCSModule chi2_module_ ;
@@ -47,24 +47,29 @@ parser.add_option('-w','--onlybackgroundfit',  help='run only background fit',
 parser.add_option('-i','--inflatejobstatistic',  help='enlarge the generated statistics in the fit',  type=int, default=1)
 parser.add_option('--scalesignalwidth', help='reduce the signal width by a factor x', type=float, default=1.)
 parser.add_option('--injectSingalStrenght', help='inject a singal in the toy generation', type=float, default=1.)
+parser.add_option('--tabulatedPdfs', help='generate the toys from RooTabulatedPdf tables with this tolerance (0 = exact pdfs), fits stay exact', type=float, default=0.)
 
 (options, args) = parser.parse_args()
 
 ### Lybrary import
 
-ROOT.gSystem.Load(options.inPath+"/PlotStyle/Util_cxx.so")
-ROOT.gSystem.Load(options.inPath+"/PlotStyle/PlotUtils_cxx.so")
 ROOT.gSystem.Load(options.inPath+"/PDFs/PdfDiagonalizer_cc.so")
+ROOT.gSystem.Load(options.inPath+"/PDFs/VectorMath_cxx.so")
 ROOT.gSystem.Load(options.inPath+"/PDFs/HWWLVJRooPdfs_cxx.so")
+ROOT.gSystem.Load(options.inPath+"/PDFs/RooBatchNLL_cxx.so")
+ROOT.gSystem.Load(options.inPath+"/PlotStyle/Util_cxx.so")
+ROOT.gSystem.Load(options.inPath+"/PlotStyle/PlotUtils_cxx.so")
 ROOT.gSystem.Load(options.inPath+"/PDFs/MakePdf_cxx.so")
 ROOT.gSystem.Load(options.inPath+"/BiasStudy/BiasUtils_cxx.so")
 ROOT.gSystem.Load(options.inPath+"/FitUtils/FitUtils_cxx.so")
+# per working point model parameters, see the header of the file
+if ROOT.LoadModelConfig(options.inPath+"/PDFs/config/N2DDT.txt") < 0: sys.exit(1)
 
 from ROOT import draw_error_band, draw_error_band_extendPdf, draw_error_band_Decor, draw_error_band_shape_Decor, Calc_error_extendPdf, Calc_error
 
 from ROOT import RooErfExpPdf, RooAlpha, RooAlpha4ErfPowPdf, RooAlpha4ErfPow2Pdf, RooAlpha4ErfPowExpPdf, PdfDiagonalizer, RooPowPdf, RooPow2Pdf, RooErfPowExpPdf, RooErfPowPdf, RooErfPow2Pdf, RooQCDPdf, RooUser1Pdf, RooBWRunPdf, RooAnaExpNPdf,RooExpNPdf, RooAlpha4ExpNPdf, RooExpTailPdf, RooPow3Pdf, RooErfPow3Pdf, RooUser1Pdf
 
-from ROOT import biasModelAnalysis, MakeGeneralPdf, MakeExtendedModel, get_TTbar_mj_Model, get_STop_mj_Model, get_VV_mj_Model, get_WW_EWK_mj_Model, get_WJets_mj_Model, get_ggH_mj_Model, get_vbfH_mj_Model, get_TTbar_mlvj_Model, get_STop_mlvj_Model, get_VV_mlvj_Model, get_WW_EWK_mlvj_Model, get_WJets_mlvj_Model, get_ggH_mlvj_Model, get_vbfH_mlvj_Model, fix_Model,  clone_Model
+from ROOT import biasModelAnalysis, MakeGeneralPdf, MakeExtendedModel, get_TTbar_mj_Model, get_STop_mj_Model, get_VV_mj_Model, get_WW_EWK_mj_Model, get_WJets_mj_Model, get_ggH_mj_Model, get_vbfH_mj_Model, get_TTbar_mlvj_Model, get_STop_mlvj_Model, get_VV_mlvj_Model, get_WW_EWK_mlvj_Model, get_WJets_mlvj_Model, get_ggH_mlvj_Model, get_vbfH_mlvj_Model, fix_Model,  clone_Model, SetTabulatedMode
 
 from ROOT import setTDRStyle, get_pull, draw_canvas, draw_canvas_with_pull, legend4Plot, GetDataPoissonInterval, GetLumi
 
@@ -161,11 +166,16 @@ class doBiasStudy_mlvj:
         if options.onlybackgroundfit  : suffix = suffix+"_B";        
         else: suffix = suffix+"_SB";
         
+        ## a new fitter is a new job: forget the models MakePdf.cxx cached for earlier workspaces
+        ROOT.ClearModelCache()
+
         ## create the workspace and import them
         if input_workspace is None:
              self.workspace4bias_ = RooWorkspace("workspace4bias_%s_%s_%s_%s_%s"%(self.channel,self.wtagger_label,self.generation_model,self.fit_model,suffix),"workspace4bias_%s_%s_%s_%s_%s"%(self.channel,self.wtagger_label,self.generation_model,self.fit_model,suffix));
         else:
             self.workspace4bias_ = input_workspace;
+
+        if options.tabulatedPdfs > 0 : SetTabulatedMode(self.workspace4bias_,True,options.tabulatedPdfs);
             
         getattr(self.workspace4bias_,"import")(rrv_mass_lvj);
         getattr(self.workspace4bias_,"import")(rrv_mass_j);
@@ -1167,6 +1177,7 @@ class doBiasStudy_mlvj:
                                            int(options.isMC));
 
       mcWjetTreeResult.setTree(self.outputTree);
+      mcWjetTreeResult.setWorkspace(self.workspace4bias_);
       mcWjetTreeResult.setFittingModel(model_Total_mc);
       mcWjetTreeResult.setPdfInformation(options.mlvjregion,spectrum,self.channel,label);
       mcWjetTreeResult.setBackgroundPdfCore(model_bkg_wjet);
@@ -1355,6 +1366,7 @@ class doBiasStudy_mlvj:
                                             int(options.isMC));
 
        mcWjetTreeResult.setTree(self.outputTree);
+       mcWjetTreeResult.setWorkspace(self.workspace4bias_);
        mcWjetTreeResult.setFittingModel(model_Total_data);
        mcWjetTreeResult.setBackgroundPdfCore(model_bkg_data);
        mcWjetTreeResult.setPdfInformation(options.mlvjregion,spectrum,self.channel,label);
@@ -1371,6 +1383,7 @@ class doBiasStudy_mlvj:
                                             int(options.nexp),
                                             int(options.isMC));
        mcWjetTreeResult.setTree(self.outputTree);
+       mcWjetTreeResult.setWorkspace(self.workspace4bias_);
        mcWjetTreeResult.setFittingModel(model_Total_data);
        mcWjetTreeResult.setBackgroundPdfCore(model_bkg_data);
        mcWjetTreeResult.setPdfInformation(options.mlvjregion,spectrum,self.channel,label);
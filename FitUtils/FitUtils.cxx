@@ -14,10 +14,13 @@ void fit_mj_single_MC(RooWorkspace* workspace, const std::string & fileName, con
 	// make the extended model  
 	std::vector<std::string>* constraint_list = new std::vector<std::string>(); 
 	RooExtendPdf* model_pdf = MakeExtendedModel(workspace,label,model,"_mj",channel,wtagger_label,constraint_list);
+	RooArgSet* warm_start_parameters = model_pdf->getParameters(*rdataset_mj);
+	WarmStartParameters(warm_start_parameters,label,model,wtagger_label);
+	delete warm_start_parameters ;
 
-	RooFitResult* rfresult = model_pdf->fitTo(*rdataset_mj,RooFit::Save(1),RooFit::SumW2Error(kTRUE),RooFit::Extended(kTRUE), RooFit::Minimizer("Minuit2"),RooFit::Verbose(kFALSE));
-	rfresult               = model_pdf->fitTo(*rdataset_mj,RooFit::Save(1),RooFit::SumW2Error(kTRUE),RooFit::Extended(kTRUE), RooFit::Minimizer("Minuit2"),RooFit::Verbose(kFALSE));
-	rfresult               = model_pdf->fitTo(*rdataset_mj,RooFit::Save(1),RooFit::SumW2Error(kTRUE),RooFit::Extended(kTRUE), RooFit::Minimizer("Minuit2"));
+	// extended, SumW2-corrected Minuit2 fit through the batch NLL; it refits with a higher strategy only if needed
+	RooFitResult* rfresult = fit_batch_nll(model_pdf,rdataset_mj,rrv_mass_j,NULL,kTRUE);
+	StoreFitResult(rfresult,label,model,wtagger_label);
  
         std::cout<<""<<std::endl;std::cout<<""<<std::endl;
         std::cout<<"PRINTING FIT RESULT!!!!!!!"<<std::endl;
@@ -66,7 +69,8 @@ void fit_mj_single_MC(RooWorkspace* workspace, const std::string & fileName, con
 	//      param=par.Next()
   
   
-	workspace->import(*model_pdf);
+	// a model reused from the MakePdf cache is already the workspace copy
+	if(workspace->pdf(model_pdf->GetName()) != model_pdf) workspace->import(*model_pdf);
 	workspace->import(*rfresult);
   
 	std::cout<<" Plot name = " << (label+" fitted by "+model).c_str() << std::endl;
@@ -651,3 +655,124 @@ void DrawScaleFactorTTbarControlSample(RooWorkspace* workspace, std::map<std::st
   draw_canvas(xframe_data_fail,std::string(nameDir),std::string(namePlot),channel,GetLumi(),0,1,0);
 
 }
+
+////// Warm start database
+
+#if !defined(__CINT__) && !defined(__MAKECINT__)
+
+struct WarmStartEntry {
+  std::string sample, model, tagger ;
+  double wp, ptMin, ptMax ;
+  RooFitResult* result ;
+};
+
+static std::string warmStartFile ;
+static std::vector<WarmStartEntry> warmStartEntries ;
+static double warmStartPtMin = 200, warmStartPtMax = 5000 ;
+static Bool_t warmStartStore = kTRUE ;
+
+/// Splits wtagger labels like HP0v45_PuppiSD_N2DDT into the tagger (HP_PuppiSD_N2DDT) and the working point (0.45)
+static void SplitWorkingPoint(const std::string & wtagger, std::string & tagger, double & wp){
+  tagger = wtagger ;
+  wp = 0. ;
+  for(size_t i = 0; i+3 < wtagger.size(); i++){
+    if(isdigit(wtagger[i]) and wtagger[i+1] == 'v' and isdigit(wtagger[i+2]) and isdigit(wtagger[i+3])){
+      wp = (wtagger[i]-'0') + 0.1*(wtagger[i+2]-'0') + 0.01*(wtagger[i+3]-'0');
+      tagger.erase(i,4);
+      return ;
+    }
+  }
+}
+
+static std::string WarmStartTitle(const WarmStartEntry & entry){
+  return std::string(Form("%s %s %s %.4f %.1f %.1f",entry.sample.c_str(),entry.model.c_str(),entry.tagger.c_str(),entry.wp,entry.ptMin,entry.ptMax));
+}
+
+void SetWarmStartFile(const std::string & fileName){
+  for(size_t i = 0; i < warmStartEntries.size(); i++) delete warmStartEntries[i].result ;
+  warmStartEntries.clear();
+  warmStartFile = fileName ;
+  if(fileName.empty() or gSystem->AccessPathName(fileName.c_str())) return ;
+
+  TFile file(fileName.c_str(),"READ");
+  TIter next(file.GetListOfKeys());
+  for(TKey* key = (TKey*)next(); key; key = (TKey*)next()){
+    RooFitResult* result = dynamic_cast<RooFitResult*>(key->ReadObj());
+    if(!result) continue ;
+    WarmStartEntry entry ;
+    std::istringstream fields(result->GetTitle());
+    if(!(fields >> entry.sample >> entry.model >> entry.tagger >> entry.wp >> entry.ptMin >> entry.ptMax)){ delete result ; continue ; }
+    entry.result = result ;
+    warmStartEntries.push_back(entry);
+  }
+  std::cout<< "Warm start: "<< warmStartEntries.size() << " fit results in "<< fileName << std::endl;
+}
+
+void SetWarmStartStore(Bool_t store){ warmStartStore = store ; }
+
+void SetWarmStartPtBin(const double & ptMin, const double & ptMax){
+  warmStartPtMin = ptMin ;
+  warmStartPtMax = ptMax ;
+}
+
+Bool_t WarmStartParameters(RooArgSet* params, const std::string & sample, const std::string & model, const std::string & wtagger){
+  if(warmStartFile.empty() or !params) return kFALSE ;
+  std::string tagger ; double wp ;
+  SplitWorkingPoint(wtagger,tagger,wp);
+
+  // nearest pT bin first, then nearest working point
+  const WarmStartEntry* nearest = NULL ;
+  double bestPt = 0, bestWp = 0 ;
+  for(size_t i = 0; i < warmStartEntries.size(); i++){
+    const WarmStartEntry & entry = warmStartEntries[i] ;
+    if(entry.sample != sample or entry.model != model or entry.tagger != tagger) continue ;
+    double dPt = TMath::Abs(entry.ptMin-warmStartPtMin) + TMath::Abs(entry.ptMax-warmStartPtMax);
+    double dWp = TMath::Abs(entry.wp-wp);
+    if(!nearest or dPt < bestPt or (dPt == bestPt and dWp < bestWp)){
+      nearest = &entry ; bestPt = dPt ; bestWp = dWp ;
+    }
+  }
+  if(!nearest) return kFALSE ;
+
+  Int_t nSet = 0 ;
+  const RooArgList & stored = nearest->result->floatParsFinal();
+  for(Int_t i = 0; i < stored.getSize(); i++){
+    RooRealVar* par = dynamic_cast<RooRealVar*>(params->find(stored[i].GetName()));
+    if(!par or par->isConstant()) continue ;
+    const RooRealVar & value = (const RooRealVar&) stored[i] ;
+    par->setVal(TMath::Min(TMath::Max(value.getVal(),par->getMin()),par->getMax()));
+    // the stored errors are the initial Minuit steps
+    if(value.getError() > 0) par->setError(value.getError());
+    nSet++ ;
+  }
+  std::cout<< "Warm start of "<< sample << " "<< model << " from "<< WarmStartTitle(*nearest) << ": "<< nSet << " parameters" << std::endl;
+  return nSet > 0 ;
+}
+
+void StoreFitResult(RooFitResult* result, const std::string & sample, const std::string & model, const std::string & wtagger){
+  if(warmStartFile.empty() or !warmStartStore or !result) return ;
+  // only converged fits with a usable covariance seed later ones
+  if(result->status() != 0 or result->covQual() < 2) return ;
+
+  WarmStartEntry entry ;
+  entry.sample = sample ; entry.model = model ;
+  SplitWorkingPoint(wtagger,entry.tagger,entry.wp);
+  entry.ptMin = warmStartPtMin ; entry.ptMax = warmStartPtMax ;
+  std::string title = WarmStartTitle(entry);
+  entry.result = (RooFitResult*) result->Clone(Form("warmstart_%u",TString(title.c_str()).Hash()));
+  entry.result->SetTitle(title.c_str());
+
+  for(size_t i = 0; i < warmStartEntries.size(); i++){
+    if(WarmStartTitle(warmStartEntries[i]) != title) continue ;
+    delete warmStartEntries[i].result ;
+    warmStartEntries.erase(warmStartEntries.begin()+i);
+    break ;
+  }
+  warmStartEntries.push_back(entry);
+
+  TFile file(warmStartFile.c_str(),"UPDATE");
+  entry.result->Write(entry.result->GetName(),TObject::kOverwrite);
+  file.Close();
+}
+
+#endif
@@ -2,12 +2,17 @@
 #include <string>
 #include <vector>
 #include <fstream>
+#include <sstream>
+#include <cctype>
 
 #include "TString.h"
 #include "TGaxis.h"
 #include "TGraph2D.h"
 #include "TFile.h"
 #include "TF1.h"
+#include "TMath.h"
+#include "TKey.h"
+#include "TSystem.h"
 
 #include "RooRealVar.h"
 #include "RooFormulaVar.h"
@@ -36,6 +41,7 @@
 #include "RooProdPdf.h"
 
 #include "../PDFs/MakePdf.h"
+#include "../PDFs/RooBatchNLL.h"
 #include "../PlotStyle/PlotUtils.h"
 // #include "../PDFs/PdfDiagonalizer.h"
 
@@ -45,3 +51,14 @@ void fit_mj_single_MC(RooWorkspace*, const std::string & = "", const std::string
 void ScaleFactorTTbarControlSampleFit(RooWorkspace*, std::map<std::string,std::string >, std::map<std::string,int>, std::vector<std::string>* = NULL, std::vector<std::string>* = NULL, const std::string & ="", const std::string & ="mu", const std::string & wtagger ="HP", const double & = 200, const double & = 2000);
 
 void DrawScaleFactorTTbarControlSample(RooWorkspace*,  std::map<std::string,int>,  const std::string & ="", const std::string & ="mu", const std::string & ="HP",const double & = 200, const double & = 2000,   const std::string & ="");
+
+/// Warm start database: a ROOT file of converged RooFitResults, one per (sample, model, tagger, working point, pT bin),
+/// read by SetWarmStartFile and updated by StoreFitResult. Empty file name (the default) switches it off.
+void SetWarmStartFile(const std::string & fileName);
+void SetWarmStartPtBin(const double & ptMin, const double & ptMax);
+/// kFALSE: StoreFitResult does nothing (forked fit workers, whose results the parent process stores)
+void SetWarmStartStore(Bool_t store);
+/// Seeds the floating parameters in params from the stored result of the same sample, model and tagger that is nearest
+/// in pT bin, then in working point. Returns kFALSE when there is none.
+Bool_t WarmStartParameters(RooArgSet* params, const std::string & sample, const std::string & model, const std::string & wtagger);
+void   StoreFitResult(RooFitResult* result, const std::string & sample, const std::string & model, const std::string & wtagger);
@@ -12,6 +12,7 @@
 #include "RooExponential.h" 
 #include <math.h> 
 #include "TMath.h" 
+#include "VectorMath.h"
 
 #include <algorithm>
 #include <vector>
@@ -44,6 +45,7 @@
 #include "RooDataSet.h"
 #include "RooDataHist.h"
 #include "RooGaussian.h"
+#include "RooRandom.h"
 #include "TCanvas.h"
 #include "RooPlot.h"
 #include "TTree.h"
@@ -57,6 +59,95 @@ using namespace std;
 
 void HWWLVJRooPdfs(){}
 
+//// Building blocks of the batch shapes, on top of the VectorMath kernels
+/// out[i] = (1+erf((x[i]-offset)/width))/2
+static void ErfTurnOnBatch(const Double_t* x, Double_t* out, Int_t n, Double_t offset, Double_t width){
+    for(Int_t i=0; i<n; i++) out[i]=(x[i]-offset)/width;
+    VecErf(out,out,n);
+    for(Int_t i=0; i<n; i++) out[i]=(1.+out[i])/2.;
+}
+
+/// out[i] = (pi/2+atan((x[i]-offset)/width))/2
+static void AtanTurnOnBatch(const Double_t* x, Double_t* out, Int_t n, Double_t offset, Double_t width){
+    for(Int_t i=0; i<n; i++) out[i]=(x[i]-offset)/width;
+    VecAtan(out,out,n);
+    for(Int_t i=0; i<n; i++) out[i]=(TMath::PiOver2()+out[i])/2.;
+}
+
+/// out[i] = log(x[i]/scale)
+static void LogScaledBatch(const Double_t* x, Double_t* out, Int_t n, Double_t scale){
+    for(Int_t i=0; i<n; i++) out[i]=x[i]/scale;
+    VecLog(out,out,n);
+}
+
+/// out[i] += log((1+erf(z))/2), z=(x[i]-offset)/width, through VecErf and VecLog. Below the turn-on (z<-0.5) 1+erf(z)
+/// cancels, so erfc(-z) is used there, with its asymptotic series where erfc underflows
+static void AddLogErfTurnOnBatch(const Double_t* x, Double_t* out, Int_t n, Double_t offset, Double_t width){
+    if(width<1e-2) width=1e-2;
+    std::vector<Double_t> z(n), turnOn(n);
+    for(Int_t i=0; i<n; i++) z[i]=(x[i]-offset)/width;
+    VecErf(&z[0],&turnOn[0],n);
+    for(Int_t i=0; i<n; i++){
+      if(z[i]>-0.5)      turnOn[i]=(1.+turnOn[i])/2.;
+      else if(z[i]>-26.) turnOn[i]=TMath::Erfc(-z[i])/2.;
+      else               turnOn[i]=1.;
+    }
+    VecLog(&turnOn[0],&turnOn[0],n);
+    for(Int_t i=0; i<n; i++){
+      if(z[i]>-26.){
+        out[i]+=turnOn[i];
+      }else{
+        Double_t t=-z[i], u=1./(t*t);
+        out[i]+=-t*t-TMath::Log(2.*t*TMath::Sqrt(TMath::Pi()))+TMath::Log(1.-u/2.+0.75*u*u-1.875*u*u*u);
+      }
+    }
+}
+
+/// out[i] += log((pi/2+atan(z))/2), z=(x[i]-offset)/width; below the turn-on pi/2+atan(z) = atan(-1/z), no cancellation
+static void AddLogAtanTurnOnBatch(const Double_t* x, Double_t* out, Int_t n, Double_t offset, Double_t width){
+    if(width<1e-2) width=1e-2;
+    std::vector<Double_t> z(n), arg(n), turnOn(n);
+    for(Int_t i=0; i<n; i++){
+      z[i]=(x[i]-offset)/width;
+      arg[i]= z[i]<-1. ? -1./z[i] : z[i];
+    }
+    VecAtan(&arg[0],&turnOn[0],n);
+    for(Int_t i=0; i<n; i++) turnOn[i]=( z[i]<-1. ? turnOn[i] : TMath::PiOver2()+turnOn[i] )/2.;
+    VecLog(&turnOn[0],&turnOn[0],n);
+    for(Int_t i=0; i<n; i++) out[i]+=turnOn[i];
+}
+
+/// Turns the exponent h stored in out into T(z)*exp(h), z=(x[i]-offset)/width, with T the erf or the atan
+/// turn-on, and fills the derivatives of the product with respect to offset and width
+static void TurnOnExpGradientBatch(const Double_t* x, Double_t* out, Double_t* gradOffset, Double_t* gradWidth, Int_t n,
+                                   Double_t offset, Double_t width, Bool_t atanTurnOn){
+    Bool_t clamped = width<1e-2;
+    if(clamped) width=1e-2;
+    std::vector<Double_t> z(n), turnOn(n), slope(n);
+    for(Int_t i=0; i<n; i++) z[i]=(x[i]-offset)/width;
+    if(atanTurnOn){
+      VecAtan(&z[0],&turnOn[0],n);
+      for(Int_t i=0; i<n; i++){
+        turnOn[i]=(TMath::PiOver2()+turnOn[i])/2.;
+        slope[i]=0.5/(1.+z[i]*z[i]);
+      }
+    }else{
+      VecErf(&z[0],&turnOn[0],n);
+      for(Int_t i=0; i<n; i++){
+        turnOn[i]=(1.+turnOn[i])/2.;
+        slope[i]=-z[i]*z[i];
+      }
+      VecExp(&slope[0],&slope[0],n);
+      for(Int_t i=0; i<n; i++) slope[i]/=TMath::Sqrt(TMath::Pi());
+    }
+    VecExp(out,out,n);
+    for(Int_t i=0; i<n; i++){
+      gradOffset[i]=-out[i]*slope[i]/width;
+      gradWidth[i] = clamped ? 0. : -out[i]*slope[i]*z[i]/width;
+      out[i]*=turnOn[i];
+    }
+}
+
 //// Erf*Exp function implementation 
 Double_t ErfExp(Double_t x, Double_t c, Double_t offset, Double_t width){
     if(width<1e-2)width=1e-2;
@@ -64,9 +155,8 @@ Double_t ErfExp(Double_t x, Double_t c, Double_t offset, Double_t width){
 	return TMath::Exp(c*x)*(1.+TMath::Erf((x-offset)/width))/2. ;
 }
 
-Double_t ErfExp(Double_t x, Double_t x_min, Double_t x_max, Double_t c, Double_t offset, Double_t width){
-    if(width<1e-2)width=1e-2;
-    if (c==0)c=1e-7;
+/// Closed-form integral of Erf*Exp between x_min and x_max
+Double_t ErfExpIntegral(Double_t x_min, Double_t x_max, Double_t c, Double_t offset, Double_t width){
     double minTerm = (TMath::Exp(c*c*width*width/4+c*offset) * 
 					TMath::Erf((2*x_min-c*width*width-
 							2*offset)/2/width) - 
@@ -79,10 +169,27 @@ Double_t ErfExp(Double_t x, Double_t x_min, Double_t x_max, Double_t c, Double_t
 					TMath::Exp(c*x_max) * 
 					TMath::Erf((x_max-offset)/width) - 
 					TMath::Exp(c*x_max))/-2/c;
-	Double_t integral=(maxTerm-minTerm) ;
+	return (maxTerm-minTerm) ;
+}
+
+Double_t ErfExp(Double_t x, Double_t x_min, Double_t x_max, Double_t c, Double_t offset, Double_t width){
+    if(width<1e-2)width=1e-2;
+    if (c==0)c=1e-7;
+	Double_t integral=ErfExpIntegral(x_min,x_max,c,offset,width) ;
 	return TMath::Exp(c*x)*(1.+TMath::Erf((x-offset)/width))/2./integral ;
 }
 
+void ErfExpBatch(const Double_t* x, Double_t* out, Int_t n, Double_t c, Double_t offset, Double_t width){
+    if(width<1e-2)width=1e-2;
+    if (c==0)c=-1e-7;
+    if(n<=0) return;
+    std::vector<Double_t> turnOn(n);
+    ErfTurnOnBatch(x,&turnOn[0],n,offset,width);
+    for(Int_t i=0; i<n; i++) out[i]=c*x[i];
+    VecExp(out,out,n);
+    for(Int_t i=0; i<n; i++) out[i]*=turnOn[i];
+}
+
 //// Single Exp function 
 Double_t Exp(Double_t x, Double_t c){
 	return TMath::Exp(c*x);
@@ -106,6 +213,18 @@ Double_t  ErfPow2(Double_t x,Double_t c0,Double_t c1, Double_t offset, Double_t
    return TMath::Power(x/sqrt_s ,-1*(c0+c1*TMath::Log(x/sqrt_s)) )*(1+ TMath::Erf((x-offset)/width)) /2. ; 
 }
 
+void ErfPow2Batch(const Double_t* x, Double_t* out, Int_t n, Double_t c0, Double_t c1, Double_t offset, Double_t width){
+   if(width<1e-2)width=1e-2;
+   Double_t sqrt_s=2000.;
+   if(n<=0) return;
+   std::vector<Double_t> turnOn(n);
+   ErfTurnOnBatch(x,&turnOn[0],n,offset,width);
+   LogScaledBatch(x,out,n,sqrt_s);
+   for(Int_t i=0; i<n; i++) out[i]=-1*(c0+c1*out[i])*out[i];
+   VecExp(out,out,n);
+   for(Int_t i=0; i<n; i++) out[i]*=turnOn[i];
+}
+
 Double_t  ErfPow3(Double_t x,Double_t c0,Double_t c1, Double_t c2, Double_t offset, Double_t width){
 
    if(width<1e-2)width=1e-2;
@@ -113,12 +232,36 @@ Double_t  ErfPow3(Double_t x,Double_t c0,Double_t c1, Double_t c2, Double_t offs
    return TMath::Power(x/sqrt_s ,-1*(c0+c1*TMath::Log(x/sqrt_s)+c2*TMath::Log(x/sqrt_s))*TMath::Log(x/sqrt_s))*(1+ TMath::Erf((x-offset)/width)) /2. ; 
 }
 
+void ErfPow3Batch(const Double_t* x, Double_t* out, Int_t n, Double_t c0, Double_t c1, Double_t c2, Double_t offset, Double_t width){
+   if(width<1e-2)width=1e-2;
+   Double_t sqrt_s=2000.;
+   if(n<=0) return;
+   std::vector<Double_t> turnOn(n);
+   ErfTurnOnBatch(x,&turnOn[0],n,offset,width);
+   LogScaledBatch(x,out,n,sqrt_s);
+   for(Int_t i=0; i<n; i++) out[i]=-1*(c0+c1*out[i]+c2*out[i])*out[i]*out[i];
+   VecExp(out,out,n);
+   for(Int_t i=0; i<n; i++) out[i]*=turnOn[i];
+}
+
 Double_t  ErfPowExp(Double_t x,Double_t c0,Double_t c1, Double_t offset, Double_t width){
    if(width<1e-2)width=1e-2;
    Double_t sqrt_s=2000.;
    return TMath::Power(x/sqrt_s ,-1*(c1*TMath::Log(x/sqrt_s)) )*TMath::Exp(-1*x/sqrt_s*c0)*(1+ TMath::Erf((x-offset)/width)) /2. ; 
 }
 
+void ErfPowExpBatch(const Double_t* x, Double_t* out, Int_t n, Double_t c0, Double_t c1, Double_t offset, Double_t width){
+   if(width<1e-2)width=1e-2;
+   Double_t sqrt_s=2000.;
+   if(n<=0) return;
+   std::vector<Double_t> turnOn(n);
+   ErfTurnOnBatch(x,&turnOn[0],n,offset,width);
+   LogScaledBatch(x,out,n,sqrt_s);
+   for(Int_t i=0; i<n; i++) out[i]=-1*c1*out[i]*out[i]-x[i]/sqrt_s*c0;
+   VecExp(out,out,n);
+   for(Int_t i=0; i<n; i++) out[i]*=turnOn[i];
+}
+
 
 Double_t  ErfPow(Double_t x,Double_t c, Double_t offset, Double_t width){
    if(width<1e-2)width=1e-2;
@@ -126,15 +269,37 @@ Double_t  ErfPow(Double_t x,Double_t c, Double_t offset, Double_t width){
    return TMath::Power(x/sqrt_s ,c)*(1+ TMath::Erf((x-offset)/width)) /2. ; 
 }
 
+void ErfPowBatch(const Double_t* x, Double_t* out, Int_t n, Double_t c, Double_t offset, Double_t width){
+   if(width<1e-2)width=1e-2;
+   Double_t sqrt_s=2000.;
+   if(n<=0) return;
+   std::vector<Double_t> turnOn(n);
+   ErfTurnOnBatch(x,&turnOn[0],n,offset,width);
+   LogScaledBatch(x,out,n,sqrt_s);
+   for(Int_t i=0; i<n; i++) out[i]*=c;
+   VecExp(out,out,n);
+   for(Int_t i=0; i<n; i++) out[i]*=turnOn[i];
+}
+
 
 Double_t ExpN(Double_t x, Double_t c, Double_t n){
     return TMath::Exp( c*x+n/x ); 
 }
 
+void ExpNBatch(const Double_t* x, Double_t* out, Int_t n, Double_t c, Double_t nn){
+    for(Int_t i=0; i<n; i++) out[i]=c*x[i]+nn/x[i];
+    VecExp(out,out,n);
+}
+
 Double_t ExpTail(Double_t x, Double_t s, Double_t a){
     return TMath::Exp( -x/(s+a*x) ); 
 }
 
+void ExpTailBatch(const Double_t* x, Double_t* out, Int_t n, Double_t s, Double_t a){
+    for(Int_t i=0; i<n; i++) out[i]=-x[i]/(s+a*x[i]);
+    VecExp(out,out,n);
+}
+
 Double_t ErfExpTail(Double_t x, Double_t offset, Double_t width, Double_t s, Double_t a){
   Double_t val = ExpTail(x,s,a)*((1.+TMath::Erf((x-offset)/width))/2);
   return val ;
@@ -150,6 +315,17 @@ Double_t AtanExp(Double_t x, Double_t c, Double_t offset, Double_t width){
     return TMath::Exp(c*x)*(TMath::Pi()/2+TMath::ATan((x-offset)/width))/2 ;
 }
 
+void AtanExpBatch(const Double_t* x, Double_t* out, Int_t n, Double_t c, Double_t offset, Double_t width){
+    if(width<1e-2) width=1e-2;
+    if (c==0) c=-1e-7;
+    if(n<=0) return;
+    std::vector<Double_t> turnOn(n);
+    AtanTurnOnBatch(x,&turnOn[0],n,offset,width);
+    for(Int_t i=0; i<n; i++) out[i]=c*x[i];
+    VecExp(out,out,n);
+    for(Int_t i=0; i<n; i++) out[i]*=turnOn[i];
+}
+
 
 Double_t  AtanPowExp(Double_t x,Double_t c0,Double_t c1, Double_t offset, Double_t width){
    if(width<1e-2)width=1e-2;
@@ -157,11 +333,35 @@ Double_t  AtanPowExp(Double_t x,Double_t c0,Double_t c1, Double_t offset, Double
    return TMath::Power(x/sqrt_s ,-1*(c1*TMath::Log(x/sqrt_s)) )*TMath::Exp(-1*x/sqrt_s*c0)*(TMath::Pi()/2+TMath::ATan((x-offset)/width))/2; 
 }
 
+void AtanPowExpBatch(const Double_t* x, Double_t* out, Int_t n, Double_t c0, Double_t c1, Double_t offset, Double_t width){
+   if(width<1e-2)width=1e-2;
+   Double_t sqrt_s=2000.;
+   if(n<=0) return;
+   std::vector<Double_t> turnOn(n);
+   AtanTurnOnBatch(x,&turnOn[0],n,offset,width);
+   LogScaledBatch(x,out,n,sqrt_s);
+   for(Int_t i=0; i<n; i++) out[i]=-1*c1*out[i]*out[i]-x[i]/sqrt_s*c0;
+   VecExp(out,out,n);
+   for(Int_t i=0; i<n; i++) out[i]*=turnOn[i];
+}
+
 Double_t  AtanPow(Double_t x,Double_t c, Double_t offset, Double_t width){
    if(width<1e-2)width=1e-2;
    Double_t sqrt_s=2000.;
    return TMath::Power(x/sqrt_s ,c)*(TMath::Pi()/2+TMath::ATan((x-offset)/width))/2; 
 }
+
+void AtanPowBatch(const Double_t* x, Double_t* out, Int_t n, Double_t c, Double_t offset, Double_t width){
+   if(width<1e-2)width=1e-2;
+   Double_t sqrt_s=2000.;
+   if(n<=0) return;
+   std::vector<Double_t> turnOn(n);
+   AtanTurnOnBatch(x,&turnOn[0],n,offset,width);
+   LogScaledBatch(x,out,n,sqrt_s);
+   for(Int_t i=0; i<n; i++) out[i]*=c;
+   VecExp(out,out,n);
+   for(Int_t i=0; i<n; i++) out[i]*=turnOn[i];
+}
 Double_t AtanExpTail(Double_t x, Double_t offset, Double_t width, Double_t s, Double_t a){
   return ExpTail(x,s,a)*(TMath::Pi()/2+TMath::ATan((x-offset)/width))/2;
 }
@@ -173,6 +373,18 @@ Double_t  AtanPow2(Double_t x,Double_t c0,Double_t c1, Double_t offset, Double_t
    return TMath::Power(x/sqrt_s ,-1*(c0+c1*TMath::Log(x/sqrt_s))) *(TMath::Pi()/2+TMath::ATan((x-offset)/width))/2 ; 
  }
 
+void AtanPow2Batch(const Double_t* x, Double_t* out, Int_t n, Double_t c0, Double_t c1, Double_t offset, Double_t width){
+   if(width<1e-2)width=1e-2;
+   Double_t sqrt_s=2000.;
+   if(n<=0) return;
+   std::vector<Double_t> turnOn(n);
+   AtanTurnOnBatch(x,&turnOn[0],n,offset,width);
+   LogScaledBatch(x,out,n,sqrt_s);
+   for(Int_t i=0; i<n; i++) out[i]=-1*(c0+c1*out[i])*out[i];
+   VecExp(out,out,n);
+   for(Int_t i=0; i<n; i++) out[i]*=turnOn[i];
+}
+
 Double_t  AtanPow3(Double_t x,Double_t c0,Double_t c1, Double_t c2, Double_t offset, Double_t width){
 
    if(width<1e-2)width=1e-2;
@@ -180,6 +392,18 @@ Double_t  AtanPow3(Double_t x,Double_t c0,Double_t c1, Double_t c2, Double_t off
    return TMath::Power(x/sqrt_s ,-1*(c0+c1*TMath::Log(x/sqrt_s)+c2*TMath::Log(x/sqrt_s))*TMath::Log(x/sqrt_s)) *(TMath::Pi()/2+TMath::ATan((x-offset)/width))/2 ; 
  }
 
+void AtanPow3Batch(const Double_t* x, Double_t* out, Int_t n, Double_t c0, Double_t c1, Double_t c2, Double_t offset, Double_t width){
+   if(width<1e-2)width=1e-2;
+   Double_t sqrt_s=2000.;
+   if(n<=0) return;
+   std::vector<Double_t> turnOn(n);
+   AtanTurnOnBatch(x,&turnOn[0],n,offset,width);
+   LogScaledBatch(x,out,n,sqrt_s);
+   for(Int_t i=0; i<n; i++) out[i]=-1*(c0+c1*out[i]+c2*out[i])*out[i]*out[i];
+   VecExp(out,out,n);
+   for(Int_t i=0; i<n; i++) out[i]*=turnOn[i];
+}
+
 
 
 //// Erf*Exp pdf 
@@ -220,49 +444,27 @@ Int_t RooErfExpPdf::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVar
 
 Double_t RooErfExpPdf::analyticalIntegral(Int_t code, const char* rangeName) const  { 
 
-    Double_t width_tmp=width; if(width<1e-2){ width_tmp=1e-2;}
 	if (code==1) { 
-        Double_t minTerm=0;
-        Double_t maxTerm=0;
-        if(c==0){ 
-            Double_t delta=-1e-7;
-            minTerm = (TMath::Exp(delta*delta*width_tmp*width_tmp/4+delta*offset) * 
-					TMath::Erf((2*x.min(rangeName)-delta*width_tmp*width_tmp-
-							2*offset)/2/width_tmp) - 
-					TMath::Exp(delta*x.min(rangeName)) * 
-					TMath::Erf((x.min(rangeName)-offset)/width_tmp) - 
-					TMath::Exp(delta*x.min(rangeName)))/-2/delta;
-		    maxTerm = (TMath::Exp(delta*delta*width_tmp*width_tmp/4+delta*offset) * 
-					TMath::Erf((2*x.max(rangeName)-delta*width_tmp*width_tmp-
-							2*offset)/2/width_tmp) - 
-					TMath::Exp(delta*x.max(rangeName)) * 
-					TMath::Erf((x.max(rangeName)-offset)/width_tmp) - 
-					TMath::Exp(delta*x.max(rangeName)))/-2/delta;
-        
-        }else{
-            minTerm = (TMath::Exp(c*c*width_tmp*width_tmp/4+c*offset) * 
-					TMath::Erf((2*x.min(rangeName)-c*width_tmp*width_tmp-
-							2*offset)/2/width_tmp) - 
-					TMath::Exp(c*x.min(rangeName)) * 
-					TMath::Erf((x.min(rangeName)-offset)/width_tmp) - 
-					TMath::Exp(c*x.min(rangeName)))/-2/c;
-		    maxTerm = (TMath::Exp(c*c*width_tmp*width_tmp/4+c*offset) * 
-					TMath::Erf((2*x.max(rangeName)-c*width_tmp*width_tmp-
-							2*offset)/2/width_tmp) - 
-					TMath::Exp(c*x.max(rangeName)) * 
-					TMath::Erf((x.max(rangeName)-offset)/width_tmp) - 
-					TMath::Exp(c*x.max(rangeName)))/-2/c;
-        }
-		return (maxTerm-minTerm) ;
+		Double_t integral=0;
+		closedIntegral(x.min(rangeName),x.max(rangeName),integral);
+		return integral ;
 	} 
 	return 0 ; 
 } 
 
+/// ErfExpIntegral with the c and width clamps of ErfExp
+Bool_t RooErfExpPdf::closedIntegral(Double_t x_min, Double_t x_max, Double_t& value) const {
+    Double_t c_tmp=c; if(c_tmp==0){ c_tmp=-1e-7;}
+    Double_t width_tmp=width; if(width_tmp<1e-2){ width_tmp=1e-2;}
+    value=ErfExpIntegral(x_min,x_max,c_tmp,offset,width_tmp);
+    return kTRUE ;
+}
+
 /// RooAlpha pdf as ratio of two Erf*Exp
 
 ClassImp(RooAlpha)
 
-RooAlpha::RooAlpha(){}
+RooAlpha::RooAlpha() {}
 
 RooAlpha::RooAlpha(const char *name, const char *title,
 		   RooAbsReal& _x,
@@ -299,17 +501,26 @@ RooAlpha::RooAlpha(const RooAlpha& other, const char* name) :
         xmax=other.xmax;
 }
 
+Double_t RooAlpha::normRatio(Double_t c_tmp, Double_t width_tmp, Double_t ca_tmp, Double_t widtha_tmp) const {
+    Double_t key[8]={c_tmp,offset,width_tmp,ca_tmp,offseta,widtha_tmp,xmin,xmax};
+    if(normConstants.update(key,8))
+        normConstants[0]=ErfExpIntegral(xmin,xmax,ca_tmp,offseta,widtha_tmp)/ErfExpIntegral(xmin,xmax,c_tmp,offset,width_tmp);
+    return normConstants[0];
+}
+
 double RooAlpha::evaluate() const{
     Double_t width_tmp=width; if(width<1e-2){ width_tmp=1e-2;}
     Double_t widtha_tmp=widtha; if(widtha<1e-2){ widtha_tmp=1e-2;}
-    return ErfExp(x,xmin,xmax,c,offset,width_tmp)/ErfExp(x,xmin,xmax,ca,offseta,widtha_tmp);
+    Double_t c_tmp=c;   if(c_tmp==0) c_tmp=1e-7;
+    Double_t ca_tmp=ca; if(ca_tmp==0) ca_tmp=1e-7;
+    return ErfExp(x,c_tmp,offset,width_tmp)/ErfExp(x,ca_tmp,offseta,widtha_tmp)*normRatio(c_tmp,width_tmp,ca_tmp,widtha_tmp);
 }
 
 
 /// Alpha function given by the ratio of two exponential functions
 ClassImp(RooAlphaExp)
 
-RooAlphaExp::RooAlphaExp(){}
+RooAlphaExp::RooAlphaExp() {}
 
 RooAlphaExp::RooAlphaExp(const char *name, const char *title,
 		   RooAbsReal& _x,
@@ -334,8 +545,16 @@ RooAlphaExp::RooAlphaExp(const RooAlphaExp& other, const char* name) :
         xmax=other.xmax;
 }
 
+Double_t RooAlphaExp::normRatio(Double_t c_tmp, Double_t ca_tmp) const {
+  Double_t key[4]={c_tmp,ca_tmp,xmin,xmax};
+  if(normConstants.update(key,4))
+    normConstants[0]=Exp(xmin,xmin,xmax,c_tmp)/Exp(xmin,xmin,xmax,ca_tmp);
+  return normConstants[0];
+}
+
 double RooAlphaExp::evaluate() const{
-  return Exp(x,xmin,xmax,c)/Exp(x,xmin,xmax,ca);
+  Double_t c_tmp=c, ca_tmp=ca;
+  return TMath::Exp((c_tmp-ca_tmp)*(x-xmin))*normRatio(c_tmp,ca_tmp);
 }
 
 
@@ -871,6 +1090,17 @@ Double_t TwoExp(Double_t x, Double_t c0, Double_t c1, Double_t frac){
   return TMath::Exp(x*c0)+frac*TMath::Exp(x*c1);
 }
 
+void TwoExpBatch(const Double_t* x, Double_t* out, Int_t n, Double_t c0, Double_t c1, Double_t frac){
+  if(frac<0){frac=0.;}
+  if(frac>1){frac=1.;}
+  if(n<=0) return;
+  std::vector<Double_t> second(n);
+  for(Int_t i=0; i<n; i++){ out[i]=x[i]*c0; second[i]=x[i]*c1; }
+  VecExp(out,out,n);
+  VecExp(&second[0],&second[0],n);
+  for(Int_t i=0; i<n; i++) out[i]+=frac*second[i];
+}
+
 
 Roo2ExpPdf::Roo2ExpPdf(const char *name, const char *title, 
                         RooAbsReal& _x,
@@ -979,7 +1209,6 @@ Double_t RooAnaExpNPdf::analyticalIntegral(Int_t code, const char* rangeName) co
 
         Double_t minTerm=integral_ExpN(x_min,c,n);
         Double_t maxTerm=integral_ExpN(x_max,c,n);
-		cout<<"maxTerm-minTerm="<<maxTerm-minTerm<<endl;
 		return (maxTerm-minTerm) ;
 	} 
 	return 0 ; 
@@ -1017,18 +1246,27 @@ RooDoubleCrystalBall::RooDoubleCrystalBall(const RooDoubleCrystalBall& other, co
   alpha2("alpha2",this,other.alpha2),
   n2("n2",this,other.n2){} 
 
+const RooDerivedConstants& RooDoubleCrystalBall::tailConstants() const {
+  Double_t inputs[4]={alpha1,n1,alpha2,n2};
+  if(tailCache.update(inputs,4)){
+    tailCache[0] = pow(inputs[1]/fabs(inputs[0]),inputs[1])*exp(-inputs[0]*inputs[0]/2);
+    tailCache[1] = inputs[1]/fabs(inputs[0])-fabs(inputs[0]);
+    tailCache[2] = pow(inputs[3]/fabs(inputs[2]),inputs[3])*exp(-inputs[2]*inputs[2]/2);
+    tailCache[3] = inputs[3]/fabs(inputs[2])-fabs(inputs[2]);
+  }
+  return tailCache;
+}
+
 double RooDoubleCrystalBall::evaluate() const { 
   double t = (x-mean)/width;
   if(t>-alpha1 && t<alpha2){
     return exp(-0.5*t*t);
   }else if(t<-alpha1){
-    double A1 = pow(n1/fabs(alpha1),n1)*exp(-alpha1*alpha1/2);
-    double B1 = n1/fabs(alpha1)-fabs(alpha1);
-    return A1*pow(B1-t,-n1);
+    const RooDerivedConstants& tail = tailConstants();
+    return tail[0]*pow(tail[1]-t,-n1);
   }else if(t>alpha2){
-    double A2 = pow(n2/fabs(alpha2),n2)*exp(-alpha2*alpha2/2);
-    double B2 = n2/fabs(alpha2)-fabs(alpha2);
-    return A2*pow(B2+t,-n2);
+    const RooDerivedConstants& tail = tailConstants();
+    return tail[2]*pow(tail[3]+t,-n2);
   }else{
     cout << "ERROR evaluating range..." << endl;
     return 99;
@@ -1059,8 +1297,9 @@ Double_t RooDoubleCrystalBall::analyticalIntegral(Int_t code, const char* rangeN
     central = rootPiBy2*width*(TMath::Erf((central_high-mean)/xscale)-TMath::Erf((central_low-mean)/xscale));
  
   //compute left tail;
-  double A1 = pow(n1/fabs(alpha1),n1)*exp(-alpha1*alpha1/2);
-  double B1 = n1/fabs(alpha1)-fabs(alpha1);
+  const RooDerivedConstants& tail = tailConstants();
+  double A1 = tail[0];
+  double B1 = tail[1];
  
   double left_low=x.min(rangeName);
   double left_high=min(x.max(rangeName),mean - alpha1*width);
@@ -1072,8 +1311,8 @@ Double_t RooDoubleCrystalBall::analyticalIntegral(Int_t code, const char* rangeN
   }
  
   //compute right tail;
-  double A2 = pow(n2/fabs(alpha2),n2)*exp(-alpha2*alpha2/2);
-  double B2 = n2/fabs(alpha2)-fabs(alpha2);
+  double A2 = tail[2];
+  double B2 = tail[3];
  
   double right_low=max(x.min(rangeName),mean + alpha2*width);
   double right_high=x.max(rangeName);
@@ -1434,3 +1673,2321 @@ Double_t RooAlpha4AtanPowPdf::evaluate() const {
 
 
 
+
+
+//////////////////////////////////////////
+//// Batch evaluation: batchSnapshot reads the proxies once, evaluateSnapshot then loops over the events
+
+void RooBatchPdf::evaluateBatch(const Double_t* xs, Double_t* out, Int_t n) const {
+   Double_t p[kMaxSnapshot];
+   batchSnapshot(p);
+   evaluateSnapshot(p,xs,out,n);
+}
+
+Bool_t RooBatchPdf::logBatch(const Double_t* xs, Double_t* out, Int_t n) const {
+   Double_t p[kMaxSnapshot];
+   batchSnapshot(p);
+   return logSnapshot(p,xs,out,n);
+}
+
+Int_t RooPowPdf::batchSnapshot(Double_t* p) const {
+   p[0]=p0;
+   return 1;
+}
+
+void RooPowPdf::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   Double_t sqrt_s=2000.;
+   Double_t p0_tmp=p[0];
+   LogScaledBatch(xs,out,n,sqrt_s);
+   for(Int_t i=0; i<n; i++) out[i]*=p0_tmp;
+   VecExp(out,out,n);
+}
+
+Int_t RooPow2Pdf::batchSnapshot(Double_t* p) const {
+   p[0]=p0; p[1]=p1;
+   return 2;
+}
+
+void RooPow2Pdf::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   Double_t sqrt_s=2000.;
+   Double_t p0_tmp=p[0], p1_tmp=p[1];
+   LogScaledBatch(xs,out,n,sqrt_s);
+   for(Int_t i=0; i<n; i++) out[i]=-1*(p0_tmp+p1_tmp*out[i])*out[i];
+   VecExp(out,out,n);
+}
+
+Int_t RooPow3Pdf::batchSnapshot(Double_t* p) const {
+   p[0]=p0; p[1]=p1; p[2]=p2;
+   return 3;
+}
+
+void RooPow3Pdf::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   Double_t sqrt_s=2000.;
+   Double_t p0_tmp=p[0], p1_tmp=p[1], p2_tmp=p[2];
+   LogScaledBatch(xs,out,n,sqrt_s);
+   for(Int_t i=0; i<n; i++) out[i]=-1*(p0_tmp+p1_tmp*out[i]+p2_tmp*out[i]*out[i])*out[i];
+   VecExp(out,out,n);
+}
+
+Int_t RooErfExpPdf::batchSnapshot(Double_t* p) const {
+   p[0]=c; p[1]=offset; p[2]=width;
+   return 3;
+}
+
+void RooErfExpPdf::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   ErfExpBatch(xs,out,n,p[0],p[1],p[2]);
+}
+
+Int_t RooAlpha::batchSnapshot(Double_t* p) const {
+   Double_t width_tmp=width; if(width<1e-2){ width_tmp=1e-2;}
+   Double_t widtha_tmp=widtha; if(widtha<1e-2){ widtha_tmp=1e-2;}
+   Double_t c_tmp=c;   if(c_tmp==0) c_tmp=1e-7;
+   Double_t ca_tmp=ca; if(ca_tmp==0) ca_tmp=1e-7;
+   p[0]=c_tmp; p[1]=offset; p[2]=width_tmp; p[3]=ca_tmp; p[4]=offseta; p[5]=widtha_tmp;
+   p[6]=normRatio(c_tmp,width_tmp,ca_tmp,widtha_tmp);
+   return 7;
+}
+
+void RooAlpha::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   std::vector<Double_t> den(n);
+   ErfExpBatch(xs,out,n,p[0],p[1],p[2]);
+   ErfExpBatch(xs,&den[0],n,p[3],p[4],p[5]);
+   for(Int_t i=0; i<n; i++) out[i]=out[i]/den[i]*p[6];
+}
+
+Int_t RooAlphaExp::batchSnapshot(Double_t* p) const {
+   Double_t c_tmp=c, ca_tmp=ca;
+   p[0]=c_tmp-ca_tmp; p[1]=xmin; p[2]=normRatio(c_tmp,ca_tmp);
+   return 3;
+}
+
+void RooAlphaExp::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   for(Int_t i=0; i<n; i++) out[i]=p[0]*(xs[i]-p[1]);
+   VecExp(out,out,n);
+   for(Int_t i=0; i<n; i++) out[i]*=p[2];
+}
+
+Int_t RooBWRunPdf::batchSnapshot(Double_t* p) const {
+   p[0]=mean; p[1]=width;
+   return 2;
+}
+
+void RooBWRunPdf::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   Double_t mean_tmp=p[0], width_tmp=p[1];
+   for(Int_t i=0; i<n; i++){
+     Double_t x2=xs[i]*xs[i];
+     out[i]=(x2*width_tmp/mean_tmp) / ( (x2-mean_tmp*mean_tmp)*(x2-mean_tmp*mean_tmp) + (x2*width_tmp/mean_tmp)*(x2*width_tmp/mean_tmp) );
+   }
+}
+
+Int_t RooErfPowPdf::batchSnapshot(Double_t* p) const {
+   p[0]=c; p[1]=offset; p[2]=width;
+   return 3;
+}
+
+void RooErfPowPdf::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   ErfPowBatch(xs,out,n,p[0],p[1],p[2]);
+}
+
+Int_t RooAlpha4ErfPowPdf::batchSnapshot(Double_t* p) const {
+   p[0]=c; p[1]=offset; p[2]=width; p[3]=ca; p[4]=offseta; p[5]=widtha;
+   return 6;
+}
+
+void RooAlpha4ErfPowPdf::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   std::vector<Double_t> den(n);
+   ErfPowBatch(xs,out,n,p[0],p[1],p[2]);
+   ErfPowBatch(xs,&den[0],n,p[3],p[4],p[5]);
+   for(Int_t i=0; i<n; i++) out[i]/=den[i];
+}
+
+Int_t RooErfPow2Pdf::batchSnapshot(Double_t* p) const {
+   p[0]=c0; p[1]=c1; p[2]=offset; p[3]=width;
+   return 4;
+}
+
+void RooErfPow2Pdf::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   ErfPow2Batch(xs,out,n,p[0],p[1],p[2],p[3]);
+}
+
+Int_t RooAlpha4ErfPow2Pdf::batchSnapshot(Double_t* p) const {
+   p[0]=c0; p[1]=c1; p[2]=offset; p[3]=width; p[4]=c0a; p[5]=c1a; p[6]=offseta; p[7]=widtha;
+   return 8;
+}
+
+void RooAlpha4ErfPow2Pdf::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   std::vector<Double_t> den(n);
+   ErfPow2Batch(xs,out,n,p[0],p[1],p[2],p[3]);
+   ErfPow2Batch(xs,&den[0],n,p[4],p[5],p[6],p[7]);
+   for(Int_t i=0; i<n; i++) out[i]/=den[i];
+}
+
+Int_t RooErfPow3Pdf::batchSnapshot(Double_t* p) const {
+   p[0]=c0; p[1]=c1; p[2]=c2; p[3]=offset; p[4]=width;
+   return 5;
+}
+
+void RooErfPow3Pdf::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   ErfPow3Batch(xs,out,n,p[0],p[1],p[2],p[3],p[4]);
+}
+
+Int_t RooErfPowExpPdf::batchSnapshot(Double_t* p) const {
+   p[0]=c0; p[1]=c1; p[2]=offset; p[3]=width;
+   return 4;
+}
+
+void RooErfPowExpPdf::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   ErfPowExpBatch(xs,out,n,p[0],p[1],p[2],p[3]);
+}
+
+Int_t RooAlpha4ErfPowExpPdf::batchSnapshot(Double_t* p) const {
+   p[0]=c0; p[1]=c1; p[2]=offset; p[3]=width; p[4]=c0a; p[5]=c1a; p[6]=offseta; p[7]=widtha;
+   return 8;
+}
+
+void RooAlpha4ErfPowExpPdf::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   std::vector<Double_t> den(n);
+   ErfPowExpBatch(xs,out,n,p[0],p[1],p[2],p[3]);
+   ErfPowExpBatch(xs,&den[0],n,p[4],p[5],p[6],p[7]);
+   for(Int_t i=0; i<n; i++) out[i]/=den[i];
+}
+
+Int_t RooQCDPdf::batchSnapshot(Double_t* p) const {
+   p[0]=p0; p[1]=p1; p[2]=p2;
+   return 3;
+}
+
+void RooQCDPdf::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   Double_t sqrt_s=2000.;
+   Double_t p0_tmp=p[0], p1_tmp=p[1], p2_tmp=p[2];
+   for(Int_t i=0; i<n; i++){
+     Double_t logx=TMath::Log(xs[i]/sqrt_s);
+     out[i]=TMath::Power(1-xs[i]/sqrt_s ,p0_tmp)*TMath::Exp(-1*(p1_tmp+p2_tmp*logx)*logx) ;
+   }
+}
+
+Int_t RooUser1Pdf::batchSnapshot(Double_t* p) const {
+   p[0]=p0; p[1]=p1;
+   return 2;
+}
+
+void RooUser1Pdf::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   Double_t sqrt_s=500.;
+   Double_t p0_tmp=p[0], p1_tmp=p[1];
+   for(Int_t i=0; i<n; i++) out[i]=TMath::Power(1-xs[i]/sqrt_s ,p0_tmp)/TMath::Power(xs[i]/sqrt_s, p1_tmp) ;
+}
+
+Int_t RooExpNPdf::batchSnapshot(Double_t* p) const {
+   p[0]=c; p[1]=this->n;
+   return 2;
+}
+
+void RooExpNPdf::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   ExpNBatch(xs,out,n,p[0],p[1]);
+}
+
+Int_t RooAlpha4ExpNPdf::batchSnapshot(Double_t* p) const {
+   p[0]=c0; p[1]=n0; p[2]=c1; p[3]=n1;
+   return 4;
+}
+
+void RooAlpha4ExpNPdf::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   ExpNBatch(xs,out,n,p[0]-p[2],p[1]-p[3]);
+}
+
+Int_t RooExpTailPdf::batchSnapshot(Double_t* p) const {
+   p[0]=s; p[1]=a;
+   return 2;
+}
+
+void RooExpTailPdf::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   ExpTailBatch(xs,out,n,p[0],p[1]);
+}
+
+Int_t RooAlpha4ExpTailPdf::batchSnapshot(Double_t* p) const {
+   p[0]=s0; p[1]=a0; p[2]=s1; p[3]=a1;
+   return 4;
+}
+
+void RooAlpha4ExpTailPdf::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   std::vector<Double_t> den(n);
+   ExpTailBatch(xs,out,n,p[0],p[1]);
+   ExpTailBatch(xs,&den[0],n,p[2],p[3]);
+   for(Int_t i=0; i<n; i++) out[i]/=den[i];
+}
+
+Int_t Roo2ExpPdf::batchSnapshot(Double_t* p) const {
+   p[0]=c0; p[1]=c1; p[2]=frac;
+   return 3;
+}
+
+void Roo2ExpPdf::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   TwoExpBatch(xs,out,n,p[0],p[1],p[2]);
+}
+
+Int_t RooAlpha42ExpPdf::batchSnapshot(Double_t* p) const {
+   p[0]=c00; p[1]=c01; p[2]=frac0; p[3]=c10; p[4]=c11; p[5]=frac1;
+   return 6;
+}
+
+void RooAlpha42ExpPdf::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   std::vector<Double_t> den(n);
+   TwoExpBatch(xs,out,n,p[0],p[1],p[2]);
+   TwoExpBatch(xs,&den[0],n,p[3],p[4],p[5]);
+   for(Int_t i=0; i<n; i++) out[i]/=den[i];
+}
+
+Int_t RooAnaExpNPdf::batchSnapshot(Double_t* p) const {
+   p[0]=c; p[1]=this->n;
+   return 2;
+}
+
+void RooAnaExpNPdf::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   ExpNBatch(xs,out,n,p[0],p[1]);
+}
+
+Int_t RooDoubleCrystalBall::batchSnapshot(Double_t* p) const {
+   const RooDerivedConstants& tail = tailConstants();
+   p[0]=mean; p[1]=width; p[2]=alpha1; p[3]=n1; p[4]=alpha2; p[5]=n2;
+   for(Int_t k=0; k<4; k++) p[6+k]=tail[k];
+   return 10;
+}
+
+void RooDoubleCrystalBall::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   Double_t mean_tmp=p[0], width_tmp=p[1];
+   Double_t alpha1_tmp=p[2], n1_tmp=p[3], alpha2_tmp=p[4], n2_tmp=p[5];
+   double A1 = p[6], B1 = p[7], A2 = p[8], B2 = p[9];
+   for(Int_t i=0; i<n; i++){
+     double t = (xs[i]-mean_tmp)/width_tmp;
+     if(t<-alpha1_tmp)     out[i]=A1*pow(B1-t,-n1_tmp);
+     else if(t>alpha2_tmp) out[i]=A2*pow(B2+t,-n2_tmp);
+     else                  out[i]=exp(-0.5*t*t);
+   }
+}
+
+Int_t RooAtanExpPdf::batchSnapshot(Double_t* p) const {
+   p[0]=c; p[1]=offset; p[2]=width;
+   return 3;
+}
+
+void RooAtanExpPdf::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   AtanExpBatch(xs,out,n,p[0],p[1],p[2]);
+}
+
+Int_t RooAtanAlpha::batchSnapshot(Double_t* p) const {
+   p[0]=c; p[1]=offset; p[2]=width; p[3]=ca; p[4]=offseta; p[5]=widtha;
+   return 6;
+}
+
+void RooAtanAlpha::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   std::vector<Double_t> den(n);
+   AtanExpBatch(xs,out,n,p[0],p[1],p[2]);
+   AtanExpBatch(xs,&den[0],n,p[3],p[4],p[5]);
+   for(Int_t i=0; i<n; i++) out[i]/=den[i];
+}
+
+Int_t RooAtanPow2Pdf::batchSnapshot(Double_t* p) const {
+   p[0]=c0; p[1]=c1; p[2]=offset; p[3]=width;
+   return 4;
+}
+
+void RooAtanPow2Pdf::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   AtanPow2Batch(xs,out,n,p[0],p[1],p[2],p[3]);
+}
+
+Int_t RooAtanPow3Pdf::batchSnapshot(Double_t* p) const {
+   p[0]=c0; p[1]=c1; p[2]=c2; p[3]=offset; p[4]=width;
+   return 5;
+}
+
+void RooAtanPow3Pdf::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   AtanPow3Batch(xs,out,n,p[0],p[1],p[2],p[3],p[4]);
+}
+
+Int_t RooAlpha4AtanPow2Pdf::batchSnapshot(Double_t* p) const {
+   p[0]=c0; p[1]=c1; p[2]=offset; p[3]=width; p[4]=c0a; p[5]=c1a; p[6]=offseta; p[7]=widtha;
+   return 8;
+}
+
+void RooAlpha4AtanPow2Pdf::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   std::vector<Double_t> den(n);
+   AtanPow2Batch(xs,out,n,p[0],p[1],p[2],p[3]);
+   AtanPow2Batch(xs,&den[0],n,p[4],p[5],p[6],p[7]);
+   for(Int_t i=0; i<n; i++) out[i]/=den[i];
+}
+
+Int_t RooAtanPowExpPdf::batchSnapshot(Double_t* p) const {
+   p[0]=c0; p[1]=c1; p[2]=offset; p[3]=width;
+   return 4;
+}
+
+void RooAtanPowExpPdf::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   AtanPowExpBatch(xs,out,n,p[0],p[1],p[2],p[3]);
+}
+
+Int_t RooAlpha4AtanPowExpPdf::batchSnapshot(Double_t* p) const {
+   p[0]=c0; p[1]=c1; p[2]=offset; p[3]=width; p[4]=c0a; p[5]=c1a; p[6]=offseta; p[7]=widtha;
+   return 8;
+}
+
+void RooAlpha4AtanPowExpPdf::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   std::vector<Double_t> den(n);
+   AtanPowExpBatch(xs,out,n,p[0],p[1],p[2],p[3]);
+   AtanPowExpBatch(xs,&den[0],n,p[4],p[5],p[6],p[7]);
+   for(Int_t i=0; i<n; i++) out[i]/=den[i];
+}
+
+Int_t RooAtanPowPdf::batchSnapshot(Double_t* p) const {
+   p[0]=c; p[1]=offset; p[2]=width;
+   return 3;
+}
+
+void RooAtanPowPdf::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   AtanPowBatch(xs,out,n,p[0],p[1],p[2]);
+}
+
+Int_t RooAlpha4AtanPowPdf::batchSnapshot(Double_t* p) const {
+   p[0]=c; p[1]=offset; p[2]=width; p[3]=ca; p[4]=offseta; p[5]=widtha;
+   return 6;
+}
+
+void RooAlpha4AtanPowPdf::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   std::vector<Double_t> den(n);
+   AtanPowBatch(xs,out,n,p[0],p[1],p[2]);
+   AtanPowBatch(xs,&den[0],n,p[3],p[4],p[5]);
+   for(Int_t i=0; i<n; i++) out[i]/=den[i];
+}
+
+
+//////////////////////////////////////////
+//// Log domain batch evaluation of the power laws: log(x/sqrt_s) once per event, no exp
+
+Bool_t RooPowPdf::logSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   Double_t p0_tmp=p[0];
+   LogScaledBatch(xs,out,n,2000.);
+   for(Int_t i=0; i<n; i++) out[i]*=p0_tmp;
+   return kTRUE;
+}
+
+Bool_t RooPow2Pdf::logSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   Double_t p0_tmp=p[0], p1_tmp=p[1];
+   LogScaledBatch(xs,out,n,2000.);
+   for(Int_t i=0; i<n; i++) out[i]=-1*(p0_tmp+p1_tmp*out[i])*out[i];
+   return kTRUE;
+}
+
+Bool_t RooPow3Pdf::logSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   Double_t p0_tmp=p[0], p1_tmp=p[1], p2_tmp=p[2];
+   LogScaledBatch(xs,out,n,2000.);
+   for(Int_t i=0; i<n; i++) out[i]=-1*(p0_tmp+p1_tmp*out[i]+p2_tmp*out[i]*out[i])*out[i];
+   return kTRUE;
+}
+
+Bool_t RooErfPowPdf::logSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   Double_t c_tmp=p[0];
+   LogScaledBatch(xs,out,n,2000.);
+   for(Int_t i=0; i<n; i++) out[i]*=c_tmp;
+   AddLogErfTurnOnBatch(xs,out,n,p[1],p[2]);
+   return kTRUE;
+}
+
+Bool_t RooErfPow2Pdf::logSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   Double_t c0_tmp=p[0], c1_tmp=p[1];
+   LogScaledBatch(xs,out,n,2000.);
+   for(Int_t i=0; i<n; i++) out[i]=-1*(c0_tmp+c1_tmp*out[i])*out[i];
+   AddLogErfTurnOnBatch(xs,out,n,p[2],p[3]);
+   return kTRUE;
+}
+
+/// same exponent as ErfPow3: -(c0+c1*L+c2*L)*L*L
+Bool_t RooErfPow3Pdf::logSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   Double_t c0_tmp=p[0], c1_tmp=p[1], c2_tmp=p[2];
+   LogScaledBatch(xs,out,n,2000.);
+   for(Int_t i=0; i<n; i++) out[i]=-1*(c0_tmp+c1_tmp*out[i]+c2_tmp*out[i])*out[i]*out[i];
+   AddLogErfTurnOnBatch(xs,out,n,p[3],p[4]);
+   return kTRUE;
+}
+
+Bool_t RooErfPowExpPdf::logSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   Double_t sqrt_s=2000.;
+   Double_t c0_tmp=p[0], c1_tmp=p[1];
+   LogScaledBatch(xs,out,n,sqrt_s);
+   for(Int_t i=0; i<n; i++) out[i]=-1*c1_tmp*out[i]*out[i]-xs[i]/sqrt_s*c0_tmp;
+   AddLogErfTurnOnBatch(xs,out,n,p[2],p[3]);
+   return kTRUE;
+}
+
+Bool_t RooAtanPowPdf::logSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   Double_t c_tmp=p[0];
+   LogScaledBatch(xs,out,n,2000.);
+   for(Int_t i=0; i<n; i++) out[i]*=c_tmp;
+   AddLogAtanTurnOnBatch(xs,out,n,p[1],p[2]);
+   return kTRUE;
+}
+
+Bool_t RooAtanPow2Pdf::logSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   Double_t c0_tmp=p[0], c1_tmp=p[1];
+   LogScaledBatch(xs,out,n,2000.);
+   for(Int_t i=0; i<n; i++) out[i]=-1*(c0_tmp+c1_tmp*out[i])*out[i];
+   AddLogAtanTurnOnBatch(xs,out,n,p[2],p[3]);
+   return kTRUE;
+}
+
+/// same exponent as AtanPow3: -(c0+c1*L+c2*L)*L*L
+Bool_t RooAtanPow3Pdf::logSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   Double_t c0_tmp=p[0], c1_tmp=p[1], c2_tmp=p[2];
+   LogScaledBatch(xs,out,n,2000.);
+   for(Int_t i=0; i<n; i++) out[i]=-1*(c0_tmp+c1_tmp*out[i]+c2_tmp*out[i])*out[i]*out[i];
+   AddLogAtanTurnOnBatch(xs,out,n,p[3],p[4]);
+   return kTRUE;
+}
+
+Bool_t RooAtanPowExpPdf::logSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   Double_t sqrt_s=2000.;
+   Double_t c0_tmp=p[0], c1_tmp=p[1];
+   LogScaledBatch(xs,out,n,sqrt_s);
+   for(Int_t i=0; i<n; i++) out[i]=-1*c1_tmp*out[i]*out[i]-xs[i]/sqrt_s*c0_tmp;
+   AddLogAtanTurnOnBatch(xs,out,n,p[2],p[3]);
+   return kTRUE;
+}
+
+Bool_t RooQCDPdf::logSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   Double_t sqrt_s=2000.;
+   Double_t p0_tmp=p[0], p1_tmp=p[1], p2_tmp=p[2];
+   std::vector<Double_t> logOneMinus(n);
+   for(Int_t i=0; i<n; i++) logOneMinus[i]=1-xs[i]/sqrt_s;
+   VecLog(&logOneMinus[0],&logOneMinus[0],n);
+   LogScaledBatch(xs,out,n,sqrt_s);
+   for(Int_t i=0; i<n; i++) out[i]=p0_tmp*logOneMinus[i]-(p1_tmp+p2_tmp*out[i])*out[i];
+   return kTRUE;
+}
+
+//////////////////////////////////////////
+//// Integrals: closed form where one exists, otherwise Gauss-Legendre quadrature on the batch shape
+//// (ErfPow*, Atan*, RooAlpha, Alpha4*, ExpTail, Alpha42Exp; see batchIntegral in the header for the accuracy)
+
+/// positive half of the 16 point Gauss-Legendre rule on [-1,1]
+static const Double_t gaussLegendreNodes[8]   = {0.095012509837637441, 0.28160355077925892, 0.45801677765722737, 0.61787624440264377,
+                                                 0.755404408355003,    0.86563120238783176, 0.9445750230732326,  0.98940093499164994};
+static const Double_t gaussLegendreWeights[8] = {0.18945061045506847, 0.18260341504492361, 0.16915651939500256, 0.14959598881657682,
+                                                 0.12462897125553395, 0.095158511682492897, 0.062253523938647776, 0.027152459411754058};
+
+void RooBatchPdf::quadratureNodes(Double_t x_min, Double_t x_max, std::vector<Double_t>& nodes, std::vector<Double_t>& weights) const {
+   nodes.clear();
+   weights.clear();
+   if(x_max<=x_min) return;
+   const Double_t turnOnRange=8.;
+   Double_t offsets[2], widths[2];
+   Int_t nTurnOn=turnOns(offsets,widths);
+   for(Int_t k=0; k<nTurnOn; k++) widths[k]=TMath::Max(widths[k],1e-2);
+   Double_t step=(x_max-x_min)/16;
+
+   std::vector<Double_t> breaks;
+   breaks.push_back(x_min);
+   breaks.push_back(x_max);
+   for(Int_t k=0; k<nTurnOn; k++){
+     for(Int_t side=-1; side<=1; side+=2){
+       Double_t edge=offsets[k]+side*turnOnRange*widths[k];
+       if(edge>x_min && edge<x_max) breaks.push_back(edge);
+     }
+   }
+   std::sort(breaks.begin(),breaks.end());
+
+   for(UInt_t b=0; b+1<breaks.size(); b++){
+     Double_t lo=breaks[b], hi=breaks[b+1];
+     if(hi<=lo) continue;
+     Double_t h=step;
+     for(Int_t k=0; k<nTurnOn; k++){
+       if(TMath::Abs((lo+hi)/2-offsets[k])<turnOnRange*widths[k]) h=TMath::Min(h,widths[k]);
+     }
+     Int_t npanel=Int_t(TMath::Ceil((hi-lo)/h-1e-9));
+     Double_t half=(hi-lo)/npanel/2;
+     for(Int_t p=0; p<npanel; p++){
+       Double_t center=lo+(2*p+1)*half;
+       for(Int_t j=0; j<8; j++){
+         nodes.push_back(center-half*gaussLegendreNodes[j]); weights.push_back(half*gaussLegendreWeights[j]);
+         nodes.push_back(center+half*gaussLegendreNodes[j]); weights.push_back(half*gaussLegendreWeights[j]);
+       }
+     }
+   }
+}
+
+Double_t RooBatchPdf::batchIntegral(Double_t x_min, Double_t x_max) const {
+   std::vector<Double_t> nodes, weights;
+   quadratureNodes(x_min,x_max,nodes,weights);
+   if(nodes.empty()) return 0;
+   std::vector<Double_t> values(nodes.size());
+   evaluateBatch(&nodes[0],&values[0],nodes.size());
+   Double_t sum=0;
+   for(UInt_t i=0; i<nodes.size(); i++) sum+=weights[i]*values[i];
+   return sum;
+}
+
+void RooBatchPdf::gradientIntegral(Double_t x_min, Double_t x_max, Double_t* grad) const {
+   Int_t npar=gradientParams().getSize();
+   for(Int_t k=0; k<npar; k++) grad[k]=0;
+   std::vector<Double_t> nodes, weights;
+   quadratureNodes(x_min,x_max,nodes,weights);
+   Int_t n=nodes.size();
+   if(npar==0 || n==0) return;
+   std::vector<Double_t> values(n), derivatives(npar*n);
+   std::vector<Double_t*> gradPtr(npar);
+   for(Int_t k=0; k<npar; k++) gradPtr[k]=&derivatives[k*n];
+   gradientBatch(&nodes[0],&values[0],&gradPtr[0],n);
+   for(Int_t k=0; k<npar; k++){
+     for(Int_t i=0; i<n; i++) grad[k]+=weights[i]*gradPtr[k][i];
+   }
+}
+
+Int_t RooAlpha::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const {
+   if (matchArgs(allVars,analVars,x)) return 1 ;
+   return 0 ;
+}
+
+Double_t RooAlpha::analyticalIntegral(Int_t code, const char* rangeName) const {
+   if (code==1) return batchIntegral(x.min(rangeName),x.max(rangeName)) ;
+   return 0 ;
+}
+
+Int_t RooAlphaExp::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const {
+   if (matchArgs(allVars,analVars,x)) return 1 ;
+   return 0 ;
+}
+
+/// exp((c-ca)*(x-xmin)) times the cached normalisation ratio
+Double_t RooAlphaExp::analyticalIntegral(Int_t code, const char* rangeName) const {
+   if (code==1) {
+     Double_t integral=0;
+     closedIntegral(x.min(rangeName),x.max(rangeName),integral);
+     return integral ;
+   }
+   return 0 ;
+}
+
+Bool_t RooAlphaExp::closedIntegral(Double_t x_min, Double_t x_max, Double_t& value) const {
+   Double_t c_tmp=c, ca_tmp=ca;
+   Double_t delta=c_tmp-ca_tmp;
+   Double_t integral= delta==0 ? x_max-x_min : ( TMath::Exp(delta*(x_max-xmin))-TMath::Exp(delta*(x_min-xmin)) )/delta;
+   value=integral*normRatio(c_tmp,ca_tmp);
+   return kTRUE ;
+}
+
+Int_t RooErfPowPdf::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const {
+   if (matchArgs(allVars,analVars,x)) return 1 ;
+   return 0 ;
+}
+
+Double_t RooErfPowPdf::analyticalIntegral(Int_t code, const char* rangeName) const {
+   if (code==1) return batchIntegral(x.min(rangeName),x.max(rangeName)) ;
+   return 0 ;
+}
+
+Int_t RooAlpha4ErfPowPdf::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const {
+   if (matchArgs(allVars,analVars,x)) return 1 ;
+   return 0 ;
+}
+
+Double_t RooAlpha4ErfPowPdf::analyticalIntegral(Int_t code, const char* rangeName) const {
+   if (code==1) return batchIntegral(x.min(rangeName),x.max(rangeName)) ;
+   return 0 ;
+}
+
+Int_t RooErfPow2Pdf::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const {
+   if (matchArgs(allVars,analVars,x)) return 1 ;
+   return 0 ;
+}
+
+Double_t RooErfPow2Pdf::analyticalIntegral(Int_t code, const char* rangeName) const {
+   if (code==1) return batchIntegral(x.min(rangeName),x.max(rangeName)) ;
+   return 0 ;
+}
+
+Int_t RooAlpha4ErfPow2Pdf::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const {
+   if (matchArgs(allVars,analVars,x)) return 1 ;
+   return 0 ;
+}
+
+Double_t RooAlpha4ErfPow2Pdf::analyticalIntegral(Int_t code, const char* rangeName) const {
+   if (code==1) return batchIntegral(x.min(rangeName),x.max(rangeName)) ;
+   return 0 ;
+}
+
+Int_t RooErfPow3Pdf::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const {
+   if (matchArgs(allVars,analVars,x)) return 1 ;
+   return 0 ;
+}
+
+Double_t RooErfPow3Pdf::analyticalIntegral(Int_t code, const char* rangeName) const {
+   if (code==1) return batchIntegral(x.min(rangeName),x.max(rangeName)) ;
+   return 0 ;
+}
+
+Int_t RooErfPowExpPdf::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const {
+   if (matchArgs(allVars,analVars,x)) return 1 ;
+   return 0 ;
+}
+
+Double_t RooErfPowExpPdf::analyticalIntegral(Int_t code, const char* rangeName) const {
+   if (code==1) return batchIntegral(x.min(rangeName),x.max(rangeName)) ;
+   return 0 ;
+}
+
+Int_t RooAlpha4ErfPowExpPdf::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const {
+   if (matchArgs(allVars,analVars,x)) return 1 ;
+   return 0 ;
+}
+
+Double_t RooAlpha4ErfPowExpPdf::analyticalIntegral(Int_t code, const char* rangeName) const {
+   if (code==1) return batchIntegral(x.min(rangeName),x.max(rangeName)) ;
+   return 0 ;
+}
+
+Int_t RooAlpha4ExpNPdf::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const {
+   if (matchArgs(allVars,analVars,x)) return 1 ;
+   return 0 ;
+}
+
+/// batchIntegral: the shape is ExpN = exp(c*x+n/x), which has no elementary primitive. integral_ExpN (RooAnaExpNPdf)
+/// is the incomplete gamma primitive of exp(c*x^n), a different function, so it cannot be reused here
+Double_t RooAlpha4ExpNPdf::analyticalIntegral(Int_t code, const char* rangeName) const {
+   if (code==1) return batchIntegral(x.min(rangeName),x.max(rangeName)) ;
+   return 0 ;
+}
+
+Int_t RooExpTailPdf::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const {
+   if (matchArgs(allVars,analVars,x)) return 1 ;
+   return 0 ;
+}
+
+Double_t RooExpTailPdf::analyticalIntegral(Int_t code, const char* rangeName) const {
+   if (code==1) return batchIntegral(x.min(rangeName),x.max(rangeName)) ;
+   return 0 ;
+}
+
+Int_t RooAlpha4ExpTailPdf::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const {
+   if (matchArgs(allVars,analVars,x)) return 1 ;
+   return 0 ;
+}
+
+Double_t RooAlpha4ExpTailPdf::analyticalIntegral(Int_t code, const char* rangeName) const {
+   if (code==1) return batchIntegral(x.min(rangeName),x.max(rangeName)) ;
+   return 0 ;
+}
+
+Int_t Roo2ExpPdf::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const {
+   if (matchArgs(allVars,analVars,x)) return 1 ;
+   return 0 ;
+}
+
+/// Exp(c0*x)+frac*Exp(c1*x)
+Double_t Roo2ExpPdf::analyticalIntegral(Int_t code, const char* rangeName) const {
+   if (code==1) {
+     Double_t integral=0;
+     closedIntegral(x.min(rangeName),x.max(rangeName),integral);
+     return integral ;
+   }
+   return 0 ;
+}
+
+Bool_t Roo2ExpPdf::closedIntegral(Double_t x_min, Double_t x_max, Double_t& value) const {
+   Double_t frac_tmp=frac;
+   if(frac_tmp<0){frac_tmp=0.;}
+   if(frac_tmp>1){frac_tmp=1.;}
+   Double_t c_tmp[2]={c0,c1};
+   Double_t integral[2];
+   for(Int_t k=0; k<2; k++){
+     if(c_tmp[k]==0) integral[k]=x_max-x_min;
+     else integral[k]=( TMath::Exp(c_tmp[k]*x_max)-TMath::Exp(c_tmp[k]*x_min) )/c_tmp[k];
+   }
+   value=integral[0]+frac_tmp*integral[1];
+   return kTRUE ;
+}
+
+Int_t RooAlpha42ExpPdf::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const {
+   if (matchArgs(allVars,analVars,x)) return 1 ;
+   return 0 ;
+}
+
+Double_t RooAlpha42ExpPdf::analyticalIntegral(Int_t code, const char* rangeName) const {
+   if (code==1) return batchIntegral(x.min(rangeName),x.max(rangeName)) ;
+   return 0 ;
+}
+
+Int_t RooAtanExpPdf::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const {
+   if (matchArgs(allVars,analVars,x)) return 1 ;
+   return 0 ;
+}
+
+Double_t RooAtanExpPdf::analyticalIntegral(Int_t code, const char* rangeName) const {
+   if (code==1) return batchIntegral(x.min(rangeName),x.max(rangeName)) ;
+   return 0 ;
+}
+
+Int_t RooAtanAlpha::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const {
+   if (matchArgs(allVars,analVars,x)) return 1 ;
+   return 0 ;
+}
+
+Double_t RooAtanAlpha::analyticalIntegral(Int_t code, const char* rangeName) const {
+   if (code==1) return batchIntegral(x.min(rangeName),x.max(rangeName)) ;
+   return 0 ;
+}
+
+Int_t RooAtanPow2Pdf::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const {
+   if (matchArgs(allVars,analVars,x)) return 1 ;
+   return 0 ;
+}
+
+Double_t RooAtanPow2Pdf::analyticalIntegral(Int_t code, const char* rangeName) const {
+   if (code==1) return batchIntegral(x.min(rangeName),x.max(rangeName)) ;
+   return 0 ;
+}
+
+Int_t RooAtanPow3Pdf::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const {
+   if (matchArgs(allVars,analVars,x)) return 1 ;
+   return 0 ;
+}
+
+Double_t RooAtanPow3Pdf::analyticalIntegral(Int_t code, const char* rangeName) const {
+   if (code==1) return batchIntegral(x.min(rangeName),x.max(rangeName)) ;
+   return 0 ;
+}
+
+Int_t RooAlpha4AtanPow2Pdf::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const {
+   if (matchArgs(allVars,analVars,x)) return 1 ;
+   return 0 ;
+}
+
+Double_t RooAlpha4AtanPow2Pdf::analyticalIntegral(Int_t code, const char* rangeName) const {
+   if (code==1) return batchIntegral(x.min(rangeName),x.max(rangeName)) ;
+   return 0 ;
+}
+
+Int_t RooAtanPowExpPdf::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const {
+   if (matchArgs(allVars,analVars,x)) return 1 ;
+   return 0 ;
+}
+
+Double_t RooAtanPowExpPdf::analyticalIntegral(Int_t code, const char* rangeName) const {
+   if (code==1) return batchIntegral(x.min(rangeName),x.max(rangeName)) ;
+   return 0 ;
+}
+
+Int_t RooAlpha4AtanPowExpPdf::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const {
+   if (matchArgs(allVars,analVars,x)) return 1 ;
+   return 0 ;
+}
+
+Double_t RooAlpha4AtanPowExpPdf::analyticalIntegral(Int_t code, const char* rangeName) const {
+   if (code==1) return batchIntegral(x.min(rangeName),x.max(rangeName)) ;
+   return 0 ;
+}
+
+Int_t RooAtanPowPdf::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const {
+   if (matchArgs(allVars,analVars,x)) return 1 ;
+   return 0 ;
+}
+
+Double_t RooAtanPowPdf::analyticalIntegral(Int_t code, const char* rangeName) const {
+   if (code==1) return batchIntegral(x.min(rangeName),x.max(rangeName)) ;
+   return 0 ;
+}
+
+Int_t RooAlpha4AtanPowPdf::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const {
+   if (matchArgs(allVars,analVars,x)) return 1 ;
+   return 0 ;
+}
+
+Double_t RooAlpha4AtanPowPdf::analyticalIntegral(Int_t code, const char* rangeName) const {
+   if (code==1) return batchIntegral(x.min(rangeName),x.max(rangeName)) ;
+   return 0 ;
+}
+
+
+Int_t RooErfExpPdf::turnOns(Double_t* offsets, Double_t* widths) const {
+   offsets[0]=offset; widths[0]=width;
+   return 1 ;
+}
+
+Int_t RooAlpha::turnOns(Double_t* offsets, Double_t* widths) const {
+   offsets[0]=offset;  widths[0]=width;
+   offsets[1]=offseta; widths[1]=widtha;
+   return 2 ;
+}
+
+Int_t RooErfPowPdf::turnOns(Double_t* offsets, Double_t* widths) const {
+   offsets[0]=offset; widths[0]=width;
+   return 1 ;
+}
+
+Int_t RooAlpha4ErfPowPdf::turnOns(Double_t* offsets, Double_t* widths) const {
+   offsets[0]=offset;  widths[0]=width;
+   offsets[1]=offseta; widths[1]=widtha;
+   return 2 ;
+}
+
+Int_t RooErfPow2Pdf::turnOns(Double_t* offsets, Double_t* widths) const {
+   offsets[0]=offset; widths[0]=width;
+   return 1 ;
+}
+
+Int_t RooAlpha4ErfPow2Pdf::turnOns(Double_t* offsets, Double_t* widths) const {
+   offsets[0]=offset;  widths[0]=width;
+   offsets[1]=offseta; widths[1]=widtha;
+   return 2 ;
+}
+
+Int_t RooErfPow3Pdf::turnOns(Double_t* offsets, Double_t* widths) const {
+   offsets[0]=offset; widths[0]=width;
+   return 1 ;
+}
+
+Int_t RooErfPowExpPdf::turnOns(Double_t* offsets, Double_t* widths) const {
+   offsets[0]=offset; widths[0]=width;
+   return 1 ;
+}
+
+Int_t RooAlpha4ErfPowExpPdf::turnOns(Double_t* offsets, Double_t* widths) const {
+   offsets[0]=offset;  widths[0]=width;
+   offsets[1]=offseta; widths[1]=widtha;
+   return 2 ;
+}
+
+Int_t RooAtanExpPdf::turnOns(Double_t* offsets, Double_t* widths) const {
+   offsets[0]=offset; widths[0]=width;
+   return 1 ;
+}
+
+Int_t RooAtanAlpha::turnOns(Double_t* offsets, Double_t* widths) const {
+   offsets[0]=offset;  widths[0]=width;
+   offsets[1]=offseta; widths[1]=widtha;
+   return 2 ;
+}
+
+Int_t RooAtanPow2Pdf::turnOns(Double_t* offsets, Double_t* widths) const {
+   offsets[0]=offset; widths[0]=width;
+   return 1 ;
+}
+
+Int_t RooAtanPow3Pdf::turnOns(Double_t* offsets, Double_t* widths) const {
+   offsets[0]=offset; widths[0]=width;
+   return 1 ;
+}
+
+Int_t RooAlpha4AtanPow2Pdf::turnOns(Double_t* offsets, Double_t* widths) const {
+   offsets[0]=offset;  widths[0]=width;
+   offsets[1]=offseta; widths[1]=widtha;
+   return 2 ;
+}
+
+Int_t RooAtanPowExpPdf::turnOns(Double_t* offsets, Double_t* widths) const {
+   offsets[0]=offset; widths[0]=width;
+   return 1 ;
+}
+
+Int_t RooAlpha4AtanPowExpPdf::turnOns(Double_t* offsets, Double_t* widths) const {
+   offsets[0]=offset;  widths[0]=width;
+   offsets[1]=offseta; widths[1]=widtha;
+   return 2 ;
+}
+
+Int_t RooAtanPowPdf::turnOns(Double_t* offsets, Double_t* widths) const {
+   offsets[0]=offset; widths[0]=width;
+   return 1 ;
+}
+
+Int_t RooAlpha4AtanPowPdf::turnOns(Double_t* offsets, Double_t* widths) const {
+   offsets[0]=offset;  widths[0]=width;
+   offsets[1]=offseta; widths[1]=widtha;
+   return 2 ;
+}
+
+
+//////////////////////////////////////////
+//// Analytic gradients: d shape / d parameter for the single shapes, the alpha ratios are left to RooBatchNLL
+
+RooArgList RooPowPdf::gradientParams() const { return RooArgList(p0.arg()) ; }
+
+void RooPowPdf::gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const {
+   if(n<=0) return;
+   std::vector<Double_t> logx(n);
+   LogScaledBatch(xs,&logx[0],n,2000.);
+   Double_t p0_tmp=p0;
+   for(Int_t i=0; i<n; i++) out[i]=p0_tmp*logx[i];
+   VecExp(out,out,n);
+   for(Int_t i=0; i<n; i++) grad[0][i]=out[i]*logx[i];
+}
+
+RooArgList RooPow2Pdf::gradientParams() const { return RooArgList(p0.arg(),p1.arg()) ; }
+
+void RooPow2Pdf::gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const {
+   if(n<=0) return;
+   std::vector<Double_t> logx(n);
+   LogScaledBatch(xs,&logx[0],n,2000.);
+   Double_t p0_tmp=p0, p1_tmp=p1;
+   for(Int_t i=0; i<n; i++) out[i]=-1*(p0_tmp+p1_tmp*logx[i])*logx[i];
+   VecExp(out,out,n);
+   for(Int_t i=0; i<n; i++){
+     grad[0][i]=-out[i]*logx[i];
+     grad[1][i]=-out[i]*logx[i]*logx[i];
+   }
+}
+
+RooArgList RooPow3Pdf::gradientParams() const { return RooArgList(p0.arg(),p1.arg(),p2.arg()) ; }
+
+void RooPow3Pdf::gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const {
+   if(n<=0) return;
+   std::vector<Double_t> logx(n);
+   LogScaledBatch(xs,&logx[0],n,2000.);
+   Double_t p0_tmp=p0, p1_tmp=p1, p2_tmp=p2;
+   for(Int_t i=0; i<n; i++) out[i]=-1*(p0_tmp+p1_tmp*logx[i]+p2_tmp*logx[i]*logx[i])*logx[i];
+   VecExp(out,out,n);
+   for(Int_t i=0; i<n; i++){
+     grad[0][i]=-out[i]*logx[i];
+     grad[1][i]=-out[i]*logx[i]*logx[i];
+     grad[2][i]=-out[i]*logx[i]*logx[i]*logx[i];
+   }
+}
+
+RooArgList RooErfExpPdf::gradientParams() const { return RooArgList(c.arg(),offset.arg(),width.arg()) ; }
+
+void RooErfExpPdf::gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const {
+   if(n<=0) return;
+   Double_t c_tmp=c;
+   if(c_tmp==0) c_tmp=-1e-7;
+   for(Int_t i=0; i<n; i++) out[i]=c_tmp*xs[i];
+   TurnOnExpGradientBatch(xs,out,grad[1],grad[2],n,offset,width,kFALSE);
+   for(Int_t i=0; i<n; i++) grad[0][i]=out[i]*xs[i];
+}
+
+RooArgList RooErfPowPdf::gradientParams() const { return RooArgList(c.arg(),offset.arg(),width.arg()) ; }
+
+void RooErfPowPdf::gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const {
+   if(n<=0) return;
+   Double_t sqrt_s=2000.;
+   std::vector<Double_t> logx(n);
+   LogScaledBatch(xs,&logx[0],n,sqrt_s);
+   Double_t c_tmp=c;
+   for(Int_t i=0; i<n; i++) out[i]=c_tmp*logx[i];
+   TurnOnExpGradientBatch(xs,out,grad[1],grad[2],n,offset,width,kFALSE);
+   for(Int_t i=0; i<n; i++) grad[0][i]=out[i]*logx[i];
+}
+
+RooArgList RooErfPow2Pdf::gradientParams() const { return RooArgList(c0.arg(),c1.arg(),offset.arg(),width.arg()) ; }
+
+void RooErfPow2Pdf::gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const {
+   if(n<=0) return;
+   Double_t sqrt_s=2000.;
+   std::vector<Double_t> logx(n);
+   LogScaledBatch(xs,&logx[0],n,sqrt_s);
+   Double_t c0_tmp=c0, c1_tmp=c1;
+   for(Int_t i=0; i<n; i++) out[i]=-1*(c0_tmp+c1_tmp*logx[i])*logx[i];
+   TurnOnExpGradientBatch(xs,out,grad[2],grad[3],n,offset,width,kFALSE);
+   for(Int_t i=0; i<n; i++){
+     grad[0][i]=-out[i]*logx[i];
+     grad[1][i]=-out[i]*logx[i]*logx[i];
+   }
+}
+
+RooArgList RooErfPow3Pdf::gradientParams() const { return RooArgList(c0.arg(),c1.arg(),c2.arg(),offset.arg(),width.arg()) ; }
+
+void RooErfPow3Pdf::gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const {
+   if(n<=0) return;
+   Double_t sqrt_s=2000.;
+   std::vector<Double_t> logx(n);
+   LogScaledBatch(xs,&logx[0],n,sqrt_s);
+   Double_t c0_tmp=c0, c1_tmp=c1, c2_tmp=c2;
+   for(Int_t i=0; i<n; i++) out[i]=-1*(c0_tmp+c1_tmp*logx[i]+c2_tmp*logx[i])*logx[i]*logx[i];
+   TurnOnExpGradientBatch(xs,out,grad[3],grad[4],n,offset,width,kFALSE);
+   for(Int_t i=0; i<n; i++){
+     grad[0][i]=-out[i]*logx[i]*logx[i];
+     grad[1][i]=-out[i]*logx[i]*logx[i]*logx[i];
+     grad[2][i]=-out[i]*logx[i]*logx[i]*logx[i];
+   }
+}
+
+RooArgList RooErfPowExpPdf::gradientParams() const { return RooArgList(c0.arg(),c1.arg(),offset.arg(),width.arg()) ; }
+
+void RooErfPowExpPdf::gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const {
+   if(n<=0) return;
+   Double_t sqrt_s=2000.;
+   std::vector<Double_t> logx(n);
+   LogScaledBatch(xs,&logx[0],n,sqrt_s);
+   Double_t c0_tmp=c0, c1_tmp=c1;
+   for(Int_t i=0; i<n; i++) out[i]=-1*c1_tmp*logx[i]*logx[i]-xs[i]/sqrt_s*c0_tmp;
+   TurnOnExpGradientBatch(xs,out,grad[2],grad[3],n,offset,width,kFALSE);
+   for(Int_t i=0; i<n; i++){
+     grad[0][i]=-out[i]*xs[i]/sqrt_s;
+     grad[1][i]=-out[i]*logx[i]*logx[i];
+   }
+}
+
+RooArgList RooAtanExpPdf::gradientParams() const { return RooArgList(c.arg(),offset.arg(),width.arg()) ; }
+
+void RooAtanExpPdf::gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const {
+   if(n<=0) return;
+   Double_t c_tmp=c;
+   if(c_tmp==0) c_tmp=-1e-7;
+   for(Int_t i=0; i<n; i++) out[i]=c_tmp*xs[i];
+   TurnOnExpGradientBatch(xs,out,grad[1],grad[2],n,offset,width,kTRUE);
+   for(Int_t i=0; i<n; i++) grad[0][i]=out[i]*xs[i];
+}
+
+RooArgList RooAtanPowPdf::gradientParams() const { return RooArgList(c.arg(),offset.arg(),width.arg()) ; }
+
+void RooAtanPowPdf::gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const {
+   if(n<=0) return;
+   Double_t sqrt_s=2000.;
+   std::vector<Double_t> logx(n);
+   LogScaledBatch(xs,&logx[0],n,sqrt_s);
+   Double_t c_tmp=c;
+   for(Int_t i=0; i<n; i++) out[i]=c_tmp*logx[i];
+   TurnOnExpGradientBatch(xs,out,grad[1],grad[2],n,offset,width,kTRUE);
+   for(Int_t i=0; i<n; i++) grad[0][i]=out[i]*logx[i];
+}
+
+RooArgList RooAtanPow2Pdf::gradientParams() const { return RooArgList(c0.arg(),c1.arg(),offset.arg(),width.arg()) ; }
+
+void RooAtanPow2Pdf::gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const {
+   if(n<=0) return;
+   Double_t sqrt_s=2000.;
+   std::vector<Double_t> logx(n);
+   LogScaledBatch(xs,&logx[0],n,sqrt_s);
+   Double_t c0_tmp=c0, c1_tmp=c1;
+   for(Int_t i=0; i<n; i++) out[i]=-1*(c0_tmp+c1_tmp*logx[i])*logx[i];
+   TurnOnExpGradientBatch(xs,out,grad[2],grad[3],n,offset,width,kTRUE);
+   for(Int_t i=0; i<n; i++){
+     grad[0][i]=-out[i]*logx[i];
+     grad[1][i]=-out[i]*logx[i]*logx[i];
+   }
+}
+
+RooArgList RooAtanPow3Pdf::gradientParams() const { return RooArgList(c0.arg(),c1.arg(),c2.arg(),offset.arg(),width.arg()) ; }
+
+void RooAtanPow3Pdf::gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const {
+   if(n<=0) return;
+   Double_t sqrt_s=2000.;
+   std::vector<Double_t> logx(n);
+   LogScaledBatch(xs,&logx[0],n,sqrt_s);
+   Double_t c0_tmp=c0, c1_tmp=c1, c2_tmp=c2;
+   for(Int_t i=0; i<n; i++) out[i]=-1*(c0_tmp+c1_tmp*logx[i]+c2_tmp*logx[i])*logx[i]*logx[i];
+   TurnOnExpGradientBatch(xs,out,grad[3],grad[4],n,offset,width,kTRUE);
+   for(Int_t i=0; i<n; i++){
+     grad[0][i]=-out[i]*logx[i]*logx[i];
+     grad[1][i]=-out[i]*logx[i]*logx[i]*logx[i];
+     grad[2][i]=-out[i]*logx[i]*logx[i]*logx[i];
+   }
+}
+
+RooArgList RooAtanPowExpPdf::gradientParams() const { return RooArgList(c0.arg(),c1.arg(),offset.arg(),width.arg()) ; }
+
+void RooAtanPowExpPdf::gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const {
+   if(n<=0) return;
+   Double_t sqrt_s=2000.;
+   std::vector<Double_t> logx(n);
+   LogScaledBatch(xs,&logx[0],n,sqrt_s);
+   Double_t c0_tmp=c0, c1_tmp=c1;
+   for(Int_t i=0; i<n; i++) out[i]=-1*c1_tmp*logx[i]*logx[i]-xs[i]/sqrt_s*c0_tmp;
+   TurnOnExpGradientBatch(xs,out,grad[2],grad[3],n,offset,width,kTRUE);
+   for(Int_t i=0; i<n; i++){
+     grad[0][i]=-out[i]*xs[i]/sqrt_s;
+     grad[1][i]=-out[i]*logx[i]*logx[i];
+   }
+}
+
+RooArgList RooExpNPdf::gradientParams() const { return RooArgList(c.arg(),this->n.arg()) ; }
+
+void RooExpNPdf::gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const {
+   Double_t c_tmp=c, n_tmp=this->n;
+   for(Int_t i=0; i<n; i++) out[i]=c_tmp*xs[i]+n_tmp/xs[i];
+   VecExp(out,out,n);
+   for(Int_t i=0; i<n; i++){
+     grad[0][i]=out[i]*xs[i];
+     grad[1][i]=out[i]/xs[i];
+   }
+}
+
+RooArgList RooAnaExpNPdf::gradientParams() const { return RooArgList(c.arg(),this->n.arg()) ; }
+
+void RooAnaExpNPdf::gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const {
+   Double_t c_tmp=c, n_tmp=this->n;
+   for(Int_t i=0; i<n; i++) out[i]=c_tmp*xs[i]+n_tmp/xs[i];
+   VecExp(out,out,n);
+   for(Int_t i=0; i<n; i++){
+     grad[0][i]=out[i]*xs[i];
+     grad[1][i]=out[i]/xs[i];
+   }
+}
+
+RooArgList RooExpTailPdf::gradientParams() const { return RooArgList(s.arg(),a.arg()) ; }
+
+void RooExpTailPdf::gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const {
+   if(n<=0) return;
+   Double_t s_tmp=s, a_tmp=a;
+   std::vector<Double_t> dexponent(n);
+   for(Int_t i=0; i<n; i++){
+     Double_t denominator=s_tmp+a_tmp*xs[i];
+     out[i]=-xs[i]/denominator;
+     dexponent[i]=xs[i]/(denominator*denominator);
+   }
+   VecExp(out,out,n);
+   for(Int_t i=0; i<n; i++){
+     grad[0][i]=out[i]*dexponent[i];
+     grad[1][i]=out[i]*dexponent[i]*xs[i];
+   }
+}
+
+RooArgList Roo2ExpPdf::gradientParams() const { return RooArgList(c0.arg(),c1.arg(),frac.arg()) ; }
+
+void Roo2ExpPdf::gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const {
+   if(n<=0) return;
+   Double_t c0_tmp=c0, c1_tmp=c1, frac_tmp=frac;
+   Bool_t clamped = frac_tmp<0 || frac_tmp>1;
+   if(frac_tmp<0){frac_tmp=0.;}
+   if(frac_tmp>1){frac_tmp=1.;}
+   std::vector<Double_t> second(n);
+   for(Int_t i=0; i<n; i++){ out[i]=xs[i]*c0_tmp; second[i]=xs[i]*c1_tmp; }
+   VecExp(out,out,n);
+   VecExp(&second[0],&second[0],n);
+   for(Int_t i=0; i<n; i++){
+     grad[0][i]=xs[i]*out[i];
+     grad[1][i]=frac_tmp*xs[i]*second[i];
+     grad[2][i]= clamped ? 0. : second[i];
+     out[i]+=frac_tmp*second[i];
+   }
+}
+
+
+//////////////////////////////////////////
+//// Fused models: components with a closed-form integral, summed by FusedSum at compile time
+/// Kept away from rootcint: only the classes declared in HWWLVJRooPdfs.h need a dictionary
+#if !defined(__CINT__) && !defined(__MAKECINT__)
+
+/// Each component reads its parameters from p[0..nParams-1]
+struct GausComponent {
+   enum { nParams=2 }; // mean, sigma
+   static Double_t value(Double_t x, const Double_t* p){
+     Double_t z=(x-p[0])/p[1];
+     return TMath::Exp(-0.5*z*z);
+   }
+   static void batch(const Double_t* x, Double_t* out, Int_t n, const Double_t* p){
+     for(Int_t i=0; i<n; i++){
+       Double_t z=(x[i]-p[0])/p[1];
+       out[i]=-0.5*z*z;
+     }
+     VecExp(out,out,n);
+   }
+   static Double_t integral(Double_t x_min, Double_t x_max, const Double_t* p){
+     Double_t scale=TMath::Sqrt(2.)*p[1];
+     return TMath::Sqrt(TMath::PiOver2())*p[1]*(TMath::Erf((x_max-p[0])/scale)-TMath::Erf((x_min-p[0])/scale));
+   }
+};
+
+struct ExpComponent {
+   enum { nParams=1 }; // c
+   static Double_t value(Double_t x, const Double_t* p){ return TMath::Exp(p[0]*x); }
+   static void batch(const Double_t* x, Double_t* out, Int_t n, const Double_t* p){
+     for(Int_t i=0; i<n; i++) out[i]=p[0]*x[i];
+     VecExp(out,out,n);
+   }
+   static Double_t integral(Double_t x_min, Double_t x_max, const Double_t* p){
+     if(p[0]==0) return x_max-x_min;
+     return (TMath::Exp(p[0]*x_max)-TMath::Exp(p[0]*x_min))/p[0];
+   }
+};
+
+/// same clamping of width and c as RooErfExpPdf
+struct ErfExpComponent {
+   enum { nParams=3 }; // c, offset, width
+   static Double_t value(Double_t x, const Double_t* p){ return ErfExp(x,p[0],p[1],p[2]); }
+   static void batch(const Double_t* x, Double_t* out, Int_t n, const Double_t* p){ ErfExpBatch(x,out,n,p[0],p[1],p[2]); }
+   static Double_t integral(Double_t x_min, Double_t x_max, const Double_t* p){
+     Double_t c_tmp=p[0]; if(c_tmp==0) c_tmp=-1e-7;
+     Double_t width_tmp=p[2]; if(width_tmp<1e-2) width_tmp=1e-2;
+     return ErfExpIntegral(x_min,x_max,c_tmp,p[1],width_tmp);
+   }
+};
+
+/// frac*First/norm[0] + (1-frac)*Second/norm[1], Second reads its parameters after the ones of First
+template<class First, class Second>
+struct FusedSum {
+   enum { nParams=First::nParams+Second::nParams };
+   static void norms(Double_t x_min, Double_t x_max, const Double_t* p, Double_t* norm){
+     norm[0]=First::integral(x_min,x_max,p);
+     norm[1]=Second::integral(x_min,x_max,p+First::nParams);
+   }
+   static Double_t value(Double_t x, Double_t frac, const Double_t* p, const Double_t* norm){
+     return frac*First::value(x,p)/norm[0]+(1.-frac)*Second::value(x,p+First::nParams)/norm[1];
+   }
+   static void batch(const Double_t* x, Double_t* out, Int_t n, Double_t frac, const Double_t* p, const Double_t* norm){
+     if(n<=0) return;
+     std::vector<Double_t> second(n);
+     First::batch(x,out,n,p);
+     Second::batch(x,&second[0],n,p+First::nParams);
+     Double_t w1=frac/norm[0], w2=(1.-frac)/norm[1];
+     for(Int_t i=0; i<n; i++) out[i]=w1*out[i]+w2*second[i];
+   }
+   static Double_t integral(Double_t x_min, Double_t x_max, Double_t frac, const Double_t* p, const Double_t* norm){
+     return frac*First::integral(x_min,x_max,p)/norm[0]+(1.-frac)*Second::integral(x_min,x_max,p+First::nParams)/norm[1];
+   }
+};
+
+/// norms of the components of Model over [x_min,x_max], recomputed only when a parameter or the range change
+template<class Model>
+static const Double_t* cachedNorms(Double_t x_min, Double_t x_max, const Double_t* p, RooDerivedConstants& cache){
+   Double_t key[Model::nParams+2];
+   std::copy(p,p+Model::nParams,key);
+   key[Model::nParams]=x_min;
+   key[Model::nParams+1]=x_max;
+   if(cache.update(key,Model::nParams+2)) Model::norms(x_min,x_max,p,cache.data());
+   return cache.data();
+}
+
+typedef FusedSum<GausComponent,ErfExpComponent> GausErfExpSum;
+typedef FusedSum<ExpComponent,GausComponent>    ExpGausSum;
+typedef FusedSum<ErfExpComponent,GausComponent> ErfExpGausSum;
+
+
+//// Gaussian + Erf*Exp
+ClassImp(RooGausErfExpPdf)
+
+RooGausErfExpPdf::RooGausErfExpPdf(const char *name, const char *title,
+                                   RooAbsReal& _x,
+                                   RooAbsReal& _mean,
+                                   RooAbsReal& _sigma,
+                                   RooAbsReal& _c,
+                                   RooAbsReal& _offset,
+                                   RooAbsReal& _width,
+                                   RooAbsReal& _frac) :
+  RooAbsPdf(name,title),
+  x("x","x",this,_x),
+  mean("mean","mean",this,_mean),
+  sigma("sigma","sigma",this,_sigma),
+  c("c","c",this,_c),
+  offset("offset","offset",this,_offset),
+  width("width","width",this,_width),
+  frac("frac","frac",this,_frac){ }
+
+RooGausErfExpPdf::RooGausErfExpPdf(const RooGausErfExpPdf& other, const char* name) :
+  RooAbsPdf(other,name),
+  x("x",this,other.x),
+  mean("mean",this,other.mean),
+  sigma("sigma",this,other.sigma),
+  c("c",this,other.c),
+  offset("offset",this,other.offset),
+  width("width",this,other.width),
+  frac("frac",this,other.frac){ }
+
+void RooGausErfExpPdf::componentParams(Double_t* p) const {
+   p[0]=mean; p[1]=sigma; p[2]=c; p[3]=offset; p[4]=width;
+}
+
+const Double_t* RooGausErfExpPdf::componentNorms(const Double_t* p) const {
+   return cachedNorms<GausErfExpSum>(x.min(),x.max(),p,normConstants);
+}
+
+Double_t RooGausErfExpPdf::evaluate() const {
+   Double_t p[GausErfExpSum::nParams];
+   componentParams(p);
+   return GausErfExpSum::value(x,frac,p,componentNorms(p));
+}
+
+Int_t RooGausErfExpPdf::batchSnapshot(Double_t* p) const {
+   componentParams(p);
+   const Double_t* norm=componentNorms(p);
+   p[GausErfExpSum::nParams]=norm[0]; p[GausErfExpSum::nParams+1]=norm[1]; p[GausErfExpSum::nParams+2]=frac;
+   return GausErfExpSum::nParams+3;
+}
+
+void RooGausErfExpPdf::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   GausErfExpSum::batch(xs,out,n,p[GausErfExpSum::nParams+2],p,p+GausErfExpSum::nParams);
+}
+
+Int_t RooGausErfExpPdf::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const {
+   if (matchArgs(allVars,analVars,x)) return 1 ;
+   return 0 ;
+}
+
+Double_t RooGausErfExpPdf::analyticalIntegral(Int_t code, const char* rangeName) const {
+   assert(code==1) ;
+   Double_t integral=0;
+   closedIntegral(x.min(rangeName),x.max(rangeName),integral);
+   return integral ;
+}
+
+Bool_t RooGausErfExpPdf::closedIntegral(Double_t x_min, Double_t x_max, Double_t& value) const {
+   Double_t p[GausErfExpSum::nParams];
+   componentParams(p);
+   value=GausErfExpSum::integral(x_min,x_max,frac,p,componentNorms(p));
+   return kTRUE ;
+}
+
+
+//// Exp + Gaussian
+ClassImp(RooExpGausPdf)
+
+RooExpGausPdf::RooExpGausPdf(const char *name, const char *title,
+                             RooAbsReal& _x,
+                             RooAbsReal& _c,
+                             RooAbsReal& _mean,
+                             RooAbsReal& _sigma,
+                             RooAbsReal& _frac) :
+  RooAbsPdf(name,title),
+  x("x","x",this,_x),
+  c("c","c",this,_c),
+  mean("mean","mean",this,_mean),
+  sigma("sigma","sigma",this,_sigma),
+  frac("frac","frac",this,_frac){ }
+
+RooExpGausPdf::RooExpGausPdf(const RooExpGausPdf& other, const char* name) :
+  RooAbsPdf(other,name),
+  x("x",this,other.x),
+  c("c",this,other.c),
+  mean("mean",this,other.mean),
+  sigma("sigma",this,other.sigma),
+  frac("frac",this,other.frac){ }
+
+void RooExpGausPdf::componentParams(Double_t* p) const {
+   p[0]=c; p[1]=mean; p[2]=sigma;
+}
+
+const Double_t* RooExpGausPdf::componentNorms(const Double_t* p) const {
+   return cachedNorms<ExpGausSum>(x.min(),x.max(),p,normConstants);
+}
+
+Double_t RooExpGausPdf::evaluate() const {
+   Double_t p[ExpGausSum::nParams];
+   componentParams(p);
+   return ExpGausSum::value(x,frac,p,componentNorms(p));
+}
+
+Int_t RooExpGausPdf::batchSnapshot(Double_t* p) const {
+   componentParams(p);
+   const Double_t* norm=componentNorms(p);
+   p[ExpGausSum::nParams]=norm[0]; p[ExpGausSum::nParams+1]=norm[1]; p[ExpGausSum::nParams+2]=frac;
+   return ExpGausSum::nParams+3;
+}
+
+void RooExpGausPdf::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   ExpGausSum::batch(xs,out,n,p[ExpGausSum::nParams+2],p,p+ExpGausSum::nParams);
+}
+
+Int_t RooExpGausPdf::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const {
+   if (matchArgs(allVars,analVars,x)) return 1 ;
+   return 0 ;
+}
+
+Double_t RooExpGausPdf::analyticalIntegral(Int_t code, const char* rangeName) const {
+   assert(code==1) ;
+   Double_t integral=0;
+   closedIntegral(x.min(rangeName),x.max(rangeName),integral);
+   return integral ;
+}
+
+Bool_t RooExpGausPdf::closedIntegral(Double_t x_min, Double_t x_max, Double_t& value) const {
+   Double_t p[ExpGausSum::nParams];
+   componentParams(p);
+   value=ExpGausSum::integral(x_min,x_max,frac,p,componentNorms(p));
+   return kTRUE ;
+}
+
+
+//// Erf*Exp + Gaussian
+ClassImp(RooErfExpGausPdf)
+
+RooErfExpGausPdf::RooErfExpGausPdf(const char *name, const char *title,
+                                   RooAbsReal& _x,
+                                   RooAbsReal& _c,
+                                   RooAbsReal& _offset,
+                                   RooAbsReal& _width,
+                                   RooAbsReal& _mean,
+                                   RooAbsReal& _sigma,
+                                   RooAbsReal& _frac) :
+  RooAbsPdf(name,title),
+  x("x","x",this,_x),
+  c("c","c",this,_c),
+  offset("offset","offset",this,_offset),
+  width("width","width",this,_width),
+  mean("mean","mean",this,_mean),
+  sigma("sigma","sigma",this,_sigma),
+  frac("frac","frac",this,_frac){ }
+
+RooErfExpGausPdf::RooErfExpGausPdf(const RooErfExpGausPdf& other, const char* name) :
+  RooAbsPdf(other,name),
+  x("x",this,other.x),
+  c("c",this,other.c),
+  offset("offset",this,other.offset),
+  width("width",this,other.width),
+  mean("mean",this,other.mean),
+  sigma("sigma",this,other.sigma),
+  frac("frac",this,other.frac){ }
+
+void RooErfExpGausPdf::componentParams(Double_t* p) const {
+   p[0]=c; p[1]=offset; p[2]=width; p[3]=mean; p[4]=sigma;
+}
+
+const Double_t* RooErfExpGausPdf::componentNorms(const Double_t* p) const {
+   return cachedNorms<ErfExpGausSum>(x.min(),x.max(),p,normConstants);
+}
+
+Double_t RooErfExpGausPdf::evaluate() const {
+   Double_t p[ErfExpGausSum::nParams];
+   componentParams(p);
+   return ErfExpGausSum::value(x,frac,p,componentNorms(p));
+}
+
+Int_t RooErfExpGausPdf::batchSnapshot(Double_t* p) const {
+   componentParams(p);
+   const Double_t* norm=componentNorms(p);
+   p[ErfExpGausSum::nParams]=norm[0]; p[ErfExpGausSum::nParams+1]=norm[1]; p[ErfExpGausSum::nParams+2]=frac;
+   return ErfExpGausSum::nParams+3;
+}
+
+void RooErfExpGausPdf::evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const {
+   ErfExpGausSum::batch(xs,out,n,p[ErfExpGausSum::nParams+2],p,p+ErfExpGausSum::nParams);
+}
+
+Int_t RooErfExpGausPdf::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const {
+   if (matchArgs(allVars,analVars,x)) return 1 ;
+   return 0 ;
+}
+
+Double_t RooErfExpGausPdf::analyticalIntegral(Int_t code, const char* rangeName) const {
+   assert(code==1) ;
+   Double_t integral=0;
+   closedIntegral(x.min(rangeName),x.max(rangeName),integral);
+   return integral ;
+}
+
+Bool_t RooErfExpGausPdf::closedIntegral(Double_t x_min, Double_t x_max, Double_t& value) const {
+   Double_t p[ErfExpGausSum::nParams];
+   componentParams(p);
+   value=ErfExpGausSum::integral(x_min,x_max,frac,p,componentNorms(p));
+   return kTRUE ;
+}
+
+#endif
+
+
+//////////////////////////////////////////
+//// Shape table: adaptive grid, cubic Hermite interpolation and running integral
+
+void RooShapeTable::clear(){
+   xs.clear(); ys.clear(); slopes.clear(); cumulative.clear();
+}
+
+void RooShapeTable::build(const Shape& shape, Double_t x_min, Double_t x_max, Double_t tolerance, Int_t maxNodes){
+   clear();
+   if(x_max<=x_min) return;
+   const Int_t nStart=64;
+   for(Int_t i=0; i<=nStart; i++) xs.push_back(x_min+(x_max-x_min)*i/nStart);
+   ys.resize(xs.size());
+   shape.evaluate(&xs[0],&ys[0],xs.size());
+   for(UInt_t i=0; i<ys.size(); i++) ys[i]=TMath::Max(ys[i],0.);
+
+   /// bisect, all the midpoints of a pass in one evaluate call, until every midpoint is within tolerance
+   std::vector<Double_t> mids, midValues, newXs, newYs;
+   while(true){
+     computeSlopes();
+     Int_t nInt=xs.size()-1;
+     mids.resize(nInt);
+     midValues.resize(nInt);
+     for(Int_t i=0; i<nInt; i++) mids[i]=(xs[i]+xs[i+1])/2;
+     shape.evaluate(&mids[0],&midValues[0],nInt);
+     for(Int_t i=0; i<nInt; i++) midValues[i]=TMath::Max(midValues[i],0.);
+
+     Double_t scale=0;
+     for(UInt_t i=0; i<ys.size(); i++) scale=TMath::Max(scale,TMath::Abs(ys[i]));
+     for(Int_t i=0; i<nInt; i++) scale=TMath::Max(scale,TMath::Abs(midValues[i]));
+     Double_t maxDiff=tolerance*scale;
+     Int_t budget=maxNodes-xs.size();
+
+     newXs.clear();
+     newYs.clear();
+     for(Int_t i=0; i<nInt; i++){
+       newXs.push_back(xs[i]);
+       newYs.push_back(ys[i]);
+       if(budget>0 && !(TMath::Abs(interpolate(i,0.5)-midValues[i])<=maxDiff)){
+         newXs.push_back(mids[i]);
+         newYs.push_back(midValues[i]);
+         budget--;
+       }
+     }
+     newXs.push_back(xs.back());
+     newYs.push_back(ys.back());
+     if(newXs.size()==xs.size()) break;
+     xs.swap(newXs);
+     ys.swap(newYs);
+   }
+
+   cumulative.resize(xs.size());
+   cumulative[0]=0;
+   for(UInt_t i=0; i+1<xs.size(); i++) cumulative[i+1]=cumulative[i]+partialIntegral(i,1.);
+}
+
+/// three point (parabola) derivatives on the non uniform grid, one sided at the ends, clamped to
+/// -3*ys[i]/h of the interval on the right and 3*ys[i]/h of the one on the left: with ys>=0 the cubic of each
+/// interval then stays >=0 (the same bound of 3 as the Fritsch-Carlson limiter), so the running integral is monotone
+void RooShapeTable::computeSlopes(){
+   Int_t n=xs.size();
+   slopes.resize(n);
+   if(n<3){
+     slopes[0]=slopes[n-1]=(ys[n-1]-ys[0])/(xs[n-1]-xs[0]);
+   }else{
+     for(Int_t i=1; i<n-1; i++){
+       Double_t h0=xs[i]-xs[i-1], h1=xs[i+1]-xs[i];
+       Double_t d0=(ys[i]-ys[i-1])/h0, d1=(ys[i+1]-ys[i])/h1;
+       slopes[i]=(h1*d0+h0*d1)/(h0+h1);
+     }
+     Double_t h0=xs[1]-xs[0], h1=xs[2]-xs[1];
+     slopes[0]=((2*h0+h1)*(ys[1]-ys[0])/h0-h0*(ys[2]-ys[1])/h1)/(h0+h1);
+     h0=xs[n-1]-xs[n-2]; h1=xs[n-2]-xs[n-3];
+     slopes[n-1]=((2*h0+h1)*(ys[n-1]-ys[n-2])/h0-h0*(ys[n-2]-ys[n-3])/h1)/(h0+h1);
+   }
+   for(Int_t i=0; i<n; i++){
+     if(i+1<n) slopes[i]=TMath::Max(slopes[i],-3*ys[i]/(xs[i+1]-xs[i]));
+     if(i>0)   slopes[i]=TMath::Min(slopes[i],3*ys[i]/(xs[i]-xs[i-1]));
+   }
+}
+
+Int_t RooShapeTable::interval(Double_t x) const {
+   Int_t i=std::upper_bound(xs.begin(),xs.end(),x)-xs.begin()-1;
+   return TMath::Min(TMath::Max(i,0),Int_t(xs.size())-2);
+}
+
+/// value at xs[i]+t*(xs[i+1]-xs[i])
+Double_t RooShapeTable::interpolate(Int_t i, Double_t t) const {
+   Double_t h=xs[i+1]-xs[i];
+   Double_t t2=t*t, t3=t2*t;
+   return ys[i]*(2*t3-3*t2+1)+h*slopes[i]*(t3-2*t2+t)+ys[i+1]*(3*t2-2*t3)+h*slopes[i+1]*(t3-t2);
+}
+
+/// integral of the interpolation from xs[i] to xs[i]+t*(xs[i+1]-xs[i])
+Double_t RooShapeTable::partialIntegral(Int_t i, Double_t t) const {
+   Double_t h=xs[i+1]-xs[i];
+   Double_t t2=t*t, t3=t2*t, t4=t3*t;
+   return h*(ys[i]*(t4/2-t3+t)+h*slopes[i]*(t4/4-2*t3/3+t2/2)+ys[i+1]*(t3-t4/2)+h*slopes[i+1]*(t4/4-t3/3));
+}
+
+Double_t RooShapeTable::value(Double_t x) const {
+   if(empty() || x<xs.front() || x>xs.back()) return 0;
+   Int_t i=interval(x);
+   return TMath::Max(interpolate(i,(x-xs[i])/(xs[i+1]-xs[i])),0.);
+}
+
+Double_t RooShapeTable::cdf(Double_t x) const {
+   x=TMath::Min(TMath::Max(x,xs.front()),xs.back());
+   Int_t i=interval(x);
+   return cumulative[i]+partialIntegral(i,(x-xs[i])/(xs[i+1]-xs[i]));
+}
+
+Double_t RooShapeTable::integral(Double_t x_min, Double_t x_max) const {
+   if(empty()) return 0;
+   return cdf(x_max)-cdf(x_min);
+}
+
+Double_t RooShapeTable::quantile(Double_t u) const {
+   if(empty()) return 0;
+   Double_t target=u*cumulative.back();
+   Int_t i=std::upper_bound(cumulative.begin(),cumulative.end(),target)-cumulative.begin()-1;
+   i=TMath::Min(TMath::Max(i,0),Int_t(xs.size())-2);
+   Double_t h=xs[i+1]-xs[i];
+   Double_t content=cumulative[i+1]-cumulative[i];
+   Double_t rest=target-cumulative[i];
+   if(content<=0) return xs[i];
+
+   /// Newton on the cubic running integral, bisection when a step leaves the bracket
+   Double_t lo=0, hi=1, t=TMath::Min(TMath::Max(rest/content,0.),1.);
+   for(Int_t iter=0; iter<50; iter++){
+     Double_t f=partialIntegral(i,t)-rest;
+     if(TMath::Abs(f)<=1e-14*cumulative.back()) break;
+     if(f>0) hi=t; else lo=t;
+     Double_t derivative=h*interpolate(i,t);
+     Double_t next= derivative>0 ? t-f/derivative : -1;
+     t= (next>lo && next<hi) ? next : (lo+hi)/2;
+   }
+   return xs[i]+t*h;
+}
+
+
+//////////////////////////////////////////
+//// Tabulated Pdf, kept away from rootcint like the fused models (TabulatedPdfShape needs no dictionary)
+#if !defined(__CINT__) && !defined(__MAKECINT__)
+
+ClassImp(RooTabulatedPdf)
+
+RooTabulatedPdf::RooTabulatedPdf(const char *name, const char *title,
+                        RooRealVar& _x,
+                        RooAbsPdf& _pdf,
+                        Double_t _tolerance) :
+   RooAbsPdf(name,title),
+   x("x","x",this,_x),
+   pdf("pdf","pdf",this,_pdf),
+   tolerance(_tolerance),
+   paramSet(0){}
+
+RooTabulatedPdf::RooTabulatedPdf(const RooTabulatedPdf& other, const char* name) :
+   RooAbsPdf(other,name),
+   x("x",this,other.x),
+   pdf("pdf",this,other.pdf),
+   tolerance(other.tolerance),
+   paramSet(0){}
+
+RooTabulatedPdf::~RooTabulatedPdf(){
+   delete paramSet;
+}
+
+/// the normalised pdf at the nodes, x restored afterwards
+class TabulatedPdfShape : public RooShapeTable::Shape {
+public:
+   TabulatedPdfShape(const RooAbsPdf& _pdf, RooRealVar& _x) : pdf(_pdf), x(_x), normSet(_x) { }
+   void evaluate(const Double_t* xs, Double_t* out, Int_t n) const {
+     Double_t x_saved=x.getVal();
+     for(Int_t i=0; i<n; i++){
+       x.setVal(xs[i]);
+       out[i]=pdf.getVal(&normSet);
+     }
+     x.setVal(x_saved);
+   }
+private:
+   const RooAbsPdf& pdf;
+   RooRealVar& x;
+   RooArgSet normSet;
+};
+
+const RooShapeTable& RooTabulatedPdf::table() const {
+   if(!paramSet) paramSet=pdf.arg().getParameters(RooArgSet(x.arg()));
+   std::vector<Double_t> inputs;
+   inputs.reserve(paramSet->getSize()+3);
+   inputs.push_back(x.min());
+   inputs.push_back(x.max());
+   inputs.push_back(tolerance);
+   TIterator* iter=paramSet->createIterator();
+   for(RooAbsArg* arg=(RooAbsArg*)iter->Next(); arg; arg=(RooAbsArg*)iter->Next()){
+     RooAbsReal* param=dynamic_cast<RooAbsReal*>(arg);
+     if(param) inputs.push_back(param->getVal());
+   }
+   delete iter;
+   if(!shapeTable.empty() && inputs==tableInputs) return shapeTable;
+
+   TabulatedPdfShape shape((RooAbsPdf&)pdf.arg(),(RooRealVar&)x.arg());
+   shapeTable.build(shape,x.min(),x.max(),tolerance);
+   tableInputs.swap(inputs);
+   return shapeTable;
+}
+
+void RooTabulatedPdf::setTolerance(Double_t _tolerance){
+   if(_tolerance==tolerance) return;
+   tolerance=_tolerance;
+   setValueDirty();
+}
+
+/// the cached parameter set points to the old servers
+Bool_t RooTabulatedPdf::redirectServersHook(const RooAbsCollection& newServerList, Bool_t mustReplaceAll, Bool_t nameChange, Bool_t isRecursive){
+   delete paramSet;
+   paramSet=0;
+   shapeTable.clear();
+   return RooAbsPdf::redirectServersHook(newServerList,mustReplaceAll,nameChange,isRecursive);
+}
+
+Double_t RooTabulatedPdf::evaluate() const {
+   return table().value(x);
+}
+
+Int_t RooTabulatedPdf::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const {
+   if (matchArgs(allVars,analVars,x)) return 1 ;
+   return 0 ;
+}
+
+Double_t RooTabulatedPdf::analyticalIntegral(Int_t code, const char* rangeName) const {
+   assert(code==1) ;
+   return table().integral(x.min(rangeName),x.max(rangeName)) ;
+}
+
+Int_t RooTabulatedPdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+/// inverse CDF of the table, which spans the current range of x
+void RooTabulatedPdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=table().quantile(RooRandom::uniform());
+}
+
+RooAbsPdf::ExtendMode RooTabulatedPdf::extendMode() const {
+   return ((RooAbsPdf&)pdf.arg()).extendMode();
+}
+
+Double_t RooTabulatedPdf::expectedEvents(const RooArgSet* nset) const {
+   return ((RooAbsPdf&)pdf.arg()).expectedEvents(nset);
+}
+
+#endif
+
+
+//////////////////////////////////////////
+//// Generators: inverse CDF of a RooShapeTable of the batch shape, no accept/reject
+/// Kept away from rootcint: BatchShape needs no dictionary
+#if !defined(__CINT__) && !defined(__MAKECINT__)
+
+class BatchShape : public RooShapeTable::Shape {
+public:
+   BatchShape(const RooBatchPdf& _pdf) : pdf(_pdf) { }
+   void evaluate(const Double_t* xs, Double_t* out, Int_t n) const { pdf.evaluateBatch(xs,out,n); }
+private:
+   const RooBatchPdf& pdf;
+};
+
+/// max |table - shape| at the interval midpoints relative to the maximum of the shape
+static const Double_t generatorTolerance=1e-6;
+
+void RooBatchPdf::initInverseCdf(Double_t x_min, Double_t x_max){
+   generatorTable.build(BatchShape(*this),x_min,x_max,generatorTolerance);
+}
+
+Double_t RooBatchPdf::inverseCdf() const {
+   return generatorTable.quantile(RooRandom::uniform());
+}
+
+Int_t RooPowPdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooPowPdf::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooPowPdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooPow2Pdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooPow2Pdf::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooPow2Pdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooPow3Pdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooPow3Pdf::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooPow3Pdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooErfExpPdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooErfExpPdf::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooErfExpPdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooAlpha::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooAlpha::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooAlpha::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooAlphaExp::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooAlphaExp::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooAlphaExp::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooBWRunPdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooBWRunPdf::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooBWRunPdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooErfPowPdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooErfPowPdf::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooErfPowPdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooAlpha4ErfPowPdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooAlpha4ErfPowPdf::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooAlpha4ErfPowPdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooErfPow2Pdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooErfPow2Pdf::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooErfPow2Pdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooAlpha4ErfPow2Pdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooAlpha4ErfPow2Pdf::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooAlpha4ErfPow2Pdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooErfPow3Pdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooErfPow3Pdf::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooErfPow3Pdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooErfPowExpPdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooErfPowExpPdf::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooErfPowExpPdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooAlpha4ErfPowExpPdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooAlpha4ErfPowExpPdf::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooAlpha4ErfPowExpPdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooQCDPdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooQCDPdf::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooQCDPdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooUser1Pdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooUser1Pdf::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooUser1Pdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooExpNPdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooExpNPdf::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooExpNPdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooAlpha4ExpNPdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooAlpha4ExpNPdf::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooAlpha4ExpNPdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooExpTailPdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooExpTailPdf::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooExpTailPdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooAlpha4ExpTailPdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooAlpha4ExpTailPdf::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooAlpha4ExpTailPdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t Roo2ExpPdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void Roo2ExpPdf::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void Roo2ExpPdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooAlpha42ExpPdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooAlpha42ExpPdf::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooAlpha42ExpPdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooAnaExpNPdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooAnaExpNPdf::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooAnaExpNPdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooDoubleCrystalBall::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooDoubleCrystalBall::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooDoubleCrystalBall::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooAtanExpPdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooAtanExpPdf::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooAtanExpPdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooAtanAlpha::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooAtanAlpha::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooAtanAlpha::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooAtanPow2Pdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooAtanPow2Pdf::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooAtanPow2Pdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooAtanPow3Pdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooAtanPow3Pdf::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooAtanPow3Pdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooAlpha4AtanPow2Pdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooAlpha4AtanPow2Pdf::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooAlpha4AtanPow2Pdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooAtanPowExpPdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooAtanPowExpPdf::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooAtanPowExpPdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooAlpha4AtanPowExpPdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooAlpha4AtanPowExpPdf::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooAlpha4AtanPowExpPdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooAtanPowPdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooAtanPowPdf::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooAtanPowPdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooAlpha4AtanPowPdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooAlpha4AtanPowPdf::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooAlpha4AtanPowPdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooGausErfExpPdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooGausErfExpPdf::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooGausErfExpPdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooExpGausPdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooExpGausPdf::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooExpGausPdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+Int_t RooErfExpGausPdf::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const {
+   if (matchArgs(directVars,generateVars,x)) return 1 ;
+   return 0 ;
+}
+
+void RooErfExpGausPdf::initGenerator(Int_t code){
+   assert(code==1) ;
+   initInverseCdf(x.min(),x.max()) ;
+}
+
+void RooErfExpGausPdf::generateEvent(Int_t code){
+   assert(code==1) ;
+   x=inverseCdf() ;
+}
+
+#endif
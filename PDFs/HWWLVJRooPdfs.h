@@ -12,9 +12,113 @@
 #include "RooCategoryProxy.h"
 #include "RooAbsReal.h"
 #include "RooAbsCategory.h"
+#include "RooArgList.h"
+#include "RooArgSet.h"
+#include "RooRealVar.h"
+
+#include "RooDerivedConstants.h"
+
+#include <vector>
+
+////// Shape table
+/// Piecewise cubic Hermite interpolation of a shape on [x_min,x_max] with its running integral at the nodes.
+/// The grid starts uniform and intervals are bisected until the interpolation at their midpoint agrees with
+/// the shape within tolerance*max(shape). Negative values are tabulated as 0 and the slopes are limited so that the
+/// interpolation stays >=0: the running integral is monotone. Used by RooTabulatedPdf and the RooBatchPdf generators.
+class RooShapeTable {
+public:
+  /// The shape to tabulate: out[i] = f(xs[i])
+  class Shape {
+  public:
+    virtual ~Shape() { }
+    virtual void evaluate(const Double_t* xs, Double_t* out, Int_t n) const = 0 ;
+  };
+
+  void build(const Shape& shape, Double_t x_min, Double_t x_max, Double_t tolerance, Int_t maxNodes=4097) ;
+  void clear() ;
+
+  Bool_t   empty() const { return xs.size()<2 ; }
+  Int_t    size() const { return xs.size() ; }
+  Double_t xMin() const { return xs.front() ; }
+  Double_t xMax() const { return xs.back() ; }
+
+  Double_t value(Double_t x) const ;
+  Double_t integral(Double_t x_min, Double_t x_max) const ;
+  /// x with integral(xMin(),x) = u*integral(xMin(),xMax()), for u in [0,1]
+  Double_t quantile(Double_t u) const ;
+
+protected:
+
+  Int_t    interval(Double_t x) const ;
+  Double_t cdf(Double_t x) const ;
+  Double_t interpolate(Int_t i, Double_t t) const ;
+  Double_t partialIntegral(Int_t i, Double_t t) const ;
+  void     computeSlopes() ;
+
+  std::vector<Double_t> xs, ys, slopes, cumulative ; //! rebuilt from the shape, never streamed
+};
+
+////// Batch evaluation interface
+/// Fills out[i] with the unnormalised shape at xs[i] for the current parameter
+/// values; proxies are read once per call instead of once per event (see RooBatchNLL)
+class RooBatchPdf {
+public:
+  virtual ~RooBatchPdf() { }
+
+  enum { kMaxSnapshot=16 } ;
+
+  /// batchSnapshot then evaluateSnapshot
+  void evaluateBatch(const Double_t* xs, Double_t* out, Int_t n) const ;
+
+  /// out[i] = log of evaluateBatch at xs[i], built in the log domain (polynomial in log(x/sqrt_s) plus the log of the
+  /// turn-on): no exp per event and no underflow at high mass. kFALSE if the shape has no log path (see RooBatchNLL)
+  Bool_t logBatch(const Double_t* xs, Double_t* out, Int_t n) const ;
+
+  /// Copies into p (at most kMaxSnapshot values) everything the shape reads from RooFit: parameter values, after
+  /// clamping, and the derived constants (norm ratios, tail constants); returns the number of values
+  virtual Int_t batchSnapshot(Double_t* p) const = 0 ;
+
+  /// evaluateBatch and logBatch from a snapshot: array code on p and xs only, no proxy or cache is read, so the
+  /// RooBatchNLL worker threads call these with a snapshot taken on the main thread
+  virtual void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const = 0 ;
+  virtual Bool_t logSnapshot(const Double_t* /*p*/, const Double_t* /*xs*/, Double_t* /*out*/, Int_t /*n*/) const { return kFALSE ; }
+
+  /// Offsets and widths of the turn-ons of the shape (at most 2), used to place the quadrature panels
+  virtual Int_t turnOns(Double_t* /*offsets*/, Double_t* /*widths*/) const { return 0 ; }
+
+  /// Integral of the unnormalised shape over [x_min,x_max] by composite 16 point Gauss-Legendre quadrature,
+  /// all nodes in one evaluateBatch call. Panels are at most one width long within 8 widths of each turn-on.
+  /// Against a 200000 panel reference on 30-200 and 500-3000: relative error below 1e-13 for the erf turn-on, power,
+  /// ExpN and ExpTail shapes; the atan turn-ons reach 1 as 1/z, below 1e-12 for widths above 0.3 and up to 1e-4 at 0.1.
+  Double_t batchIntegral(Double_t x_min, Double_t x_max) const ;
+
+  /// Closed-form integral of the unnormalised shape over [x_min,x_max] in value; kFALSE if the shape has none,
+  /// batchIntegral is then the fallback (see binIntegralsShape in RooBatchNLL)
+  virtual Bool_t closedIntegral(Double_t /*x_min*/, Double_t /*x_max*/, Double_t& /*value*/) const { return kFALSE ; }
+
+  /// Parameters with an analytic derivative, in the order used by gradientBatch; empty if there is none
+  virtual RooArgList gradientParams() const { return RooArgList() ; }
+
+  /// out[i] as in evaluateBatch and grad[k][i] = d out[i] / d gradientParams()[k]
+  virtual void gradientBatch(const Double_t* /*xs*/, Double_t* /*out*/, Double_t** /*grad*/, Int_t /*n*/) const { }
+
+  /// grad[k] = d/d gradientParams()[k] of the integral over [x_min,x_max], same quadrature as batchIntegral
+  void gradientIntegral(Double_t x_min, Double_t x_max, Double_t* grad) const ;
+
+  /// Inverse CDF generation, used by getGenerator/initGenerator/generateEvent of the shapes: initInverseCdf tabulates
+  /// the shape on [x_min,x_max] once per generate() call, inverseCdf then draws one value without rejection
+  void initInverseCdf(Double_t x_min, Double_t x_max) ;
+  Double_t inverseCdf() const ;
+
+protected:
+
+  void quadratureNodes(Double_t x_min, Double_t x_max, std::vector<Double_t>& nodes, std::vector<Double_t>& weights) const ;
+
+  RooShapeTable generatorTable ; //!
+};
 
 ////// Pow Pdf 
-class RooPowPdf : public RooAbsPdf {
+class RooPowPdf : public RooAbsPdf, public RooBatchPdf {
 public:
   RooPowPdf() {} ; 
   RooPowPdf(const char *name, const char *title,
@@ -27,6 +131,15 @@ public:
 
   inline virtual ~RooPowPdf() { }
 
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Bool_t logSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+  RooArgList gradientParams() const ;
+  void gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const ;
+
 protected:
 
   RooRealProxy x ;
@@ -36,11 +149,11 @@ protected:
 
 private:
 
-  ClassDef(RooPowPdf,1) // Your description goes here...
+  ClassDef(RooPowPdf,2) // Your description goes here...
 };
 
 ///////// Pow2 Pdf 
-class RooPow2Pdf : public RooAbsPdf {
+class RooPow2Pdf : public RooAbsPdf, public RooBatchPdf {
 public:
   RooPow2Pdf() {} ; 
   RooPow2Pdf(const char *name, const char *title,
@@ -55,6 +168,15 @@ public:
 
   inline virtual ~RooPow2Pdf() { }
 
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Bool_t logSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+  RooArgList gradientParams() const ;
+  void gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const ;
+
 protected:
 
   RooRealProxy x ;
@@ -65,12 +187,12 @@ protected:
 
 private:
 
-  ClassDef(RooPow2Pdf,1) // Your description goes here...
+  ClassDef(RooPow2Pdf,2) // Your description goes here...
 };
 
 
 ///////// Pow3 Pdf 
-class RooPow3Pdf : public RooAbsPdf {
+class RooPow3Pdf : public RooAbsPdf, public RooBatchPdf {
 public:
   RooPow3Pdf() {} ; 
   RooPow3Pdf(const char *name, const char *title,
@@ -86,6 +208,15 @@ public:
 
   inline virtual ~RooPow3Pdf() { }
 
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Bool_t logSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+  RooArgList gradientParams() const ;
+  void gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const ;
+
 protected:
 
   RooRealProxy x ;
@@ -97,15 +228,16 @@ protected:
 
 private:
 
-  ClassDef(RooPow3Pdf,1) // Your description goes here...
+  ClassDef(RooPow3Pdf,2) // Your description goes here...
 };
 
 
 /////// Error Function * Exponential 
 
 Double_t ErfExp(Double_t x, Double_t c, Double_t offset, Double_t width);
+void ErfExpBatch(const Double_t* x, Double_t* out, Int_t n, Double_t c, Double_t offset, Double_t width);
  
-class RooErfExpPdf : public RooAbsPdf {
+class RooErfExpPdf : public RooAbsPdf, public RooBatchPdf {
  public:
   RooErfExpPdf() {} ;  // default constructor
   RooErfExpPdf(const char *name, const char *title,
@@ -120,8 +252,18 @@ class RooErfExpPdf : public RooAbsPdf {
 
   inline virtual ~RooErfExpPdf() { } // dtor
 
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+  Int_t turnOns(Double_t* offsets, Double_t* widths) const ;
+  RooArgList gradientParams() const ;
+  void gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const ;
+
   Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ; // analytic integral
   Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
+  Bool_t closedIntegral(Double_t x_min, Double_t x_max, Double_t& value) const ;
 
 protected:
 
@@ -134,13 +276,13 @@ protected:
 
 private:
 
-  ClassDef(RooErfExpPdf,1) // Your description goes here...
+  ClassDef(RooErfExpPdf,2) // Your description goes here...
 };
 
 
 /////// Alpha defined as ration of two Erf*Exp
 
-class RooAlpha : public RooAbsPdf {
+class RooAlpha : public RooAbsPdf, public RooBatchPdf {
  public:
 	 RooAlpha();
 	 RooAlpha(const char *name, const char *title,
@@ -160,6 +302,16 @@ class RooAlpha : public RooAbsPdf {
 
 	inline virtual ~RooAlpha() { }
 
+	Int_t batchSnapshot(Double_t* p) const ;
+	void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+	Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+	void initGenerator(Int_t code) ;
+	void generateEvent(Int_t code) ;
+	Int_t turnOns(Double_t* offsets, Double_t* widths) const ;
+
+	Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
+	Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
+
         Double_t xmin;
         Double_t xmax;
 
@@ -175,14 +327,18 @@ class RooAlpha : public RooAbsPdf {
 
 	   Double_t evaluate() const ;
 
+	   /// integral(ca,offseta,widtha)/integral(c,offset,width) over [xmin,xmax], recomputed only when a parameter changes
+	   Double_t normRatio(Double_t c_tmp, Double_t width_tmp, Double_t ca_tmp, Double_t widtha_tmp) const ;
+	   mutable RooDerivedConstants normConstants ; //! the ratio, for c, offset, width, ca, offseta, widtha, xmin, xmax
+
  private:
 
-	  ClassDef(RooAlpha,1)
+	  ClassDef(RooAlpha,2)
 };
 
 
 /////// Alpha defined as ratio of two Exp 
-class RooAlphaExp : public RooAbsPdf {
+class RooAlphaExp : public RooAbsPdf, public RooBatchPdf {
 	public:
 		RooAlphaExp();
 		RooAlphaExp(const char *name, const char *title,
@@ -198,6 +354,16 @@ class RooAlphaExp : public RooAbsPdf {
 
 		inline virtual ~RooAlphaExp() { }
 
+		Int_t batchSnapshot(Double_t* p) const ;
+		void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+		Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+		void initGenerator(Int_t code) ;
+		void generateEvent(Int_t code) ;
+
+		Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
+		Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
+		Bool_t closedIntegral(Double_t x_min, Double_t x_max, Double_t& value) const ;
+
         Double_t xmin;
         Double_t xmax;
 
@@ -208,14 +374,18 @@ class RooAlphaExp : public RooAbsPdf {
 		RooRealProxy ca;
 		Double_t evaluate() const ;
 
+		/// Exp(xmin,xmin,xmax,c)/Exp(xmin,xmin,xmax,ca), recomputed only when c, ca or the range change
+		Double_t normRatio(Double_t c_tmp, Double_t ca_tmp) const ;
+		mutable RooDerivedConstants normConstants ; //! the ratio, for c, ca, xmin, xmax
+
 	private:
 
-		ClassDef(RooAlphaExp,1)
+		ClassDef(RooAlphaExp,2)
 };
 
 
 /////// Breit Wigner Run Pdf --> relativistic breit wigner
-class RooBWRunPdf : public RooAbsPdf {
+class RooBWRunPdf : public RooAbsPdf, public RooBatchPdf {
 public:
   RooBWRunPdf() {} ; 
   RooBWRunPdf(const char *name, const char *title,
@@ -229,6 +399,12 @@ public:
 
   inline virtual ~RooBWRunPdf() { }
 
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+
 protected:
 
   RooRealProxy x ;
@@ -239,13 +415,14 @@ protected:
 
 private:
 
-  ClassDef(RooBWRunPdf,1) // Your description goes here...
+  ClassDef(RooBWRunPdf,2) // Your description goes here...
 };
 
 ///// Erf*Pow pdf definition
 Double_t  ErfPow(Double_t x,Double_t c, Double_t offset, Double_t width);
+void ErfPowBatch(const Double_t* x, Double_t* out, Int_t n, Double_t c, Double_t offset, Double_t width);
 
-class RooErfPowPdf : public RooAbsPdf {
+class RooErfPowPdf : public RooAbsPdf, public RooBatchPdf {
 public:
   RooErfPowPdf() {} ; 
   RooErfPowPdf(const char *name, const char *title,
@@ -260,6 +437,19 @@ public:
 
   inline virtual ~RooErfPowPdf() { }
 
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Bool_t logSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+  Int_t turnOns(Double_t* offsets, Double_t* widths) const ;
+  RooArgList gradientParams() const ;
+  void gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const ;
+
+  Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
+  Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
+
 protected:
 
   RooRealProxy x ;
@@ -271,12 +461,12 @@ protected:
 
 private:
 
-  ClassDef(RooErfPowPdf,1) // Your description goes here...
+  ClassDef(RooErfPowPdf,2) // Your description goes here...
 };
  
 
 //////// Alpha given by the ratio of two ErfPow Pdf 
-class RooAlpha4ErfPowPdf : public RooAbsPdf {
+class RooAlpha4ErfPowPdf : public RooAbsPdf, public RooBatchPdf {
 public:
   RooAlpha4ErfPowPdf() {} ; 
   RooAlpha4ErfPowPdf(const char *name, const char *title,
@@ -294,6 +484,16 @@ public:
 
   inline virtual ~RooAlpha4ErfPowPdf() { }
 
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+  Int_t turnOns(Double_t* offsets, Double_t* widths) const ;
+
+  Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
+  Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
+
 protected:
 
   RooRealProxy x ;
@@ -308,14 +508,15 @@ protected:
 
 private:
 
-  ClassDef(RooAlpha4ErfPowPdf,1) // Your description goes here...
+  ClassDef(RooAlpha4ErfPowPdf,2) // Your description goes here...
 };
 
 
 ////////////  Erf*Pow2 function 
 Double_t  ErfPow2(Double_t x,Double_t c0, Double_t c1, Double_t offset, Double_t width);
+void ErfPow2Batch(const Double_t* x, Double_t* out, Int_t n, Double_t c0, Double_t c1, Double_t offset, Double_t width);
 
-class RooErfPow2Pdf : public RooAbsPdf {
+class RooErfPow2Pdf : public RooAbsPdf, public RooBatchPdf {
 public:
   RooErfPow2Pdf() {} ; 
   RooErfPow2Pdf(const char *name, const char *title,
@@ -331,6 +532,19 @@ public:
 
   inline virtual ~RooErfPow2Pdf() { }
 
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Bool_t logSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+  Int_t turnOns(Double_t* offsets, Double_t* widths) const ;
+  RooArgList gradientParams() const ;
+  void gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const ;
+
+  Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
+  Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
+
 protected:
 
   RooRealProxy x ;
@@ -343,11 +557,11 @@ protected:
 
 private:
 
-  ClassDef(RooErfPow2Pdf,1) // Your description goes here...
+  ClassDef(RooErfPow2Pdf,2) // Your description goes here...
 };
 
 ///// Alpha function for Erf*Pow2 funtion
-class RooAlpha4ErfPow2Pdf : public RooAbsPdf {
+class RooAlpha4ErfPow2Pdf : public RooAbsPdf, public RooBatchPdf {
 public:
   RooAlpha4ErfPow2Pdf() {} ; 
   RooAlpha4ErfPow2Pdf(const char *name, const char *title,
@@ -367,6 +581,16 @@ public:
 
   inline virtual ~RooAlpha4ErfPow2Pdf() { }
 
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+  Int_t turnOns(Double_t* offsets, Double_t* widths) const ;
+
+  Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
+  Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
+
 protected:
 
   RooRealProxy x ;
@@ -383,14 +607,15 @@ protected:
 
 private:
 
-  ClassDef(RooAlpha4ErfPow2Pdf,1) // Your description goes here...
+  ClassDef(RooAlpha4ErfPow2Pdf,2) // Your description goes here...
 };
 
 
 /// Erf Pow3
 Double_t  ErfPow3(Double_t x,Double_t c0, Double_t c1, Double_t c2, Double_t offset, Double_t width);
+void ErfPow3Batch(const Double_t* x, Double_t* out, Int_t n, Double_t c0, Double_t c1, Double_t c2, Double_t offset, Double_t width);
 
-class RooErfPow3Pdf : public RooAbsPdf {
+class RooErfPow3Pdf : public RooAbsPdf, public RooBatchPdf {
 public:
   RooErfPow3Pdf() {} ; 
   RooErfPow3Pdf(const char *name, const char *title,
@@ -407,6 +632,19 @@ public:
 
   inline virtual ~RooErfPow3Pdf() { }
 
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Bool_t logSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+  Int_t turnOns(Double_t* offsets, Double_t* widths) const ;
+  RooArgList gradientParams() const ;
+  void gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const ;
+
+  Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
+  Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
+
 protected:
 
   RooRealProxy x ;
@@ -420,15 +658,16 @@ protected:
 
 private:
 
-  ClassDef(RooErfPow3Pdf,1) // Your description goes here...
+  ClassDef(RooErfPow3Pdf,2) // Your description goes here...
 };
  
 
 
 /////// ErfPow Exp function and related pdf 
 Double_t  ErfPowExp(Double_t x,Double_t c0, Double_t c1, Double_t offset, Double_t width);
+void ErfPowExpBatch(const Double_t* x, Double_t* out, Int_t n, Double_t c0, Double_t c1, Double_t offset, Double_t width);
 
-class RooErfPowExpPdf : public RooAbsPdf {
+class RooErfPowExpPdf : public RooAbsPdf, public RooBatchPdf {
 public:
   RooErfPowExpPdf() {} ; 
   RooErfPowExpPdf(const char *name, const char *title,
@@ -444,6 +683,19 @@ public:
 
   inline virtual ~RooErfPowExpPdf() { }
 
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Bool_t logSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+  Int_t turnOns(Double_t* offsets, Double_t* widths) const ;
+  RooArgList gradientParams() const ;
+  void gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const ;
+
+  Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
+  Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
+
 protected:
 
   RooRealProxy x ;
@@ -456,12 +708,12 @@ protected:
 
 private:
 
-  ClassDef(RooErfPowExpPdf,1) // Your description goes here...
+  ClassDef(RooErfPowExpPdf,2) // Your description goes here...
 };
  
 
 /////// Alpha function given by the ration of two Erf*Pow*Exp Pdf
-class RooAlpha4ErfPowExpPdf : public RooAbsPdf {
+class RooAlpha4ErfPowExpPdf : public RooAbsPdf, public RooBatchPdf {
 public:
   RooAlpha4ErfPowExpPdf() {} ; 
   RooAlpha4ErfPowExpPdf(const char *name, const char *title,
@@ -481,6 +733,16 @@ public:
 
   inline virtual ~RooAlpha4ErfPowExpPdf() { }
 
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+  Int_t turnOns(Double_t* offsets, Double_t* widths) const ;
+
+  Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
+  Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
+
 protected:
 
   RooRealProxy x ;
@@ -497,12 +759,12 @@ protected:
 
 private:
 
-  ClassDef(RooAlpha4ErfPowExpPdf,1) // Your description goes here...
+  ClassDef(RooAlpha4ErfPowExpPdf,2) // Your description goes here...
 };
 
 
 //////// QCD Pdf
-class RooQCDPdf : public RooAbsPdf {
+class RooQCDPdf : public RooAbsPdf, public RooBatchPdf {
 public:
   RooQCDPdf() {} ; 
   RooQCDPdf(const char *name, const char *title,
@@ -517,6 +779,13 @@ public:
 
   inline virtual ~RooQCDPdf() { }
 
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Bool_t logSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+
 protected:
 
   RooRealProxy x ;
@@ -528,12 +797,12 @@ protected:
 
 private:
 
-  ClassDef(RooQCDPdf,1) // Your description goes here...
+  ClassDef(RooQCDPdf,2) // Your description goes here...
 };
 
 
 //////// User 1 Pdf 
-class RooUser1Pdf : public RooAbsPdf {
+class RooUser1Pdf : public RooAbsPdf, public RooBatchPdf {
 public:
   RooUser1Pdf() {} ; 
   RooUser1Pdf(const char *name, const char *title,
@@ -548,6 +817,12 @@ public:
 
   inline virtual ~RooUser1Pdf() { }
 
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+
 protected:
 
   RooRealProxy x ;
@@ -558,14 +833,15 @@ protected:
 
 private:
 
-  ClassDef(RooUser1Pdf,1) // Your description goes here...
+  ClassDef(RooUser1Pdf,2) // Your description goes here...
 };
 
 
 //////////// ExpN function and pdf 
 Double_t ExpN(Double_t x, Double_t c, Double_t n);
+void ExpNBatch(const Double_t* x, Double_t* out, Int_t n, Double_t c, Double_t nn);
 
-class RooExpNPdf : public RooAbsPdf {
+class RooExpNPdf : public RooAbsPdf, public RooBatchPdf {
 public:
   RooExpNPdf() {} ; 
   RooExpNPdf(const char *name, const char *title,
@@ -579,6 +855,14 @@ public:
 
   inline virtual ~RooExpNPdf() { }
 
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+  RooArgList gradientParams() const ;
+  void gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const ;
+
 protected:
 
   RooRealProxy x ;
@@ -589,11 +873,11 @@ protected:
 
 private:
 
-  ClassDef(RooExpNPdf,1) // Your description goes here...
+  ClassDef(RooExpNPdf,2) // Your description goes here...
 };
 
 //// Alpha function given by the ratio of two ExpN Pdf 
-class RooAlpha4ExpNPdf : public RooAbsPdf {
+class RooAlpha4ExpNPdf : public RooAbsPdf, public RooBatchPdf {
 public:
   RooAlpha4ExpNPdf() {} ; 
   RooAlpha4ExpNPdf(const char *name, const char *title,
@@ -609,6 +893,15 @@ public:
 
   inline virtual ~RooAlpha4ExpNPdf() { }
 
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+
+  Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
+  Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
+
 protected:
 
   RooRealProxy x ;
@@ -621,14 +914,15 @@ protected:
 
 private:
 
-  ClassDef(RooAlpha4ExpNPdf,1) // Your description goes here...
+  ClassDef(RooAlpha4ExpNPdf,2) // Your description goes here...
 };
 
 
 //////// ExpTail Pdf = Levelled exp with 2 parameter
 Double_t ExpTail(Double_t x, Double_t s, Double_t a);
+void ExpTailBatch(const Double_t* x, Double_t* out, Int_t n, Double_t s, Double_t a);
 
-class RooExpTailPdf : public RooAbsPdf {
+class RooExpTailPdf : public RooAbsPdf, public RooBatchPdf {
 public:
   RooExpTailPdf() {} ; 
   RooExpTailPdf(const char *name, const char *title,
@@ -642,6 +936,17 @@ public:
 
   inline virtual ~RooExpTailPdf() { }
 
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+  RooArgList gradientParams() const ;
+  void gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const ;
+
+  Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
+  Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
+
 protected:
 
   RooRealProxy x ;
@@ -652,11 +957,11 @@ protected:
 
 private:
 
-  ClassDef(RooExpTailPdf,1) // Your description goes here...
+  ClassDef(RooExpTailPdf,2) // Your description goes here...
 };
 
 ////// Alpha function given by the ratio of two levelled exp
-class RooAlpha4ExpTailPdf : public RooAbsPdf {
+class RooAlpha4ExpTailPdf : public RooAbsPdf, public RooBatchPdf {
 public:
   RooAlpha4ExpTailPdf() {} ; 
   RooAlpha4ExpTailPdf(const char *name, const char *title,
@@ -672,6 +977,15 @@ public:
 
   inline virtual ~RooAlpha4ExpTailPdf() { }
 
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+
+  Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
+  Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
+
 protected:
 
   RooRealProxy x ;
@@ -684,14 +998,15 @@ protected:
 
 private:
 
-  ClassDef(RooAlpha4ExpTailPdf,1) // Your description goes here...
+  ClassDef(RooAlpha4ExpTailPdf,2) // Your description goes here...
 };
 
 
 //////////// Doublw exp function and pdf 
 Double_t TwoExp(Double_t x, Double_t c0, Double_t c1, Double_t frac);
+void TwoExpBatch(const Double_t* x, Double_t* out, Int_t n, Double_t c0, Double_t c1, Double_t frac);
 
-class Roo2ExpPdf : public RooAbsPdf {
+class Roo2ExpPdf : public RooAbsPdf, public RooBatchPdf {
 public:
   Roo2ExpPdf() {} ; 
   Roo2ExpPdf(const char *name, const char *title,
@@ -706,6 +1021,18 @@ public:
 
   inline virtual ~Roo2ExpPdf() { }
 
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+  RooArgList gradientParams() const ;
+  void gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const ;
+
+  Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
+  Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
+  Bool_t closedIntegral(Double_t x_min, Double_t x_max, Double_t& value) const ;
+
 protected:
 
   RooRealProxy x ;
@@ -717,11 +1044,11 @@ protected:
 
 private:
 
-  ClassDef(Roo2ExpPdf,1) // Your description goes here...
+  ClassDef(Roo2ExpPdf,2) // Your description goes here...
 };
 
 ///// Alpha function given by the ratio of two double exp pdf 
-class RooAlpha42ExpPdf : public RooAbsPdf {
+class RooAlpha42ExpPdf : public RooAbsPdf, public RooBatchPdf {
 public:
   RooAlpha42ExpPdf() {} ; 
   RooAlpha42ExpPdf(const char *name, const char *title,
@@ -739,6 +1066,15 @@ public:
 
   inline virtual ~RooAlpha42ExpPdf() { }
 
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+
+  Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
+  Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
+
 protected:
 
   RooRealProxy x ;
@@ -753,12 +1089,12 @@ protected:
 
 private:
 
-  ClassDef(RooAlpha42ExpPdf,1) // Your description goes here...
+  ClassDef(RooAlpha42ExpPdf,2) // Your description goes here...
 };
 
 
 // RooAnaExpNPdf.h
-class RooAnaExpNPdf : public RooAbsPdf {
+class RooAnaExpNPdf : public RooAbsPdf, public RooBatchPdf {
 public:
   RooAnaExpNPdf() {} ; 
   RooAnaExpNPdf(const char *name, const char *title,
@@ -772,6 +1108,14 @@ public:
 
   inline virtual ~RooAnaExpNPdf() { }
 
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+  RooArgList gradientParams() const ;
+  void gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const ;
+
   Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
 
   Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
@@ -786,11 +1130,11 @@ protected:
 
 private:
 
-  ClassDef(RooAnaExpNPdf,1) // Your description goes here...
+  ClassDef(RooAnaExpNPdf,2) // Your description goes here...
 };
 
 ///// Double Crystal Ball function 
-class RooDoubleCrystalBall : public RooAbsPdf {
+class RooDoubleCrystalBall : public RooAbsPdf, public RooBatchPdf {
  public:
   RooDoubleCrystalBall();
   RooDoubleCrystalBall(const char *name, const char *title,
@@ -809,6 +1153,12 @@ class RooDoubleCrystalBall : public RooAbsPdf {
 
   inline virtual ~RooDoubleCrystalBall() { }
 
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+
   Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
 
   Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
@@ -825,9 +1175,13 @@ class RooDoubleCrystalBall : public RooAbsPdf {
   
   Double_t evaluate() const ;
 
+  /// A1, B1, A2, B2 of the power-law tails, recomputed only when alpha1, n1, alpha2 or n2 change
+  const RooDerivedConstants& tailConstants() const ;
+  mutable RooDerivedConstants tailCache ; //!
+
  private:
 
-  ClassDef(RooDoubleCrystalBall,1)
+  ClassDef(RooDoubleCrystalBall,2)
 };
 
 ///////////////////////////////////////////////////////////////
@@ -835,8 +1189,9 @@ class RooDoubleCrystalBall : public RooAbsPdf {
 /////// Atan * Exponential 
 
 Double_t AtanExp(Double_t x, Double_t c, Double_t offset, Double_t width);
+void AtanExpBatch(const Double_t* x, Double_t* out, Int_t n, Double_t c, Double_t offset, Double_t width);
  
-class RooAtanExpPdf : public RooAbsPdf {
+class RooAtanExpPdf : public RooAbsPdf, public RooBatchPdf {
  public:
   RooAtanExpPdf() {} ;  // default constructor
   RooAtanExpPdf(const char *name, const char *title,
@@ -851,6 +1206,18 @@ class RooAtanExpPdf : public RooAbsPdf {
 
   inline virtual ~RooAtanExpPdf() { } // dtor
 
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+  Int_t turnOns(Double_t* offsets, Double_t* widths) const ;
+  RooArgList gradientParams() const ;
+  void gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const ;
+
+  Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
+  Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
+
 protected:
 
   RooRealProxy x ;
@@ -862,13 +1229,13 @@ protected:
 
 private:
 
-  ClassDef(RooAtanExpPdf,1) // Your description goes here...
+  ClassDef(RooAtanExpPdf,2) // Your description goes here...
 };
 
 
 /////// Alpha defined as ration of two Erf*Exp
 
-class RooAtanAlpha : public RooAbsPdf {
+class RooAtanAlpha : public RooAbsPdf, public RooBatchPdf {
  public:
 	 RooAtanAlpha();
 	 RooAtanAlpha(const char *name, const char *title,
@@ -888,6 +1255,16 @@ class RooAtanAlpha : public RooAbsPdf {
 
 	inline virtual ~RooAtanAlpha() { }
 
+	Int_t batchSnapshot(Double_t* p) const ;
+	void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+	Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+	void initGenerator(Int_t code) ;
+	void generateEvent(Int_t code) ;
+	Int_t turnOns(Double_t* offsets, Double_t* widths) const ;
+
+	Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
+	Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
+
         Double_t xmin;
         Double_t xmax;
 
@@ -905,14 +1282,15 @@ class RooAtanAlpha : public RooAbsPdf {
 
  private:
 
-	  ClassDef(RooAtanAlpha,1)
+	  ClassDef(RooAtanAlpha,2)
 };
 
 
 ////////////  Erf*Pow2 function 
 Double_t  AtanPow2(Double_t x,Double_t c0, Double_t c1, Double_t offset, Double_t width);
+void AtanPow2Batch(const Double_t* x, Double_t* out, Int_t n, Double_t c0, Double_t c1, Double_t offset, Double_t width);
 
-class RooAtanPow2Pdf : public RooAbsPdf {
+class RooAtanPow2Pdf : public RooAbsPdf, public RooBatchPdf {
 public:
   RooAtanPow2Pdf() {} ; 
   RooAtanPow2Pdf(const char *name, const char *title,
@@ -928,6 +1306,19 @@ public:
 
   inline virtual ~RooAtanPow2Pdf() { }
 
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Bool_t logSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+  Int_t turnOns(Double_t* offsets, Double_t* widths) const ;
+  RooArgList gradientParams() const ;
+  void gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const ;
+
+  Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
+  Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
+
 protected:
 
   RooRealProxy x ;
@@ -940,13 +1331,14 @@ protected:
 
 private:
 
-  ClassDef(RooAtanPow2Pdf,1) // Your description goes here...
+  ClassDef(RooAtanPow2Pdf,2) // Your description goes here...
 };
 
 ////////////  Erf*Pow2 function 
 Double_t  AtanPow3(Double_t x,Double_t c0, Double_t c1, Double_t c2, Double_t offset, Double_t width);
+void AtanPow3Batch(const Double_t* x, Double_t* out, Int_t n, Double_t c0, Double_t c1, Double_t c2, Double_t offset, Double_t width);
 
-class RooAtanPow3Pdf : public RooAbsPdf {
+class RooAtanPow3Pdf : public RooAbsPdf, public RooBatchPdf {
 public:
   RooAtanPow3Pdf() {} ; 
   RooAtanPow3Pdf(const char *name, const char *title,
@@ -963,6 +1355,19 @@ public:
 
   inline virtual ~RooAtanPow3Pdf() { }
 
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Bool_t logSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+  Int_t turnOns(Double_t* offsets, Double_t* widths) const ;
+  RooArgList gradientParams() const ;
+  void gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const ;
+
+  Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
+  Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
+
 protected:
 
   RooRealProxy x ;
@@ -976,13 +1381,13 @@ protected:
 
 private:
 
-  ClassDef(RooAtanPow3Pdf,1) // Your description goes here...
+  ClassDef(RooAtanPow3Pdf,2) // Your description goes here...
 };
  
 
 ///// Alpha function for Atan*Pow2 funtion
 
-class RooAlpha4AtanPow2Pdf : public RooAbsPdf {
+class RooAlpha4AtanPow2Pdf : public RooAbsPdf, public RooBatchPdf {
 public:
   RooAlpha4AtanPow2Pdf() {} ; 
   RooAlpha4AtanPow2Pdf(const char *name, const char *title,
@@ -1002,6 +1407,16 @@ public:
 
   inline virtual ~RooAlpha4AtanPow2Pdf() { }
 
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+  Int_t turnOns(Double_t* offsets, Double_t* widths) const ;
+
+  Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
+  Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
+
 protected:
 
   RooRealProxy x ;
@@ -1018,16 +1433,17 @@ protected:
 
 private:
 
-  ClassDef(RooAlpha4AtanPow2Pdf,1) // Your description goes here...
+  ClassDef(RooAlpha4AtanPow2Pdf,2) // Your description goes here...
 };
 
 
 
 /////// AtanPow Exp function and related pdf 
 Double_t  AtanPowExp(Double_t x,Double_t c0, Double_t c1, Double_t offset, Double_t width);
+void AtanPowExpBatch(const Double_t* x, Double_t* out, Int_t n, Double_t c0, Double_t c1, Double_t offset, Double_t width);
 
 
-class RooAtanPowExpPdf : public RooAbsPdf {
+class RooAtanPowExpPdf : public RooAbsPdf, public RooBatchPdf {
 public:
   RooAtanPowExpPdf() {} ; 
   RooAtanPowExpPdf(const char *name, const char *title,
@@ -1043,6 +1459,19 @@ public:
 
   inline virtual ~RooAtanPowExpPdf() { }
 
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Bool_t logSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+  Int_t turnOns(Double_t* offsets, Double_t* widths) const ;
+  RooArgList gradientParams() const ;
+  void gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const ;
+
+  Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
+  Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
+
 protected:
 
   RooRealProxy x ;
@@ -1055,13 +1484,13 @@ protected:
 
 private:
 
-  ClassDef(RooAtanPowExpPdf,1) // Your description goes here...
+  ClassDef(RooAtanPowExpPdf,2) // Your description goes here...
 };
  
 
 /////// Alpha function given by the ration of two Atan*Pow*Exp Pdf
 
-class RooAlpha4AtanPowExpPdf : public RooAbsPdf {
+class RooAlpha4AtanPowExpPdf : public RooAbsPdf, public RooBatchPdf {
 public:
   RooAlpha4AtanPowExpPdf() {} ; 
   RooAlpha4AtanPowExpPdf(const char *name, const char *title,
@@ -1081,6 +1510,16 @@ public:
 
   inline virtual ~RooAlpha4AtanPowExpPdf() { }
 
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+  Int_t turnOns(Double_t* offsets, Double_t* widths) const ;
+
+  Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
+  Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
+
 protected:
 
   RooRealProxy x ;
@@ -1097,15 +1536,16 @@ protected:
 
 private:
 
-  ClassDef(RooAlpha4AtanPowExpPdf,1) // Your description goes here...
+  ClassDef(RooAlpha4AtanPowExpPdf,2) // Your description goes here...
 };
 
 
 ///// Atan*Pow pdf definition
 Double_t  AtanPow(Double_t x,Double_t c, Double_t offset, Double_t width);
+void AtanPowBatch(const Double_t* x, Double_t* out, Int_t n, Double_t c, Double_t offset, Double_t width);
 
 
-class RooAtanPowPdf : public RooAbsPdf {
+class RooAtanPowPdf : public RooAbsPdf, public RooBatchPdf {
 public:
   RooAtanPowPdf() {} ; 
   RooAtanPowPdf(const char *name, const char *title,
@@ -1120,6 +1560,19 @@ public:
 
   inline virtual ~RooAtanPowPdf() { }
 
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Bool_t logSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+  Int_t turnOns(Double_t* offsets, Double_t* widths) const ;
+  RooArgList gradientParams() const ;
+  void gradientBatch(const Double_t* xs, Double_t* out, Double_t** grad, Int_t n) const ;
+
+  Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
+  Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
+
 protected:
 
   RooRealProxy x ;
@@ -1131,12 +1584,12 @@ protected:
 
 private:
 
-  ClassDef(RooAtanPowPdf,1) // Your description goes here...
+  ClassDef(RooAtanPowPdf,2) // Your description goes here...
 };
  
 
 //////// Alpha given by the ratio of two AtanPow Pdf 
-class RooAlpha4AtanPowPdf : public RooAbsPdf {
+class RooAlpha4AtanPowPdf : public RooAbsPdf, public RooBatchPdf {
 public:
   RooAlpha4AtanPowPdf() {} ; 
   RooAlpha4AtanPowPdf(const char *name, const char *title,
@@ -1154,6 +1607,16 @@ public:
 
   inline virtual ~RooAlpha4AtanPowPdf() { }
 
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+  Int_t turnOns(Double_t* offsets, Double_t* widths) const ;
+
+  Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
+  Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
+
 protected:
 
   RooRealProxy x ;
@@ -1168,7 +1631,214 @@ protected:
 
 private:
 
-  ClassDef(RooAlpha4AtanPowPdf,1) // Your description goes here...
+  ClassDef(RooAlpha4AtanPowPdf,2) // Your description goes here...
+};
+
+
+////// Fused models
+/// Fixed two component sums frac*A/norm(A) + (1-frac)*B/norm(B), equivalent to
+/// RooAddPdf(RooArgList(A,B),RooArgList(frac)) with the components normalised over the default range of x.
+/// Components and fraction are evaluated in one call, the component norms are cached and the integral is analytic.
+/// The components are composed at compile time in HWWLVJRooPdfs.cxx (FusedSum<First,Second>).
+
+/////// Gaussian + Erf*Exp (MakeGeneralPdf "GausErfExp_ttbar")
+class RooGausErfExpPdf : public RooAbsPdf, public RooBatchPdf {
+ public:
+  RooGausErfExpPdf() {} ;
+  RooGausErfExpPdf(const char *name, const char *title,
+	      RooAbsReal& _x,
+	      RooAbsReal& _mean, // mean of the gaussian
+	      RooAbsReal& _sigma, // width of the gaussian
+	      RooAbsReal& _c, // slope of the exp
+	      RooAbsReal& _offset, // offset of the erf
+	      RooAbsReal& _width, // width of the erf
+	      RooAbsReal& _frac); // fraction of the gaussian
+
+  RooGausErfExpPdf(const RooGausErfExpPdf& other, const char* name=0) ;
+
+  virtual TObject* clone(const char* newname) const { return new RooGausErfExpPdf(*this,newname); }
+
+  inline virtual ~RooGausErfExpPdf() { }
+
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+
+  Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
+  Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
+  Bool_t closedIntegral(Double_t x_min, Double_t x_max, Double_t& value) const ;
+
+protected:
+
+  RooRealProxy x ;
+  RooRealProxy mean ;
+  RooRealProxy sigma ;
+  RooRealProxy c ;
+  RooRealProxy offset ;
+  RooRealProxy width ;
+  RooRealProxy frac ;
+
+  Double_t evaluate() const ;
+
+  /// component parameters in the order of the fused components, and their norms over the default range of x
+  void componentParams(Double_t* p) const ;
+  const Double_t* componentNorms(const Double_t* p) const ;
+  mutable RooDerivedConstants normConstants ; //! the two norms, for the parameters and the range
+
+private:
+
+  ClassDef(RooGausErfExpPdf,1)
+};
+
+/////// Exp + Gaussian (MakeGeneralPdf "ExpGaus_sp")
+class RooExpGausPdf : public RooAbsPdf, public RooBatchPdf {
+ public:
+  RooExpGausPdf() {} ;
+  RooExpGausPdf(const char *name, const char *title,
+	      RooAbsReal& _x,
+	      RooAbsReal& _c, // slope of the exp
+	      RooAbsReal& _mean, // mean of the gaussian
+	      RooAbsReal& _sigma, // width of the gaussian
+	      RooAbsReal& _frac); // fraction of the exp
+
+  RooExpGausPdf(const RooExpGausPdf& other, const char* name=0) ;
+
+  virtual TObject* clone(const char* newname) const { return new RooExpGausPdf(*this,newname); }
+
+  inline virtual ~RooExpGausPdf() { }
+
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+
+  Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
+  Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
+  Bool_t closedIntegral(Double_t x_min, Double_t x_max, Double_t& value) const ;
+
+protected:
+
+  RooRealProxy x ;
+  RooRealProxy c ;
+  RooRealProxy mean ;
+  RooRealProxy sigma ;
+  RooRealProxy frac ;
+
+  Double_t evaluate() const ;
+
+  /// component parameters in the order of the fused components, and their norms over the default range of x
+  void componentParams(Double_t* p) const ;
+  const Double_t* componentNorms(const Double_t* p) const ;
+  mutable RooDerivedConstants normConstants ; //! the two norms, for the parameters and the range
+
+private:
+
+  ClassDef(RooExpGausPdf,1)
+};
+
+/////// Erf*Exp + Gaussian (MakeGeneralPdf "ErfExpGaus_sp")
+class RooErfExpGausPdf : public RooAbsPdf, public RooBatchPdf {
+ public:
+  RooErfExpGausPdf() {} ;
+  RooErfExpGausPdf(const char *name, const char *title,
+	      RooAbsReal& _x,
+	      RooAbsReal& _c, // slope of the exp
+	      RooAbsReal& _offset, // offset of the erf
+	      RooAbsReal& _width, // width of the erf
+	      RooAbsReal& _mean, // mean of the gaussian
+	      RooAbsReal& _sigma, // width of the gaussian
+	      RooAbsReal& _frac); // fraction of the Erf*Exp
+
+  RooErfExpGausPdf(const RooErfExpGausPdf& other, const char* name=0) ;
+
+  virtual TObject* clone(const char* newname) const { return new RooErfExpGausPdf(*this,newname); }
+
+  inline virtual ~RooErfExpGausPdf() { }
+
+  Int_t batchSnapshot(Double_t* p) const ;
+  void evaluateSnapshot(const Double_t* p, const Double_t* xs, Double_t* out, Int_t n) const ;
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void initGenerator(Int_t code) ;
+  void generateEvent(Int_t code) ;
+
+  Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
+  Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
+  Bool_t closedIntegral(Double_t x_min, Double_t x_max, Double_t& value) const ;
+
+protected:
+
+  RooRealProxy x ;
+  RooRealProxy c ;
+  RooRealProxy offset ;
+  RooRealProxy width ;
+  RooRealProxy mean ;
+  RooRealProxy sigma ;
+  RooRealProxy frac ;
+
+  Double_t evaluate() const ;
+
+  /// component parameters in the order of the fused components, and their norms over the default range of x
+  void componentParams(Double_t* p) const ;
+  const Double_t* componentNorms(const Double_t* p) const ;
+  mutable RooDerivedConstants normConstants ; //! the two norms, for the parameters and the range
+
+private:
+
+  ClassDef(RooErfExpGausPdf,1)
+};
+
+////// Tabulated Pdf
+/// Lookup-table version of any pdf of x, for toy generation and plotting at fixed parameters: the normalised pdf
+/// on a RooShapeTable over the default range of x, with integrals and generation (inverse CDF) from the table.
+/// The table is rebuilt when a parameter of pdf or the range of x changes; extended pdfs keep their yield.
+class RooTabulatedPdf : public RooAbsPdf {
+public:
+  RooTabulatedPdf() : tolerance(1e-4), paramSet(0) {} ;
+  RooTabulatedPdf(const char *name, const char *title,
+	      RooRealVar& _x,
+	      RooAbsPdf& _pdf,
+	      Double_t _tolerance=1e-4); // max |table - pdf| at the interval midpoints, relative to the maximum of pdf
+
+  RooTabulatedPdf(const RooTabulatedPdf& other, const char* name=0) ;
+
+  virtual TObject* clone(const char* newname) const { return new RooTabulatedPdf(*this,newname); }
+
+  virtual ~RooTabulatedPdf() ;
+
+  Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
+  Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
+
+  Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const ;
+  void generateEvent(Int_t code) ;
+
+  virtual ExtendMode extendMode() const ;
+  virtual Double_t expectedEvents(const RooArgSet* nset) const ;
+
+  Double_t getTolerance() const { return tolerance ; }
+  void setTolerance(Double_t _tolerance) ;
+  Int_t tableSize() const { return table().size() ; }
+
+protected:
+
+  RooRealProxy x ;
+  RooRealProxy pdf ;
+  Double_t tolerance ;
+
+  Double_t evaluate() const ;
+
+  virtual Bool_t redirectServersHook(const RooAbsCollection& newServerList, Bool_t mustReplaceAll, Bool_t nameChange, Bool_t isRecursive) ;
+
+  const RooShapeTable& table() const ;
+  mutable RooShapeTable shapeTable ;           //!
+  mutable RooArgSet* paramSet ;                //! parameters of pdf
+  mutable std::vector<Double_t> tableInputs ; //! range, tolerance and parameter values the table was built for
+
+private:
+
+  ClassDef(RooTabulatedPdf,1)
 };
 
 
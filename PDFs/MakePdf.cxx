@@ -1,4 +1,246 @@
 #include "MakePdf.h"
+#include <map>
+#include <set>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include "TObjArray.h"
+
+static Bool_t useFusedModels = kFALSE ;
+
+void SetFusedModels(Bool_t fused){ useFusedModels = fused ; }
+
+Bool_t GetFusedModels(){ return useFusedModels ; }
+
+void SetTabulatedMode(RooWorkspace* workspace, Bool_t tabulated, Double_t tolerance){
+  Double_t value = tabulated ? tolerance : 0. ;
+  if(!workspace->var("tabulated_mode_tolerance")){
+    RooRealVar mode("tabulated_mode_tolerance","tabulated_mode_tolerance",value,0.,1.);
+    mode.setConstant(kTRUE);
+    workspace->import(mode);
+  }
+  workspace->var("tabulated_mode_tolerance")->setVal(value);
+}
+
+Double_t GetTabulatedMode(RooWorkspace* workspace){
+  if(!workspace || !workspace->var("tabulated_mode_tolerance")) return 0. ;
+  return workspace->var("tabulated_mode_tolerance")->getVal();
+}
+
+RooAbsPdf* GetTabulatedPdf(RooWorkspace* workspace, RooAbsPdf* pdf, RooRealVar* x){
+  Double_t tolerance = GetTabulatedMode(workspace);
+  if(tolerance <= 0 || !pdf || !x) return pdf ;
+
+  TString name = TString(pdf->GetName())+"_tab";
+  RooTabulatedPdf* tabulated = dynamic_cast<RooTabulatedPdf*>(workspace->pdf(name.Data()));
+  if(!tabulated){
+    RooTabulatedPdf tab(name.Data(),name.Data(),*x,*pdf,tolerance);
+    workspace->import(tab,RooFit::RecycleConflictNodes(),RooFit::Silence());
+    tabulated = dynamic_cast<RooTabulatedPdf*>(workspace->pdf(name.Data()));
+  }
+  tabulated->setTolerance(tolerance);
+  return tabulated ;
+}
+
+#if !defined(__CINT__) && !defined(__MAKECINT__)
+
+////// Model configuration: entries of the loaded config files indexed by "<model> <parameter>", in file order
+struct ModelConfigEntry {
+  std::vector<std::string> tokens ;
+  Double_t value, min, max, sigma ;
+  Bool_t   hasRange ;
+  Int_t    constant ;   // -1 keep the flag of the builder, 0 float, 1 fix
+};
+
+static std::map<std::string,std::vector<ModelConfigEntry> > modelConfig ;
+static std::set<std::string> modelConfigFiles ;
+
+static const ModelConfigEntry* FindModelConfig(const std::string & model, const std::string & parameter, const std::string & wtagger_label, const std::string & label){
+  std::map<std::string,std::vector<ModelConfigEntry> >::const_iterator it = modelConfig.find(model+" "+parameter);
+  if(it == modelConfig.end()) return NULL ;
+  // the last matching entry wins, as in the if cascades the entries come from
+  const ModelConfigEntry* found = NULL ;
+  for(std::vector<ModelConfigEntry>::const_iterator entry = it->second.begin(); entry != it->second.end(); ++entry){
+    Bool_t match = kTRUE ;
+    for(std::vector<std::string>::const_iterator token = entry->tokens.begin(); token != entry->tokens.end() and match; ++token){
+      Bool_t negated = ((*token)[0] == '!');
+      std::string text = negated ? token->substr(1) : *token ;
+      Bool_t found_text = (wtagger_label.find(text) != std::string::npos or label.find(text) != std::string::npos);
+      match = (found_text != negated);
+    }
+    if(match) found = &(*entry) ;
+  }
+  return found ;
+}
+
+Int_t LoadModelConfig(const std::string & fileName){
+  if(modelConfigFiles.count(fileName)) return 0 ;
+  std::ifstream file(fileName.c_str());
+  if(!file){
+    std::cout<< "LoadModelConfig: cannot open "<< fileName << std::endl;
+    return -1 ;
+  }
+
+  Int_t nEntries = 0, nLine = 0 ;
+  std::string line ;
+  while(std::getline(file,line)){
+    nLine++ ;
+    if(line.find('#') != std::string::npos) line.erase(line.find('#'));
+    std::istringstream fields(line);
+    std::string model, parameter, selection, value, min, max, option ;
+    if(!(fields >> model)) continue ;
+    if(!(fields >> parameter >> selection >> value >> min >> max)){
+      std::cout<< "LoadModelConfig: "<< fileName << ":"<< nLine << " needs model parameter selection value min max [sigma] [const|float]" << std::endl;
+      continue ;
+    }
+    ModelConfigEntry entry ;
+    if(selection != "*"){
+      TString tokens(selection.c_str());
+      TObjArray* list = tokens.Tokenize(",");
+      for(Int_t i = 0; i < list->GetEntries(); i++) entry.tokens.push_back(list->At(i)->GetName());
+      delete list ;
+    }
+    entry.value    = TString(value.c_str()).Atof();
+    entry.hasRange = (min != "-" and max != "-");
+    entry.min      = entry.hasRange ? TString(min.c_str()).Atof() : 0. ;
+    entry.max      = entry.hasRange ? TString(max.c_str()).Atof() : 0. ;
+    entry.sigma    = 0. ;
+    entry.constant = -1 ;
+    while(fields >> option){
+      if(option == "const") entry.constant = 1 ;
+      else if(option == "float") entry.constant = 0 ;
+      else entry.sigma = TString(option.c_str()).Atof();
+    }
+    modelConfig[model+" "+parameter].push_back(entry);
+    nEntries++ ;
+  }
+  modelConfigFiles.insert(fileName);
+  std::cout<< "LoadModelConfig: "<< nEntries << " entries from "<< fileName << std::endl;
+  return nEntries ;
+}
+
+void ClearModelConfig(){
+  modelConfig.clear();
+  modelConfigFiles.clear();
+}
+
+static void SetConfigValue(RooRealVar* var, const ModelConfigEntry* entry){
+  if(!var) return ;
+  if(entry->hasRange) var->setRange(entry->min,entry->max);
+  var->setVal(entry->value);
+  if(entry->constant >= 0) var->setConstant(entry->constant == 1);
+}
+
+Int_t ApplyModelConfig(RooWorkspace* workspace, const std::string & model, const std::string & wtagger_label, const std::string & label, const RooArgSet & params, const std::string & suffix, std::vector<std::string>* constraint){
+  if(modelConfig.empty()){
+    static Bool_t warned = kFALSE ;
+    if(!warned) std::cout<< "ApplyModelConfig: no model config loaded (PDFs/config/N2DDT.txt), the models keep the defaults of their builders" << std::endl;
+    warned = kTRUE ;
+    return 0 ;
+  }
+
+  Int_t nApplied = 0 ;
+  TIterator* par = params.createIterator();
+  for(RooAbsArg* arg = (RooAbsArg*)par->Next(); arg; arg = (RooAbsArg*)par->Next()){
+    RooRealVar* var = dynamic_cast<RooRealVar*>(arg);
+    std::string name = arg->GetName();
+    if(!var or name.size() <= suffix.size() or name.compare(name.size()-suffix.size(),suffix.size(),suffix) != 0) continue ;
+    const ModelConfigEntry* entry = FindModelConfig(model,name.substr(0,name.size()-suffix.size()),wtagger_label,label);
+    if(!entry) continue ;
+
+    SetConfigValue(var,entry);
+    // copies already imported with a constraint pdf
+    if(workspace and workspace->var(name.c_str()) != var) SetConfigValue(workspace->var(name.c_str()),entry);
+
+    if(entry->sigma > 0){
+      if(workspace and workspace->var((name+"_mean").c_str())){
+        workspace->var((name+"_mean").c_str())->setVal(entry->value);
+        workspace->var((name+"_sigma").c_str())->setVal(entry->sigma);
+      }
+      else if(workspace and constraint){
+        RooGaussian* gaus = addConstraint(var,entry->value,entry->sigma,constraint);
+        workspace->import(*gaus);
+      }
+    }
+    nApplied++ ;
+  }
+  delete par ;
+  return nApplied ;
+}
+
+////// Model cache: models built in this job, keyed by workspace, model name and how they were built, with the
+////// state of their parameters when built and the constraints they added
+struct CachedModel {
+  RooAbsPdf* model ;
+  RooArgSet* initial ;
+  std::vector<std::string> constraints ;
+};
+
+static std::map<std::string,CachedModel> modelCache ;
+
+static RooRealVar* SpectrumVar(RooWorkspace* workspace, const std::string & spectrum){
+  if(TString(spectrum).Contains("_mlvj")) return workspace->var("rrv_mass_lvj");
+  return workspace->var("rrv_mass_j");
+}
+
+static std::string ModelCacheKey(RooWorkspace* workspace, const std::string & name, const std::string & model, const std::string & wtagger_label, Int_t ismc){
+  return std::string(workspace->uuid().AsString())+" "+name+" "+model+" "+wtagger_label+Form(" %d",ismc);
+}
+
+/// Puts each RooRealVar of params back to its copy in initial: value, errors, range and constant flag (the get_*_Model
+/// helpers fix the parameters of a model after its fit, a value only reset would hand back a constant model)
+static void RestoreParameters(RooArgSet* params, const RooArgSet & initial){
+  TIterator* iter = params->createIterator();
+  for(RooAbsArg* arg = (RooAbsArg*) iter->Next(); arg; arg = (RooAbsArg*) iter->Next()){
+    RooRealVar* var = dynamic_cast<RooRealVar*>(arg);
+    const RooRealVar* saved = dynamic_cast<const RooRealVar*>(initial.find(arg->GetName()));
+    if(!var or !saved) continue;
+    var->setRange(saved->getMin(),saved->getMax());
+    var->setVal(saved->getVal());
+    var->setError(saved->getError());
+    if(saved->hasAsymError()) var->setAsymError(saved->getErrorLo(),saved->getErrorHi());
+    else var->removeAsymError();
+    var->setConstant(saved->isConstant());
+  }
+  delete iter ;
+}
+
+/// The cached model (its workspace copy once imported) with its parameters back in their initial state, NULL if key
+/// was not built yet
+static RooAbsPdf* FindCachedModel(RooWorkspace* workspace, const std::string & key, const std::string & spectrum, std::vector<std::string>* constraint){
+  std::map<std::string,CachedModel>::iterator it = modelCache.find(key);
+  if(it == modelCache.end()) return NULL ;
+
+  RooAbsPdf* model = workspace->pdf(it->second.model->GetName());
+  if(!model) model = it->second.model ;
+  RooArgSet* params = model->getParameters(*SpectrumVar(workspace,spectrum));
+  RestoreParameters(params,*it->second.initial);
+  delete params ;
+
+  for(std::vector<std::string>::const_iterator name = it->second.constraints.begin(); name != it->second.constraints.end(); ++name){
+    if(constraint and std::find(constraint->begin(),constraint->end(),*name) == constraint->end()) constraint->push_back(*name);
+  }
+  std::cout<< "## Reusing model "<< model->GetName() << " ##" << std::endl;
+  return model ;
+}
+
+static void CacheModel(RooWorkspace* workspace, const std::string & key, const std::string & spectrum, RooAbsPdf* model, std::vector<std::string>* constraint, size_t nConstraints){
+  CachedModel cached ;
+  cached.model = model ;
+  RooArgSet* params = model->getParameters(*SpectrumVar(workspace,spectrum));
+  cached.initial = (RooArgSet*) params->snapshot(kFALSE);
+  delete params ;
+  if(constraint) cached.constraints.assign(constraint->begin()+nConstraints,constraint->end());
+  modelCache[key] = cached ;
+}
+
+void ClearModelCache(){
+  for(std::map<std::string,CachedModel>::iterator it = modelCache.begin(); it != modelCache.end(); ++it) delete it->second.initial ;
+  modelCache.clear();
+}
+
+#endif
 
 ////////////////////////////////////////////
 RooExtendPdf* MakeExtendedModel(RooWorkspace* workspace, const std::string & label, const std::string & model, const std::string & spectrum, const std::string & channel, const std::string & wtagger_label, std::vector<std::string>* constraint, const int & ismc_wjet, const int & area_init_value){
@@ -9,6 +251,11 @@ RooExtendPdf* MakeExtendedModel(RooWorkspace* workspace, const std::string & lab
   std::cout<<""<<std::endl;
   std::cout<<" "<<std::endl;
 
+  std::string key = ModelCacheKey(workspace,"model"+label+"_"+channel+spectrum,model,wtagger_label,ismc_wjet);
+  RooExtendPdf* cached = dynamic_cast<RooExtendPdf*>(FindCachedModel(workspace,key,spectrum,constraint));
+  if(cached) return cached ;
+  size_t nConstraints = constraint ? constraint->size() : 0 ;
+
   RooRealVar* rrv_number = new  RooRealVar(("rrv_number"+label+"_"+channel+spectrum).c_str(),("rrv_number"+label+"_"+channel+spectrum).c_str(),500.,0.,1e5);
 //  if (TString(label).Contains("_bkg_data") and not TString(label).Contains("failN2DDTcut")){
 //    rrv_number = new  RooRealVar(("rrv_number"+label+"_"+channel+spectrum).c_str(),("rrv_number"+label+"_"+channel+spectrum).c_str(),500.,0.,1.25e3);
@@ -23,6 +270,7 @@ RooExtendPdf* MakeExtendedModel(RooWorkspace* workspace, const std::string & lab
   RooExtendPdf* model_extended = new RooExtendPdf(("model"+label+"_"+channel+spectrum).c_str(),("model"+label+"_"+channel+spectrum).c_str(),*model_pdf, *rrv_number);
   std::cout<< "######## Model Extended Pdf ########"<<std::endl;
   // model_extended->Print();
+  CacheModel(workspace,key,spectrum,model_extended,constraint,nConstraints);
   // return the total extended pdf
   return model_extended;
 }
@@ -53,34 +301,36 @@ RooAbsPdf* MakeModelTTbarControlSample(RooWorkspace* workspace ,const std::strin
   std::cout<<""<<std::endl;
   std::cout<<" "<<std::endl;
 
+  std::string key = ModelCacheKey(workspace,"model"+label+"_"+channel+spectrum+" "+information,modelName,wtagger,0);
+  RooAbsPdf* cached = FindCachedModel(workspace,key,spectrum,constraint);
+  if(cached) return cached ;
+  size_t nConstraints = constraint ? constraint->size() : 0 ;
+
   RooRealVar* rrv_number_total = NULL , *eff_ttbar = NULL ; 
   RooFormulaVar *rrv_number = NULL ;
 
-  if(TString(label).Contains("_ttbar_data") and not TString(label).Contains("failN2DDTcut")){
-    rrv_number_total = new RooRealVar(("rrv_number_total_ttbar_data"+information+"_"+channel+spectrum).c_str(),("rrv_number_total_ttbar_data"+information+"_"+channel+spectrum).c_str(),500,0.,1e7);
-    // eff_ttbar        = new RooRealVar(("eff_ttbar_data"+information+"_"+channel+spectrum).c_str(),("eff_ttbar_data"+information+"_"+channel+spectrum).c_str(),0.7,0.3,0.99);
-//    eff_ttbar        = new RooRealVar(("eff_ttbar_data"+information+"_"+channel+spectrum).c_str(),("eff_ttbar_data"+information+"_"+channel+spectrum).c_str(),0.7,0.0,0.99);
-    eff_ttbar        = new RooRealVar(("eff_ttbar_data"+information+"_"+channel+spectrum).c_str(),("eff_ttbar_data"+information+"_"+channel+spectrum).c_str(),0.7,0.,1.);
-    rrv_number       = new RooFormulaVar(("rrv_number"+label+"_"+channel+spectrum+spectrum).c_str(), "@0*@1", RooArgList(*rrv_number_total,*eff_ttbar));
-  }
+  // one total yield and efficiency per sample, built with the pass model and shared by the fail one
+  std::string sample ;
+  if(TString(label).Contains("_ttbar_data")) sample = "data" ;
+  else if(TString(label).Contains("_ttbar_TotalMC")) sample = "TotalMC" ;
+  std::string total_name = "rrv_number_total_ttbar_"+sample+information+"_"+channel+spectrum ;
+  std::string eff_name   = "eff_ttbar_"+sample+information+"_"+channel+spectrum ;
 
-  else if(TString(label).Contains("_ttbar_data") and TString(label).Contains("failN2DDTcut")){
-    rrv_number_total = workspace->var(("rrv_number_total_ttbar_data"+information+"_"+channel+spectrum).c_str());
-    eff_ttbar        = workspace->var(("eff_ttbar_data"+information+"_"+channel+spectrum).c_str());
-    rrv_number       = new RooFormulaVar(("rrv_number"+label+"_"+channel+spectrum+spectrum).c_str(), "(1-@0)*@1", RooArgList(*eff_ttbar,*rrv_number_total));
-  }
-  else if(TString(label).Contains("_ttbar_TotalMC") and not TString(label).Contains("failN2DDTcut")){
-    rrv_number_total = new RooRealVar(("rrv_number_total_ttbar_TotalMC"+information+"_"+channel+spectrum).c_str(),("rrv_number_total_ttbar_TotalMC"+information+"_"+channel+spectrum).c_str(),500,0.,1e7);
-    // eff_ttbar        = new RooRealVar(("eff_ttbar_TotalMC"+information+"_"+channel+spectrum).c_str(),("eff_ttbar_TotalMC"+information+"_"+channel+spectrum).c_str(),0.7,0.3,0.99);
-    eff_ttbar        = new RooRealVar(("eff_ttbar_TotalMC"+information+"_"+channel+spectrum).c_str(),("eff_ttbar_TotalMC"+information+"_"+channel+spectrum).c_str(),0.7,0.,1.);
+  if(sample != "" and not TString(label).Contains("failN2DDTcut")){
+    rrv_number_total = new RooRealVar(total_name.c_str(),total_name.c_str(),500,0.,1e7);
+    eff_ttbar        = new RooRealVar(eff_name.c_str(),eff_name.c_str(),0.7,0.,1.);
     rrv_number       = new RooFormulaVar(("rrv_number"+label+"_"+channel+spectrum+spectrum).c_str(), "@0*@1", RooArgList(*eff_ttbar,*rrv_number_total));
   }
-  else if(TString(label).Contains("_ttbar_TotalMC") and TString(label).Contains("failN2DDTcut")){
-    rrv_number_total = workspace->var(("rrv_number_total_ttbar_TotalMC"+information+"_"+channel+spectrum).c_str());
-    eff_ttbar        = workspace->var(("eff_ttbar_TotalMC"+information+"_"+channel+spectrum).c_str());
-    rrv_number       = new RooFormulaVar(("rrv_number"+label+"_"+channel+spectrum+spectrum).c_str(), "(1-@0)*@1", RooArgList(*eff_ttbar,*rrv_number_total)) ;
+  else if(sample != ""){
+    rrv_number_total = workspace->var(total_name.c_str());
+    eff_ttbar        = workspace->var(eff_name.c_str());
+    rrv_number       = new RooFormulaVar(("rrv_number"+label+"_"+channel+spectrum+spectrum).c_str(), "(1-@0)*@1", RooArgList(*eff_ttbar,*rrv_number_total));
   }
 
+  if(rrv_number_total and eff_ttbar){
+    RooArgSet yields(*rrv_number_total,*eff_ttbar);
+    ApplyModelConfig(workspace,modelName,wtagger,label,yields,information+"_"+channel+spectrum,constraint);
+  }
 
   RooAbsPdf* model_pdf = MakeGeneralPdf(workspace,label,modelName,spectrum,wtagger,channel,constraint,false);
 
@@ -88,17 +338,36 @@ RooAbsPdf* MakeModelTTbarControlSample(RooWorkspace* workspace ,const std::strin
 
   workspace->import(*model);
   workspace->pdf(("model"+label+"_"+channel+spectrum).c_str())->Print();
+  CacheModel(workspace,key,spectrum,workspace->pdf(("model"+label+"_"+channel+spectrum).c_str()),constraint,nConstraints);
   return workspace->pdf(("model"+label+"_"+channel+spectrum).c_str());
 
 }
 
 
 //## change a dataset to a histpdf roofit object
+static Bool_t SameBinning(const RooDataHist & datahist, RooRealVar* x){
+  const RooRealVar* binned = dynamic_cast<const RooRealVar*>(datahist.get()->find(x->GetName()));
+  return binned and binned->getBins() == x->getBins() and binned->getMin() == x->getMin() and binned->getMax() == x->getMax() ;
+}
+
 void change_dataset_to_histpdf(RooWorkspace* workspace,RooRealVar* x,RooDataSet* dataset){
  
-  std::cout<<"######## change the dataset into a histpdf  ########"<<std::endl;
-  RooDataHist* datahist = dataset->binnedClone((std::string(dataset->GetName())+"_binnedClone").c_str(),(std::string(dataset->GetName())+"_binnedClone").c_str());
-  RooHistPdf* histpdf = new RooHistPdf((std::string(dataset->GetName())+"_histpdf").c_str(),(std::string(dataset->GetName())+"_histpdf").c_str(),RooArgSet(*x),*datahist);
+  std::string name = std::string(dataset->GetName())+"_histpdf" ;
+  // built once per dataset and binning
+  RooHistPdf* cached = dynamic_cast<RooHistPdf*>(workspace->pdf(name.c_str()));
+  if(cached){
+    if(!SameBinning(cached->dataHist(),x)) std::cout<< "######## "<< name << " already exists with a different binning, kept ########"<<std::endl;
+    return ;
+  }
+
+  // template filled in the tree loop (get_mj_dataset), otherwise binned from the dataset
+  RooDataHist* datahist = dynamic_cast<RooDataHist*>(workspace->data((std::string(dataset->GetName())+"_template").c_str()));
+  if(datahist and SameBinning(*datahist,x)) std::cout<<"######## histpdf from the template of "<< dataset->GetName() << " ########"<<std::endl;
+  else {
+    std::cout<<"######## change the dataset into a histpdf  ########"<<std::endl;
+    datahist = dataset->binnedClone((std::string(dataset->GetName())+"_binnedClone").c_str(),(std::string(dataset->GetName())+"_binnedClone").c_str());
+  }
+  RooHistPdf* histpdf = new RooHistPdf(name.c_str(),name.c_str(),RooArgSet(*x),*datahist);
   workspace->import(*histpdf);
 }
   
@@ -345,1522 +614,498 @@ void ShowParam_Pdf(RooAbsPdf* model_pdf, RooArgSet* argset_notparameter){
 }
 
 ///////////////////////////////////////////////
-RooAbsPdf* MakeGeneralPdf(RooWorkspace* workspace, const std::string & label, const std::string & model, const std::string & spectrum, const std::string & wtagger_label, const std::string & channel, std::vector<std::string>* constraint, const int & ismc){
-  
-  std::cout<< "Making general PDF for wtagger_label = "<<wtagger_label.c_str() << " model = "<< model.c_str() << " label = "<< label.c_str()<< " ismc = "<< ismc << " channel = "<< channel.c_str()<< std::endl;
-
-  RooRealVar* rrv_x = NULL ; 
-  if(TString(spectrum).Contains("_mj"))   rrv_x = workspace->var("rrv_mass_j");
-  if(TString(spectrum).Contains("_mlvj")) rrv_x = workspace->var("rrv_mass_lvj");  
-  
-  
-  // Fits for data and MC (not matched tt)
-  if( !(TString(label).Contains("realW")) and !(TString(label).Contains("fakeW")) ){
+#if !defined(__CINT__) && !defined(__MAKECINT__)
 
-    if( model == "Exp"){
-      double c0_tmp_err = 1.46e-02;
-      std::cout<< "######### Exp = levelled exp funtion for W+jets mlvj ############" <<std::endl;
-      RooRealVar* rrv_c_Exp = new RooRealVar(("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),-0.030, -2., 0.05);
-      RooExponential* model_pdf = new RooExponential(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_Exp);
+typedef RooAbsPdf* (*GeneralPdfBuilder)(RooWorkspace* workspace, const std::string & label, const std::string & model, const std::string & spectrum, const std::string & wtagger_label, const std::string & channel, std::vector<std::string>* constraint, const int & ismc, RooRealVar* rrv_x);
 
-// >500 pT, 26% N2DDT Transformation
-      RooGaussian* gaus1 = addConstraint(rrv_c_Exp,rrv_c_Exp->getVal(),c0_tmp_err,constraint);
-      workspace->import(*gaus1);
+////// The builders set one default per parameter: the working point and sample dependent values are entries of the
+////// model config (PDFs/config/N2DDT.txt) that MakeGeneralPdf applies on top of them
 
-      return model_pdf ;
-    }
-    
-    if( model == "Gaus"){
+////// Fits for data and MC (not matched tt)
 
-      RooRealVar* rrv_mean1_gaus   = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),80,40,100);
-      RooRealVar* rrv_sigma1_gaus  = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),7,0.,15);  
-      RooGaussian* model_pdf       = new RooGaussian(("gaus"+label+"_"+channel+spectrum).c_str(),("gaus"+label+"_"+channel+spectrum).c_str(), *rrv_x,*rrv_mean1_gaus,*rrv_sigma1_gaus);
-
-      return model_pdf ;
-    }
-    
-
-    if( model == "ErfExp" ){
-      std::cout<< "########### Erf*Exp for mj fit  ############"<<std::endl;
-      RooRealVar* rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.026);//,-0.05, 0.05);
-      RooRealVar* rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),41.,0.,100);
-      RooRealVar* rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),30.,1.,100.);
-      
-      if(!TString(wtagger_label.c_str()).Contains("0v60")){
-      if(TString(label).Contains("_WJets0") ) {
-        rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.0279,-0.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),70.,60.,75.);
-        rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),23.8,20.,30.);
-
-        if(TString(label).Contains("fail") ) {
-          rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.0294,-0.05,0.05);
-          rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),39.,30.,50.);
-          rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),22.5,10.,30.);
-        }
-        if(TString(wtagger_label.c_str()).Contains("Puppi")){
-          
-          rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.0279,-0.5,0.);
-          rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),70.,10.,75.);
-          rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),23.8,20.,80.);
-
-/*          rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.0279,-0.5,0.);
-          rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),40.,10.,500.);
-          rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),23.8,10.,100.);*/
-        
-          if(TString(label).Contains("fail") ) {
-            rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.0279,-0.5,0.);
-/*            rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),70.,10.,1000.);
-            rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),80,20.,500.);*/
-            rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),70.,10.,75.);
-            rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),23.8,20.,80.);
-          }
-        }
-      }
-    }
-
-      RooErfExpPdf* model_pdf       = new RooErfExpPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_ErfExp,*rrv_offset_ErfExp,*rrv_width_ErfExp);
-      return model_pdf ;
-    }
-
-    if( model == "ExpGaus_sp"){
-
-      RooRealVar* rrv_c_Exp       = new RooRealVar(("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),-0.05,-0.5,0.5);
-      RooRealVar* rrv_mean1_gaus  = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),84,70,90);
-      RooRealVar* rrv_sigma1_gaus = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),7,4,40);
-      RooRealVar* rrv_high        = new RooRealVar(("rrv_high"+label+"_"+channel+spectrum).c_str(),("rrv_high"+label+"_"+channel+spectrum).c_str(),0.5,0.,1.);
-      RooRealVar* rrv_frac = new RooRealVar(("rrv_frac"+label+"_"+channel+spectrum).c_str(),("rrv_frac"+label+"_"+channel+spectrum).c_str(),1);
-
-      if( TString(label).Contains("_STop_failN2DDTcut" ) ) {
-        rrv_c_Exp       = new RooRealVar(("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),-0.03,-0.5,0.5);
-        rrv_mean1_gaus  = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),84,60,120); //Too narrow limits here often lead to error!! eg max 80
-
-        rrv_sigma1_gaus = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),7,4,60);
-
-        if(TString(wtagger_label.c_str()).Contains("Puppi")){
-          rrv_c_Exp       = new RooRealVar(("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),-1.7882e-02,-1.,0.);
-          rrv_mean1_gaus  = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),8.4346e+01 ,75,89);
-          rrv_sigma1_gaus = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),1.1533e+01,4,12);
-          rrv_high        = new RooRealVar(("rrv_high"+label+"_"+channel+spectrum).c_str(),("rrv_high"+label+"_"+channel+spectrum).c_str(),7.3428e-01,0.,1.);
-
-// >450 pT, 26% N2DDT Transformation -- NOPE
-          if(TString(wtagger_label.c_str()).Contains("0v00")){
-            rrv_c_Exp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.07,-0.5,0.);
-            rrv_mean1_gaus  = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),8.4346e+01 ,75,89);
-            rrv_sigma1_gaus = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),8.,4,20);
-          }
-
-        }
-      }
-
-      RooExponential* exp         = new RooExponential(("exp"+label+"_"+channel+spectrum).c_str(),("exp"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_Exp);
-      RooGaussian* gaus           = new RooGaussian(("gaus"+label+"_"+channel+spectrum).c_str(),("gaus"+label+"_"+channel+spectrum).c_str(), *rrv_x,*rrv_mean1_gaus,*rrv_sigma1_gaus);
-      RooAddPdf* model_pdf  = new RooAddPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),RooArgList(*exp,*gaus),RooArgList(*rrv_high));
-
-      return model_pdf ;
-
-    }
-
-    if( model == "ExpGaus"){
-
-      RooRealVar* rrv_c_Exp       = new RooRealVar(("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),-0.05,-0.5,0.5);
-      RooRealVar* rrv_mean1_gaus  = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),84,70,90);
-      RooRealVar* rrv_sigma1_gaus = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),7,4,40);
-      RooRealVar* rrv_high        = new RooRealVar(("rrv_high"+label+"_"+channel+spectrum).c_str(),("rrv_high"+label+"_"+channel+spectrum).c_str(),0.,0.,1.);
-      RooRealVar* rrv_frac = new RooRealVar(("rrv_frac"+label+"_"+channel+spectrum).c_str(),("rrv_frac"+label+"_"+channel+spectrum).c_str(),1);
-
-
-      if( TString(label).Contains("_STop_failN2DDTcut" ) ) {
-        rrv_c_Exp       = new RooRealVar(("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),-0.03,-0.5,0.5);
-        rrv_mean1_gaus  = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),84,60,120); //Too narrow limits here often lead to error!! eg max 80
-        rrv_sigma1_gaus = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),7,4,60);
-        
-        if(TString(wtagger_label.c_str()).Contains("Puppi")){
-          rrv_c_Exp       = new RooRealVar(("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),-1.7882e-02,-1.,0.);
-          rrv_mean1_gaus  = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),8.4346e+01 ,75,89); 
-          rrv_sigma1_gaus = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),1.1533e+01,4,12);
-          rrv_high        = new RooRealVar(("rrv_high"+label+"_"+channel+spectrum).c_str(),("rrv_high"+label+"_"+channel+spectrum).c_str(),7.3428e-01,0.,1.);
-
-// >450 pT, 26% N2DDT Transformation -- NOPE
-          if(TString(wtagger_label.c_str()).Contains("0v00")){
-            rrv_c_Exp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.07,-0.5,0.);
-            rrv_mean1_gaus  = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),8.4346e+01 ,75,89);
-	    rrv_sigma1_gaus = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),8.,4,20);
-          }
-
-        }
-
-        if(TString(wtagger_label.c_str()).Contains("_DDT")){
-          rrv_c_Exp       = new RooRealVar(("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),8.9813e-03);//,-5.,5.);
-          rrv_mean1_gaus  = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),84,75,89); 
-          rrv_sigma1_gaus = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),7,4,12);
-        }
-        
-      }
-      if( TString(label).Contains("_VV") ) {
-        rrv_c_Exp       = new RooRealVar(("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),-0.005,-0.2,0.2);
-        rrv_mean1_gaus  = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),90,0.,150.);
-        rrv_sigma1_gaus = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),7,4.,50.);
-        
-        if(TString(wtagger_label.c_str()).Contains("0v60")){
-          rrv_c_Exp       = new RooRealVar(("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),-1.7882e-02,-1.,0.);
-          rrv_mean1_gaus  = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),8.4346e+01 ,75,89); 
-          rrv_sigma1_gaus = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),1.1533e+01,4,12);
-          rrv_high        = new RooRealVar(("rrv_high"+label+"_"+channel+spectrum).c_str(),("rrv_high"+label+"_"+channel+spectrum).c_str(),7.3428e-01,0.,1.);
-        }
-        
-        if(TString(wtagger_label.c_str()).Contains("_DDT")){
-          rrv_c_Exp       = new RooRealVar(("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),-0.05,-0.5,0.5);
-          rrv_mean1_gaus  = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),80,70.,95.);
-          rrv_sigma1_gaus = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),7,4.,12.);   
-        }
-        if(TString(wtagger_label.c_str()).Contains("Puppi")){
-          rrv_c_Exp       = new RooRealVar(("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),-0.05,-0.5,0.5);
-          rrv_mean1_gaus  = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),80,70.,95.);
-          rrv_sigma1_gaus = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),7,6.,200.);
-          rrv_high        = new RooRealVar(("rrv_high"+label+"_"+channel+spectrum).c_str(),("rrv_high"+label+"_"+channel+spectrum).c_str(),0.,0.0,1.);
-          
-          if( TString(label).Contains("fail") ) {
-//            rrv_c_Exp       = new RooRealVar(("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),-0.05,-0.5,0.5);
-            rrv_c_Exp       = new RooRealVar(("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),-0.05,-0.5,0.5);
-            rrv_mean1_gaus  = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),80,70.,95.);
-//            rrv_sigma1_gaus = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),7,6.,20.);
-            rrv_sigma1_gaus = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),7,6.,20.);
-            rrv_high        = new RooRealVar(("rrv_high"+label+"_"+channel+spectrum).c_str(),("rrv_high"+label+"_"+channel+spectrum).c_str(),0.,0.,1.);
-          }
-        }
-        
-      }
-
-//      if(TString(wtagger_label.c_str()).Contains("0v80")){
-	rrv_c_Exp     ->setConstant(kTRUE);
-//      }
-
-      RooExponential* exp         = new RooExponential(("exp"+label+"_"+channel+spectrum).c_str(),("exp"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_Exp);
-      RooGaussian* gaus1           = new RooGaussian(("gaus1"+label+"_"+channel+spectrum).c_str(),("gaus1"+label+"_"+channel+spectrum).c_str(), *rrv_x,*rrv_mean1_gaus,*rrv_sigma1_gaus);
-      RooAddPdf* model_pdf  = new RooAddPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),RooArgList(*gaus1,*exp),RooArgList(*rrv_frac),1);
-//      RooAddPdf* model_pdf  = new RooAddPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),RooArgList(*gaus1,*exp),RooArgList(*rrv_high));      
-      return model_pdf ;
-    }
-
-    if( model == "ErfExpGaus_sp"){
-
-//      RooRealVar* rrv_c_ErfExp    = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.2,-1,1.);
-      RooRealVar* rrv_c_ErfExp    = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-0.2,0.);
-      RooRealVar* rrv_width_ErfExp= new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),30.,10.,300.);
-      RooRealVar* rrv_mean1_gaus   = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),80,40,100);
-      RooRealVar* rrv_sigma1_gaus  = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),7,0.,40);
-      if(TString(label).Contains("_failN2DDTcut")){
-        rrv_c_ErfExp    = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-0.08,0.);
-        rrv_width_ErfExp= new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),150.,50.,1000.);
-        rrv_mean1_gaus   = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),80,40,100);
-        rrv_sigma1_gaus  = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),7,0.,40.);
-
-// 300-400 pT, 26% N2DDT Transformation
-/*	if(TString(wtagger_label.c_str()).Contains("0v00")){
-	  rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.07,-0.5,0.);
-	  rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),50.,10.,1000.);
-          rrv_mean1_gaus   = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),100.,60.,100.);  
-          rrv_sigma1_gaus  = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),7,0.,40.);
-	}*/
+static RooAbsPdf* MakeGeneralPdf_Exp(RooWorkspace* workspace, const std::string & label, const std::string & model, const std::string & spectrum, const std::string & wtagger_label, const std::string & channel, std::vector<std::string>* constraint, const int & ismc, RooRealVar* rrv_x){
+  double c0_tmp_err = 1.46e-02;
+  std::cout<< "######### Exp = levelled exp funtion for W+jets mlvj ############" <<std::endl;
+  RooRealVar* rrv_c_Exp = new RooRealVar(("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),-0.030, -2., 0.05);
+  RooExponential* model_pdf = new RooExponential(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_Exp);
 
 // >500 pT, 26% N2DDT Transformation
-/*        if(TString(wtagger_label.c_str()).Contains("0v00")){
-          rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.07,-0.5,0.5);
-          rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),70.,10.,1000.);
-          rrv_mean1_gaus   = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),75.,60.,100.);
-          rrv_sigma1_gaus  = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),12,0.,40.);
-        }*/
-
-// >450 pT, 26% N2DDT Transformation
-        if(TString(wtagger_label.c_str()).Contains("0v00")){
-          rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.07,-0.5,0.5);
-          rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),70.,10.,10000.);
-          rrv_mean1_gaus   = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),75.,60.,100.);
-          rrv_sigma1_gaus  = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),12,0.,40.);
-        }
-
-
-      }
-
-      if(TString(wtagger_label.c_str()).Contains("_DDT")){
-        rrv_c_ErfExp    = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-4.0352e-02);//,-.,0.);
-        rrv_width_ErfExp= new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),30.,10,80.);
-        rrv_mean1_gaus   = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),80,75,90);
-        rrv_sigma1_gaus  = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),7,5.,11);
-        
-        if( TString(label).Contains("_VV") ) {
-          rrv_c_ErfExp    = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-4.0352e-02,-0.09,0.);
-          rrv_width_ErfExp= new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),30.,10,80.);
-          rrv_mean1_gaus   = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),84,75,87);
-          rrv_sigma1_gaus  = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),7,5.,9.);
-
-        }
-      }
-
-
-      RooErfExpPdf* erfExp        = new RooErfExpPdf(("erfExp"+label+"_"+channel+spectrum).c_str(),("erfExp"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_ErfExp,*rrv_mean1_gaus,*rrv_width_ErfExp);
-      RooGaussian* gaus            = new RooGaussian(("gaus"+label+"_"+channel+spectrum).c_str(),("gaus"+label+"_"+channel+spectrum).c_str(), *rrv_x,*rrv_mean1_gaus,*rrv_sigma1_gaus);
-
-      RooRealVar* rrv_high  = new RooRealVar(("rrv_high"+label+"_"+channel+spectrum).c_str(),("rrv_high"+label+"_"+channel+spectrum).c_str(),0.5,0.,1.);
-      if( TString(label).Contains("_VV") )rrv_high  = new RooRealVar(("rrv_high"+label+"_"+channel+spectrum).c_str(),("rrv_high"+label+"_"+channel+spectrum).c_str(),0.8,0.5,1.);
-      RooAddPdf* model_pdf  = new RooAddPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),RooArgList(*erfExp,*gaus),RooArgList(*rrv_high));
-
-      return model_pdf ;
-    }
-
-    if( model == "GausErfExp_ttbar"){
-
-      double mean1_tmp = 8.2653e+01;
-      double sigma1_tmp = 7.5932e+00;
-      float rangeMean = 6. ;
-      float rangeWidth = 5. ;
-      double frac_tmp = 1.0;
-      double c0_tmp     = -2.7180e-02 ;      //double c0_tmp_err     = 6.83e-03;
-      double offset_tmp =  8.6888e+01 ;      //double offset_tmp_err = 9.35e+00;
-      double width_tmp  =  2.9860e+01 ;      //double width_tmp_err  = 2.97e+00;  
-      
-      if(TString(wtagger_label.c_str()).Contains("0v60")){
-        mean1_tmp = 8.2402e+01;   
-        sigma1_tmp = 7.5645e+00;            
-        rangeMean = 6. ;
-        rangeWidth = 5. ;
-        c0_tmp     = -4.2672e-02 ;
-        offset_tmp =  8.5656e+01 ;
-        width_tmp  =  2.5308e+01  ;
-      }
-      if( TString(wtagger_label.c_str()).Contains("PuppiSD") ){
-        mean1_tmp = 8.0857e+01;
-        sigma1_tmp = 8.4035e+00;
-        rangeMean = 5. ;
-        rangeWidth = 5. ;
-        c0_tmp     = -2.1046e-02  ;
-        offset_tmp =  8.0122e+01 ;
-        width_tmp  =  2.9595e+01 ;
-          
-        if(TString(wtagger_label.c_str()).Contains("0v56")){
-          mean1_tmp = 8.2402e+01;
-          sigma1_tmp = 7.5645e+00;
-          rangeMean = 6. ;
-          rangeWidth = 5. ;
-          c0_tmp     = -4.2672e-02 ;
-          offset_tmp =  8.5656e+01 ;
-          width_tmp  =  2.5308e+01  ;
-        }
-      }
-      
-      if(TString(wtagger_label.c_str()).Contains("_DDT")){
-        
-        if(TString(wtagger_label.c_str()).Contains("0v38")){
-          mean1_tmp = 8.6000e+01;
-          sigma1_tmp = 7.2154e+00;
-          c0_tmp     = -1.7193e-01 ;
-          offset_tmp =  1.1819e+02 ;
-          width_tmp  =   2.3273e+01  ;
-        }
-        
-        if(TString(wtagger_label.c_str()).Contains("0v52")){
-          mean1_tmp = 86.;   
-          sigma1_tmp = 1.0008e+01 ;            
-          rangeMean = 6. ;
-          rangeWidth = 5. ;
-          c0_tmp     = -1.7193e-01 ;
-          offset_tmp =  1.1819e+02 ;
-          width_tmp  =  2.3273e+01  ;
-        }
-        if(TString(wtagger_label.c_str()).Contains("0v44")){
-          mean1_tmp = 8.6138e+01 ;   
-          sigma1_tmp = 9.9019e+00 ;            
-          rangeMean = 6. ;
-          rangeWidth = 5. ;
-          c0_tmp     = -1.2532e-01 ;
-          offset_tmp =  1.1819e+02  ;
-          width_tmp  =  2.3299e+00  ;
-          // frac_tmp = 9.9757e-01
-        }
-      }
-
-      RooRealVar* rrv_mean1_gaus  = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),mean1_tmp, mean1_tmp-rangeMean, mean1_tmp+rangeMean);
-      RooRealVar* rrv_sigma1_gaus = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),sigma1_tmp, sigma1_tmp-rangeWidth,sigma1_tmp+rangeWidth );
-
-      if(TString(wtagger_label.c_str()).Contains("0v90")){
-        rrv_mean1_gaus  = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),83, 73, 93);
-        rrv_sigma1_gaus = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),7.5, 0.,20. );
-      }
-
-      RooGaussian* gaus1 = new RooGaussian(("gaus1"+label+"_"+channel+spectrum).c_str(),("gaus1"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_mean1_gaus,*rrv_sigma1_gaus);
+  RooGaussian* gaus1 = addConstraint(rrv_c_Exp,rrv_c_Exp->getVal(),c0_tmp_err,constraint);
+  workspace->import(*gaus1);
 
-      float offset_tmp_err = 20;;
-      
-/*      RooRealVar* rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),c0_tmp,c0_tmp-4e-2, c0_tmp+4e-2 );
-      RooRealVar* rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),offset_tmp,offset_tmp-offset_tmp_err*4,offset_tmp+offset_tmp_err*4);
-      RooRealVar* rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),width_tmp, width_tmp-10, width_tmp+10);*/
-      RooRealVar* rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),c0_tmp,-10,10.);
-      RooRealVar* rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),offset_tmp,0.,100.);
-      RooRealVar* rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),width_tmp,0.,100.);
-
-      RooRealVar* rrv_frac = new RooRealVar(("rrv_frac"+label+"_"+channel+spectrum).c_str(),("rrv_frac"+label+"_"+channel+spectrum).c_str(),frac_tmp);
-      
-
-      if(TString(wtagger_label.c_str()).Contains("0v80")){
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),90.,-1000.,1000.);
-        rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),140.,-1000.,1000.);
-      }
+  return model_pdf ;
+}
 
+static RooAbsPdf* MakeGeneralPdf_Gaus(RooWorkspace* workspace, const std::string & label, const std::string & model, const std::string & spectrum, const std::string & wtagger_label, const std::string & channel, std::vector<std::string>* constraint, const int & ismc, RooRealVar* rrv_x){
+  RooRealVar* rrv_mean1_gaus   = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),80,40,100);
+  RooRealVar* rrv_sigma1_gaus  = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),7,0.,15);
+  RooGaussian* model_pdf       = new RooGaussian(("gaus"+label+"_"+channel+spectrum).c_str(),("gaus"+label+"_"+channel+spectrum).c_str(), *rrv_x,*rrv_mean1_gaus,*rrv_sigma1_gaus);
 
-      if(TString(wtagger_label.c_str()).Contains("0v90")){
-        std::cout<< "HERE I AM" << std::endl;
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),190.,-1000.,1000.);
-        rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),80.,-1000.,1000.);
-      }
+  return model_pdf ;
+}
 
-// 300-400 pT, 26% N2DDT Transformation
-/*      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.07,-0.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),350.,10.,1000.);
-        rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),140.,10.,1000.);
-      }*/
-
-// 300-450 pT, 5% N2DDT Transformation
-/*      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.07,-0.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),100.,10.,1000.);
-        rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),100.,10.,1000.);
-      }*/
-
-// >450 pT, 5% N2DDT Transformation
-/*      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.07,-0.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),550.,10.,1000.);
-        rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),100.,10.,1000.);
-      }*/
-
-// >400 pT, 5% N2DDT Transformation
-      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.07,-0.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),100.,10.,1000.);
-        rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),100.,10.,1000.);
-      }
+static RooAbsPdf* MakeGeneralPdf_ErfExp(RooWorkspace* workspace, const std::string & label, const std::string & model, const std::string & spectrum, const std::string & wtagger_label, const std::string & channel, std::vector<std::string>* constraint, const int & ismc, RooRealVar* rrv_x){
+  std::cout<< "########### Erf*Exp for mj fit  ############"<<std::endl;
+  // c fixed, the W+jets entries of the config give it a range and float it
+  RooRealVar* rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.026);
+  RooRealVar* rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),41.,0.,100);
+  RooRealVar* rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),30.,1.,100.);
 
-      rrv_c_ErfExp     ->setConstant(kTRUE);
-      rrv_offset_ErfExp->setConstant(kTRUE);
-      rrv_width_ErfExp ->setConstant(kTRUE);
-//      rrv_frac->setConstant(kTRUE);
-      
-      RooErfExpPdf* erfExp = new RooErfExpPdf(("erfExp"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_ErfExp,*rrv_offset_ErfExp,*rrv_width_ErfExp);
-      RooAddPdf* model_pdf = new RooAddPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),RooArgList(*gaus1,*erfExp),RooArgList(*rrv_frac),1);
+  RooErfExpPdf* model_pdf       = new RooErfExpPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_ErfExp,*rrv_offset_ErfExp,*rrv_width_ErfExp);
+  return model_pdf ;
+}
 
-      return model_pdf ;
-    }
+static RooAbsPdf* MakeGeneralPdf_ExpGaus_sp(RooWorkspace* workspace, const std::string & label, const std::string & model, const std::string & spectrum, const std::string & wtagger_label, const std::string & channel, std::vector<std::string>* constraint, const int & ismc, RooRealVar* rrv_x){
+  RooRealVar* rrv_c_Exp       = new RooRealVar(("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),-0.05,-0.5,0.5);
+  RooRealVar* rrv_mean1_gaus  = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),84,70,90);
+  RooRealVar* rrv_sigma1_gaus = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),7,4,40);
+  RooRealVar* rrv_high        = new RooRealVar(("rrv_high"+label+"_"+channel+spectrum).c_str(),("rrv_high"+label+"_"+channel+spectrum).c_str(),0.5,0.,1.);
+
+  RooExponential* exp         = new RooExponential(("exp"+label+"_"+channel+spectrum).c_str(),("exp"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_Exp);
+  RooGaussian* gaus           = new RooGaussian(("gaus"+label+"_"+channel+spectrum).c_str(),("gaus"+label+"_"+channel+spectrum).c_str(), *rrv_x,*rrv_mean1_gaus,*rrv_sigma1_gaus);
+  if(GetFusedModels()){
+    RooExpGausPdf* model_fused = new RooExpGausPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_Exp,*rrv_mean1_gaus,*rrv_sigma1_gaus,*rrv_high);
+    return model_fused ;
+  }
+  RooAddPdf* model_pdf  = new RooAddPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),RooArgList(*exp,*gaus),RooArgList(*rrv_high));
 
-    if( model == "2Gaus_ttbar"){
+  return model_pdf ;
+}
 
-      double mean1_tmp = 80.5;
-      double sigma1_tmp = 8.1149e+00;
-      float rangeMean = 8. ;
-      float rangeWidth = 5. ;
-      float frac_tmp = 8.3460e-01 ;
-      float deltamean_tmp  = 9.499 ;
-      float scalesigma_tmp = 2.5752;
+static RooAbsPdf* MakeGeneralPdf_ExpGaus(RooWorkspace* workspace, const std::string & label, const std::string & model, const std::string & spectrum, const std::string & wtagger_label, const std::string & channel, std::vector<std::string>* constraint, const int & ismc, RooRealVar* rrv_x){
+  RooRealVar* rrv_c_Exp       = new RooRealVar(("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),-0.05,-0.5,0.5);
+  RooRealVar* rrv_mean1_gaus  = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),84,70,90);
+  RooRealVar* rrv_sigma1_gaus = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),7,4,40);
+  RooRealVar* rrv_frac        = new RooRealVar(("rrv_frac"+label+"_"+channel+spectrum).c_str(),("rrv_frac"+label+"_"+channel+spectrum).c_str(),1);
 
+  rrv_c_Exp->setConstant(kTRUE);
 
+  RooExponential* exp         = new RooExponential(("exp"+label+"_"+channel+spectrum).c_str(),("exp"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_Exp);
+  RooGaussian* gaus1          = new RooGaussian(("gaus1"+label+"_"+channel+spectrum).c_str(),("gaus1"+label+"_"+channel+spectrum).c_str(), *rrv_x,*rrv_mean1_gaus,*rrv_sigma1_gaus);
+  RooAddPdf* model_pdf  = new RooAddPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),RooArgList(*gaus1,*exp),RooArgList(*rrv_frac),1);
+  return model_pdf ;
+}
 
-      if(TString(wtagger_label.c_str()).Contains("76X")){
-        frac_tmp = 7.3739e-01 ; 
-        deltamean_tmp  = 7.81599999999998829e+00 ;
-        scalesigma_tmp = 2.74416583258705149e+00;
-      }
-      if( TString(wtagger_label.c_str()).Contains("PuppiSD") ){
-        mean1_tmp = 80.85;
-        sigma1_tmp = 9.65;
-        // frac_tmp = 6.9510e-01 ;
-        deltamean_tmp  = 3.499 ;
-        scalesigma_tmp = 2.5752;
-      }
-      
-      
-      if(TString(wtagger_label.c_str()).Contains("_DDT")){
-        mean1_tmp = 8.5423e+01;   
-        sigma1_tmp = 7.1694e+00 ;            
-        rangeMean = 6. ;
-        rangeWidth = 5. ;
-        frac_tmp = 8.2613e-01 ;
-        deltamean_tmp  = 4.4964e-13 ;
-        scalesigma_tmp = 2.5898e+00;
-      }
-      
+static RooAbsPdf* MakeGeneralPdf_ErfExpGaus_sp(RooWorkspace* workspace, const std::string & label, const std::string & model, const std::string & spectrum, const std::string & wtagger_label, const std::string & channel, std::vector<std::string>* constraint, const int & ismc, RooRealVar* rrv_x){
+  RooRealVar* rrv_c_ErfExp     = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-0.2,0.);
+  RooRealVar* rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),30.,10.,300.);
+  RooRealVar* rrv_mean1_gaus   = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),80,40,100);
+  RooRealVar* rrv_sigma1_gaus  = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),7,0.,40);
+  RooRealVar* rrv_high         = new RooRealVar(("rrv_high"+label+"_"+channel+spectrum).c_str(),("rrv_high"+label+"_"+channel+spectrum).c_str(),0.5,0.,1.);
+
+  RooErfExpPdf* erfExp        = new RooErfExpPdf(("erfExp"+label+"_"+channel+spectrum).c_str(),("erfExp"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_ErfExp,*rrv_mean1_gaus,*rrv_width_ErfExp);
+  RooGaussian* gaus            = new RooGaussian(("gaus"+label+"_"+channel+spectrum).c_str(),("gaus"+label+"_"+channel+spectrum).c_str(), *rrv_x,*rrv_mean1_gaus,*rrv_sigma1_gaus);
+  if(GetFusedModels()){
+    RooErfExpGausPdf* model_fused = new RooErfExpGausPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_ErfExp,*rrv_mean1_gaus,*rrv_width_ErfExp,*rrv_mean1_gaus,*rrv_sigma1_gaus,*rrv_high);
+    return model_fused ;
+  }
+  RooAddPdf* model_pdf  = new RooAddPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),RooArgList(*erfExp,*gaus),RooArgList(*rrv_high));
 
-      RooRealVar* rrv_mean1_gaus  = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),mean1_tmp, mean1_tmp-rangeMean, mean1_tmp+rangeMean);
-      RooRealVar* rrv_sigma1_gaus = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),sigma1_tmp, sigma1_tmp-rangeWidth,sigma1_tmp+rangeWidth );
-
-      if( TString(label.c_str()).Contains("fail") ){
-        if( TString(label).Contains("data") ) {
-          rrv_mean1_gaus  = workspace->var(("rrv_mean1_gaus_ttbar_data_"+channel+spectrum).c_str());
-          rrv_sigma1_gaus = workspace->var(("rrv_sigma1_gaus_ttbar_data_"+channel+spectrum).c_str());
-        }
-        else if( TString(label).Contains("TotalMC") ) {
-          rrv_mean1_gaus  = workspace->var(("rrv_mean1_gaus_ttbar_TotalMC_"+channel+spectrum).c_str());
-          rrv_sigma1_gaus = workspace->var(("rrv_sigma1_gaus_ttbar_TotalMC_"+channel+spectrum).c_str());
-        }
-      }
+  return model_pdf ;
+}
 
-      RooGaussian* gaus1 = new RooGaussian(("gaus1"+label+"_"+channel+spectrum).c_str(),("gaus1"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_mean1_gaus,*rrv_sigma1_gaus);
+static RooAbsPdf* MakeGeneralPdf_GausErfExp_ttbar(RooWorkspace* workspace, const std::string & label, const std::string & model, const std::string & spectrum, const std::string & wtagger_label, const std::string & channel, std::vector<std::string>* constraint, const int & ismc, RooRealVar* rrv_x){
+  RooRealVar* rrv_mean1_gaus  = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),8.2653e+01,7.6653e+01,8.8653e+01);
+  RooRealVar* rrv_sigma1_gaus = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),7.5932e+00,2.5932e+00,1.25932e+01);
+  RooGaussian* gaus1 = new RooGaussian(("gaus1"+label+"_"+channel+spectrum).c_str(),("gaus1"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_mean1_gaus,*rrv_sigma1_gaus);
+
+  RooRealVar* rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-2.7180e-02,-10,10.);
+  RooRealVar* rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),8.6888e+01,0.,100.);
+  RooRealVar* rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),2.9860e+01,0.,100.);
+  RooRealVar* rrv_frac = new RooRealVar(("rrv_frac"+label+"_"+channel+spectrum).c_str(),("rrv_frac"+label+"_"+channel+spectrum).c_str(),1.);
+
+  // the erf*exp shape stays fixed at its working point values, only the peak floats
+  rrv_c_ErfExp     ->setConstant(kTRUE);
+  rrv_offset_ErfExp->setConstant(kTRUE);
+  rrv_width_ErfExp ->setConstant(kTRUE);
+
+  RooErfExpPdf* erfExp = new RooErfExpPdf(("erfExp"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_ErfExp,*rrv_offset_ErfExp,*rrv_width_ErfExp);
+  if(GetFusedModels()){
+    // the gaussian alone is still picked up from the workspace by GausExp_failN2DDTcut
+    workspace->import(*gaus1);
+    RooGausErfExpPdf* model_fused = new RooGausErfExpPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_mean1_gaus,*rrv_sigma1_gaus,*rrv_c_ErfExp,*rrv_offset_ErfExp,*rrv_width_ErfExp,*rrv_frac);
+    return model_fused ;
+  }
+  RooAddPdf* model_pdf = new RooAddPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),RooArgList(*gaus1,*erfExp),RooArgList(*rrv_frac),1);
 
-      RooRealVar* rrv_deltamean_gaus  = new RooRealVar(("rrv_deltamean_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_deltamean_gaus"+label+"_"+channel+spectrum).c_str(),deltamean_tmp);
-      RooFormulaVar* rrv_mean2_gaus   = new RooFormulaVar(("rrv_mean2_gaus"+label+"_"+channel+spectrum).c_str(),"@0+@1",RooArgList(*rrv_mean1_gaus,*rrv_deltamean_gaus));
-      RooRealVar* rrv_scalesigma_gaus = new RooRealVar(("rrv_scalesigma_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_scalesigma_gaus"+label+"_"+channel+spectrum).c_str(),scalesigma_tmp);
-      RooFormulaVar* rrv_sigma2_gaus  = new RooFormulaVar(("rrv_sigma2_gaus"+label+"_"+channel+spectrum).c_str(),"@0*@1", RooArgList(*rrv_sigma1_gaus,*rrv_scalesigma_gaus));
-      RooGaussian* gaus2 = new RooGaussian(("gaus2"+label+"_"+channel+spectrum).c_str(),("gaus2"+label+"_"+channel+spectrum).c_str(), *rrv_x,*rrv_mean2_gaus,*rrv_sigma2_gaus);
+  return model_pdf ;
+}
 
-      RooRealVar* rrv_frac = new RooRealVar(("rrv_frac"+label+"_"+channel+spectrum).c_str(),("rrv_frac"+label+"_"+channel+spectrum).c_str(),frac_tmp);//,frac_tmp-frac_tmp_err,frac_tmp+frac_tmp_err);
-      RooAddPdf* model_pdf = new RooAddPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),RooArgList(*gaus1,*gaus2),RooArgList(*rrv_frac),1);
+static RooAbsPdf* MakeGeneralPdf_2Gaus_ttbar(RooWorkspace* workspace, const std::string & label, const std::string & model, const std::string & spectrum, const std::string & wtagger_label, const std::string & channel, std::vector<std::string>* constraint, const int & ismc, RooRealVar* rrv_x){
+  RooRealVar* rrv_mean1_gaus  = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),80.5,72.5,88.5);
+  RooRealVar* rrv_sigma1_gaus = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),8.1149e+00,3.1149e+00,1.31149e+01);
 
-      return model_pdf ;
+  // the fail sample shares the peak of the pass sample
+  if( TString(label.c_str()).Contains("fail") ){
+    if( TString(label).Contains("data") ) {
+      rrv_mean1_gaus  = workspace->var(("rrv_mean1_gaus_ttbar_data_"+channel+spectrum).c_str());
+      rrv_sigma1_gaus = workspace->var(("rrv_sigma1_gaus_ttbar_data_"+channel+spectrum).c_str());
     }
-
-    if( model == "GausChebychev_ttbar_failN2DDTcut"){
-
-      RooAbsPdf* model_pdf = NULL ;
-
-      double p0_tmp = 3.1099e-01 ; double p0_tmp_err = 1.86e-01;
-      double p1_tmp = -2.2128e-01; double p1_tmp_err = 3.02e-01;
-      double frac_tmp =  4.6400e-01  ; double frac_tmp_err = 1.20e-01;
-      double mean1_tmp = 8.7682e+01;
-      double sigma1_tmp = 9.2789e+00;
-
-      if(TString(wtagger_label.c_str()).Contains("76X")){
-        p0_tmp = 2.1208e-01 ;
-        p1_tmp = -3.2198e-01;
-        frac_tmp = 4.3714e-01;
-      }
-      
-      if(TString(wtagger_label.c_str()).Contains("_DDT")){
-        if(TString(wtagger_label.c_str()).Contains("0v38")){
-        p0_tmp = 3.7004e-01 ;
-        p1_tmp = -4.5610e-01;
-        frac_tmp = 6.8410e-01;
-        mean1_tmp = 8.7682e+01;
-        sigma1_tmp = 9.2789e+00;
-      }
-      }
-
-      // take the same gaussian used in the pass sample
-      RooAbsPdf* gaus = NULL ;
-      if( TString(label).Contains("data"   ) ) gaus = workspace->pdf(("gaus1_ttbar_data_"+channel+spectrum).c_str());
-      if( TString(label).Contains("TotalMC") ) gaus = workspace->pdf(("gaus1_ttbar_TotalMC_"+channel+spectrum).c_str());
-      if( TString(label).Contains("realW")   ) gaus = workspace->pdf(("gaus1_TTbar_realW_"+channel+spectrum).c_str());
-
-      // RooRealVar* rrv_mean1_gaus = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),mean1_tmp, 75., 90.);
-    //   RooRealVar* rrv_sigma1_gaus = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),sigma1_tmp,5.,15. );
-    //   RooGaussian* gaus = new RooGaussian(("gaus"+label+"_"+channel+spectrum).c_str(),("gaus1"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_mean1_gaus,*rrv_sigma1_gaus);
-
-      RooRealVar* rrv_p0_cheb = new RooRealVar(("rrv_p0_cheb"+label+"_"+channel+spectrum).c_str(),("rrv_p0_cheb"+label+"_"+channel+spectrum).c_str(),p0_tmp);
-      RooRealVar* rrv_p1_cheb = new RooRealVar(("rrv_p1_cheb"+label+"_"+channel+spectrum).c_str(),("rrv_p1_cheb"+label+"_"+channel+spectrum).c_str(),p1_tmp);
-
-      RooChebychev* cheb = new RooChebychev(("cheb"+label+"_"+channel+spectrum).c_str(),("cheb"+label+"_"+channel+spectrum).c_str(), *rrv_x, RooArgList(*rrv_p0_cheb,*rrv_p1_cheb) );
-
-      RooRealVar* rrv_frac = new RooRealVar(("rrv_frac"+label+"_"+channel+spectrum).c_str(),("rrv_frac"+label+"_"+channel+spectrum).c_str(),frac_tmp);
-      model_pdf = new RooAddPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),RooArgList(*gaus,*cheb),RooArgList(*rrv_frac),1);
-
-      return model_pdf ;
+    else if( TString(label).Contains("TotalMC") ) {
+      rrv_mean1_gaus  = workspace->var(("rrv_mean1_gaus_ttbar_TotalMC_"+channel+spectrum).c_str());
+      rrv_sigma1_gaus = workspace->var(("rrv_sigma1_gaus_ttbar_TotalMC_"+channel+spectrum).c_str());
     }
+  }
 
-    if( model == "GausErfExp_ttbar_failN2DDTcut"){
-
-//      std::cout << "AM I IN HERE????" << std::endl;
-      double c0_tmp     = -3.0626e-02 ;      double c0_tmp_err = 1.46e-02;
-      double offset_tmp = 5.1636e+01  ;      double offset_tmp_err = 4.92e+01;
-      double width_tmp  = 3.6186e+01  ;      double width_tmp_err = 4.69e+00;
-      double frac_tmp   = 1.          ;
-      double mean1_tmp  = 8.7486e+01;
-      double sigma1_tmp = 8.7456e+00;
-      
-      RooAbsPdf* model_pdf = NULL ;
-
-      if(TString(wtagger_label.c_str()).Contains("0v60")){
-        c0_tmp = -7.3294e-03    ;     
-        offset_tmp = 3.7914e+01 ;    
-        width_tmp = 2.6943e+01  ;
-      }
-      if( TString(wtagger_label.c_str()).Contains("PuppiSD") ){
-        
-        c0_tmp      = -5.5604e-02;
-        offset_tmp  = 1.9915e+02 ;
-        width_tmp   = 6.4888e+01 ;
-        // frac_tmp = 4.5680e-01 ;
-        mean1_tmp   = 8.0056e+01 ;
-        sigma1_tmp  = 9.4160e+00 ;
-          
-        if(TString(wtagger_label.c_str()).Contains("0v56")){
-          mean1_tmp = 8.4429e+01 ;
-          sigma1_tmp = 7.8370e+00;
-          c0_tmp     = -4.5251e-02 ;
-          offset_tmp =  1.7294e+02 ;
-          width_tmp  =  6.7105e+01  ;
-          // frac_tmp = 2.5562e-01 ;
-        }
-      }
-      if(TString(wtagger_label.c_str()).Contains("_DDT")){
-        if(TString(wtagger_label.c_str()).Contains("0v38")){
-          mean1_tmp = 8.7486e+01;
-          sigma1_tmp = 8.7456e+00;
-          c0_tmp     = -9.3552e-02 ;
-          offset_tmp =  1.4301e+02 ;
-          width_tmp  =   3.5879e+01  ;
-          frac_tmp  = 8.3460e-01;
-        }
-        if(TString(wtagger_label.c_str()).Contains("0v52")){
-          mean1_tmp = 8.7107e+01;
-          sigma1_tmp = 8.9305e+00;
-          c0_tmp     =  -1.7229e-01 ;
-          offset_tmp =  2.3192e+02 ;
-          width_tmp  =  4.0557e+01  ;
-        }
-        if(TString(wtagger_label.c_str()).Contains("0v44")){
-          c0_tmp = -7.6941e-02    ;     
-          offset_tmp = 1.2437e+02 ;    
-          width_tmp = 3.3459e+01  ;
-          // frac_tmp  = 5.5513e-01 ;
-          mean1_tmp  = 8.7495e+01;
-          sigma1_tmp = 8.8403e+00;
-           
-        }
-      }
-      
-      
-   
-      // take the same gaussian used in the pass sample
-      RooAbsPdf* gaus = NULL ;
-      if( TString(label).Contains("data"   ) ) gaus = workspace->pdf(("gaus1_ttbar_data_"+channel+spectrum).c_str());
-      if( TString(label).Contains("TotalMC") ) gaus = workspace->pdf(("gaus1_ttbar_TotalMC_"+channel+spectrum).c_str());
-      
-/*      RooRealVar* rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),c0_tmp,c0_tmp-4e-2, c0_tmp+4e-2);
-      RooRealVar* rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),offset_tmp,offset_tmp-offset_tmp_err,offset_tmp+offset_tmp_err);
-      RooRealVar* rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), width_tmp,width_tmp-width_tmp_err, width_tmp+width_tmp_err);*/
-      RooRealVar* rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.06,-0.2,0.);//,c0_tmp-4e-2, c0_tmp+4e-2);
-      RooRealVar* rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),152.,30.,1000.);//,offset_tmp-offset_tmp_err,offset_tmp+offset_tmp_err);
-      RooRealVar* rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 64.8,30.,200);//,width_tmp-width_tmp_err, width_tmp+width_tmp_err);
-
+  RooGaussian* gaus1 = new RooGaussian(("gaus1"+label+"_"+channel+spectrum).c_str(),("gaus1"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_mean1_gaus,*rrv_sigma1_gaus);
 
-      RooErfExpPdf* erfExp = new RooErfExpPdf(("erfExp"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_ErfExp,*rrv_offset_ErfExp,*rrv_width_ErfExp);
+  RooRealVar* rrv_deltamean_gaus  = new RooRealVar(("rrv_deltamean_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_deltamean_gaus"+label+"_"+channel+spectrum).c_str(),9.499);
+  RooFormulaVar* rrv_mean2_gaus   = new RooFormulaVar(("rrv_mean2_gaus"+label+"_"+channel+spectrum).c_str(),"@0+@1",RooArgList(*rrv_mean1_gaus,*rrv_deltamean_gaus));
+  RooRealVar* rrv_scalesigma_gaus = new RooRealVar(("rrv_scalesigma_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_scalesigma_gaus"+label+"_"+channel+spectrum).c_str(),2.5752);
+  RooFormulaVar* rrv_sigma2_gaus  = new RooFormulaVar(("rrv_sigma2_gaus"+label+"_"+channel+spectrum).c_str(),"@0*@1", RooArgList(*rrv_sigma1_gaus,*rrv_scalesigma_gaus));
+  RooGaussian* gaus2 = new RooGaussian(("gaus2"+label+"_"+channel+spectrum).c_str(),("gaus2"+label+"_"+channel+spectrum).c_str(), *rrv_x,*rrv_mean2_gaus,*rrv_sigma2_gaus);
 
-      RooRealVar* rrv_frac = new RooRealVar(("rrv_frac"+label+"_"+channel+spectrum).c_str(),("rrv_frac"+label+"_"+channel+spectrum).c_str(),frac_tmp);
+  RooRealVar* rrv_frac = new RooRealVar(("rrv_frac"+label+"_"+channel+spectrum).c_str(),("rrv_frac"+label+"_"+channel+spectrum).c_str(),8.3460e-01);
+  RooAddPdf* model_pdf = new RooAddPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),RooArgList(*gaus1,*gaus2),RooArgList(*rrv_frac),1);
 
-      if(TString(wtagger_label.c_str()).Contains("0v60")){
-        rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-0.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),210.,30.,1000.);
-        rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 50.,10.,1000);
-      }
+  return model_pdf ;
+}
 
-      if(TString(wtagger_label.c_str()).Contains("0v80")){
-        rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-0.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),210.,30.,1000.);
-        rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 50.,10.,1000);
-      }
+static RooAbsPdf* MakeGeneralPdf_GausChebychev_ttbar_failN2DDTcut(RooWorkspace* workspace, const std::string & label, const std::string & model, const std::string & spectrum, const std::string & wtagger_label, const std::string & channel, std::vector<std::string>* constraint, const int & ismc, RooRealVar* rrv_x){
+  RooAbsPdf* model_pdf = NULL ;
 
-// < 300 pT, 26% transformation
-/*      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-0.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),210.,30.,1000.);
-        rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 50.,10.,1000);
-      }*/
-
-// 300-400 pT, 26% transformation
-/*      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-10.,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),150.,30.,1000.);
-        rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 65.,10.,1000);
-      }*/
-
-// 400-500 pT, 26% transformation
-/*      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-10.,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),150.,30.,1000.);
-        rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 65.,10.,1000);
-      }*/
-// >500 pT, 26% transformation
-/*      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-10.,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),500.,30.,1000.);
-        rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 80.,10.,1000);
-      }*/
-
-// > 450 pT, 5% Transformation     
-      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-10.,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),100.,30.,1000.);
-        rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 80.,10.,1000);
-      }
+  // take the same gaussian used in the pass sample
+  RooAbsPdf* gaus = NULL ;
+  if( TString(label).Contains("data"   ) ) gaus = workspace->pdf(("gaus1_ttbar_data_"+channel+spectrum).c_str());
+  if( TString(label).Contains("TotalMC") ) gaus = workspace->pdf(("gaus1_ttbar_TotalMC_"+channel+spectrum).c_str());
+  if( TString(label).Contains("realW")   ) gaus = workspace->pdf(("gaus1_TTbar_realW_"+channel+spectrum).c_str());
 
- 
-      rrv_c_ErfExp     ->setConstant(kTRUE);
-      rrv_offset_ErfExp->setConstant(kTRUE);
-      rrv_width_ErfExp ->setConstant(kTRUE);
-      
-      model_pdf = new RooAddPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),RooArgList(*gaus,*erfExp),RooArgList(*rrv_frac),1);
+  RooRealVar* rrv_p0_cheb = new RooRealVar(("rrv_p0_cheb"+label+"_"+channel+spectrum).c_str(),("rrv_p0_cheb"+label+"_"+channel+spectrum).c_str(),3.1099e-01);
+  RooRealVar* rrv_p1_cheb = new RooRealVar(("rrv_p1_cheb"+label+"_"+channel+spectrum).c_str(),("rrv_p1_cheb"+label+"_"+channel+spectrum).c_str(),-2.2128e-01);
 
-      return model_pdf ;
-    }
+  RooChebychev* cheb = new RooChebychev(("cheb"+label+"_"+channel+spectrum).c_str(),("cheb"+label+"_"+channel+spectrum).c_str(), *rrv_x, RooArgList(*rrv_p0_cheb,*rrv_p1_cheb) );
 
-    if( model == "GausExp_failN2DDTcut"){
-      RooAbsPdf* model_pdf = NULL ;
+  RooRealVar* rrv_frac = new RooRealVar(("rrv_frac"+label+"_"+channel+spectrum).c_str(),("rrv_frac"+label+"_"+channel+spectrum).c_str(),4.6400e-01);
+  model_pdf = new RooAddPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),RooArgList(*gaus,*cheb),RooArgList(*rrv_frac),1);
 
-      RooAbsPdf* gaus = NULL ;
-      if( TString(label).Contains("data"   ) ) gaus = workspace->pdf(("gaus1_ttbar_data_"+channel+spectrum).c_str());
-      if( TString(label).Contains("TotalMC") ) gaus = workspace->pdf(("gaus1_ttbar_TotalMC_"+channel+spectrum).c_str());
+  return model_pdf ;
+}
 
-      RooRealVar* rrv_c_Exp       = new RooRealVar(("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),-0.05,-0.5,0.5);
+static RooAbsPdf* MakeGeneralPdf_GausErfExp_ttbar_failN2DDTcut(RooWorkspace* workspace, const std::string & label, const std::string & model, const std::string & spectrum, const std::string & wtagger_label, const std::string & channel, std::vector<std::string>* constraint, const int & ismc, RooRealVar* rrv_x){
+  RooAbsPdf* model_pdf = NULL ;
 
-// >450 pT, 5% Transformation
-      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        rrv_c_Exp       = new RooRealVar(("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),-0.05,-0.5,0.5);
-      }
+  // take the same gaussian used in the pass sample
+  RooAbsPdf* gaus = NULL ;
+  if( TString(label).Contains("data"   ) ) gaus = workspace->pdf(("gaus1_ttbar_data_"+channel+spectrum).c_str());
+  if( TString(label).Contains("TotalMC") ) gaus = workspace->pdf(("gaus1_ttbar_TotalMC_"+channel+spectrum).c_str());
 
-      RooExponential* exp         = new RooExponential(("exp"+label+"_"+channel+spectrum).c_str(),("exp"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_Exp);
-      RooRealVar* rrv_frac = new RooRealVar(("rrv_frac"+label+"_"+channel+spectrum).c_str(),("rrv_frac"+label+"_"+channel+spectrum).c_str(),0.5,0.,1.);
+  RooRealVar* rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.06,-0.2,0.);
+  RooRealVar* rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),152.,30.,1000.);
+  RooRealVar* rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),64.8,30.,200);
+  RooRealVar* rrv_frac = new RooRealVar(("rrv_frac"+label+"_"+channel+spectrum).c_str(),("rrv_frac"+label+"_"+channel+spectrum).c_str(),1.);
 
-      rrv_c_Exp     ->setConstant(kTRUE);
+  rrv_c_ErfExp     ->setConstant(kTRUE);
+  rrv_offset_ErfExp->setConstant(kTRUE);
+  rrv_width_ErfExp ->setConstant(kTRUE);
 
-      model_pdf = new RooAddPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),RooArgList(*gaus,*exp),RooArgList(*rrv_frac),1);
+  RooErfExpPdf* erfExp = new RooErfExpPdf(("erfExp"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_ErfExp,*rrv_offset_ErfExp,*rrv_width_ErfExp);
+  model_pdf = new RooAddPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),RooArgList(*gaus,*erfExp),RooArgList(*rrv_frac),1);
 
-      return model_pdf ;
-    }
+  return model_pdf ;
+}
 
-    if( model == "ErfExp_ttbar"){
+static RooAbsPdf* MakeGeneralPdf_GausExp_failN2DDTcut(RooWorkspace* workspace, const std::string & label, const std::string & model, const std::string & spectrum, const std::string & wtagger_label, const std::string & channel, std::vector<std::string>* constraint, const int & ismc, RooRealVar* rrv_x){
+  RooAbsPdf* model_pdf = NULL ;
 
-      double c0_tmp     = -2.7180e-02 ;      double c0_tmp_err     = 6.83e-03;
-      double offset_tmp =  8.6888e+01 ;      double offset_tmp_err = 9.35e+00;
-      double width_tmp  =  2.9860e+01 ;      double width_tmp_err  = 2.97e+00;
+  RooAbsPdf* gaus = NULL ;
+  if( TString(label).Contains("data"   ) ) gaus = workspace->pdf(("gaus1_ttbar_data_"+channel+spectrum).c_str());
+  if( TString(label).Contains("TotalMC") ) gaus = workspace->pdf(("gaus1_ttbar_TotalMC_"+channel+spectrum).c_str());
 
-      if(TString(wtagger_label.c_str()).Contains("76X")){
-        c0_tmp     = -1.9681e-02 ;
-        offset_tmp =  7.4564e+01 ;
-        width_tmp  =  2.6397e+01 ;
-      }
-      if(TString(wtagger_label.c_str()).Contains("0v60")){
-        c0_tmp     = -2.9373e-02 ;  
-        offset_tmp =  8.2980e+01 ;
-        width_tmp  =  3.6133e+01 ;
-        if(TString(wtagger_label.c_str()).Contains("76X")){
-          c0_tmp     = -2.2689e-02 ;
-          offset_tmp =  6.9803e+01 ;
-          width_tmp  =  3.2077e+01 ;
-        }
-      }
-      
-      if( TString(wtagger_label.c_str()).Contains("PuppiSD") ){
-        c0_tmp     =  -2.1046e-02 ;     
-        offset_tmp =  8.0122e+01 ;      
-        width_tmp  =  2.9595e+01 ; 
-      }
-      
-      
-      if(TString(wtagger_label.c_str()).Contains("_DDT")){
-        if(TString(wtagger_label.c_str()).Contains("0v38")){
-          c0_tmp     = -6.0079e-02  ;
-          offset_tmp =  1.4980e+02 ;
-          width_tmp  =  4.8168e+01  ;
-        }
-        if(TString(wtagger_label.c_str()).Contains("0v52")){
-          c0_tmp     =     -3.1793e-02  ;
-          offset_tmp =  9.7997e+01 ;
-          width_tmp  =  3.8820e+01  ;
-        }
-        if(TString(wtagger_label.c_str()).Contains("0v44")){
-          c0_tmp     = -4.1927e-02 ;
-          offset_tmp =  1.1240e+02  ;
-          width_tmp  =  3.9190e+01  ;
-        }
-      }
-        
-      RooRealVar* rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.02,-.5,0.);
-      RooRealVar* rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),80.,50.,1000.);
-      RooRealVar* rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),35.,20.,1000.);
-        
-/*      RooRealVar* rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),c0_tmp,c0_tmp-4e-2, c0_tmp+4e-2 );
-      RooRealVar* rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),offset_tmp,offset_tmp-offset_tmp_err*4,offset_tmp+offset_tmp_err*4);
-      RooRealVar* rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),width_tmp, width_tmp-10, width_tmp+10);*/
-      
-// < 300 pT, 26% N2DDT Transformation
-/*      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.07,-.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),150.,50.,1000.);
-        rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),30.,10.,500.);
-      }*/
-
-// 300-400 pT, 26% N2DDT Transformation
-/*      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        std::cout<<"WHERE???" << std::endl;
-        rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.07,-.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),150.,50.,1000.);
-        rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),30.,10.,500.);
-      }*/
-
-// 400-500 pT, 26% N2DDT Transformation
-/*      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.07,-.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),300.,50.,1000.);
-        rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),70.,10.,500.);
-      }*/
-        
-// >500 pT, 26% N2DDT Transformation
-/*      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.07,-.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),450.,50.,1000.);
-        rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),100.,10.,500.);
-      }*/
-
-// >400 pT, 5% N2DDT Transformation
-/*     if(TString(wtagger_label.c_str()).Contains("0v00")){
-       rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.07,-.5,0.);
-       rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),200.,50.,1000.);
-       rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),50.,10.,1000.);
-      }*/
-
-// 300-400 pT, 5% N2DDT Transformation
-      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        std::cout<<"WHERE???" << std::endl;
-        rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.07,-.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),150.,50.,1000.);
-        rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),30.,10.,500.);
-      }
+  RooRealVar* rrv_c_Exp       = new RooRealVar(("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),-0.05,-0.5,0.5);
+  RooExponential* exp         = new RooExponential(("exp"+label+"_"+channel+spectrum).c_str(),("exp"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_Exp);
+  RooRealVar* rrv_frac = new RooRealVar(("rrv_frac"+label+"_"+channel+spectrum).c_str(),("rrv_frac"+label+"_"+channel+spectrum).c_str(),0.5,0.,1.);
 
-// <300 pT, 5% N2DDT Transformation
-/*     if(TString(wtagger_label.c_str()).Contains("0v00")){
-       rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.07,-.5,0.);
-       rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),80.,50.,1000.);
-       rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),50.,10.,1000.);
-      }*/
-                                     
-      RooErfExpPdf* model_pdf = new RooErfExpPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_ErfExp,*rrv_offset_ErfExp,*rrv_width_ErfExp);
-
-      RooGaussian* gaus1 = addConstraint(rrv_c_ErfExp,rrv_c_ErfExp->getVal(),c0_tmp_err,constraint);
-      RooGaussian* gaus2 = addConstraint(rrv_offset_ErfExp,rrv_offset_ErfExp->getVal(),offset_tmp_err,constraint);
-      RooGaussian* gaus3 = addConstraint(rrv_width_ErfExp,rrv_width_ErfExp->getVal(),width_tmp_err,constraint);
-      workspace->import(*gaus1);
-      workspace->import(*gaus2);
-      workspace->import(*gaus3);
-      return model_pdf ;
-    }
+  rrv_c_Exp     ->setConstant(kTRUE);
 
-    if( model == "ErfExp_ttbar_failN2DDTcut"){
+  model_pdf = new RooAddPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),RooArgList(*gaus,*exp),RooArgList(*rrv_frac),1);
 
-      RooErfExpPdf* model_pdf = NULL ;
+  return model_pdf ;
+}
 
-      double c0_tmp = -3.0626e-02    ;      double c0_tmp_err = 1.46e-02;
-      double offset_tmp = 5.1636e+01 ;      double offset_tmp_err = 4.92e+01;
-      double width_tmp = 3.6186e+01  ;      double width_tmp_err = 4.69e+00;
+static RooAbsPdf* MakeGeneralPdf_ErfExp_ttbar(RooWorkspace* workspace, const std::string & label, const std::string & model, const std::string & spectrum, const std::string & wtagger_label, const std::string & channel, std::vector<std::string>* constraint, const int & ismc, RooRealVar* rrv_x){
+  double c0_tmp_err     = 6.83e-03;
+  double offset_tmp_err = 9.35e+00;
+  double width_tmp_err  = 2.97e+00;
+
+  RooRealVar* rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.02,-.5,0.);
+  RooRealVar* rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),80.,50.,1000.);
+  RooRealVar* rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),35.,20.,1000.);
+
+  RooErfExpPdf* model_pdf = new RooErfExpPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_ErfExp,*rrv_offset_ErfExp,*rrv_width_ErfExp);
+
+  // the config entries with a sigma move these constraints to their values
+  RooGaussian* gaus1 = addConstraint(rrv_c_ErfExp,rrv_c_ErfExp->getVal(),c0_tmp_err,constraint);
+  RooGaussian* gaus2 = addConstraint(rrv_offset_ErfExp,rrv_offset_ErfExp->getVal(),offset_tmp_err,constraint);
+  RooGaussian* gaus3 = addConstraint(rrv_width_ErfExp,rrv_width_ErfExp->getVal(),width_tmp_err,constraint);
+  workspace->import(*gaus1);
+  workspace->import(*gaus2);
+  workspace->import(*gaus3);
+  return model_pdf ;
+}
 
-      if(TString(wtagger_label.c_str()).Contains("76X")){
-        c0_tmp = -2.8654e-02    ;
-        offset_tmp = 4.5140e+01 ;
-        width_tmp = 3.4083e+01  ;
-      }
-      if(TString(wtagger_label.c_str()).Contains("0v60")){
-        c0_tmp = -3.4131e-02    ;  
-        offset_tmp = 3.3961e+01 ;
-        width_tmp = 3.2876e+01  ;
-        if(TString(wtagger_label.c_str()).Contains("76X")){
-          c0_tmp = -3.3221e-02    ; 
-          offset_tmp = 2.9445e+01 ;
-          width_tmp = 2.5680e+01  ;
-        }
-      }
-      if( TString(wtagger_label.c_str()).Contains("PuppiSD") ){     
-        c0_tmp = -3.5160e-02    ;       c0_tmp_err = 1.46e-02;
-        offset_tmp = 6.0935e+01 ;       offset_tmp_err = 4.92e+01;
-        width_tmp = 3.9583e+01  ;       width_tmp_err = 4.69e+00;
-      }
-      
-      if(TString(wtagger_label.c_str()).Contains("_DDT")){
-        if(TString(wtagger_label.c_str()).Contains("0v38")){
-          c0_tmp     = -5.9405e-02 ;
-          offset_tmp =  1.4790e+02 ;
-          width_tmp  =  5.3544e+01  ;
-        }
-        if(TString(wtagger_label.c_str()).Contains("0v52")){
-          c0_tmp     = -4.0722e-02  ;
-          offset_tmp =  1.0108e+02 ;
-          width_tmp  =  4.9796e+01  ;
-        }
-        if(TString(wtagger_label.c_str()).Contains("0v44")){
-          c0_tmp     = -2.0670e-02 ;
-          offset_tmp =  6.1299e+01  ;
-          width_tmp  =  3.0247e+01  ;
-          
-        }
-      }
+static RooAbsPdf* MakeGeneralPdf_ErfExp_ttbar_failN2DDTcut(RooWorkspace* workspace, const std::string & label, const std::string & model, const std::string & spectrum, const std::string & wtagger_label, const std::string & channel, std::vector<std::string>* constraint, const int & ismc, RooRealVar* rrv_x){
+  double c0_tmp_err = 1.46e-02;
 
+  RooRealVar* rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-3.0626e-02,-7.0626e-02,9.374e-03);
+  RooRealVar* rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),100.,30.,1000.);
+  RooRealVar* rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),40.,10.,500.);
 
-      RooRealVar* rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),c0_tmp,c0_tmp-4e-2, c0_tmp+4e-2);
-      RooRealVar* rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),100.,30.,1000.);
-      RooRealVar* rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 40.,10.,500.);
+  RooErfExpPdf* model_pdf = new RooErfExpPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_ErfExp,*rrv_offset_ErfExp,*rrv_width_ErfExp);
+  RooGaussian* gaus1 = addConstraint(rrv_c_ErfExp,rrv_c_ErfExp->getVal(),c0_tmp_err,constraint);
+  workspace->import(*gaus1);
+  return model_pdf ;
+}
 
+////// Fits for matched tt MC (realW / fakeW), config entries under <model>_matched
 
-      if(label == "_bkg_TotalMC_failN2DDTcut"){
-	rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-.5,0.);
-	rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),90.,50.,1000.);
-	rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 60.,30.,1000.);
-      }
+static RooAbsPdf* MakeMatchedPdf_Exp(RooWorkspace* workspace, const std::string & label, const std::string & model, const std::string & spectrum, const std::string & wtagger_label, const std::string & channel, std::vector<std::string>* constraint, const int & ismc, RooRealVar* rrv_x){
+  std::cout<< "######### Exp = levelled exp funtion for W+jets mlvj ############" <<std::endl;
+  RooRealVar* rrv_c_Exp = new RooRealVar(("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),-0.030, -0.2, 0.05);
+  RooExponential* model_pdf = new RooExponential(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_Exp);
+  return model_pdf ;
+}
 
-      if(TString(wtagger_label.c_str()).Contains("0v90")){
-        rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),90.,50.,1000.);
-        rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 60.,30.,1000.);
-      }
+static RooAbsPdf* MakeMatchedPdf_ErfExp(RooWorkspace* workspace, const std::string & label, const std::string & model, const std::string & spectrum, const std::string & wtagger_label, const std::string & channel, std::vector<std::string>* constraint, const int & ismc, RooRealVar* rrv_x){
+  std::cout<< "########### Erf*Exp for mj fit  ############"<<std::endl;
+  RooRealVar* rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.026);
+  RooRealVar* rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),41.,0.,100);
+  RooRealVar* rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),30.,1.,100.);
 
-      if(TString(wtagger_label.c_str()).Contains("0v80")){
-        rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),350.,50.,1000.);
-        rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 60.,30.,1000.);
-      }
+  RooErfExpPdf* model_pdf       = new RooErfExpPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_ErfExp,*rrv_offset_ErfExp,*rrv_width_ErfExp);
+  return model_pdf ;
+}
 
-      if(TString(wtagger_label.c_str()).Contains("0v60")){
-        rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),300.,50.,1000.);
-        rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 60.,30.,1000.);
-      }
+static RooAbsPdf* MakeMatchedPdf_ExpGaus(RooWorkspace* workspace, const std::string & label, const std::string & model, const std::string & spectrum, const std::string & wtagger_label, const std::string & channel, std::vector<std::string>* constraint, const int & ismc, RooRealVar* rrv_x){
+  RooRealVar* rrv_c_Exp       = new RooRealVar(("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),-0.05,-0.5,0.5);
+  RooRealVar* rrv_mean1_gaus  = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),84,70,90);
+  RooRealVar* rrv_sigma1_gaus = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),7,4,40);
+  RooRealVar* rrv_frac        = new RooRealVar(("rrv_frac"+label+"_"+channel+spectrum).c_str(),("rrv_frac"+label+"_"+channel+spectrum).c_str(),0.6,0.4,1);
 
-// 300-400 pT, 26% N2DDT Transformation
-/*      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),300.,50.,1000.);
-        rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 60.,30.,1000.);
-      }*/
+  RooExponential* exp         = new RooExponential(("exp"+label+"_"+channel+spectrum).c_str(),("exp"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_Exp);
+  RooGaussian* gaus1          = new RooGaussian(("gaus1"+label+"_"+channel+spectrum).c_str(),("gaus1"+label+"_"+channel+spectrum).c_str(), *rrv_x,*rrv_mean1_gaus,*rrv_sigma1_gaus);
+  RooAddPdf* model_pdf  = new RooAddPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),RooArgList(*exp,*gaus1),RooArgList(*rrv_frac),1);
+  return model_pdf ;
+}
 
-// 400-500 pT, 26% N2DDT Transformation
-/*      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),750.,50.,1000.);
-        rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 180.,30.,1000.);
-      }*/
+static RooAbsPdf* MakeMatchedPdf_ErfExpGaus_sp(RooWorkspace* workspace, const std::string & label, const std::string & model, const std::string & spectrum, const std::string & wtagger_label, const std::string & channel, std::vector<std::string>* constraint, const int & ismc, RooRealVar* rrv_x){
+  RooRealVar* rrv_c_ErfExp    = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-0.2,0.);
+  RooRealVar* rrv_width_ErfExp= new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),30.,10,300.);
+  RooRealVar* rrv_mean1_gaus   = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),80,40,100);
+  RooRealVar* rrv_sigma1_gaus  = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),7,0.,40);
 
-// >500 pT, 26% N2DDT Transformation
-/*      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),100.,-1000.,1000.);
-        rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 180.,30.,10000.);
-      }*/
-
-// 300-400 pT, 5% N2DDT Transformation
-      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),300.,50.,1000.);
-        rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 60.,30.,1000.);
-      }
+  RooErfExpPdf* erfExp        = new RooErfExpPdf(("erfExp"+label+"_"+channel+spectrum).c_str(),("erfExp"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_ErfExp,*rrv_mean1_gaus,*rrv_width_ErfExp);
+  RooGaussian* gaus            = new RooGaussian(("gaus"+label+"_"+channel+spectrum).c_str(),("gaus"+label+"_"+channel+spectrum).c_str(), *rrv_x,*rrv_mean1_gaus,*rrv_sigma1_gaus);
 
-      
-      model_pdf = new RooErfExpPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_ErfExp,*rrv_offset_ErfExp,*rrv_width_ErfExp);
-      RooGaussian* gaus1 = addConstraint(rrv_c_ErfExp,rrv_c_ErfExp->getVal(),c0_tmp_err,constraint);
-      workspace->import(*gaus1);
-      return model_pdf ;
-    }
+  RooRealVar* rrv_high  = new RooRealVar(("rrv_high"+label+"_"+channel+spectrum).c_str(),("rrv_high"+label+"_"+channel+spectrum).c_str(),0.5,0.,1.);
+  if(GetFusedModels()){
+    RooErfExpGausPdf* model_fused = new RooErfExpGausPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_ErfExp,*rrv_mean1_gaus,*rrv_width_ErfExp,*rrv_mean1_gaus,*rrv_sigma1_gaus,*rrv_high);
+    return model_fused ;
   }
+  RooAddPdf* model_pdf  = new RooAddPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),RooArgList(*erfExp,*gaus),RooArgList(*rrv_high));
 
+  return model_pdf ;
+}
 
-  // FOR MC FITS TO MATCHED TT MC!!!    
-  else if( TString(label).Contains("realW") or TString(label).Contains("fakeW")){
-
-    if( model == "Exp"){
-      std::cout<< "######### Exp = levelled exp funtion for W+jets mlvj ############" <<std::endl;
-      RooRealVar* rrv_c_Exp = new RooRealVar(("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),-0.030, -0.2, 0.05);
-      RooExponential* model_pdf = new RooExponential(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_Exp);
-      return model_pdf ;
-    }
-
-    if( model == "ErfExp" ){
-      std::cout<< "########### Erf*Exp for mj fit  ############"<<std::endl;
-      RooRealVar* rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.026);//,-0.05, 0.05);
-      RooRealVar* rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),41.,0.,100);
-      RooRealVar* rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),30.,1.,100.);
-
-      if(TString(label).Contains("_WJets0") ) {
-        rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.0279,-0.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),70.,60.,75.);
-        rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),23.8,20.,30.);
-
-        if(TString(label).Contains("fail") ) {
-          rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.0294,-0.05,0.05);
-          rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),39.,30.,50.);
-          rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),22.5,10.,30.);
-        }
-      }
-
-      RooErfExpPdf* model_pdf       = new RooErfExpPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_ErfExp,*rrv_offset_ErfExp,*rrv_width_ErfExp);
-      return model_pdf ;
-    }
-
-    if( model == "ExpGaus"){
-
-      RooRealVar* rrv_c_Exp       = new RooRealVar(("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),-0.05,-0.5,0.5);
-      RooRealVar* rrv_mean1_gaus  = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),84,70,90);
-      RooRealVar* rrv_sigma1_gaus = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),7,4,40);
-      RooRealVar* rrv_high        = new RooRealVar(("rrv_high"+label+"_"+channel+spectrum).c_str(),("rrv_high"+label+"_"+channel+spectrum).c_str(),0.,0.,1.);
-      RooRealVar* rrv_frac = new RooRealVar(("rrv_frac"+label+"_"+channel+spectrum).c_str(),("rrv_frac"+label+"_"+channel+spectrum).c_str(),0.6,0.4,1);
-      
-      if( TString(label).Contains("_STop_failN2DDTcut" ) ) {
-        rrv_c_Exp       = new RooRealVar(("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),-0.03,-0.5,0.5);
-        rrv_mean1_gaus  = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),84,60,120); //Too narrow limits here often lead to error!! eg max 80
-        rrv_sigma1_gaus = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),7,4,60);
-      }
-      if( TString(label).Contains("_VV") ) {
-        rrv_c_Exp       = new RooRealVar(("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),-0.005,-0.2,0.2);
-        rrv_mean1_gaus  = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),90,0.,150.);
-        rrv_sigma1_gaus = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),7,4.,50.);
-      }
-      RooExponential* exp         = new RooExponential(("exp"+label+"_"+channel+spectrum).c_str(),("exp"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_Exp);
-      RooGaussian* gaus1           = new RooGaussian(("gaus1"+label+"_"+channel+spectrum).c_str(),("gaus1"+label+"_"+channel+spectrum).c_str(), *rrv_x,*rrv_mean1_gaus,*rrv_sigma1_gaus);
-      RooAddPdf* model_pdf  = new RooAddPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),RooArgList(*exp,*gaus1),RooArgList(*rrv_frac),1);
-//      RooAddPdf* model_pdf  = new RooAddPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),RooArgList(*exp,*gaus1),RooArgList(*rrv_high));
-      return model_pdf ;
-    }
-
-    if( model == "ErfExpGaus_sp"){
-
-      RooRealVar* rrv_c_ErfExp    = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-0.2,0.);
-      RooRealVar* rrv_width_ErfExp= new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),30.,10,300.);
-      RooRealVar* rrv_mean1_gaus   = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),80,40,100);
-      RooRealVar* rrv_sigma1_gaus  = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),7,0.,40);
-
-      RooErfExpPdf* erfExp        = new RooErfExpPdf(("erfExp"+label+"_"+channel+spectrum).c_str(),("erfExp"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_ErfExp,*rrv_mean1_gaus,*rrv_width_ErfExp);
-      RooGaussian* gaus            = new RooGaussian(("gaus"+label+"_"+channel+spectrum).c_str(),("gaus"+label+"_"+channel+spectrum).c_str(), *rrv_x,*rrv_mean1_gaus,*rrv_sigma1_gaus);
-
-      RooRealVar* rrv_high  = new RooRealVar(("rrv_high"+label+"_"+channel+spectrum).c_str(),("rrv_high"+label+"_"+channel+spectrum).c_str(),0.5,0.,1.);
-      RooAddPdf* model_pdf  = new RooAddPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),RooArgList(*erfExp,*gaus),RooArgList(*rrv_high));
-
-      return model_pdf ;
-    }
-
-    if( model == "GausErfExp_ttbar"){
-
-      double mean1_tmp = 8.02653e+01;
-      double sigma1_tmp = 7.5932e+00;
-      float rangeMean = 6. ;
-      float rangeWidth = 5. ;
-      double frac_tmp = 0.6;
-      double c0_tmp     = -2.7180e-02 ;      //double c0_tmp_err     = 6.83e-03;
-      double offset_tmp =  8.6888e+01 ;      //double offset_tmp_err = 9.35e+00;
-      double width_tmp  =  2.9860e+01 ;      //double width_tmp_err  = 2.97e+00;  
-      
-      if(TString(wtagger_label.c_str()).Contains("0v60")){
-        mean1_tmp = 8.2402e+01;   
-        sigma1_tmp = 7.5645e+00;            
-        rangeMean = 10. ;
-        rangeWidth = 10. ;
-        c0_tmp     = -4.2672e-02 ;
-        offset_tmp =  8.5656e+01 ;
-        width_tmp  =  2.5308e+01  ;
-      }
-      if(TString(wtagger_label.c_str()).Contains("_DDT")){
-        mean1_tmp = 86.;   
-        sigma1_tmp = 7.2154e+0;            
-        rangeMean = 6. ;
-        rangeWidth = 5. ;
-        c0_tmp     = -1.7193e-01 ;
-        offset_tmp =  1.1819e+02 ;
-        width_tmp  =  2.3273e+01  ;
-        
-        if(TString(wtagger_label.c_str()).Contains("0v52")){
-          mean1_tmp = 8.7637e+01;   
-          sigma1_tmp = 8.2736e+00;            
-          rangeMean = 6. ;
-          rangeWidth = 5. ;
-          c0_tmp     = -2.5333e-01 ;
-          offset_tmp =  1.6746e+02 ;
-          width_tmp  =  2.6201e+01  ;
-        }
-      }
-
-      RooRealVar* rrv_mean1_gaus  = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),mean1_tmp, mean1_tmp-rangeMean, mean1_tmp+rangeMean);
-      RooRealVar* rrv_sigma1_gaus = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),sigma1_tmp, sigma1_tmp-rangeWidth,sigma1_tmp+rangeWidth );
-      RooGaussian* gaus1 = new RooGaussian(("gaus1"+label+"_"+channel+spectrum).c_str(),("gaus1"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_mean1_gaus,*rrv_sigma1_gaus);
-
-      RooRealVar* rrv_frac = new RooRealVar(("rrv_frac"+label+"_"+channel+spectrum).c_str(),("rrv_frac"+label+"_"+channel+spectrum).c_str(),frac_tmp,0.4,1);
-      RooRealVar* rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),c0_tmp,-10,10.);
-      RooRealVar* rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),offset_tmp,0.,100.);
-      RooRealVar* rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),width_tmp,0.,100.);
-
-      if(TString(wtagger_label.c_str()).Contains("0v90")){
-	rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),190.,-1000.,1000.);
-	rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),80.,-1000.,1000.);
-      }
-
-      if(TString(wtagger_label.c_str()).Contains("0v80")){
-	rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.03,-10,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),350.,-1000.,1000.);
-        rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),140.,-1000.,1000.);
-      }
-
-// 300-400 pT, 26% N2DDT Transformation
-/*      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.07,-0.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),350.,10.,1000.);
-        rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),140.,10.,1000.);
-      }*/
-
-// >450 pT, 5% N2DDT Transformation
-/*      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.07,-0.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),550.,10.,1000.);
-        rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),100.,10.,1000.);
-      }*/
-
-// >400 pT, 5% N2DDT Transformation
-      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.07,-0.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),100.,10.,1000.);
-        rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),100.,10.,1000.);
-      }
-
-// 300-450 pT, 5% N2DDT Transformation
-/*      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.07,-0.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),100.,10.,1000.);
-        rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),100.,10.,1000.);
-      }*/
-      
-      RooErfExpPdf* erfExp = new RooErfExpPdf(("erfExp"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_ErfExp,*rrv_offset_ErfExp,*rrv_width_ErfExp);
-      RooAddPdf* model_pdf = new RooAddPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),RooArgList(*gaus1,*erfExp),RooArgList(*rrv_frac),1);
-
-      return model_pdf ;
-    }
-
-    if( model == "2Gaus_ttbar"){
-
-      double mean1_tmp = 8.5934e+01;
-      double sigma1_tmp = 8.1149e+00;
-      float rangeMean = 5. ;
-      float rangeWidth = 5. ;
-      double frac_tmp = 7.3994e-01 ;
-      double deltamean_tmp  = 9.499 ;
-      double scalesigma_tmp = 2.5752;
-
-      if(TString(wtagger_label.c_str()).Contains("76X")){
-        frac_tmp = 7.3739e-01 ; 
-        deltamean_tmp  = 7.81599999999998829e+00 ;
-        scalesigma_tmp = 2.74416583258705149e+00;
-      }
-
-      RooRealVar* rrv_mean1_gaus  = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),mean1_tmp, mean1_tmp-rangeMean, mean1_tmp+rangeMean);
-      RooRealVar* rrv_sigma1_gaus = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),sigma1_tmp, sigma1_tmp-rangeWidth,sigma1_tmp+rangeWidth );
-
-      if( TString(label.c_str()).Contains("fail") ){
-        if( TString(label).Contains("data") ) {
-          rrv_mean1_gaus  = workspace->var(("rrv_mean1_gaus_ttbar_data_"+channel+spectrum).c_str());
-          rrv_sigma1_gaus = workspace->var(("rrv_sigma1_gaus_ttbar_data_"+channel+spectrum).c_str());
-        }
-        else if( TString(label).Contains("TotalMC") ) {
-          rrv_mean1_gaus  = workspace->var(("rrv_mean1_gaus_ttbar_TotalMC_"+channel+spectrum).c_str());
-          rrv_sigma1_gaus = workspace->var(("rrv_sigma1_gaus_ttbar_TotalMC_"+channel+spectrum).c_str());
-        }
-      }
-
-      RooGaussian* gaus1 = new RooGaussian(("gaus1"+label+"_"+channel+spectrum).c_str(),("gaus1"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_mean1_gaus,*rrv_sigma1_gaus);
-
-      
+static RooAbsPdf* MakeMatchedPdf_GausErfExp_ttbar(RooWorkspace* workspace, const std::string & label, const std::string & model, const std::string & spectrum, const std::string & wtagger_label, const std::string & channel, std::vector<std::string>* constraint, const int & ismc, RooRealVar* rrv_x){
+  RooRealVar* rrv_mean1_gaus  = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),8.02653e+01,7.42653e+01,8.62653e+01);
+  RooRealVar* rrv_sigma1_gaus = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),7.5932e+00,2.5932e+00,1.25932e+01);
+  RooGaussian* gaus1 = new RooGaussian(("gaus1"+label+"_"+channel+spectrum).c_str(),("gaus1"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_mean1_gaus,*rrv_sigma1_gaus);
+
+  RooRealVar* rrv_frac = new RooRealVar(("rrv_frac"+label+"_"+channel+spectrum).c_str(),("rrv_frac"+label+"_"+channel+spectrum).c_str(),0.6,0.4,1);
+  RooRealVar* rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-2.7180e-02,-10,10.);
+  RooRealVar* rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),8.6888e+01,0.,100.);
+  RooRealVar* rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),2.9860e+01,0.,100.);
+
+  RooErfExpPdf* erfExp = new RooErfExpPdf(("erfExp"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_ErfExp,*rrv_offset_ErfExp,*rrv_width_ErfExp);
+  if(GetFusedModels()){
+    // the gaussian alone is still picked up from the workspace by GausExp_failN2DDTcut
+    workspace->import(*gaus1);
+    RooGausErfExpPdf* model_fused = new RooGausErfExpPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_mean1_gaus,*rrv_sigma1_gaus,*rrv_c_ErfExp,*rrv_offset_ErfExp,*rrv_width_ErfExp,*rrv_frac);
+    return model_fused ;
+  }
+  RooAddPdf* model_pdf = new RooAddPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),RooArgList(*gaus1,*erfExp),RooArgList(*rrv_frac),1);
 
-      RooRealVar* rrv_deltamean_gaus  = new RooRealVar(("rrv_deltamean_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_deltamean_gaus"+label+"_"+channel+spectrum).c_str(),deltamean_tmp,0,30);
-      RooFormulaVar* rrv_mean2_gaus   = new RooFormulaVar(("rrv_mean2_gaus"+label+"_"+channel+spectrum).c_str(),"@0+@1",RooArgList(*rrv_mean1_gaus,*rrv_deltamean_gaus));
-      RooRealVar* rrv_scalesigma_gaus = new RooRealVar(("rrv_scalesigma_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_scalesigma_gaus"+label+"_"+channel+spectrum).c_str(),scalesigma_tmp,0,5);
-      RooFormulaVar* rrv_sigma2_gaus  = new RooFormulaVar(("rrv_sigma2_gaus"+label+"_"+channel+spectrum).c_str(),"@0*@1", RooArgList(*rrv_sigma1_gaus,*rrv_scalesigma_gaus));
-      RooGaussian* gaus2 = new RooGaussian(("gaus2"+label+"_"+channel+spectrum).c_str(),("gaus2"+label+"_"+channel+spectrum).c_str(), *rrv_x,*rrv_mean2_gaus,*rrv_sigma2_gaus);
+  return model_pdf ;
+}
 
-      RooRealVar* rrv_frac = new RooRealVar(("rrv_frac"+label+"_"+channel+spectrum).c_str(),("rrv_frac"+label+"_"+channel+spectrum).c_str(),frac_tmp,0,1);//,frac_tmp-frac_tmp_err,frac_tmp+frac_tmp_err);
-      RooAddPdf* model_pdf = new RooAddPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),RooArgList(*gaus1,*gaus2),RooArgList(*rrv_frac),1);
+static RooAbsPdf* MakeMatchedPdf_2Gaus_ttbar(RooWorkspace* workspace, const std::string & label, const std::string & model, const std::string & spectrum, const std::string & wtagger_label, const std::string & channel, std::vector<std::string>* constraint, const int & ismc, RooRealVar* rrv_x){
+  RooRealVar* rrv_mean1_gaus  = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),8.5934e+01,8.0934e+01,9.0934e+01);
+  RooRealVar* rrv_sigma1_gaus = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),8.1149e+00,3.1149e+00,1.31149e+01);
 
-      return model_pdf ;
+  // the fail sample shares the peak of the pass sample
+  if( TString(label.c_str()).Contains("fail") ){
+    if( TString(label).Contains("data") ) {
+      rrv_mean1_gaus  = workspace->var(("rrv_mean1_gaus_ttbar_data_"+channel+spectrum).c_str());
+      rrv_sigma1_gaus = workspace->var(("rrv_sigma1_gaus_ttbar_data_"+channel+spectrum).c_str());
     }
-
-    if( model == "GausChebychev_ttbar_failN2DDTcut"){
-
-      RooAbsPdf* model_pdf = NULL ;
-
-      double p0_tmp = 3.1099e-01 ; double p0_tmp_err = 1.86e-01;
-      double p1_tmp = -2.2128e-01; double p1_tmp_err = 3.02e-01;
-      double frac_tmp =  4.6400e-01  ; double frac_tmp_err = 1.20e-01;
-
-      if(TString(wtagger_label.c_str()).Contains("76X")){
-        p0_tmp = 2.1208e-01 ;
-        p1_tmp = -3.2198e-01;
-        frac_tmp = 4.3714e-01;
-      }
-
-      // take the same gaussian used in the pass sample
-      RooAbsPdf* gaus = NULL ;
-      if( TString(label).Contains("data"   ) ) gaus = workspace->pdf(("gaus1_ttbar_data_"+channel+spectrum).c_str());
-      if( TString(label).Contains("TotalMC") ) gaus = workspace->pdf(("gaus1_ttbar_TotalMC_"+channel+spectrum).c_str());
-      if( TString(label).Contains("realW")   ) gaus = workspace->pdf(("gaus1_TTbar_realW_"+channel+spectrum).c_str());
-
-      RooRealVar* rrv_p0_cheb = new RooRealVar(("rrv_p0_cheb"+label+"_"+channel+spectrum).c_str(),("rrv_p0_cheb"+label+"_"+channel+spectrum).c_str(),p0_tmp,0.,1.);
-      RooRealVar* rrv_p1_cheb = new RooRealVar(("rrv_p1_cheb"+label+"_"+channel+spectrum).c_str(),("rrv_p1_cheb"+label+"_"+channel+spectrum).c_str(),p1_tmp,-1.,0.);//,p1_tmp-p1_tmp_err,p1_tmp+p1_tmp_err);
-
-      RooChebychev* cheb = new RooChebychev(("cheb"+label+"_"+channel+spectrum).c_str(),("cheb"+label+"_"+channel+spectrum).c_str(), *rrv_x, RooArgList(*rrv_p0_cheb,*rrv_p1_cheb) );
-
-      RooRealVar* rrv_frac = new RooRealVar(("rrv_frac"+label+"_"+channel+spectrum).c_str(),("rrv_frac"+label+"_"+channel+spectrum).c_str(),frac_tmp,0.,1.);
-      model_pdf = new RooAddPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),RooArgList(*gaus,*cheb),RooArgList(*rrv_frac),1);
-
-      return model_pdf ;
+    else if( TString(label).Contains("TotalMC") ) {
+      rrv_mean1_gaus  = workspace->var(("rrv_mean1_gaus_ttbar_TotalMC_"+channel+spectrum).c_str());
+      rrv_sigma1_gaus = workspace->var(("rrv_sigma1_gaus_ttbar_TotalMC_"+channel+spectrum).c_str());
     }
+  }
 
-    if( model == "GausErfExp_ttbar_failN2DDTcut"){
-
-      double c0_tmp     = -5.5276e-02;      double c0_tmp_err = 1.46e-02;
-      double offset_tmp = 198. ;      double offset_tmp_err = 4.92e+01;
-      double width_tmp  = 64.8  ;      double width_tmp_err = 4.69e+00;
-      double frac_tmp   = 0.4;
-      
-      RooAbsPdf* model_pdf = NULL ;
-      
-      if(TString(wtagger_label.c_str()).Contains("0v40")){
-        c0_tmp = -7.2072e-02    ;     
-        offset_tmp = 1.8361e+02  ;    
-        width_tmp = 5.3578e+01  ;
-        frac_tmp = 4.2724e-01;
-        
-      }
-      
-      
-      if(TString(wtagger_label.c_str()).Contains("0v60")){
-        c0_tmp = -7.3294e-03    ;     
-        offset_tmp = 3.7914e+01 ;    
-        width_tmp = 2.6943e+01  ;
-      }
-      if(TString(wtagger_label.c_str()).Contains("_DDT")){
-        c0_tmp = -9.3552e-02    ;     
-        offset_tmp = 1.4301e+02 ;    
-        width_tmp = 3.5879e+01  ;
-        if(TString(wtagger_label.c_str()).Contains("0v52")){
-          c0_tmp = -1.7229e-01    ;     
-          offset_tmp = 2.3192e+02 ;    
-          width_tmp = 4.0557e+01  ;
-        }
-      }
-   
-      // take the same gaussian used in the pass sample
-      RooAbsPdf* gaus = NULL ;
-      if( TString(label).Contains("data"   ) ) gaus = workspace->pdf(("gaus1_ttbar_data_"+channel+spectrum).c_str());
-      if( TString(label).Contains("TotalMC") ) gaus = workspace->pdf(("gaus1_ttbar_TotalMC_"+channel+spectrum).c_str());
-      if( TString(label).Contains("realW")   ) gaus = workspace->pdf(("gaus1_TTbar_realW_"+channel+spectrum).c_str());
-      
-      // double mean1_tmp  = 8.7486e+01;
-      //     double sigma1_tmp = 8.7456e+00;
-      //     RooRealVar* rrv_mean1_gaus  = new RooRealVar(("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_mean1_gaus"+label+"_"+channel+spectrum).c_str(),mean1_tmp, mean1_tmp-15, mean1_tmp+15);
-      //     RooRealVar* rrv_sigma1_gaus = new RooRealVar(("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_sigma1_gaus"+label+"_"+channel+spectrum).c_str(),sigma1_tmp, sigma1_tmp-3,sigma1_tmp+3 );
-      //     RooGaussian* gaus = new RooGaussian(("gaus"+label+"_"+channel+spectrum).c_str(),("gaus1"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_mean1_gaus,*rrv_sigma1_gaus);
-      //
-      
-
-      RooRealVar* rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.06,-0.2,0.);//,c0_tmp-4e-2, c0_tmp+4e-2);
-      RooRealVar* rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),152.,30.,1000.);//,offset_tmp-offset_tmp_err,offset_tmp+offset_tmp_err);
-      RooRealVar* rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 64.8,30.,200);//,width_tmp-width_tmp_err, width_tmp+width_tmp_err);
-
-// < 300 pT, 26% transformation
-/*      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-0.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),210.,30.,1000.);
-        rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 50.,10.,1000);
-      }*/
-
-// 300-400 pT, 26% transformation
-/*      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-10.,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),150.,30.,1000.);
-        rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 65.,10.,1000);
-      }*/
-
-// 400-500 pT, 26% transformation
-/*      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-10.,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),150.,30.,1000.);
-        rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 65.,10.,1000);
-      }*/
-
-// >500 pT, 26% transformation
-/*      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-10.,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),500.,30.,1000.);
-        rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 80.,10.,1000);
-      }*/
-
-// >450 pT, 5% Transformation
-      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-10.,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),100.,30.,1000.);
-        rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 80.,10.,1000);
-      }
-
-
-      if(TString(wtagger_label.c_str()).Contains("0v80")){
-        rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-0.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),210.,30.,1000.);
-        rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 50.,10.,1000);
-      }
-
-      if(TString(wtagger_label.c_str()).Contains("0v60")){
-        rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-0.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),210.,30.,1000.);
-        rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 50.,10.,1000);
-      }
-
+  RooGaussian* gaus1 = new RooGaussian(("gaus1"+label+"_"+channel+spectrum).c_str(),("gaus1"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_mean1_gaus,*rrv_sigma1_gaus);
 
-      if(TString(wtagger_label.c_str()).Contains("0v30")){
-//        std::cout<<"AM I HERE??" << std::endl;
-	rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-0.2,0.);
-	rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),130.,30.,1000.);
-	rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 50.,30.,200);
-      }
+  RooRealVar* rrv_deltamean_gaus  = new RooRealVar(("rrv_deltamean_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_deltamean_gaus"+label+"_"+channel+spectrum).c_str(),9.499,0,30);
+  RooFormulaVar* rrv_mean2_gaus   = new RooFormulaVar(("rrv_mean2_gaus"+label+"_"+channel+spectrum).c_str(),"@0+@1",RooArgList(*rrv_mean1_gaus,*rrv_deltamean_gaus));
+  RooRealVar* rrv_scalesigma_gaus = new RooRealVar(("rrv_scalesigma_gaus"+label+"_"+channel+spectrum).c_str(),("rrv_scalesigma_gaus"+label+"_"+channel+spectrum).c_str(),2.5752,0,5);
+  RooFormulaVar* rrv_sigma2_gaus  = new RooFormulaVar(("rrv_sigma2_gaus"+label+"_"+channel+spectrum).c_str(),"@0*@1", RooArgList(*rrv_sigma1_gaus,*rrv_scalesigma_gaus));
+  RooGaussian* gaus2 = new RooGaussian(("gaus2"+label+"_"+channel+spectrum).c_str(),("gaus2"+label+"_"+channel+spectrum).c_str(), *rrv_x,*rrv_mean2_gaus,*rrv_sigma2_gaus);
 
-/*      if(TString(wtagger_label.c_str()).Contains("0v60")){
-        std::cout<<"AM I HERE??" << std::endl;
-        rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-0.2,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),210.,30.,1000.);
-        rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 50.,30.,200);
-      }*/
+  RooRealVar* rrv_frac = new RooRealVar(("rrv_frac"+label+"_"+channel+spectrum).c_str(),("rrv_frac"+label+"_"+channel+spectrum).c_str(),7.3994e-01,0,1);
+  RooAddPdf* model_pdf = new RooAddPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),RooArgList(*gaus1,*gaus2),RooArgList(*rrv_frac),1);
 
-      RooErfExpPdf* erfExp = new RooErfExpPdf(("erfExp"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_ErfExp,*rrv_offset_ErfExp,*rrv_width_ErfExp);
+  return model_pdf ;
+}
 
-//      RooRealVar* rrv_frac = new RooRealVar(("rrv_frac"+label+"_"+channel+spectrum).c_str(),("rrv_frac"+label+"_"+channel+spectrum).c_str(),frac_tmp,0.,1.);
-      RooRealVar* rrv_frac = new RooRealVar(("rrv_frac"+label+"_"+channel+spectrum).c_str(),("rrv_frac"+label+"_"+channel+spectrum).c_str(),0.5,0.,1.);
-      
-      model_pdf = new RooAddPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),RooArgList(*gaus,*erfExp),RooArgList(*rrv_frac),1);
+static RooAbsPdf* MakeMatchedPdf_GausChebychev_ttbar_failN2DDTcut(RooWorkspace* workspace, const std::string & label, const std::string & model, const std::string & spectrum, const std::string & wtagger_label, const std::string & channel, std::vector<std::string>* constraint, const int & ismc, RooRealVar* rrv_x){
+  RooAbsPdf* model_pdf = NULL ;
 
-      return model_pdf ;
-    }
+  // take the same gaussian used in the pass sample
+  RooAbsPdf* gaus = NULL ;
+  if( TString(label).Contains("data"   ) ) gaus = workspace->pdf(("gaus1_ttbar_data_"+channel+spectrum).c_str());
+  if( TString(label).Contains("TotalMC") ) gaus = workspace->pdf(("gaus1_ttbar_TotalMC_"+channel+spectrum).c_str());
+  if( TString(label).Contains("realW")   ) gaus = workspace->pdf(("gaus1_TTbar_realW_"+channel+spectrum).c_str());
 
-    if( model == "GausExp_failN2DDTcut"){
-      RooAbsPdf* model_pdf = NULL ;
+  RooRealVar* rrv_p0_cheb = new RooRealVar(("rrv_p0_cheb"+label+"_"+channel+spectrum).c_str(),("rrv_p0_cheb"+label+"_"+channel+spectrum).c_str(),3.1099e-01,0.,1.);
+  RooRealVar* rrv_p1_cheb = new RooRealVar(("rrv_p1_cheb"+label+"_"+channel+spectrum).c_str(),("rrv_p1_cheb"+label+"_"+channel+spectrum).c_str(),-2.2128e-01,-1.,0.);
 
-      RooAbsPdf* gaus = NULL ;
-      if( TString(label).Contains("data"   ) ) gaus = workspace->pdf(("gaus1_ttbar_data_"+channel+spectrum).c_str());
-      if( TString(label).Contains("TotalMC") ) gaus = workspace->pdf(("gaus1_ttbar_TotalMC_"+channel+spectrum).c_str());
-      if( TString(label).Contains("realW")   ) gaus = workspace->pdf(("gaus1_TTbar_realW_"+channel+spectrum).c_str());
+  RooChebychev* cheb = new RooChebychev(("cheb"+label+"_"+channel+spectrum).c_str(),("cheb"+label+"_"+channel+spectrum).c_str(), *rrv_x, RooArgList(*rrv_p0_cheb,*rrv_p1_cheb) );
 
-      RooRealVar* rrv_c_Exp       = new RooRealVar(("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),-0.05,-0.5,0.5);
+  RooRealVar* rrv_frac = new RooRealVar(("rrv_frac"+label+"_"+channel+spectrum).c_str(),("rrv_frac"+label+"_"+channel+spectrum).c_str(),4.6400e-01,0.,1.);
+  model_pdf = new RooAddPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),RooArgList(*gaus,*cheb),RooArgList(*rrv_frac),1);
 
-// >450 pT, 5% Transformation
-      if(TString(wtagger_label.c_str()).Contains("0v00")){
-	rrv_c_Exp       = new RooRealVar(("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),-0.05,-0.5,0.5);
-      }
+  return model_pdf ;
+}
 
-      RooExponential* exp         = new RooExponential(("exp"+label+"_"+channel+spectrum).c_str(),("exp"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_Exp);
-      RooRealVar* rrv_frac = new RooRealVar(("rrv_frac"+label+"_"+channel+spectrum).c_str(),("rrv_frac"+label+"_"+channel+spectrum).c_str(),0.5,0.,1.);
+static RooAbsPdf* MakeMatchedPdf_GausErfExp_ttbar_failN2DDTcut(RooWorkspace* workspace, const std::string & label, const std::string & model, const std::string & spectrum, const std::string & wtagger_label, const std::string & channel, std::vector<std::string>* constraint, const int & ismc, RooRealVar* rrv_x){
+  RooAbsPdf* model_pdf = NULL ;
 
-      model_pdf = new RooAddPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),RooArgList(*gaus,*exp),RooArgList(*rrv_frac),1);
+  // take the same gaussian used in the pass sample
+  RooAbsPdf* gaus = NULL ;
+  if( TString(label).Contains("data"   ) ) gaus = workspace->pdf(("gaus1_ttbar_data_"+channel+spectrum).c_str());
+  if( TString(label).Contains("TotalMC") ) gaus = workspace->pdf(("gaus1_ttbar_TotalMC_"+channel+spectrum).c_str());
+  if( TString(label).Contains("realW")   ) gaus = workspace->pdf(("gaus1_TTbar_realW_"+channel+spectrum).c_str());
 
-      return model_pdf ;
+  RooRealVar* rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.06,-0.2,0.);
+  RooRealVar* rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),152.,30.,1000.);
+  RooRealVar* rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),64.8,30.,200);
+  RooRealVar* rrv_frac = new RooRealVar(("rrv_frac"+label+"_"+channel+spectrum).c_str(),("rrv_frac"+label+"_"+channel+spectrum).c_str(),0.5,0.,1.);
 
+  RooErfExpPdf* erfExp = new RooErfExpPdf(("erfExp"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_ErfExp,*rrv_offset_ErfExp,*rrv_width_ErfExp);
+  model_pdf = new RooAddPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),RooArgList(*gaus,*erfExp),RooArgList(*rrv_frac),1);
 
-    }
+  return model_pdf ;
+}
 
-    if( model == "ErfExp_ttbar"){
+static RooAbsPdf* MakeMatchedPdf_GausExp_failN2DDTcut(RooWorkspace* workspace, const std::string & label, const std::string & model, const std::string & spectrum, const std::string & wtagger_label, const std::string & channel, std::vector<std::string>* constraint, const int & ismc, RooRealVar* rrv_x){
+  RooAbsPdf* model_pdf = NULL ;
 
-      double c0_tmp     = -2.7180e-02 ;      double c0_tmp_err     = 6.83e-03;
-      double offset_tmp =  8.6888e+01 ;      double offset_tmp_err = 9.35e+00;
-      double width_tmp  =  2.9860e+01 ;      double width_tmp_err  = 2.97e+00;
+  RooAbsPdf* gaus = NULL ;
+  if( TString(label).Contains("data"   ) ) gaus = workspace->pdf(("gaus1_ttbar_data_"+channel+spectrum).c_str());
+  if( TString(label).Contains("TotalMC") ) gaus = workspace->pdf(("gaus1_ttbar_TotalMC_"+channel+spectrum).c_str());
+  if( TString(label).Contains("realW")   ) gaus = workspace->pdf(("gaus1_TTbar_realW_"+channel+spectrum).c_str());
 
-      if(TString(wtagger_label.c_str()).Contains("76X")){
-        c0_tmp     = -1.9681e-02 ;
-        offset_tmp =  7.4564e+01 ;
-        width_tmp  =  2.6397e+01 ;
-      }
-      if(TString(wtagger_label.c_str()).Contains("0v60")){
-        c0_tmp     = -2.9373e-02 ;  
-        offset_tmp =  8.2980e+01 ;
-        width_tmp  =  3.6133e+01 ;
-        if(TString(wtagger_label.c_str()).Contains("76X")){
-          c0_tmp     = -2.2689e-02 ;
-          offset_tmp =  6.9803e+01 ;
-          width_tmp  =  3.2077e+01 ;
-        }
-      }
-      if( TString(wtagger_label.c_str()).Contains("PuppiSD") ){
-        c0_tmp     =  -2.1046e-02 ;
-        offset_tmp =  8.0122e+01 ;
-        width_tmp  =  2.9595e+01 ;
-      }
+  RooRealVar* rrv_c_Exp       = new RooRealVar(("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),("rrv_c_Exp"+label+"_"+channel+spectrum).c_str(),-0.05,-0.5,0.5);
+  RooExponential* exp         = new RooExponential(("exp"+label+"_"+channel+spectrum).c_str(),("exp"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_Exp);
+  RooRealVar* rrv_frac = new RooRealVar(("rrv_frac"+label+"_"+channel+spectrum).c_str(),("rrv_frac"+label+"_"+channel+spectrum).c_str(),0.5,0.,1.);
 
-      if(TString(wtagger_label.c_str()).Contains("_DDT")){
-        c0_tmp     = -6.0079e-02 ;
-        offset_tmp =  1.4980e+02 ;
-        width_tmp  =  4.8168e+01 ;
-        if(TString(wtagger_label.c_str()).Contains("0v52")){
-          c0_tmp = -3.1793e-02    ;     
-          offset_tmp = 9.7997e+01 ;    
-          width_tmp = 3.8820e+01  ;
-        }
-        
-      }
-      
-      RooRealVar* rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.02,-.5,0.);
-      RooRealVar* rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),80.,50.,1000.);
-      RooRealVar* rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),35.,20.,1000.);
-
-      if(TString(wtagger_label.c_str()).Contains("0v40")){
-	std::cout<<"WHERE???" << std::endl;
-	rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),c0_tmp,c0_tmp-4e-2, c0_tmp+4e-2 );
-	rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),100.,50.,1000.);
-	rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),30.,10.,100.);
-      }
+  model_pdf = new RooAddPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),RooArgList(*gaus,*exp),RooArgList(*rrv_frac),1);
 
-// < 300 pT, 26% N2DDT Transformation
-/*      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        std::cout<<"WHERE???" << std::endl;
-        rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.07,-.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),150.,50.,1000.);
-        rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),30.,10.,500.);
-      }*/
-
-// 300-400 pT, 26% N2DDT Transformation
-/*      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        std::cout<<"WHERE???" << std::endl;
-        rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.07,-.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),150.,50.,1000.);
-        rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),30.,10.,500.);
-      }*/
-
-// 400-500 pT, 26% N2DDT Transformation
-/*      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.07,-.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),300.,50.,1000.);
-        rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),70.,10.,500.);
-      }*/
+  return model_pdf ;
+}
 
-// >500 pT, 26% N2DDT Transformation
-/*     if(TString(wtagger_label.c_str()).Contains("0v00")){
-       rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.07,-.5,0.);
-       rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),450.,50.,1000.);
-       rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),100.,10.,500.);
-      }*/
-
-// >450 pT, 5% N2DDT Transformation
-/*     if(TString(wtagger_label.c_str()).Contains("0v00")){
-       rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.07,-.5,0.);
-       rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),450.,50.,1000.);
-       rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),100.,10.,500.);
-      }*/
-
-// >400 pT, 5% N2DDT Transformation
-/*     if(TString(wtagger_label.c_str()).Contains("0v00")){
-       rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.07,-.5,0.);
-       rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),200.,50.,1000.);
-       rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),50.,10.,1000.);
-      }*/
-
-// <300 pT, 5% N2DDT Transformation
-/*     if(TString(wtagger_label.c_str()).Contains("0v00")){
-       rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.07,-.5,0.);
-       rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),80.,50.,1000.);
-       rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),50.,10.,1000.);
-      }*/
-
-// 300-400 pT, 5% N2DDT Transformation
-      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        std::cout<<"WHERE???" << std::endl;
-        rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.07,-.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),150.,50.,1000.);
-        rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),30.,10.,500.);
-      }
-      RooErfExpPdf* model_pdf = new RooErfExpPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_ErfExp,*rrv_offset_ErfExp,*rrv_width_ErfExp);
-
-      RooGaussian* gaus1 = addConstraint(rrv_c_ErfExp,rrv_c_ErfExp->getVal(),c0_tmp_err,constraint);
-      RooGaussian* gaus2 = addConstraint(rrv_offset_ErfExp,rrv_offset_ErfExp->getVal(),offset_tmp_err,constraint);
-      RooGaussian* gaus3 = addConstraint(rrv_width_ErfExp,rrv_width_ErfExp->getVal(),width_tmp_err,constraint);
-      workspace->import(*gaus1);
-      workspace->import(*gaus2);
-      workspace->import(*gaus3);
-      return model_pdf ;
-    }
+static RooAbsPdf* MakeMatchedPdf_ErfExp_ttbar(RooWorkspace* workspace, const std::string & label, const std::string & model, const std::string & spectrum, const std::string & wtagger_label, const std::string & channel, std::vector<std::string>* constraint, const int & ismc, RooRealVar* rrv_x){
+  double c0_tmp_err     = 6.83e-03;
+  double offset_tmp_err = 9.35e+00;
+  double width_tmp_err  = 2.97e+00;
 
-    if( model == "ErfExp_ttbar_failN2DDTcut"){
+  RooRealVar* rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-.02,-.5,0.);
+  RooRealVar* rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),80.,50.,1000.);
+  RooRealVar* rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),35.,20.,1000.);
 
-      RooErfExpPdf* model_pdf = NULL ;
+  RooErfExpPdf* model_pdf = new RooErfExpPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_ErfExp,*rrv_offset_ErfExp,*rrv_width_ErfExp);
 
-      double c0_tmp = -3.0626e-02    ;      double c0_tmp_err = 1.46e-02;
-      double offset_tmp = 5.1636e+01 ;      double offset_tmp_err = 4.92e+01;
-      double width_tmp = 3.6186e+01  ;      double width_tmp_err = 4.69e+00;
+  RooGaussian* gaus1 = addConstraint(rrv_c_ErfExp,rrv_c_ErfExp->getVal(),c0_tmp_err,constraint);
+  RooGaussian* gaus2 = addConstraint(rrv_offset_ErfExp,rrv_offset_ErfExp->getVal(),offset_tmp_err,constraint);
+  RooGaussian* gaus3 = addConstraint(rrv_width_ErfExp,rrv_width_ErfExp->getVal(),width_tmp_err,constraint);
+  workspace->import(*gaus1);
+  workspace->import(*gaus2);
+  workspace->import(*gaus3);
+  return model_pdf ;
+}
 
-      if(TString(wtagger_label.c_str()).Contains("76X")){
-        c0_tmp = -2.8654e-02    ;
-        offset_tmp = 4.5140e+01 ;
-        width_tmp = 3.4083e+01  ;
-      }
-      if(TString(wtagger_label.c_str()).Contains("0v60")){
-        c0_tmp = -3.4131e-02    ;  
-        offset_tmp = 3.3961e+01 ;
-        width_tmp = 3.2876e+01  ;
-        if(TString(wtagger_label.c_str()).Contains("76X")){
-          c0_tmp = -3.3221e-02    ; 
-          offset_tmp = 2.9445e+01 ;
-          width_tmp = 2.5680e+01  ;
-        }
-      }
-      if(TString(wtagger_label.c_str()).Contains("_DDT")){
-        c0_tmp     = -5.9405e-02 ;
-        offset_tmp =  1.4790e+02 ;
-        width_tmp  =  5.3544e+01 ;
-        if(TString(wtagger_label.c_str()).Contains("0v52")){
-          c0_tmp = -4.0722e-02    ;     
-          offset_tmp = 1.0108e+02 ;    
-          width_tmp = 4.9796e+01  ;
-        }
-      }
+static RooAbsPdf* MakeMatchedPdf_ErfExp_ttbar_failN2DDTcut(RooWorkspace* workspace, const std::string & label, const std::string & model, const std::string & spectrum, const std::string & wtagger_label, const std::string & channel, std::vector<std::string>* constraint, const int & ismc, RooRealVar* rrv_x){
+  double c0_tmp_err = 1.46e-02;
 
-      std::cout<<"I SHOULD BE HERE" << std::endl;
-      RooRealVar* rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-.1,0.);
-      RooRealVar* rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),90.,50.,1000.);
-      RooRealVar* rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 60.,30.,1000.);
+  RooRealVar* rrv_c_ErfExp      = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-.1,0.);
+  RooRealVar* rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),90.,50.,1000.);
+  RooRealVar* rrv_width_ErfExp  = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),60.,30.,1000.);
 
-      if(TString(wtagger_label.c_str()).Contains("0v90")){
-	rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-.5,0.);
-	rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),90.,50.,1000.);
-	rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 60.,30.,1000.);
-      }
+  RooErfExpPdf* model_pdf = new RooErfExpPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_ErfExp,*rrv_offset_ErfExp,*rrv_width_ErfExp);
+  RooGaussian* gaus1 = addConstraint(rrv_c_ErfExp,rrv_c_ErfExp->getVal(),c0_tmp_err,constraint);
+  workspace->import(*gaus1);
+  return model_pdf ;
+}
 
-      if(TString(wtagger_label.c_str()).Contains("0v80")){
-        rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),350.,50.,1000.);
-        rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 60.,30.,1000.);
-      }
+////// Model registry: model name -> builder, one map for data/MC and one for matched tt
+static const std::map<std::string,GeneralPdfBuilder> & GeneralPdfBuilders(Bool_t matchedTT){
+  static std::map<std::string,GeneralPdfBuilder> builders, matchedBuilders ;
+  if(builders.empty()){
+    builders["Exp"] = MakeGeneralPdf_Exp ;
+    builders["Gaus"] = MakeGeneralPdf_Gaus ;
+    builders["ErfExp"] = MakeGeneralPdf_ErfExp ;
+    builders["ExpGaus_sp"] = MakeGeneralPdf_ExpGaus_sp ;
+    builders["ExpGaus"] = MakeGeneralPdf_ExpGaus ;
+    builders["ErfExpGaus_sp"] = MakeGeneralPdf_ErfExpGaus_sp ;
+    builders["GausErfExp_ttbar"] = MakeGeneralPdf_GausErfExp_ttbar ;
+    builders["2Gaus_ttbar"] = MakeGeneralPdf_2Gaus_ttbar ;
+    builders["GausChebychev_ttbar_failN2DDTcut"] = MakeGeneralPdf_GausChebychev_ttbar_failN2DDTcut ;
+    builders["GausErfExp_ttbar_failN2DDTcut"] = MakeGeneralPdf_GausErfExp_ttbar_failN2DDTcut ;
+    builders["GausExp_failN2DDTcut"] = MakeGeneralPdf_GausExp_failN2DDTcut ;
+    builders["ErfExp_ttbar"] = MakeGeneralPdf_ErfExp_ttbar ;
+    builders["ErfExp_ttbar_failN2DDTcut"] = MakeGeneralPdf_ErfExp_ttbar_failN2DDTcut ;
+
+    matchedBuilders["Exp"] = MakeMatchedPdf_Exp ;
+    matchedBuilders["ErfExp"] = MakeMatchedPdf_ErfExp ;
+    matchedBuilders["ExpGaus"] = MakeMatchedPdf_ExpGaus ;
+    matchedBuilders["ErfExpGaus_sp"] = MakeMatchedPdf_ErfExpGaus_sp ;
+    matchedBuilders["GausErfExp_ttbar"] = MakeMatchedPdf_GausErfExp_ttbar ;
+    matchedBuilders["2Gaus_ttbar"] = MakeMatchedPdf_2Gaus_ttbar ;
+    matchedBuilders["GausChebychev_ttbar_failN2DDTcut"] = MakeMatchedPdf_GausChebychev_ttbar_failN2DDTcut ;
+    matchedBuilders["GausErfExp_ttbar_failN2DDTcut"] = MakeMatchedPdf_GausErfExp_ttbar_failN2DDTcut ;
+    matchedBuilders["GausExp_failN2DDTcut"] = MakeMatchedPdf_GausExp_failN2DDTcut ;
+    matchedBuilders["ErfExp_ttbar"] = MakeMatchedPdf_ErfExp_ttbar ;
+    matchedBuilders["ErfExp_ttbar_failN2DDTcut"] = MakeMatchedPdf_ErfExp_ttbar_failN2DDTcut ;
+  }
+  return matchedTT ? matchedBuilders : builders ;
+}
 
-      if(TString(wtagger_label.c_str()).Contains("0v60")){
-        rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),300.,50.,1000.);
-        rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 60.,30.,1000.);
-      }
+#endif
 
-// 300-400 pT, 5% N2DDT Transformation
-      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),300.,50.,1000.);
-        rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 60.,30.,1000.);
-      }
+RooAbsPdf* MakeGeneralPdf(RooWorkspace* workspace, const std::string & label, const std::string & model, const std::string & spectrum, const std::string & wtagger_label, const std::string & channel, std::vector<std::string>* constraint, const int & ismc){
+  
+  std::cout<< "Making general PDF for wtagger_label = "<<wtagger_label.c_str() << " model = "<< model.c_str() << " label = "<< label.c_str()<< " ismc = "<< ismc << " channel = "<< channel.c_str()<< std::endl;
 
-// 300-400 pT, 26% N2DDT Transformation
-/*      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),300.,50.,1000.);
-        rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 60.,30.,1000.);
-      }*/
+  RooRealVar* rrv_x = NULL ; 
+  if(TString(spectrum).Contains("_mj"))   rrv_x = workspace->var("rrv_mass_j");
+  if(TString(spectrum).Contains("_mlvj")) rrv_x = workspace->var("rrv_mass_lvj");  
+  
+  
+  Bool_t matchedTT = TString(label).Contains("realW") or TString(label).Contains("fakeW");
 
-// 400-500 pT, 26% N2DDT Transformation
-/*      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),750.,50.,1000.);
-        rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 180.,30.,1000.);
-      }*/
+  const std::map<std::string,GeneralPdfBuilder> & builders = GeneralPdfBuilders(matchedTT);
+  std::map<std::string,GeneralPdfBuilder>::const_iterator builder = builders.find(model);
+  if(builder == builders.end()){
+    std::cout<< "MakeGeneralPdf: no model "<< model.c_str() << (matchedTT ? " for matched tt" : "") << std::endl;
+    return NULL ;
+  }
+  RooAbsPdf* model_pdf = builder->second(workspace,label,model,spectrum,wtagger_label,channel,constraint,ismc,rrv_x);
 
-// >500 pT, 26% N2DDT Transformation
-/*      if(TString(wtagger_label.c_str()).Contains("0v00")){
-        rrv_c_ErfExp = new RooRealVar(("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_c_ErfExp"+label+"_"+channel+spectrum).c_str(),-0.04,-.5,0.);
-        rrv_offset_ErfExp = new RooRealVar(("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_offset_ErfExp"+label+"_"+channel+spectrum).c_str(),100.,-1000.,1000.);
-        rrv_width_ErfExp = new RooRealVar(("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(),("rrv_width_ErfExp"+label+"_"+channel+spectrum).c_str(), 180.,30.,10000.);
-      }*/
+  RooArgSet* params = model_pdf->getParameters(*rrv_x);
+  // the matched tt builders have their own values: their entries are under <model>_matched
+  ApplyModelConfig(workspace,matchedTT ? model+"_matched" : model,wtagger_label,label,*params,label+"_"+channel+spectrum,constraint);
+  delete params ;
+  return model_pdf ;
 
-      
-      model_pdf = new RooErfExpPdf(("model_pdf"+label+"_"+channel+spectrum).c_str(),("model_pdf"+label+"_"+channel+spectrum).c_str(),*rrv_x,*rrv_c_ErfExp,*rrv_offset_ErfExp,*rrv_width_ErfExp);
-      RooGaussian* gaus1 = addConstraint(rrv_c_ErfExp,rrv_c_ErfExp->getVal(),c0_tmp_err,constraint);
-      workspace->import(*gaus1);
-      return model_pdf ;
-    }
-  
-  }
 } //End
@@ -28,12 +28,45 @@
 
 #include "HWWLVJRooPdfs.h"
 
+/// kTRUE: GausErfExp_ttbar, ExpGaus_sp and ErfExpGaus_sp are built as the fused pdfs of HWWLVJRooPdfs
+/// (one object, no RooAddPdf components) instead of RooAddPdf trees. Default kFALSE.
+void   SetFusedModels(Bool_t fused);
+Bool_t GetFusedModels();
+
+/// Tabulated mode of a workspace: the tolerance of the RooTabulatedPdf tables, stored in the workspace as the
+/// constant "tabulated_mode_tolerance" (0 = off). Toy generation and plotting take their pdf from GetTabulatedPdf,
+/// fits keep the exact one.
+void     SetTabulatedMode(RooWorkspace* workspace, Bool_t tabulated, Double_t tolerance = 1e-4);
+Double_t GetTabulatedMode(RooWorkspace* workspace);
+
+/// In tabulated mode the RooTabulatedPdf "<pdf name>_tab" of the workspace (imported on first use, recycling the
+/// nodes of pdf and x found in the workspace), otherwise pdf itself
+RooAbsPdf* GetTabulatedPdf(RooWorkspace* workspace, RooAbsPdf* pdf, RooRealVar* x);
+
+/// Model configuration: per tagger text files of parameter values, ranges and constraints (format in
+/// PDFs/config/N2DDT.txt), read once per job into an index that is applied to every model MakeGeneralPdf builds
+/// and to the ttbar yields of MakeModelTTbarControlSample, on top of the values compiled in the builders.
+/// Returns the number of entries read (0 for a file already loaded, -1 if it cannot be opened).
+Int_t LoadModelConfig(const std::string & fileName);
+void  ClearModelConfig();
+/// Sets the RooRealVars of params named <parameter><suffix> from the entries of model whose selection tokens
+/// all match wtagger_label or the sample label
+Int_t ApplyModelConfig(RooWorkspace* workspace, const std::string & model, const std::string & wtagger_label, const std::string & label, const RooArgSet & params, const std::string & suffix, std::vector<std::string>* constraint);
+
+/// MakeExtendedModel and MakeModelTTbarControlSample build a model once per workspace and key; later calls with the
+/// same arguments return it (the workspace copy once imported) with its parameters back in their initial state (value,
+/// errors, range, constant flag). ClearModelCache forgets all of them; the fit scripts call it for each new fitter.
+void  ClearModelCache();
+
+/// Builds model through the model name registry of MakePdf.cxx; NULL (with a message) for an unknown model
 RooAbsPdf* MakeGeneralPdf(RooWorkspace* ,const std::string & = "", const std::string & = "", const std::string & = "_mj", const std::string & = "em", const std::string & = "HP",  std::vector<std::string>* = NULL, const int & = 0);
 
 RooExtendPdf* MakeExtendedModel(RooWorkspace*, const std::string & = "", const std::string & = "", const std::string & = "_mj", const std::string & = "em", const std::string & wtagger_label = "HP",  std::vector<std::string>* = NULL, const int & = 0, const int & = 500);
 
 RooGaussian* addConstraint(RooRealVar*, double, double,  std::vector<std::string>*);
 
+/// Imports the RooHistPdf "<dataset>_histpdf" unless the workspace already has it, built from the RooDataHist
+/// "<dataset>_template" filled in the tree loop when there is one with the binning of x, from a binned clone otherwise
 void change_dataset_to_histpdf(RooWorkspace*,RooRealVar*,RooDataSet*);
 
 TH1F* change_dataset_to_histogram(RooRealVar*, RooDataSet*, const std::string & = "", const int & = 1);
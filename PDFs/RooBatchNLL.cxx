@@ -0,0 +1,1299 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ *                                                                           *
+ * Unbinned (weighted) NLL evaluated through the batch interface of the      *
+ * HWWLVJRooPdfs shapes                                                      *
+ *****************************************************************************/
+
+#include "Riostream.h"
+
+#include "RooBatchNLL.h"
+#include "RooAddPdf.h"
+#include "RooExtendPdf.h"
+#include "RooSimultaneous.h"
+#include "RooAbsCategory.h"
+#include "RooGaussian.h"
+#include "RooExponential.h"
+#include "RooArgProxy.h"
+#include "RooMinimizer.h"
+#include "Math/IFunction.h"
+#include "Math/Minimizer.h"
+#include "Math/Factory.h"
+#include "Math/MinimizerOptions.h"
+#include "TIterator.h"
+#include "TMatrixDSym.h"
+#include "TMath.h"
+#include "TString.h"
+#include "TObjArray.h"
+#include "TObjString.h"
+#include "TStopwatch.h"
+
+#include "VectorMath.h"
+
+#include <iostream>
+#include <algorithm>
+#include <string.h>
+#include <pthread.h>
+using namespace std;
+
+/// mean and sigma of a RooGaussian, found through its proxies; kFALSE if x is not its observable
+static Bool_t gaussianParams(const RooAbsPdf& pdf, const RooRealVar& x, RooAbsReal*& mean, RooAbsReal*& sigma){
+  mean=0; sigma=0;
+  Bool_t hasX=kFALSE;
+  for(Int_t p=0; p<pdf.numProxies(); p++){
+    RooArgProxy* proxy = dynamic_cast<RooArgProxy*>(pdf.getProxy(p));
+    if(!proxy) continue;
+    if(!strcmp(proxy->name(),"x"))     hasX = !strcmp(proxy->absArg()->GetName(),x.GetName());
+    if(!strcmp(proxy->name(),"mean"))  mean  = dynamic_cast<RooAbsReal*>(proxy->absArg());
+    if(!strcmp(proxy->name(),"sigma")) sigma = dynamic_cast<RooAbsReal*>(proxy->absArg());
+  }
+  return hasX && mean && sigma;
+}
+
+/// slope of a RooExponential, found through its proxies; kFALSE if x is not its observable
+static Bool_t exponentialParams(const RooAbsPdf& pdf, const RooRealVar& x, RooAbsReal*& c){
+  c=0;
+  Bool_t hasX=kFALSE;
+  for(Int_t p=0; p<pdf.numProxies(); p++){
+    RooArgProxy* proxy = dynamic_cast<RooArgProxy*>(pdf.getProxy(p));
+    if(!proxy) continue;
+    if(!strcmp(proxy->name(),"x")) hasX = !strcmp(proxy->absArg()->GetName(),x.GetName());
+    if(!strcmp(proxy->name(),"c")) c = dynamic_cast<RooAbsReal*>(proxy->absArg());
+  }
+  return hasX && c;
+}
+
+/// Central difference of f (of its expected events if expectedEvents) with respect to par, kept inside the range of par
+static Double_t parameterDerivative(const RooAbsReal& f, RooRealVar& par, const RooArgSet* normSet, Bool_t expectedEvents=kFALSE){
+  Double_t value=par.getVal();
+  Double_t step=1e-6*(1.+TMath::Abs(value));
+  Double_t up=value+step, down=value-step;
+  if(par.hasMax() && up>par.getMax())   up=par.getMax();
+  if(par.hasMin() && down<par.getMin()) down=par.getMin();
+  if(up<=down) return 0;
+  par.setVal(up);
+  Double_t fUp   = expectedEvents ? ((const RooAbsPdf&)f).expectedEvents(normSet) : f.getVal(normSet);
+  par.setVal(down);
+  Double_t fDown = expectedEvents ? ((const RooAbsPdf&)f).expectedEvents(normSet) : f.getVal(normSet);
+  par.setVal(value);
+  return (fUp-fDown)/(up-down);
+}
+
+/// d arg / d par: 1 for the parameter itself, a central difference for functions of it, 0 otherwise
+static Double_t chainFactor(const RooAbsReal& arg, RooAbsArg& par){
+  if(&arg==&par) return 1;
+  RooRealVar* var = dynamic_cast<RooRealVar*>(&par);
+  if(!var || !arg.dependsOn(par)) return 0;
+  return parameterDerivative(arg,*var,0);
+}
+
+void evaluatePdfBatch(const RooAbsPdf& pdf, RooRealVar& x, const Double_t* xs, Double_t* out, Int_t n, const RooArgSet* normSet){
+
+  /// shapes from HWWLVJRooPdfs: one array call + one (cached) normalisation integral
+  const RooBatchPdf* batchPdf = dynamic_cast<const RooBatchPdf*>(&pdf);
+  if(batchPdf){
+    batchPdf->evaluateBatch(xs,out,n);
+    Double_t norm = pdf.getNorm(normSet);
+    for(Int_t i=0; i<n; i++) out[i]/=norm;
+    return;
+  }
+
+  /// gaussian peak: array exp, RooGaussian analytic normalisation
+  RooAbsReal *mean, *sigma;
+  if(dynamic_cast<const RooGaussian*>(&pdf) && gaussianParams(pdf,x,mean,sigma)){
+    Double_t mean_tmp=mean->getVal(), sigma_tmp=sigma->getVal();
+    for(Int_t i=0; i<n; i++){
+      Double_t z=(xs[i]-mean_tmp)/sigma_tmp;
+      out[i]=-0.5*z*z;
+    }
+    VecExp(out,out,n);
+    Double_t norm = pdf.getNorm(normSet);
+    for(Int_t i=0; i<n; i++) out[i]/=norm;
+    return;
+  }
+
+  /// sum of pdfs: coefficients are either yields (extended) or n-1 fractions
+  const RooAddPdf* addPdf = dynamic_cast<const RooAddPdf*>(&pdf);
+  if(addPdf){
+    const RooArgList& pdfList  = addPdf->pdfList();
+    const RooArgList& coefList = addPdf->coefList();
+    Int_t npdf  = pdfList.getSize();
+    Int_t ncoef = coefList.getSize();
+    if(ncoef==npdf || ncoef==npdf-1){
+      std::vector<Double_t> frac(npdf,0.);
+      Double_t sum=0;
+      for(Int_t k=0; k<ncoef; k++){ frac[k] = ((RooAbsReal&)coefList[k]).getVal(); sum+=frac[k]; }
+      if(ncoef==npdf){ for(Int_t k=0; k<npdf; k++) frac[k]/=sum; }
+      else frac[npdf-1] = 1.-sum;
+
+      std::vector<Double_t> comp(n);
+      for(Int_t i=0; i<n; i++) out[i]=0.;
+      for(Int_t k=0; k<npdf; k++){
+        if(frac[k]==0) continue;
+        evaluatePdfBatch((RooAbsPdf&)pdfList[k],x,xs,&comp[0],n,normSet);
+        for(Int_t i=0; i<n; i++) out[i]+=frac[k]*comp[i];
+      }
+      return;
+    }
+  }
+
+  /// extended wrapper: the shape is the one of the wrapped pdf
+  if(dynamic_cast<const RooExtendPdf*>(&pdf)){
+    TIterator* iter = pdf.serverIterator();
+    RooAbsArg* server;
+    const RooAbsPdf* wrapped = 0;
+    while((server = (RooAbsArg*) iter->Next())){
+      wrapped = dynamic_cast<const RooAbsPdf*>(server);
+      if(wrapped) break;
+    }
+    delete iter;
+    if(wrapped){
+      evaluatePdfBatch(*wrapped,x,xs,out,n,normSet);
+      return;
+    }
+  }
+
+  /// anything else (RooHistPdf, RooGenericPdf, ...): point by point
+  Double_t x_saved = x.getVal();
+  for(Int_t i=0; i<n; i++){
+    x.setVal(xs[i]);
+    out[i] = pdf.getVal(normSet);
+  }
+  x.setVal(x_saved);
+}
+
+Bool_t logPdfBatch(const RooAbsPdf& pdf, const Double_t* xs, Double_t* out, Int_t n, const RooArgSet* normSet){
+
+  /// power laws from HWWLVJRooPdfs: log shape - log(norm)
+  const RooBatchPdf* batchPdf = dynamic_cast<const RooBatchPdf*>(&pdf);
+  if(batchPdf){
+    if(!batchPdf->logBatch(xs,out,n)) return kFALSE;
+    Double_t logNorm = TMath::Log(pdf.getNorm(normSet));
+    for(Int_t i=0; i<n; i++) out[i]-=logNorm;
+    return kTRUE;
+  }
+
+  /// extended wrapper: the shape is the one of the wrapped pdf
+  if(dynamic_cast<const RooExtendPdf*>(&pdf)){
+    TIterator* iter = pdf.serverIterator();
+    RooAbsArg* server;
+    const RooAbsPdf* wrapped = 0;
+    while((server = (RooAbsArg*) iter->Next())){
+      wrapped = dynamic_cast<const RooAbsPdf*>(server);
+      if(wrapped) break;
+    }
+    delete iter;
+    if(wrapped) return logPdfBatch(*wrapped,xs,out,n,normSet);
+  }
+
+  return kFALSE;
+}
+
+void gradientPdfBatch(const RooAbsPdf& pdf, RooRealVar& x, const Double_t* xs, Double_t* out, Double_t** grad, Int_t n,
+                      const RooArgSet* normSet, const RooArgList& params){
+
+  Int_t npar = params.getSize();
+  for(Int_t j=0; j<npar; j++) std::fill(grad[j],grad[j]+n,0.);
+
+  /// shapes from HWWLVJRooPdfs with an analytic gradient: P=f/I, dP/da = (df/da - P*dI/da)/I
+  const RooBatchPdf* batchPdf = dynamic_cast<const RooBatchPdf*>(&pdf);
+  RooArgList shapeParams;
+  if(batchPdf) shapeParams.add(batchPdf->gradientParams());
+  if(shapeParams.getSize()>0){
+    Int_t nshape = shapeParams.getSize();
+    std::vector<Double_t> shapeGrad(nshape*n), normGrad(nshape);
+    std::vector<Double_t*> shapeGradPtr(nshape);
+    for(Int_t k=0; k<nshape; k++) shapeGradPtr[k]=&shapeGrad[k*n];
+    batchPdf->gradientBatch(xs,out,&shapeGradPtr[0],n);
+    batchPdf->gradientIntegral(x.getMin(),x.getMax(),&normGrad[0]);
+    Double_t norm = pdf.getNorm(normSet);
+    for(Int_t i=0; i<n; i++) out[i]/=norm;
+    for(Int_t k=0; k<nshape; k++){
+      for(Int_t i=0; i<n; i++) shapeGradPtr[k][i]=(shapeGradPtr[k][i]-out[i]*normGrad[k])/norm;
+      for(Int_t j=0; j<npar; j++){
+        Double_t factor = chainFactor((RooAbsReal&)shapeParams[k],params[j]);
+        if(factor==0) continue;
+        for(Int_t i=0; i<n; i++) grad[j][i]+=factor*shapeGradPtr[k][i];
+      }
+    }
+    return;
+  }
+
+  /// gaussian peak: I = sigma*sqrt(pi/2)*(erf(..)-erf(..)), dI/dmean = f(a)-f(b), dI/dsigma = I/sigma - (z_b f(b) - z_a f(a))
+  RooAbsReal *mean, *sigma;
+  if(dynamic_cast<const RooGaussian*>(&pdf) && gaussianParams(pdf,x,mean,sigma)){
+    Double_t mean_tmp=mean->getVal(), sigma_tmp=sigma->getVal();
+    std::vector<Double_t> z(n);
+    for(Int_t i=0; i<n; i++){
+      z[i]=(xs[i]-mean_tmp)/sigma_tmp;
+      out[i]=-0.5*z[i]*z[i];
+    }
+    VecExp(out,out,n);
+    Double_t norm = pdf.getNorm(normSet);
+    Double_t z_a=(x.getMin()-mean_tmp)/sigma_tmp, z_b=(x.getMax()-mean_tmp)/sigma_tmp;
+    Double_t f_a=TMath::Exp(-0.5*z_a*z_a), f_b=TMath::Exp(-0.5*z_b*z_b);
+    Double_t dNormMean  = f_a-f_b;
+    Double_t dNormSigma = norm/sigma_tmp-(z_b*f_b-z_a*f_a);
+    for(Int_t j=0; j<npar; j++){
+      Double_t factorMean  = chainFactor(*mean,params[j]);
+      Double_t factorSigma = chainFactor(*sigma,params[j]);
+      if(factorMean==0 && factorSigma==0) continue;
+      for(Int_t i=0; i<n; i++){
+        Double_t prob=out[i]/norm;
+        Double_t dMean  = (out[i]*z[i]/sigma_tmp-prob*dNormMean)/norm;
+        Double_t dSigma = (out[i]*z[i]*z[i]/sigma_tmp-prob*dNormSigma)/norm;
+        grad[j][i]=factorMean*dMean+factorSigma*dSigma;
+      }
+    }
+    for(Int_t i=0; i<n; i++) out[i]/=norm;
+    return;
+  }
+
+  /// sum of pdfs: d(sum frac_k P_k) = sum (dfrac_k P_k + frac_k dP_k)
+  const RooAddPdf* addPdf = dynamic_cast<const RooAddPdf*>(&pdf);
+  if(addPdf){
+    const RooArgList& pdfList  = addPdf->pdfList();
+    const RooArgList& coefList = addPdf->coefList();
+    Int_t npdf  = pdfList.getSize();
+    Int_t ncoef = coefList.getSize();
+    if(ncoef==npdf || ncoef==npdf-1){
+      std::vector<Double_t> frac(npdf,0.), fracGrad(npdf*npar,0.);
+      Double_t sum=0;
+      std::vector<Double_t> sumGrad(npar,0.);
+      for(Int_t k=0; k<ncoef; k++){
+        frac[k] = ((RooAbsReal&)coefList[k]).getVal();
+        sum+=frac[k];
+        for(Int_t j=0; j<npar; j++){
+          fracGrad[k*npar+j] = chainFactor((RooAbsReal&)coefList[k],params[j]);
+          sumGrad[j]+=fracGrad[k*npar+j];
+        }
+      }
+      if(ncoef==npdf){
+        for(Int_t k=0; k<npdf; k++){
+          frac[k]/=sum;
+          for(Int_t j=0; j<npar; j++) fracGrad[k*npar+j]=(fracGrad[k*npar+j]-frac[k]*sumGrad[j])/sum;
+        }
+      }else{
+        frac[npdf-1] = 1.-sum;
+        for(Int_t j=0; j<npar; j++) fracGrad[(npdf-1)*npar+j]=-sumGrad[j];
+      }
+
+      std::vector<Double_t> comp(n), compGrad(npar*n);
+      std::vector<Double_t*> compGradPtr(npar);
+      for(Int_t j=0; j<npar; j++) compGradPtr[j]=&compGrad[j*n];
+      for(Int_t i=0; i<n; i++) out[i]=0.;
+      for(Int_t k=0; k<npdf; k++){
+        Bool_t fracFloats=kFALSE;
+        for(Int_t j=0; j<npar; j++) if(fracGrad[k*npar+j]!=0) fracFloats=kTRUE;
+        if(frac[k]==0 && !fracFloats) continue;
+        gradientPdfBatch((RooAbsPdf&)pdfList[k],x,xs,&comp[0],&compGradPtr[0],n,normSet,params);
+        for(Int_t i=0; i<n; i++) out[i]+=frac[k]*comp[i];
+        for(Int_t j=0; j<npar; j++){
+          Double_t dfrac=fracGrad[k*npar+j];
+          for(Int_t i=0; i<n; i++) grad[j][i]+=frac[k]*compGradPtr[j][i]+dfrac*comp[i];
+        }
+      }
+      return;
+    }
+  }
+
+  /// extended wrapper: the shape is the one of the wrapped pdf
+  if(dynamic_cast<const RooExtendPdf*>(&pdf)){
+    TIterator* iter = pdf.serverIterator();
+    RooAbsArg* server;
+    const RooAbsPdf* wrapped = 0;
+    while((server = (RooAbsArg*) iter->Next())){
+      wrapped = dynamic_cast<const RooAbsPdf*>(server);
+      if(wrapped) break;
+    }
+    delete iter;
+    if(wrapped){
+      gradientPdfBatch(*wrapped,x,xs,out,grad,n,normSet,params);
+      return;
+    }
+  }
+
+  /// anything else: central differences of the whole array, only for the parameters the pdf depends on
+  evaluatePdfBatch(pdf,x,xs,out,n,normSet);
+  std::vector<Double_t> outUp(n), outDown(n);
+  for(Int_t j=0; j<npar; j++){
+    RooRealVar* par = dynamic_cast<RooRealVar*>(&params[j]);
+    if(!par || !pdf.dependsOn(*par)) continue;
+    Double_t value=par->getVal();
+    Double_t step=1e-6*(1.+TMath::Abs(value));
+    Double_t up=value+step, down=value-step;
+    if(par->hasMax() && up>par->getMax())   up=par->getMax();
+    if(par->hasMin() && down<par->getMin()) down=par->getMin();
+    if(up<=down) continue;
+    par->setVal(up);
+    evaluatePdfBatch(pdf,x,xs,&outUp[0],n,normSet);
+    par->setVal(down);
+    evaluatePdfBatch(pdf,x,xs,&outDown[0],n,normSet);
+    par->setVal(value);
+    for(Int_t i=0; i<n; i++) grad[j][i]=(outUp[i]-outDown[i])/(up-down);
+  }
+}
+
+
+/// pdf wrapped by a RooExtendPdf (its first pdf server), 0 if there is none
+static const RooAbsPdf* extendWrappedPdf(const RooAbsPdf& pdf){
+  TIterator* iter = pdf.serverIterator();
+  RooAbsArg* server;
+  const RooAbsPdf* wrapped = 0;
+  while((server = (RooAbsArg*) iter->Next())){
+    wrapped = dynamic_cast<const RooAbsPdf*>(server);
+    if(wrapped) break;
+  }
+  delete iter;
+  return wrapped;
+}
+
+/// normalised fractions of the components of a RooAddPdf (yields or n-1 fractions), kFALSE for other coefficient lists
+static Bool_t addPdfFractions(const RooAddPdf& addPdf, std::vector<Double_t>& frac){
+  Int_t npdf  = addPdf.pdfList().getSize();
+  Int_t ncoef = addPdf.coefList().getSize();
+  if(ncoef!=npdf && ncoef!=npdf-1) return kFALSE;
+  frac.assign(npdf,0.);
+  Double_t sum=0;
+  for(Int_t k=0; k<ncoef; k++){ frac[k] = ((RooAbsReal&)addPdf.coefList()[k]).getVal(); sum+=frac[k]; }
+  if(ncoef==npdf){ for(Int_t k=0; k<npdf; k++) frac[k]/=sum; }
+  else frac[npdf-1] = 1.-sum;
+  return kTRUE;
+}
+
+/// integrals of a single shape over the bins, normalised to their sum
+static void binIntegralsShape(const RooAbsPdf& pdf, RooRealVar& x, const Double_t* edges, Double_t* out, Int_t n, const RooArgSet* normSet){
+
+  /// gaussian peak: difference of the CDF at the edges, from the tail closest to the bin to keep the precision
+  RooAbsReal *mean, *sigma, *slope;
+  const RooBatchPdf* batchPdf = dynamic_cast<const RooBatchPdf*>(&pdf);
+  if(dynamic_cast<const RooGaussian*>(&pdf) && gaussianParams(pdf,x,mean,sigma)){
+    Double_t mean_tmp=mean->getVal(), scale=TMath::Sqrt2()*sigma->getVal();
+    for(Int_t b=0; b<n; b++){
+      Double_t z_lo=(edges[b]-mean_tmp)/scale, z_hi=(edges[b+1]-mean_tmp)/scale;
+      if(z_lo>0) out[b]=TMath::Erfc(z_lo)-TMath::Erfc(z_hi);
+      else       out[b]=TMath::Erf(z_hi)-TMath::Erf(z_lo);
+    }
+  }
+  /// exponential: (exp(c*x_hi)-exp(c*x_lo))/c
+  else if(dynamic_cast<const RooExponential*>(&pdf) && exponentialParams(pdf,x,slope)){
+    Double_t c_tmp=slope->getVal();
+    for(Int_t b=0; b<n; b++){
+      if(c_tmp==0) out[b]=edges[b+1]-edges[b];
+      else out[b]=(TMath::Exp(c_tmp*edges[b+1])-TMath::Exp(c_tmp*edges[b]))/c_tmp;
+    }
+  }
+  /// shapes from HWWLVJRooPdfs: closed form where the shape has one (ErfExp, AlphaExp, 2Exp, the Gaussian sums),
+  /// else quadrature of the batch interface with the panels placed around the turn-ons
+  else if(batchPdf){
+    for(Int_t b=0; b<n; b++){
+      if(!batchPdf->closedIntegral(edges[b],edges[b+1],out[b])) out[b]=batchPdf->batchIntegral(edges[b],edges[b+1]);
+    }
+  }
+  /// anything else: 2 point Gauss-Legendre per bin in one evaluatePdfBatch call (exact for histograms in the same bins)
+  else{
+    std::vector<Double_t> nodes(2*n), values(2*n);
+    for(Int_t b=0; b<n; b++){
+      Double_t centre=0.5*(edges[b]+edges[b+1]), offset=0.5*(edges[b+1]-edges[b])/TMath::Sqrt(3.);
+      nodes[2*b]=centre-offset; nodes[2*b+1]=centre+offset;
+    }
+    evaluatePdfBatch(pdf,x,&nodes[0],&values[0],2*n,normSet);
+    for(Int_t b=0; b<n; b++) out[b]=0.5*(edges[b+1]-edges[b])*(values[2*b]+values[2*b+1]);
+  }
+
+  Double_t sum=0;
+  for(Int_t b=0; b<n; b++) sum+=out[b];
+  if(sum>0) for(Int_t b=0; b<n; b++) out[b]/=sum;
+}
+
+void binIntegralsPdf(const RooAbsPdf& pdf, RooRealVar& x, const Double_t* edges, Double_t* out, Int_t n, const RooArgSet* normSet){
+
+  const RooAddPdf* addPdf = dynamic_cast<const RooAddPdf*>(&pdf);
+  std::vector<Double_t> frac;
+  if(addPdf && addPdfFractions(*addPdf,frac)){
+    std::vector<Double_t> comp(n);
+    std::fill(out,out+n,0.);
+    for(UInt_t k=0; k<frac.size(); k++){
+      if(frac[k]==0) continue;
+      binIntegralsPdf((RooAbsPdf&)addPdf->pdfList()[k],x,edges,&comp[0],n,normSet);
+      for(Int_t b=0; b<n; b++) out[b]+=frac[k]*comp[b];
+    }
+    return;
+  }
+
+  if(dynamic_cast<const RooExtendPdf*>(&pdf)){
+    const RooAbsPdf* wrapped = extendWrappedPdf(pdf);
+    if(wrapped){
+      binIntegralsPdf(*wrapped,x,edges,out,n,normSet);
+      return;
+    }
+  }
+
+  binIntegralsShape(pdf,x,edges,out,n,normSet);
+}
+
+Bool_t binIntegralsClosed(const RooAbsPdf& pdf, const RooRealVar& x){
+
+  const RooAddPdf* addPdf = dynamic_cast<const RooAddPdf*>(&pdf);
+  std::vector<Double_t> frac;
+  if(addPdf && addPdfFractions(*addPdf,frac)){
+    for(UInt_t k=0; k<frac.size(); k++){
+      if(frac[k]!=0 && !binIntegralsClosed((RooAbsPdf&)addPdf->pdfList()[k],x)) return kFALSE;
+    }
+    return kTRUE;
+  }
+  if(dynamic_cast<const RooExtendPdf*>(&pdf)){
+    const RooAbsPdf* wrapped = extendWrappedPdf(pdf);
+    return wrapped ? binIntegralsClosed(*wrapped,x) : kFALSE;
+  }
+
+  RooAbsReal *mean, *sigma, *slope;
+  if(dynamic_cast<const RooGaussian*>(&pdf)) return gaussianParams(pdf,x,mean,sigma);
+  if(dynamic_cast<const RooExponential*>(&pdf)) return exponentialParams(pdf,x,slope);
+  return dynamic_cast<const RooBatchPdf*>(&pdf)!=0;
+}
+
+
+void flattenPdfTerms(const RooAbsPdf& pdf, const RooRealVar& x, Double_t coef, std::vector<BatchPdfTerm>& terms, const RooArgSet* normSet){
+
+  const RooAddPdf* addPdf = dynamic_cast<const RooAddPdf*>(&pdf);
+  std::vector<Double_t> frac;
+  if(addPdf && addPdfFractions(*addPdf,frac)){
+    for(UInt_t c=0; c<frac.size(); c++){
+      if(frac[c]!=0) flattenPdfTerms((RooAbsPdf&)addPdf->pdfList()[c],x,coef*frac[c],terms,normSet);
+    }
+    return;
+  }
+  if(dynamic_cast<const RooExtendPdf*>(&pdf)){
+    const RooAbsPdf* wrapped = extendWrappedPdf(pdf);
+    if(wrapped){
+      flattenPdfTerms(*wrapped,x,coef,terms,normSet);
+      return;
+    }
+  }
+
+  BatchPdfTerm term;
+  term.pdf = &pdf;
+  term.batchPdf = dynamic_cast<const RooBatchPdf*>(&pdf);
+  term.gaussian = kFALSE;
+  term.mean = term.sigma = 0;
+  term.values = 0;
+  term.coef = coef;
+
+  RooAbsReal *mean, *sigma;
+  if(term.batchPdf){
+    /// parameters and derived constants copied here: the workers never read the proxies or caches
+    term.batchPdf->batchSnapshot(term.params);
+    term.coef /= pdf.getNorm(normSet);
+  }else if(dynamic_cast<const RooGaussian*>(&pdf) && gaussianParams(pdf,x,mean,sigma)){
+    term.gaussian = kTRUE;
+    term.mean  = mean->getVal();
+    term.sigma = sigma->getVal();
+    term.coef /= pdf.getNorm(normSet);
+  }
+  terms.push_back(term);
+}
+
+void evaluatePdfTerms(const std::vector<BatchPdfTerm>& terms, const Double_t* xs, Double_t* out, Int_t n, Int_t first, Double_t* shape){
+  std::fill(out,out+n,0.);
+  for(UInt_t t=0; t<terms.size(); t++){
+    const BatchPdfTerm& term = terms[t];
+    if(term.gaussian){
+      for(Int_t i=0; i<n; i++){
+        Double_t z=(xs[i]-term.mean)/term.sigma;
+        shape[i]=-0.5*z*z;
+      }
+      VecExp(shape,shape,n);
+    }else if(term.batchPdf){
+      term.batchPdf->evaluateSnapshot(term.params,xs,shape,n);
+    }else{
+      if(term.values) for(Int_t i=0; i<n; i++) out[i]+=term.coef*term.values[first+i];
+      continue;
+    }
+    for(Int_t i=0; i<n; i++) out[i]+=term.coef*shape[i];
+  }
+}
+
+
+/// worker threads given to the RooBatchNLLs built from now on, see SetBatchNLLThreads
+static Int_t batchNLLThreads = 0 ;
+
+void SetBatchNLLThreads(Int_t n){ batchNLLThreads = TMath::Max(n,0); }
+
+/// events per block of the unbinned evaluation: the blocks, not the threads, fix the order of the sums
+static const Int_t eventBlockSize = 4096 ;
+
+struct BatchNLLBlock {
+  Int_t cat, begin, end ;
+  Double_t nll, sumW, sumW2 ;
+  Int_t nInvalid ;
+};
+
+struct BatchNLLJob {
+  const std::vector<std::vector<Double_t> >* catX ;
+  const std::vector<std::vector<Double_t> >* catW ;
+  const std::vector<std::vector<BatchPdfTerm> >* terms ;
+  const std::vector<Int_t>* logDomain ;
+  std::vector<BatchNLLBlock>* blocks ;
+  Bool_t weightSq ;
+  UInt_t first, stride ;
+};
+
+static inline void kahanAdd(Double_t& sum, Double_t& carry, Double_t value){
+  Double_t y = value-carry;
+  Double_t t = sum+y;
+  carry = (t-sum)-y;
+  sum = t;
+}
+
+static Double_t pairwiseSum(const Double_t* values, Int_t n){
+  if(n<=0) return 0;
+  if(n==1) return values[0];
+  Int_t half = n/2;
+  return pairwiseSum(values,half)+pairwiseSum(values+half,n-half);
+}
+
+/// blocks first, first+stride, ... of the job; only array code on the snapshots, no RooFit object is read
+static void* batchNLLWorker(void* arg){
+  BatchNLLJob& job = *(BatchNLLJob*) arg;
+  std::vector<Double_t> prob(eventBlockSize), shape(eventBlockSize);
+
+  for(UInt_t b=job.first; b<job.blocks->size(); b+=job.stride){
+    BatchNLLBlock& block = (*job.blocks)[b];
+    const Double_t* xs = &(*job.catX)[block.cat][block.begin];
+    const Double_t* ws = &(*job.catW)[block.cat][block.begin];
+    const std::vector<BatchPdfTerm>& terms = (*job.terms)[block.cat];
+    Bool_t logDomain = (*job.logDomain)[block.cat];
+    Int_t n = block.end-block.begin;
+
+    if(logDomain){
+      terms[0].batchPdf->logSnapshot(terms[0].params,xs,&prob[0],n);
+      Double_t logCoef = TMath::Log(terms[0].coef);
+      for(Int_t i=0; i<n; i++) prob[i]+=logCoef;
+    }else{
+      evaluatePdfTerms(terms,xs,&prob[0],n,block.begin,&shape[0]);
+    }
+
+    Double_t nll=0, nllCarry=0, sumW=0, sumWCarry=0, sumW2=0, sumW2Carry=0;
+    block.nInvalid=0;
+    for(Int_t i=0; i<n; i++){
+      Double_t weight = ws[i];
+      kahanAdd(sumW,sumWCarry,weight);
+      kahanAdd(sumW2,sumW2Carry,weight*weight);
+      if(job.weightSq) weight*=weight;
+      Double_t logProb;
+      if(logDomain){
+        if(!TMath::Finite(prob[i])){ block.nInvalid++; continue; }
+        logProb = prob[i];
+      }else{
+        if(prob[i]<=0){ block.nInvalid++; continue; }
+        logProb = TMath::Log(prob[i]);
+      }
+      kahanAdd(nll,nllCarry,-weight*logProb);
+    }
+    block.nll=nll; block.sumW=sumW; block.sumW2=sumW2;
+  }
+  return 0;
+}
+
+
+ClassImp(RooBatchNLL)
+
+RooBatchNLL::RooBatchNLL(const char *name, const char *title,
+                         RooAbsPdf& _pdf,
+                         RooAbsData& _data,
+                         RooRealVar& _x,
+                         const RooArgSet* _constraints,
+                         Bool_t _binned) :
+  RooAbsReal(name,title),
+  params("params","params",this),
+  constraints("constraints","constraints",this),
+  pdf(&_pdf),
+  x(&_x),
+  weightSq(kFALSE),
+  binned(_binned),
+  nEvents(0),
+  nThreads(batchNLLThreads){
+
+  /// only the parameters are servers, the observable values live in catX
+  RooArgSet* pdfParams = _pdf.getParameters(_data);
+  params.add(*pdfParams);
+  delete pdfParams;
+  if(_constraints){
+    constraints.add(*_constraints);
+    TIterator* iter = _constraints->createIterator();
+    RooAbsArg* arg;
+    while((arg = (RooAbsArg*) iter->Next())){
+      RooArgSet* constraintParams = arg->getParameters(_data);
+      params.add(*constraintParams,kTRUE);
+      delete constraintParams;
+    }
+    delete iter;
+  }
+
+  /// binned: edges of the default binning of x, the entries are summed into them below
+  const RooAbsBinning& binning = _x.getBinning();
+  if(binned){
+    binEdges.resize(binning.numBins()+1);
+    for(Int_t b=0; b<binning.numBins(); b++) binEdges[b]=binning.binLow(b);
+    binEdges[binning.numBins()]=binning.highBound();
+  }
+
+  RooSimultaneous* simPdf = dynamic_cast<RooSimultaneous*>(&_pdf);
+  for(Int_t i=0; i<_data.numEntries(); i++){
+    const RooArgSet* row = _data.get(i);
+    Double_t weight = _data.weight();
+    if(weight==0) continue;
+
+    RooAbsPdf* rowPdf = &_pdf;
+    if(simPdf){
+      const RooAbsCategory* category = dynamic_cast<const RooAbsCategory*>(row->find(simPdf->indexCat().GetName()));
+      rowPdf = category ? simPdf->getPdf(category->getLabel()) : 0;
+      if(!rowPdf) continue;
+    }
+
+    UInt_t k=0;
+    while(k<catPdf.size() && catPdf[k]!=rowPdf) k++;
+    if(k==catPdf.size()){
+      catPdf.push_back(rowPdf);
+      catX.push_back(std::vector<Double_t>());
+      catW.push_back(std::vector<Double_t>());
+      catW2.push_back(std::vector<Double_t>());
+      if(binned){
+        catW[k].assign(binning.numBins(),0.);
+        catW2[k].assign(binning.numBins(),0.);
+      }
+    }
+
+    Double_t value = row->getRealValue(_x.GetName());
+    if(binned){
+      if(value<binEdges.front() || value>binEdges.back()) continue;
+      Int_t b = binning.binNumber(value);
+      catW[k][b]  += weight;
+      catW2[k][b] += _data.weightSquared();
+      nEvents++;
+      continue;
+    }
+    catX[k].push_back(value);
+    catW[k].push_back(weight);
+  }
+}
+
+RooBatchNLL::RooBatchNLL(const RooBatchNLL& other, const char* name) :
+  RooAbsReal(other,name),
+  params("params",this,other.params),
+  constraints("constraints",this,other.constraints),
+  pdf(other.pdf),
+  x(other.x),
+  weightSq(other.weightSq),
+  catPdf(other.catPdf),
+  catX(other.catX),
+  catW(other.catW),
+  catW2(other.catW2),
+  binned(other.binned),
+  nEvents(other.nEvents),
+  binEdges(other.binEdges),
+  nThreads(other.nThreads){}
+
+RooBatchNLL::~RooBatchNLL(){
+  clearShapeCache();
+}
+
+void RooBatchNLL::clearShapeCache(){
+  for(UInt_t s=0; s<shapeParams.size(); s++) delete shapeParams[s];
+  shapePdf.clear();
+  shapeParams.clear();
+  shapeParamValues.clear();
+  shapeBinProb.clear();
+  eventPdf.clear();
+  eventCat.clear();
+  eventFixed.clear();
+  eventValues.clear();
+}
+
+void RooBatchNLL::setThreads(Int_t n){
+  nThreads = TMath::Max(n,0);
+  setValueDirty();
+}
+
+void RooBatchNLL::applyWeightSquared(Bool_t flag){
+  if(flag!=weightSq){
+    weightSq=flag;
+    setValueDirty();
+  }
+}
+
+Int_t RooBatchNLL::numEvents() const {
+  if(binned) return nEvents;
+  Int_t nevents=0;
+  for(UInt_t k=0; k<catX.size(); k++) nevents+=catX[k].size();
+  return nevents;
+}
+
+/// extended term of category k with N = expectedEvents: N - sumW*log(N) (RooAbsPdf::extendedTerm) in the weights pass,
+/// N*sumW2/sumW - sumW2*log(N) in the weights^2 pass, i.e. the weights-pass term scaled by sumW2/sumW
+Double_t RooBatchNLL::extendedTerm(UInt_t k, Double_t sumW, Double_t sumW2, const RooArgSet& normSet) const {
+  if(!catPdf[k]->canBeExtended()) return 0;
+  if(weightSq){
+    Double_t expected = catPdf[k]->expectedEvents(&normSet);
+    return expected*sumW2/sumW - sumW2*TMath::Log(expected);
+  }
+  return catPdf[k]->extendedTerm(sumW,&normSet);
+}
+
+Double_t RooBatchNLL::constraintTerm() const {
+  if(constraints.getSize()==0) return 0;
+  Double_t nll=0;
+  RooArgSet constraintNormSet(params);
+  TIterator* iter = constraints.createIterator();
+  RooAbsPdf* constraint;
+  while((constraint = (RooAbsPdf*) iter->Next())) nll -= constraint->getLogVal(&constraintNormSet);
+  delete iter;
+  return nll;
+}
+
+void RooBatchNLL::binProbabilities(const RooAbsPdf& _pdf, Double_t* out, const RooArgSet* normSet) const {
+
+  Int_t n = numBins();
+
+  /// sums and extended wrappers are recombined at each call, O(bins) per component
+  const RooAddPdf* addPdf = dynamic_cast<const RooAddPdf*>(&_pdf);
+  std::vector<Double_t> frac;
+  if(addPdf && addPdfFractions(*addPdf,frac)){
+    std::vector<Double_t> comp(n);
+    std::fill(out,out+n,0.);
+    for(UInt_t k=0; k<frac.size(); k++){
+      if(frac[k]==0) continue;
+      binProbabilities((RooAbsPdf&)addPdf->pdfList()[k],&comp[0],normSet);
+      for(Int_t b=0; b<n; b++) out[b]+=frac[k]*comp[b];
+    }
+    return;
+  }
+  if(dynamic_cast<const RooExtendPdf*>(&_pdf)){
+    const RooAbsPdf* wrapped = extendWrappedPdf(_pdf);
+    if(wrapped){
+      binProbabilities(*wrapped,out,normSet);
+      return;
+    }
+  }
+
+  /// single shape: integrated again only when one of its parameters moved
+  UInt_t s=0;
+  while(s<shapePdf.size() && shapePdf[s]!=&_pdf) s++;
+  if(s==shapePdf.size()){
+    shapePdf.push_back(&_pdf);
+    shapeParams.push_back(_pdf.getParameters(*x));
+    shapeParamValues.push_back(std::vector<Double_t>());
+    shapeBinProb.push_back(std::vector<Double_t>());
+  }
+
+  std::vector<Double_t> values;
+  TIterator* iter = shapeParams[s]->createIterator();
+  RooAbsArg* arg;
+  while((arg = (RooAbsArg*) iter->Next())){
+    RooAbsReal* par = dynamic_cast<RooAbsReal*>(arg);
+    if(par) values.push_back(par->getVal());
+  }
+  delete iter;
+
+  if(values!=shapeParamValues[s] || Int_t(shapeBinProb[s].size())!=n){
+    shapeBinProb[s].resize(n);
+    binIntegralsShape(_pdf,*x,&binEdges[0],&shapeBinProb[s][0],n,normSet);
+    shapeParamValues[s]=values;
+  }
+  std::copy(shapeBinProb[s].begin(),shapeBinProb[s].end(),out);
+}
+
+Double_t RooBatchNLL::evaluateBinned() const {
+
+  RooArgSet normSet(*x);
+  Double_t nll=0;
+  std::vector<Double_t> prob(numBins());
+
+  for(UInt_t k=0; k<catPdf.size(); k++){
+    const std::vector<Double_t>& ws = weightSq ? catW2[k] : catW[k];
+    binProbabilities(*catPdf[k],&prob[0],&normSet);
+
+    Double_t sumW=0, sumW2=0;
+    for(Int_t b=0; b<numBins(); b++){
+      sumW  += catW[k][b];
+      sumW2 += catW2[k][b];
+      if(ws[b]==0) continue;
+      if(prob[b]<=0){
+        logEvalError("bin probability is less than or equal to zero");
+        continue;
+      }
+      nll -= ws[b]*TMath::Log(prob[b]);
+    }
+
+    nll += extendedTerm(k,sumW,sumW2,normSet);
+  }
+
+  return nll+constraintTerm();
+}
+
+const Double_t* RooBatchNLL::pdfEventValues(UInt_t k, const RooAbsPdf& _pdf, const RooArgSet& normSet) const {
+
+  UInt_t e=0;
+  while(e<eventPdf.size() && !(eventPdf[e]==&_pdf && eventCat[e]==k)) e++;
+  if(e==eventPdf.size()){
+    RooArgSet* pdfParams = _pdf.getParameters(*x);
+    eventPdf.push_back(&_pdf);
+    eventCat.push_back(k);
+    eventFixed.push_back(pdfParams->getSize()==0 ? 1 : 0);
+    eventValues.push_back(std::vector<Double_t>());
+    delete pdfParams;
+  }
+
+  /// pdfs without parameters (RooHistPdf templates) are evaluated once
+  std::vector<Double_t>& values = eventValues[e];
+  if(!eventFixed[e] || values.empty()){
+    values.resize(catX[k].size());
+    evaluatePdfBatch(_pdf,*x,&catX[k][0],&values[0],values.size(),&normSet);
+  }
+  return &values[0];
+}
+
+/// leaves of category k, with the per event values of the leaves without array path
+void RooBatchNLL::flattenTerms(UInt_t k, std::vector<BatchPdfTerm>& terms, const RooArgSet& normSet) const {
+  flattenPdfTerms(*catPdf[k],*x,1.,terms,&normSet);
+  for(UInt_t t=0; t<terms.size(); t++){
+    if(!terms[t].batchPdf && !terms[t].gaussian) terms[t].values = pdfEventValues(k,*terms[t].pdf,normSet);
+  }
+}
+
+Double_t RooBatchNLL::evaluateBlocks() const {
+
+  RooArgSet normSet(*x);
+  UInt_t ncat = catPdf.size();
+  std::vector<std::vector<BatchPdfTerm> > terms(ncat);
+  std::vector<Int_t> logDomain(ncat,0);
+  std::vector<BatchNLLBlock> blocks;
+
+  /// everything that touches RooFit objects (fractions, norms, pdfs without array path) runs here, on this thread
+  for(UInt_t k=0; k<ncat; k++){
+    Int_t n = catX[k].size();
+    if(n==0) continue;
+    flattenTerms(k,terms[k],normSet);
+    if(terms[k].size()==1 && terms[k][0].batchPdf){
+      Double_t value;
+      logDomain[k] = terms[k][0].batchPdf->logSnapshot(terms[k][0].params,&catX[k][0],&value,1) ? 1 : 0;
+    }
+    for(Int_t begin=0; begin<n; begin+=eventBlockSize){
+      BatchNLLBlock block;
+      block.cat=k; block.begin=begin; block.end=TMath::Min(begin+eventBlockSize,n);
+      block.nll=block.sumW=block.sumW2=0; block.nInvalid=0;
+      blocks.push_back(block);
+    }
+  }
+
+  /// the calling thread works on the first share of blocks while the others run
+  UInt_t nworkers = TMath::Max(1,TMath::Min(nThreads,Int_t(blocks.size())));
+  std::vector<BatchNLLJob> jobs(nworkers);
+  std::vector<pthread_t> threads(nworkers);
+  std::vector<Int_t> started(nworkers,0);
+  for(UInt_t t=0; t<nworkers; t++){
+    BatchNLLJob& job = jobs[t];
+    job.catX=&catX; job.catW=&catW; job.terms=&terms; job.logDomain=&logDomain; job.blocks=&blocks;
+    job.weightSq=weightSq; job.first=t; job.stride=nworkers;
+  }
+  for(UInt_t t=1; t<nworkers; t++) started[t] = pthread_create(&threads[t],0,batchNLLWorker,&jobs[t])==0 ? 1 : 0;
+  batchNLLWorker(&jobs[0]);
+  for(UInt_t t=1; t<nworkers; t++){
+    if(started[t]) pthread_join(threads[t],0);
+    else batchNLLWorker(&jobs[t]);
+  }
+
+  /// block sums combined pairwise in block order: the same value for any number of threads
+  Double_t nll=0;
+  std::vector<Double_t> blockNLL, blockSumW, blockSumW2;
+  UInt_t b=0;
+  for(UInt_t k=0; k<ncat; k++){
+    blockNLL.clear(); blockSumW.clear(); blockSumW2.clear();
+    Int_t nInvalid=0;
+    for(; b<blocks.size() && blocks[b].cat==Int_t(k); b++){
+      blockNLL.push_back(blocks[b].nll);
+      blockSumW.push_back(blocks[b].sumW);
+      blockSumW2.push_back(blocks[b].sumW2);
+      nInvalid+=blocks[b].nInvalid;
+    }
+    if(blockNLL.empty()) continue;
+    if(nInvalid>0) logEvalError(Form("p.d.f value is not positive (or its log not finite) for %d events",nInvalid));
+    nll += pairwiseSum(&blockNLL[0],blockNLL.size());
+    nll += extendedTerm(k,pairwiseSum(&blockSumW[0],blockSumW.size()),pairwiseSum(&blockSumW2[0],blockSumW2.size()),normSet);
+  }
+
+  return nll+constraintTerm();
+}
+
+Double_t RooBatchNLL::evaluate() const {
+  return binned ? evaluateBinned() : evaluateBlocks();
+}
+
+void RooBatchNLL::gradient(const RooArgList& floatParams, Double_t* grad) const {
+
+  RooArgSet normSet(*x);
+  Int_t npar = floatParams.getSize();
+  for(Int_t j=0; j<npar; j++) grad[j]=0;
+
+  /// binned: central differences of evaluateBinned, only the shapes depending on the moved parameter are integrated again
+  if(binned){
+    for(Int_t j=0; j<npar; j++){
+      RooRealVar* par = dynamic_cast<RooRealVar*>(floatParams.at(j));
+      if(par) grad[j] = parameterDerivative(*this,*par,0);
+    }
+    return;
+  }
+
+  std::vector<Double_t> prob, derivatives;
+  std::vector<Double_t*> derivativePtr(npar);
+
+  for(UInt_t k=0; k<catPdf.size(); k++){
+    const std::vector<Double_t>& xs = catX[k];
+    const std::vector<Double_t>& ws = catW[k];
+    Int_t n = xs.size();
+    if(n==0) continue;
+
+    prob.resize(n);
+    derivatives.resize(npar*n);
+    for(Int_t j=0; j<npar; j++) derivativePtr[j]=&derivatives[j*n];
+    gradientPdfBatch(*catPdf[k],*x,&xs[0],&prob[0],&derivativePtr[0],n,&normSet,floatParams);
+
+    Double_t sumW=0, sumW2=0;
+    for(Int_t i=0; i<n; i++){
+      Double_t weight = ws[i];
+      sumW  += weight;
+      sumW2 += weight*weight;
+      if(weightSq) weight*=weight;
+      if(prob[i]<=0) continue;
+      for(Int_t j=0; j<npar; j++) grad[j] -= weight*derivativePtr[j][i]/prob[i];
+    }
+
+    /// extended term: d(expected - sumW*log(expected)) = (1 - sumW/expected) d expected
+    if(catPdf[k]->canBeExtended()){
+      Double_t expected = catPdf[k]->expectedEvents(&normSet);
+      for(Int_t j=0; j<npar; j++){
+        RooRealVar* par = dynamic_cast<RooRealVar*>(floatParams.at(j));
+        if(!par || !catPdf[k]->dependsOn(*par)) continue;
+        Double_t dExpected = parameterDerivative(*catPdf[k],*par,&normSet,kTRUE);
+        if(weightSq) grad[j] += (sumW2/sumW - sumW2/expected)*dExpected;
+        else         grad[j] += (1. - sumW/expected)*dExpected;
+      }
+    }
+  }
+
+  if(constraints.getSize()>0){
+    RooArgSet constraintNormSet(params);
+    TIterator* iter = constraints.createIterator();
+    RooAbsPdf* constraint;
+    while((constraint = (RooAbsPdf*) iter->Next())){
+      Double_t value = constraint->getVal(&constraintNormSet);
+      for(Int_t j=0; j<npar; j++){
+        RooRealVar* par = dynamic_cast<RooRealVar*>(floatParams.at(j));
+        if(!par || !constraint->dependsOn(*par)) continue;
+        grad[j] -= parameterDerivative(*constraint,*par,&constraintNormSet)/value;
+      }
+    }
+    delete iter;
+  }
+}
+
+
+/// RooBatchNLL as a Minuit2 function of the floating parameters, derivatives left to Minuit2
+class RooBatchNLLFcn : public ROOT::Math::IMultiGenFunction {
+public:
+  RooBatchNLLFcn(RooBatchNLL& _nll, const RooArgList& _floatParams) : nll(_nll), floatParams(_floatParams) {}
+
+  RooBatchNLLFcn* Clone() const { return new RooBatchNLLFcn(nll,floatParams); }
+
+  unsigned int NDim() const { return floatParams.getSize(); }
+
+private:
+
+  double DoEval(const double* pars) const {
+    for(Int_t i=0; i<floatParams.getSize(); i++){
+      RooRealVar* par = (RooRealVar*) floatParams.at(i);
+      if(par->getVal()!=pars[i]) par->setVal(pars[i]);
+    }
+    return nll.getVal();
+  }
+
+  RooBatchNLL& nll;
+  RooArgList floatParams;
+};
+
+/// RooBatchNLL as a Minuit2 function of the floating parameters, with the analytic gradient
+class RooBatchNLLGradFcn : public ROOT::Math::IMultiGradFunction {
+public:
+  RooBatchNLLGradFcn(RooBatchNLL& _nll, const RooArgList& _floatParams) : nll(_nll), floatParams(_floatParams) {}
+
+  RooBatchNLLGradFcn* Clone() const { return new RooBatchNLLGradFcn(nll,floatParams); }
+
+  unsigned int NDim() const { return floatParams.getSize(); }
+
+  void Gradient(const double* pars, double* grad) const {
+    setParams(pars);
+    nll.gradient(floatParams,grad);
+  }
+
+  void FdF(const double* pars, double& value, double* grad) const {
+    setParams(pars);
+    value = nll.getVal();
+    nll.gradient(floatParams,grad);
+  }
+
+private:
+
+  double DoEval(const double* pars) const {
+    setParams(pars);
+    return nll.getVal();
+  }
+
+  double DoDerivative(const double* pars, unsigned int icoord) const {
+    std::vector<Double_t> grad(NDim());
+    Gradient(pars,&grad[0]);
+    return grad[icoord];
+  }
+
+  void setParams(const double* pars) const {
+    for(Int_t i=0; i<floatParams.getSize(); i++){
+      RooRealVar* par = (RooRealVar*) floatParams.at(i);
+      if(par->getVal()!=pars[i]) par->setVal(pars[i]);
+    }
+  }
+
+  RooBatchNLL& nll;
+  RooArgList floatParams;
+};
+
+/// gives access to the RooFitResult setters that RooMinimizer::save uses
+class RooBatchFitResult : public RooFitResult {
+public:
+  RooBatchFitResult(const char* name, const char* title) : RooFitResult(name,title) {}
+
+  void fill(const RooArgList& constPars, const RooArgList& initPars, const RooArgList& finalPars,
+            Int_t status, Int_t covQual, Double_t minNLL, Double_t edm, TMatrixDSym& cov){
+    setConstParList(constPars);
+    setInitParList(initPars);
+    setStatus(status);
+    setCovQual(covQual);
+    setMinNLL(minNLL);
+    setNumInvalidNLL(0);
+    setEDM(edm);
+    setFinalParList(finalPars);
+    setCovarianceMatrix(cov);
+  }
+};
+
+/// Migrad attempts, from the cheapest: a later one only runs, from the minimum of the previous one, if that one
+/// did not converge. The last one loosens the tolerance and its result is reported with the EDM it reached.
+static const Int_t    fitAttempts = 3 ;
+static const Int_t    fitAttemptStrategy[fitAttempts]  = { 1, 2, 2 } ;
+static const Double_t fitAttemptTolerance[fitAttempts] = { 1., 1., 10. } ;
+
+/// minos names: comma separated substrings of parameter names, e.g. "eff_ttbar,rrv_mean1_gaus,rrv_sigma1_gaus"
+static Bool_t matchesMinos(const char* name, const char* minosParams){
+  if(!minosParams || !minosParams[0]) return kFALSE;
+  TString list(minosParams);
+  TObjArray* tokens = list.Tokenize(",");
+  Bool_t match=kFALSE;
+  for(Int_t i=0; i<tokens->GetEntries() && !match; i++){
+    TString token = ((TObjString*) tokens->At(i))->GetString();
+    token = token.Strip(TString::kBoth);
+    if(token.Length()>0 && TString(name).Contains(token)) match=kTRUE;
+  }
+  delete tokens;
+  return match;
+}
+
+/// Convergence driven Minuit2 fit: migrad + hesse, escalated along fitAttempt* until migrad reports status 0,
+/// the EDM is below the Minuit2 threshold and hesse gives a full accurate covariance; then minos on the minosParams
+/// and the SumW2 correction. Time per stage is printed. Returns 0 if the Minuit2 plugin cannot be loaded.
+static RooFitResult* minimize_batch_nll(RooBatchNLL& nll, Bool_t sumW2Error, Bool_t analyticGradient, const char* minosParams,
+                                        const char* resultName){
+
+  ROOT::Math::Minimizer* minimizer = ROOT::Math::Factory::CreateMinimizer("Minuit2","Migrad");
+  if(!minimizer) return 0;
+
+  RooArgSet* allParams = nll.getParameters(RooArgSet());
+  RooArgList floatParams, constParams;
+  TIterator* iter = allParams->createIterator();
+  RooAbsArg* arg;
+  while((arg = (RooAbsArg*) iter->Next())){
+    RooRealVar* par = dynamic_cast<RooRealVar*>(arg);
+    if(!par) continue;
+    if(par->isConstant()) constParams.add(*par);
+    else floatParams.add(*par);
+  }
+  delete iter;
+  RooArgList* initParams = (RooArgList*) floatParams.snapshot(kFALSE);
+  Int_t npar = floatParams.getSize();
+
+  RooBatchNLLGradFcn gradFcn(nll,floatParams);
+  RooBatchNLLFcn fcn(nll,floatParams);
+  if(analyticGradient) minimizer->SetFunction(gradFcn);
+  else                 minimizer->SetFunction(fcn);
+  minimizer->SetErrorDef(0.5);
+  minimizer->SetPrintLevel(0);
+  minimizer->SetMaxFunctionCalls(500*npar);
+  minimizer->SetMaxIterations(500*npar);
+
+  /// same initial steps as RooMinimizerFcn
+  for(Int_t i=0; i<npar; i++){
+    RooRealVar* par = (RooRealVar*) floatParams.at(i);
+    Double_t step = par->getError();
+    if(step<=0) step = (par->hasMin() && par->hasMax()) ? 0.1*(par->getMax()-par->getMin()) : 1.;
+    if(par->hasMin() && par->hasMax()){
+      if(par->getMax()-par->getMin() < 2*step) step = 0.1*(par->getMax()-par->getMin());
+      minimizer->SetLimitedVariable(i,par->GetName(),par->getVal(),step,par->getMin(),par->getMax());
+    }else if(par->hasMin()){
+      minimizer->SetLowerLimitedVariable(i,par->GetName(),par->getVal(),step,par->getMin());
+    }else if(par->hasMax()){
+      minimizer->SetUpperLimitedVariable(i,par->GetName(),par->getVal(),step,par->getMax());
+    }else{
+      minimizer->SetVariable(i,par->GetName(),par->getVal(),step);
+    }
+  }
+
+  TStopwatch timerMigrad, timerHesse, timerSumW2, timerMinos;
+  timerMigrad.Reset(); timerHesse.Reset(); timerSumW2.Reset(); timerMinos.Reset();
+
+  Int_t status=-1, covQual=-1, attempt=0;
+  Double_t edm=0;
+  for(attempt=0; attempt<fitAttempts; attempt++){
+    Double_t tolerance = fitAttemptTolerance[attempt]*ROOT::Math::MinimizerOptions::DefaultTolerance();
+    minimizer->SetStrategy(fitAttemptStrategy[attempt]);
+    minimizer->SetTolerance(tolerance);
+
+    timerMigrad.Start(kFALSE);
+    minimizer->Minimize();
+    timerMigrad.Stop();
+    status = minimizer->Status();
+
+    timerHesse.Start(kFALSE);
+    Bool_t hesseOK = minimizer->Hesse();
+    timerHesse.Stop();
+    covQual = minimizer->CovMatrixStatus();
+    edm = minimizer->Edm();
+
+    /// Minuit2 stops migrad at EDM < 0.002*tolerance*errorDef
+    Bool_t edmOK = edm < 0.002*tolerance*minimizer->ErrorDef();
+    if(status==0 && edmOK && hesseOK && covQual==3) break;
+    std::cout<<"fit_batch_nll: attempt "<<attempt+1<<" (strategy "<<fitAttemptStrategy[attempt]<<", tolerance "<<tolerance
+             <<") status "<<status<<" edm "<<edm<<" covQual "<<covQual<<(hesseOK ? "" : ", hesse failed")<<std::endl;
+  }
+  Int_t attempts = TMath::Min(attempt+1,fitAttempts);
+
+  Double_t minNLL = minimizer->MinValue();
+  std::vector<Double_t> best(minimizer->X(),minimizer->X()+npar);
+
+  TMatrixDSym matV(npar);
+  for(Int_t i=0; i<npar; i++) for(Int_t j=0; j<npar; j++) matV(i,j)=minimizer->CovMatrix(i,j);
+
+  /// minos on the scale factor parameters only, from the weights (not weights^2) likelihood: before the weights^2 hesse,
+  /// which leaves the weights^2 minimum and covariance in the Minuit2 state, as RooAbsPdf::fitTo does
+  std::vector<Double_t> minosLow(npar,0), minosUp(npar,0);
+  std::vector<Bool_t> minosDone(npar,kFALSE);
+  if(status==0){
+    for(Int_t i=0; i<npar; i++){
+      RooRealVar* par = (RooRealVar*) floatParams.at(i);
+      if(!matchesMinos(par->GetName(),minosParams)) continue;
+      timerMinos.Start(kFALSE);
+      minosDone[i] = minimizer->GetMinosError(i,minosLow[i],minosUp[i]);
+      timerMinos.Stop();
+      if(!minosDone[i]) std::cout<<"fit_batch_nll: minos failed for "<<par->GetName()<<std::endl;
+    }
+  }
+
+  /// SumW2 correction: C = V * (V_w2)^-1 * V, as done by RooAbsPdf::fitTo
+  if(sumW2Error){
+    timerSumW2.Start(kFALSE);
+    nll.applyWeightSquared(kTRUE);
+    minimizer->Hesse();
+    TMatrixDSym matC(npar);
+    for(Int_t i=0; i<npar; i++) for(Int_t j=0; j<npar; j++) matC(i,j)=minimizer->CovMatrix(i,j);
+    nll.applyWeightSquared(kFALSE);
+    timerSumW2.Stop();
+    Double_t det=0;
+    matC.Invert(&det);
+    if(det==0){
+      std::cout<<"fit_batch_nll: weights^2 covariance matrix is singular, no SumW2 correction applied"<<std::endl;
+    }else{
+      matC.Similarity(matV);
+      matV=matC;
+    }
+  }
+
+  for(Int_t i=0; i<npar; i++){
+    RooRealVar* par = (RooRealVar*) floatParams.at(i);
+    par->setVal(best[i]);
+    par->setError(TMath::Sqrt(matV(i,i)));
+    par->removeAsymError();
+    if(minosDone[i]) par->setAsymError(minosLow[i],minosUp[i]);
+  }
+
+  std::cout<<Form("fit_batch_nll: %d migrad attempt(s) %.2f s, hesse %.2f s, sumw2 hesse %.2f s, minos %.2f s",
+                  attempts,timerMigrad.RealTime(),timerHesse.RealTime(),timerSumW2.RealTime(),timerMinos.RealTime())<<std::endl;
+
+  RooBatchFitResult filler(resultName,resultName);
+  filler.fill(constParams,*initParams,floatParams,status,covQual,minNLL,edm,matV);
+  RooFitResult* result = new RooFitResult(filler);
+
+  delete initParams;
+  delete allParams;
+  delete minimizer;
+  return result;
+}
+
+
+RooFitResult* fit_batch_nll(RooAbsPdf* pdf, RooAbsData* data, RooRealVar* x, RooArgSet* constraints, Bool_t sumW2Error,
+                            Bool_t analyticGradient, Bool_t binned, const char* minosParams){
+
+  TString name; name.Form("nll_batch_%s_%s",pdf->GetName(),data->GetName());
+  RooBatchNLL nll(name.Data(),name.Data(),*pdf,*data,*x,constraints,binned);
+  TString events; events.Form(binned ? "%d events in %d bins" : "%d events",nll.numEvents(),nll.numBins());
+
+  name.Form("fitresult_%s_%s",pdf->GetName(),data->GetName());
+  /// with threads Minuit2 differentiates the threaded NLL numerically, the analytic gradient being single threaded
+  if(nll.numThreads()>0 && !binned) events += Form(", %d threads",nll.numThreads());
+  Bool_t useGradient = analyticGradient && !binned && nll.numThreads()==0;
+  RooFitResult* result = minimize_batch_nll(nll,sumW2Error,useGradient,minosParams,name.Data());
+  if(result){
+    const char* derivatives = binned ? ", cached bin integrals" : (useGradient ? ", analytic gradient" : "");
+    std::cout<<"fit_batch_nll: "<<events<<derivatives<<", status "<<result->status()<<" covQual "<<result->covQual()<<std::endl;
+    return result;
+  }
+  std::cout<<"fit_batch_nll: Minuit2 not available, using RooMinimizer"<<std::endl;
+
+  RooMinimizer minimizer(nll);
+  minimizer.setMinimizerType("Minuit2");
+  minimizer.setStrategy(1);
+  minimizer.minimize("Minuit2","migrad");
+  minimizer.hesse();
+
+  /// SumW2 correction: C = V * (V_w2)^-1 * V, as done by RooAbsPdf::fitTo
+  if(sumW2Error){
+    RooFitResult* result_w = minimizer.save();
+    nll.applyWeightSquared(kTRUE);
+    minimizer.hesse();
+    RooFitResult* result_w2 = minimizer.save();
+    nll.applyWeightSquared(kFALSE);
+
+    TMatrixDSym matV(result_w->covarianceMatrix());
+    TMatrixDSym matC(result_w2->covarianceMatrix());
+    Double_t det=0;
+    matC.Invert(&det);
+    if(det==0){
+      std::cout<<"fit_batch_nll: weights^2 covariance matrix is singular, no SumW2 correction applied"<<std::endl;
+    }else{
+      matC.Similarity(matV);
+      minimizer.applyCovarianceMatrix(matC);
+    }
+    delete result_w;
+    delete result_w2;
+  }
+
+  result = minimizer.save(name.Data(),name.Data());
+  std::cout<<"fit_batch_nll: "<<events<<", status "<<result->status()<<" covQual "<<result->covQual()<<std::endl;
+  return result;
+}
@@ -0,0 +1,168 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ *                                                                           *
+ * Unbinned (weighted) NLL evaluated through the batch interface of the      *
+ * HWWLVJRooPdfs shapes                                                      *
+ *****************************************************************************/
+
+#ifndef ROO_BATCH_NLL
+#define ROO_BATCH_NLL
+
+#include <vector>
+
+#include "RooAbsReal.h"
+#include "RooAbsPdf.h"
+#include "RooAbsData.h"
+#include "RooRealVar.h"
+#include "RooListProxy.h"
+#include "RooArgSet.h"
+#include "RooFitResult.h"
+
+#include "HWWLVJRooPdfs.h"
+
+/// Fill out[i] with the normalised density of pdf at xs[i]. RooBatchPdf shapes and RooAddPdf / RooExtendPdf
+/// trees of them are evaluated as arrays; any other pdf falls back to one getVal per point.
+void evaluatePdfBatch(const RooAbsPdf& pdf, RooRealVar& x, const Double_t* xs, Double_t* out, Int_t n, const RooArgSet* normSet);
+
+/// Fill out[i] with the log of the normalised density when pdf, or the pdf a RooExtendPdf wraps, is a shape with a
+/// log path (RooBatchPdf::logBatch); kFALSE otherwise, and the caller takes the log of evaluatePdfBatch
+Bool_t logPdfBatch(const RooAbsPdf& pdf, const Double_t* xs, Double_t* out, Int_t n, const RooArgSet* normSet);
+
+/// As evaluatePdfBatch, plus grad[j][i] = d out[i] / d params[j]. Shapes with gradientParams(), RooGaussian and
+/// RooAddPdf / RooExtendPdf trees of them are differentiated analytically (functions of the parameters, like
+/// RooFormulaVar coefficients, by central differences); other pdfs by central differences of the whole array.
+void gradientPdfBatch(const RooAbsPdf& pdf, RooRealVar& x, const Double_t* xs, Double_t* out, Double_t** grad, Int_t n,
+                      const RooArgSet* normSet, const RooArgList& params);
+
+/// Fill out[b] with the probability of pdf in bin b of [edges[b],edges[b+1]]: analytic erf differences for
+/// RooGaussian, batchIntegral for RooBatchPdf shapes, 2 point Gauss-Legendre of evaluatePdfBatch otherwise,
+/// RooAddPdf / RooExtendPdf trees combined bin by bin. Each shape is normalised to the sum over the n bins.
+void binIntegralsPdf(const RooAbsPdf& pdf, RooRealVar& x, const Double_t* edges, Double_t* out, Int_t n, const RooArgSet* normSet);
+
+/// kTRUE when binIntegralsPdf integrates every leaf of pdf without sampling it: gaussians, exponentials and RooBatchPdf
+/// shapes (closedIntegral, else batchIntegral) under RooAddPdf / RooExtendPdf
+Bool_t binIntegralsClosed(const RooAbsPdf& pdf, const RooRealVar& x);
+
+#if !defined(__CINT__) && !defined(__MAKECINT__)
+/// coef*shape(x) for one leaf of the RooAddPdf / RooExtendPdf tree of a pdf, with everything read from RooFit copied in;
+/// coef includes the fractions above the leaf and 1/norm of the leaf
+struct BatchPdfTerm {
+  const RooAbsPdf* pdf ;                        // the leaf
+  const RooBatchPdf* batchPdf ;                 // array shape, evaluated from params
+  Double_t params[RooBatchPdf::kMaxSnapshot] ;  // its batchSnapshot
+  Bool_t gaussian ;
+  Double_t mean, sigma ;
+  const Double_t* values ;                      // normalised values of any other leaf, filled in by the caller
+  Double_t coef ;
+};
+
+/// Append the leaves of pdf to terms. Reads the fractions, norms and snapshots, so it runs on the thread that owns pdf
+void flattenPdfTerms(const RooAbsPdf& pdf, const RooRealVar& x, Double_t coef, std::vector<BatchPdfTerm>& terms, const RooArgSet* normSet);
+
+/// out[i] = sum of the terms at xs[i], the values of the other leaves read at values[first+i]; shape is scratch space
+/// of n values. Array code on the terms only, safe on worker threads
+void evaluatePdfTerms(const std::vector<BatchPdfTerm>& terms, const Double_t* xs, Double_t* out, Int_t n, Int_t first, Double_t* shape);
+#endif
+
+/// Worker threads of the unbinned RooBatchNLLs built afterwards (0, the default, and 1: the calling thread only).
+/// The events of each category are cut into fixed blocks, Kahan summed inside a block and pairwise over the blocks,
+/// so the NLL does not depend on n.
+void SetBatchNLLThreads(Int_t n);
+
+////// Batch NLL
+/// -sum w*log(pdf) (+ extended term, + external constraints). The observable values and weights are copied
+/// once at construction; RooSimultaneous pdfs are split into one event block per category.
+/// Binned: the events are summed into the bins of x (sumW and sumW2 per bin and category) and the NLL is
+/// -sum_b sumW_b*log(p_b), with the bin probabilities p_b of each shape kept until one of its parameters changes,
+/// so one evaluation costs O(bins) whatever the number of events.
+/// Threaded: the fractions, norms, shape snapshots (RooBatchPdf::batchSnapshot) and pdfs without array path are
+/// evaluated on the calling thread, then the blocks of events are shared among the threads, which only run array
+/// code on these values (see SetBatchNLLThreads).
+class RooBatchNLL : public RooAbsReal {
+public:
+  RooBatchNLL() : pdf(0), x(0), weightSq(kFALSE), binned(kFALSE), nEvents(0), nThreads(0) {} ;
+  RooBatchNLL(const char *name, const char *title,
+              RooAbsPdf& _pdf,
+              RooAbsData& _data,
+              RooRealVar& _x,
+              const RooArgSet* _constraints=0,
+              Bool_t _binned=kFALSE);
+
+  RooBatchNLL(const RooBatchNLL& other, const char* name=0) ;
+
+  virtual TObject* clone(const char* newname) const { return new RooBatchNLL(*this,newname); }
+
+  virtual ~RooBatchNLL() ;
+
+  void applyWeightSquared(Bool_t flag) ; // weights -> weights^2, used for the SumW2 covariance correction
+
+  Int_t numEvents() const ;
+  Int_t numBins() const { return binned ? Int_t(binEdges.size())-1 : 0 ; }
+
+  void setThreads(Int_t n) ;
+  Int_t numThreads() const { return nThreads ; }
+
+  /// grad[j] = d value / d floatParams[j], with floatParams RooRealVars of the likelihood (central differences if binned)
+  void gradient(const RooArgList& floatParams, Double_t* grad) const ;
+
+protected:
+
+  RooListProxy params ;
+  RooListProxy constraints ;
+
+  RooAbsPdf*  pdf ; //!
+  RooRealVar* x ;   //!
+  Bool_t weightSq ;
+
+  std::vector<RooAbsPdf*> catPdf ;             //! one entry per category (a single one for non simultaneous pdfs)
+  std::vector<std::vector<Double_t> > catX ;  //!
+  std::vector<std::vector<Double_t> > catW ;  //! weights, or sum of weights per bin if binned
+  std::vector<std::vector<Double_t> > catW2 ; //! sum of weights^2 per bin if binned
+
+  Bool_t binned ;
+  Int_t nEvents ;                  //!
+  std::vector<Double_t> binEdges ; //!
+
+  /// bin probabilities of the shapes of the pdfs, with the parameter values they were computed for
+  mutable std::vector<const RooAbsPdf*> shapePdf ;                 //!
+  mutable std::vector<RooArgSet*> shapeParams ;                    //!
+  mutable std::vector<std::vector<Double_t> > shapeParamValues ;   //!
+  mutable std::vector<std::vector<Double_t> > shapeBinProb ;       //!
+
+  Int_t nThreads ;
+
+  /// per event values of the pdfs without array path for the threaded evaluation, kept if they have no parameters
+  mutable std::vector<const RooAbsPdf*> eventPdf ;                  //!
+  mutable std::vector<UInt_t> eventCat ;                            //!
+  mutable std::vector<Int_t> eventFixed ;                           //!
+  mutable std::vector<std::vector<Double_t> > eventValues ;         //!
+
+  void binProbabilities(const RooAbsPdf& _pdf, Double_t* out, const RooArgSet* normSet) const ;
+  void clearShapeCache() ;
+  const Double_t* pdfEventValues(UInt_t k, const RooAbsPdf& _pdf, const RooArgSet& normSet) const ;
+#if !defined(__CINT__) && !defined(__MAKECINT__)
+  void flattenTerms(UInt_t k, std::vector<BatchPdfTerm>& terms, const RooArgSet& normSet) const ;
+#endif
+
+  Double_t extendedTerm(UInt_t k, Double_t sumW, Double_t sumW2, const RooArgSet& normSet) const ;
+  Double_t constraintTerm() const ;
+
+  Double_t evaluate() const ;
+  Double_t evaluateBinned() const ;
+  Double_t evaluateBlocks() const ;
+
+private:
+
+  ClassDef(RooBatchNLL,3)
+};
+
+/// Minuit2 fit of pdf to data through RooBatchNLL (migrad + hesse), with the same SumW2 covariance correction as fitTo.
+/// Migrad is run again with strategy 2, then with a 10 times looser tolerance, only while the previous attempt has a
+/// non zero status, an EDM above threshold or a covariance that is not full accurate; one pass for a healthy fit.
+/// With analyticGradient Minuit2 gets RooBatchNLL::gradient instead of computing finite differences of the NLL.
+/// With binned the NLL is the binned one over the binning of x (data can be a RooDataSet or a RooDataHist).
+/// minosParams: comma separated substrings of the parameter names that get minos errors (none by default).
+RooFitResult* fit_batch_nll(RooAbsPdf* pdf, RooAbsData* data, RooRealVar* x, RooArgSet* constraints=NULL, Bool_t sumW2Error=kTRUE,
+                            Bool_t analyticGradient=kTRUE, Bool_t binned=kFALSE, const char* minosParams=0);
+
+#endif
@@ -0,0 +1,57 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ *                                                                           *
+ * Cache of the parameter-only quantities of a pdf                           *
+ *****************************************************************************/
+
+#ifndef HWWLVJ_DERIVEDCONSTANTS
+#define HWWLVJ_DERIVEDCONSTANTS
+
+#include "Rtypes.h"
+
+#include <algorithm>
+#include <cassert>
+
+////// Derived constants cache
+/// Quantities of a pdf that depend on the parameters only (tail constants, component norms, ...),
+/// stored with the parameter values they were computed from. A pdf keeps one as a mutable transient
+/// member and fills it when update() reports that the inputs changed:
+///   Double_t inputs[4]={alpha1,n1,alpha2,n2};
+///   if(tailConstants.update(inputs,4)){ tailConstants[0]=...; tailConstants[1]=...; }
+/// Pdf copy constructors leave it out of their initialiser list, so a copy starts empty.
+class RooDerivedConstants {
+public:
+  enum { kMaxInputs=16, kMaxValues=8 };
+
+  RooDerivedConstants() : valid(kFALSE), nInputs(0) { }
+
+  /// kTRUE if in[0..n-1] differ from the inputs of the stored values; in becomes the new reference.
+  /// More than kMaxInputs inputs cannot be stored: always kTRUE, so the values are recomputed on every call
+  Bool_t update(const Double_t* in, Int_t n){
+    assert(n>=0 && n<=kMaxInputs) ;
+    if(n>kMaxInputs){ valid=kFALSE; return kTRUE; }
+    if(valid && n==nInputs && std::equal(in,in+n,inputs)) return kFALSE;
+    std::copy(in,in+n,inputs);
+    nInputs=n;
+    valid=kTRUE;
+    return kTRUE;
+  }
+
+  void invalidate(){ valid=kFALSE; }
+
+  Double_t& operator[](Int_t i){ assert(i>=0 && i<kMaxValues) ; return values[i]; }
+  Double_t  operator[](Int_t i) const { assert(i>=0 && i<kMaxValues) ; return values[i]; }
+
+  /// the kMaxValues stored values
+  Double_t*       data(){ return values; }
+  const Double_t* data() const { return values; }
+
+private:
+
+  Bool_t   valid;              //!
+  Int_t    nInputs;            //!
+  Double_t inputs[kMaxInputs]; //!
+  Double_t values[kMaxValues]; //!
+};
+
+#endif
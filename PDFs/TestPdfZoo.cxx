@@ -0,0 +1,135 @@
+/*
+ * The HWWLVJRooPdfs shapes shared by the test macros (test_Integrals, test_Gradients, test_Tabulated,
+ * test_Generators, test_LogBatch), with their parameters as members: a TestPdfZoo on the stack of the
+ * macro owns all of them. Loaded after HWWLVJRooPdfs.cxx:
+ *   gROOT->ProcessLine(".L TestPdfZoo.cxx+");
+ *   TestPdfZoo zoo(x);
+ *   RooArgList pdfs(zoo.pdfs("ErfExp,ExpTail"));
+ */
+
+#include "Riostream.h"
+
+#include "HWWLVJRooPdfs.h"
+#include "RooGaussian.h"
+#include "RooRealVar.h"
+#include "RooArgList.h"
+#include "TObjArray.h"
+#include "TObjString.h"
+#include "TString.h"
+
+class TestPdfZoo {
+public:
+  TestPdfZoo(RooRealVar& x) ;
+
+  /// the shapes named in the comma separated list, in the order of the list; all of them for ""
+  RooArgList pdfs(const char* names="") const ;
+
+  RooRealVar c, ca, c0, c1, c2, c0a, c1a ;
+  RooRealVar p, p0, p1, p2 ;
+  RooRealVar offset, width, offseta, widtha ;
+  RooRealVar s, a, s1, a1, n, n0, n1, frac ;
+  RooRealVar mean, sigma ;
+
+  RooGaussian gaus ;  // peak of the sums built by the tests, not in pdfs()
+
+  RooPowPdf pow1 ;
+  RooPow2Pdf pow2 ;
+  RooPow3Pdf pow3 ;
+  RooQCDPdf qcd ;
+  RooErfExpPdf erfExp ;
+  RooErfPowPdf erfPow ;
+  RooErfPow2Pdf erfPow2 ;
+  RooErfPow3Pdf erfPow3 ;
+  RooErfPowExpPdf erfPowExp ;
+  RooAlpha4ErfPowPdf alpha4ErfPow ;
+  RooAlpha4ErfPow2Pdf alpha4ErfPow2 ;
+  RooAlpha4ErfPowExpPdf alpha4ErfPowExp ;
+  RooExpNPdf expN ;
+  RooAnaExpNPdf anaExpN ;
+  RooAlpha4ExpNPdf alpha4ExpN ;
+  RooExpTailPdf expTail ;
+  RooAlpha4ExpTailPdf alpha4ExpTail ;
+  RooAlpha alpha ;
+  RooAlphaExp alphaExp ;
+  Roo2ExpPdf twoExp ;
+  RooAlpha42ExpPdf alpha42Exp ;
+  RooAtanAlpha atanAlpha ;
+  RooAtanExpPdf atanExp ;
+  RooAtanPowPdf atanPow ;
+  RooAtanPow2Pdf atanPow2 ;
+  RooAtanPow3Pdf atanPow3 ;
+  RooAtanPowExpPdf atanPowExp ;
+  RooAlpha4AtanPowPdf alpha4AtanPow ;
+  RooAlpha4AtanPow2Pdf alpha4AtanPow2 ;
+  RooAlpha4AtanPowExpPdf alpha4AtanPowExp ;
+  RooGausErfExpPdf gausErfExp ;
+  RooExpGausPdf expGaus ;
+  RooErfExpGausPdf erfExpGaus ;
+
+private:
+  TestPdfZoo(const TestPdfZoo&) ;
+  RooArgList all ;
+};
+
+TestPdfZoo::TestPdfZoo(RooRealVar& x) :
+  c("c","c",-0.03), ca("ca","ca",-0.02), c0("c0","c0",3), c1("c1","c1",0.5), c2("c2","c2",0.1),
+  c0a("c0a","c0a",2), c1a("c1a","c1a",0.3),
+  p("p","p",-5), p0("p0","p0",10), p1("p1","p1",5), p2("p2","p2",0.5),
+  offset("offset","offset",80), width("width","width",30), offseta("offseta","offseta",60), widtha("widtha","widtha",20),
+  s("s","s",30), a("a","a",0.1), s1("s1","s1",40), a1("a1","a1",0.05),
+  n("n","n",10), n0("n0","n0",10), n1("n1","n1",5), frac("frac","frac",0.3),
+  mean("mean","mean",84), sigma("sigma","sigma",8),
+  gaus("gaus","gaus",x,mean,sigma),
+  pow1("Pow","Pow",x,p),
+  pow2("Pow2","Pow2",x,p0,p1),
+  pow3("Pow3","Pow3",x,p0,p1,p2),
+  qcd("QCD","QCD",x,p0,p1,p2),
+  erfExp("ErfExp","ErfExp",x,c,offset,width),
+  erfPow("ErfPow","ErfPow",x,c,offset,width),
+  erfPow2("ErfPow2","ErfPow2",x,c0,c1,offset,width),
+  erfPow3("ErfPow3","ErfPow3",x,c0,c1,c2,offset,width),
+  erfPowExp("ErfPowExp","ErfPowExp",x,c0,c1,offset,width),
+  alpha4ErfPow("Alpha4ErfPow","Alpha4ErfPow",x,c,offset,width,ca,offseta,widtha),
+  alpha4ErfPow2("Alpha4ErfPow2","Alpha4ErfPow2",x,c0,c1,offset,width,c0a,c1a,offseta,widtha),
+  alpha4ErfPowExp("Alpha4ErfPowExp","Alpha4ErfPowExp",x,c0,c1,offset,width,c0a,c1a,offseta,widtha),
+  expN("ExpN","ExpN",x,c,n),
+  anaExpN("AnaExpN","AnaExpN",x,c,n),
+  alpha4ExpN("Alpha4ExpN","Alpha4ExpN",x,c,n0,ca,n1),
+  expTail("ExpTail","ExpTail",x,s,a),
+  alpha4ExpTail("Alpha4ExpTail","Alpha4ExpTail",x,s,a,s1,a1),
+  alpha("Alpha","Alpha",x,c,offset,width,ca,offseta,widtha,x.getMin(),x.getMax()),
+  alphaExp("AlphaExp","AlphaExp",x,c,ca,x.getMin(),x.getMax()),
+  twoExp("2Exp","2Exp",x,c,ca,frac),
+  alpha42Exp("Alpha42Exp","Alpha42Exp",x,c,ca,frac,ca,c,frac),
+  atanAlpha("AtanAlpha","AtanAlpha",x,c,offset,width,ca,offseta,widtha,x.getMin(),x.getMax()),
+  atanExp("AtanExp","AtanExp",x,c,offset,width),
+  atanPow("AtanPow","AtanPow",x,c,offset,width),
+  atanPow2("AtanPow2","AtanPow2",x,c0,c1,offset,width),
+  atanPow3("AtanPow3","AtanPow3",x,c0,c1,c2,offset,width),
+  atanPowExp("AtanPowExp","AtanPowExp",x,c0,c1,offset,width),
+  alpha4AtanPow("Alpha4AtanPow","Alpha4AtanPow",x,c,offset,width,ca,offseta,widtha),
+  alpha4AtanPow2("Alpha4AtanPow2","Alpha4AtanPow2",x,c0,c1,offset,width,c0a,c1a,offseta,widtha),
+  alpha4AtanPowExp("Alpha4AtanPowExp","Alpha4AtanPowExp",x,c0,c1,offset,width,c0a,c1a,offseta,widtha),
+  gausErfExp("GausErfExp","GausErfExp",x,mean,sigma,c,offset,width,frac),
+  expGaus("ExpGaus","ExpGaus",x,c,mean,sigma,frac),
+  erfExpGaus("ErfExpGaus","ErfExpGaus",x,c,offset,width,mean,sigma,frac){
+
+  all.add(RooArgList(pow1,pow2,pow3,qcd,erfExp,erfPow,erfPow2,erfPow3));
+  all.add(RooArgList(erfPowExp,alpha4ErfPow,alpha4ErfPow2,alpha4ErfPowExp,expN,anaExpN,alpha4ExpN,expTail));
+  all.add(RooArgList(alpha4ExpTail,alpha,alphaExp,twoExp,alpha42Exp,atanAlpha,atanExp,atanPow));
+  all.add(RooArgList(atanPow2,atanPow3,atanPowExp,alpha4AtanPow,alpha4AtanPow2,alpha4AtanPowExp,gausErfExp,expGaus));
+  all.add(erfExpGaus);
+}
+
+RooArgList TestPdfZoo::pdfs(const char* names) const {
+  if(TString(names)=="") return all;
+  RooArgList selected;
+  TObjArray* tokens=TString(names).Tokenize(",");
+  for(Int_t i=0; i<tokens->GetEntries(); i++){
+    RooAbsArg* pdf=all.find(((TObjString*)tokens->At(i))->GetString().Data());
+    if(pdf) selected.add(*pdf);
+    else std::cout<<"TestPdfZoo: no shape "<<((TObjString*)tokens->At(i))->GetString()<<std::endl;
+  }
+  delete tokens;
+  return selected;
+}
@@ -0,0 +1,249 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ *                                                                           *
+ * Array versions of exp, log, erf and atan used by the batch evaluation of  *
+ * the HWWLVJRooPdfs shapes                                                  *
+ *****************************************************************************/
+
+#include "VectorMath.h"
+#include "TMath.h"
+#include <math.h>
+
+/// the AVX2 code is compiled through the target attribute, no special compiler flag is needed
+#if defined(__GNUC__) && defined(__x86_64__) && !defined(__CINT__) && !defined(__MAKECINT__)
+#define VECTORMATH_AVX2
+#include <immintrin.h>
+#define AVX2_TARGET __attribute__((target("avx2,fma")))
+#endif
+
+void VectorMath(){}
+
+static Int_t vectorMathBackend = -1; // -1: not decided yet
+
+static Int_t cpuHasAVX2(){
+#ifdef VECTORMATH_AVX2
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") ? 1 : 0;
+#else
+  return 0;
+#endif
+}
+
+Int_t GetVectorMathBackend(){
+  if(vectorMathBackend<0) vectorMathBackend=cpuHasAVX2();
+  return vectorMathBackend;
+}
+
+void SetVectorMathBackend(Int_t backend){
+  vectorMathBackend = backend==0 ? 0 : cpuHasAVX2();
+}
+
+
+//// Chebyshev expansion of g(u)=log(erfc(z)*exp(z^2)/t), t=2/(2+z), u=2t-1, used by the erf kernel.
+/// The coefficients are computed once at library load from the libm erfc (asymptotic series for large z).
+static const Int_t nErfCoefficients = 32;
+
+static Double_t scaledErfc(Double_t z){
+  if(z<10) return erfc(z)*exp(z*z);
+  Double_t term=1., sum=1., twoZ2=2*z*z;
+  for(Int_t k=1; k<20; k++){ term*=-(2*k-1)/twoZ2; sum+=term; }
+  return sum/(z*TMath::Sqrt(TMath::Pi()));
+}
+
+struct ErfChebyshev {
+  Double_t c[nErfCoefficients];
+  ErfChebyshev(){
+    const Int_t nNodes=2*nErfCoefficients;
+    Double_t g[nNodes];
+    for(Int_t j=0; j<nNodes; j++){
+      Double_t u = cos(TMath::Pi()*(j+0.5)/nNodes);
+      Double_t t = (u+1)/2;
+      g[j] = log(scaledErfc(2/t-2)/t);
+    }
+    for(Int_t k=0; k<nErfCoefficients; k++){
+      Double_t sum=0;
+      for(Int_t j=0; j<nNodes; j++) sum += g[j]*cos(TMath::Pi()*k*(j+0.5)/nNodes);
+      c[k] = 2*sum/nNodes;
+    }
+  }
+};
+
+static const ErfChebyshev erfChebyshev;
+
+/// Taylor coefficients of erf(x)/x in powers of x^2, used for |x|<1
+static const Int_t nErfTaylor = 19;
+
+struct ErfTaylor {
+  Double_t c[nErfTaylor];
+  ErfTaylor(){
+    Double_t factorial=1.;
+    for(Int_t k=0; k<nErfTaylor; k++){
+      if(k>0) factorial*=k;
+      c[k] = (k%2==0 ? 2. : -2.)/TMath::Sqrt(TMath::Pi())/factorial/(2*k+1);
+    }
+  }
+};
+
+static const ErfTaylor erfTaylor;
+
+
+#ifdef VECTORMATH_AVX2
+
+//// exp: x = n*ln2 + r, |r|<ln2/2, degree 13 Taylor polynomial for exp(r), 2^n applied in two halves
+AVX2_TARGET static inline __m256d exp_avx2(__m256d x){
+  x = _mm256_min_pd(_mm256_max_pd(x,_mm256_set1_pd(-746.)),_mm256_set1_pd(710.));
+  __m256d fn = _mm256_round_pd(_mm256_mul_pd(x,_mm256_set1_pd(1.4426950408889634)),_MM_FROUND_TO_NEAREST_INT|_MM_FROUND_NO_EXC);
+  __m256d r  = _mm256_sub_pd(x,_mm256_mul_pd(fn,_mm256_set1_pd(6.93145751953125e-1)));
+  r          = _mm256_sub_pd(r,_mm256_mul_pd(fn,_mm256_set1_pd(1.42860682030941723212e-6)));
+
+  static const Double_t invFactorial[14] = {1., 1., 1./2, 1./6, 1./24, 1./120, 1./720, 1./5040, 1./40320, 1./362880.,
+                                            1./3628800., 1./39916800., 1./479001600., 1./6227020800.};
+  __m256d p = _mm256_set1_pd(invFactorial[13]);
+  for(Int_t k=12; k>=0; k--) p = _mm256_add_pd(_mm256_mul_pd(p,r),_mm256_set1_pd(invFactorial[k]));
+
+  __m256d fn1 = _mm256_floor_pd(_mm256_mul_pd(fn,_mm256_set1_pd(0.5)));
+  __m256d fn2 = _mm256_sub_pd(fn,fn1);
+  __m256i bias = _mm256_set1_epi64x(1023);
+  __m256i n1 = _mm256_add_epi64(_mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(fn1)),bias);
+  __m256i n2 = _mm256_add_epi64(_mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(fn2)),bias);
+  __m256d scale1 = _mm256_castsi256_pd(_mm256_slli_epi64(n1,52));
+  __m256d scale2 = _mm256_castsi256_pd(_mm256_slli_epi64(n2,52));
+  return _mm256_mul_pd(_mm256_mul_pd(p,scale1),scale2);
+}
+
+//// log: x = m*2^e with sqrt(1/2)<=m<sqrt(2), log(m) = 2*atanh(s), s=(m-1)/(m+1), series up to s^23
+AVX2_TARGET static inline __m256d log_avx2(__m256d x){
+  __m256i bits = _mm256_castpd_si256(x);
+  __m256i mantissaBits = _mm256_or_si256(_mm256_and_si256(bits,_mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL)),_mm256_set1_epi64x(0x3FF0000000000000LL));
+  __m256d m = _mm256_castsi256_pd(mantissaBits);
+  /// biased exponent -> double without a 64 bit conversion instruction: 2^52 + e - 2^52
+  __m256d magic = _mm256_set1_pd(4503599627370496.);
+  __m256d e = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(bits,52),_mm256_castpd_si256(magic))),magic);
+  e = _mm256_sub_pd(e,_mm256_set1_pd(1023.));
+
+  __m256d big = _mm256_cmp_pd(m,_mm256_set1_pd(1.4142135623730951),_CMP_GT_OQ);
+  m = _mm256_blendv_pd(m,_mm256_mul_pd(m,_mm256_set1_pd(0.5)),big);
+  e = _mm256_blendv_pd(e,_mm256_add_pd(e,_mm256_set1_pd(1.)),big);
+
+  __m256d one = _mm256_set1_pd(1.);
+  __m256d s = _mm256_div_pd(_mm256_sub_pd(m,one),_mm256_add_pd(m,one));
+  __m256d z = _mm256_mul_pd(s,s);
+  __m256d p = _mm256_set1_pd(1./23);
+  for(Int_t k=10; k>=0; k--) p = _mm256_add_pd(_mm256_mul_pd(p,z),_mm256_set1_pd(1./(2*k+1)));
+  __m256d logm = _mm256_mul_pd(_mm256_add_pd(s,s),p);
+
+  __m256d result = _mm256_add_pd(_mm256_mul_pd(e,_mm256_set1_pd(6.93145751953125e-1)),
+                                 _mm256_add_pd(logm,_mm256_mul_pd(e,_mm256_set1_pd(1.42860682030941723212e-6))));
+  __m256d zero = _mm256_setzero_pd();
+  result = _mm256_blendv_pd(result,_mm256_set1_pd(-HUGE_VAL),_mm256_cmp_pd(x,zero,_CMP_EQ_OQ));
+  result = _mm256_blendv_pd(result,_mm256_set1_pd(NAN),_mm256_cmp_pd(x,zero,_CMP_LT_OQ));
+  result = _mm256_blendv_pd(result,x,_mm256_cmp_pd(x,_mm256_set1_pd(HUGE_VAL),_CMP_EQ_OQ));
+  return result;
+}
+
+//// atan: |x|>1 -> pi/2-atan(1/|x|), |x|>tan(pi/12) -> pi/6+atan((sqrt3*x-1)/(x+sqrt3)), series up to x^29
+AVX2_TARGET static inline __m256d atan_avx2(__m256d x){
+  __m256d signMask = _mm256_set1_pd(-0.);
+  __m256d sign = _mm256_and_pd(x,signMask);
+  __m256d a = _mm256_andnot_pd(signMask,x);
+  __m256d one = _mm256_set1_pd(1.);
+  __m256d sqrt3 = _mm256_set1_pd(1.7320508075688772);
+
+  __m256d inverted = _mm256_cmp_pd(a,one,_CMP_GT_OQ);
+  a = _mm256_blendv_pd(a,_mm256_div_pd(one,a),inverted);
+  __m256d shifted = _mm256_cmp_pd(a,_mm256_set1_pd(0.2679491924311227),_CMP_GT_OQ);
+  a = _mm256_blendv_pd(a,_mm256_div_pd(_mm256_sub_pd(_mm256_mul_pd(a,sqrt3),one),_mm256_add_pd(a,sqrt3)),shifted);
+
+  __m256d z = _mm256_mul_pd(a,a);
+  __m256d p = _mm256_set1_pd(1./29);
+  for(Int_t k=13; k>=0; k--) p = _mm256_add_pd(_mm256_mul_pd(p,_mm256_sub_pd(_mm256_setzero_pd(),z)),_mm256_set1_pd(1./(2*k+1)));
+  __m256d result = _mm256_mul_pd(a,p);
+
+  result = _mm256_blendv_pd(result,_mm256_add_pd(result,_mm256_set1_pd(TMath::Pi()/6)),shifted);
+  result = _mm256_blendv_pd(result,_mm256_sub_pd(_mm256_set1_pd(TMath::PiOver2()),result),inverted);
+  return _mm256_or_pd(result,sign);
+}
+
+//// erf: erfc(|x|) = t*exp(-x^2+g(u)) with the Chebyshev series g evaluated by Clenshaw recurrence,
+//// Taylor series for |x|<1. Each series is only evaluated when at least one lane needs it.
+AVX2_TARGET static inline __m256d erf_avx2(__m256d x){
+  __m256d signMask = _mm256_set1_pd(-0.);
+  __m256d sign = _mm256_and_pd(x,signMask);
+  __m256d z = _mm256_andnot_pd(signMask,x);
+  __m256d z2 = _mm256_mul_pd(z,z);
+  __m256d small = _mm256_cmp_pd(z,_mm256_set1_pd(1.),_CMP_LT_OQ);
+  Int_t smallLanes = _mm256_movemask_pd(small);
+
+  __m256d result = _mm256_setzero_pd();
+  if(smallLanes!=0xF){
+    __m256d two = _mm256_set1_pd(2.);
+    __m256d t = _mm256_div_pd(two,_mm256_add_pd(two,z));
+    __m256d u = _mm256_sub_pd(_mm256_add_pd(t,t),_mm256_set1_pd(1.));
+    __m256d u2 = _mm256_add_pd(u,u);
+
+    __m256d b1 = _mm256_setzero_pd(), b2 = _mm256_setzero_pd();
+    for(Int_t k=nErfCoefficients-1; k>=1; k--){
+      __m256d b0 = _mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(u2,b1),b2),_mm256_set1_pd(erfChebyshev.c[k]));
+      b2 = b1; b1 = b0;
+    }
+    __m256d g = _mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(u,b1),b2),_mm256_set1_pd(0.5*erfChebyshev.c[0]));
+
+    __m256d erfc = _mm256_mul_pd(t,exp_avx2(_mm256_sub_pd(g,z2)));
+    result = _mm256_sub_pd(_mm256_set1_pd(1.),erfc);
+  }
+
+  /// |x|<1: Taylor series 2/sqrt(pi)*sum (-1)^k x^(2k+1)/(k!(2k+1)), avoids the cancellation in 1-erfc
+  if(smallLanes!=0){
+    __m256d p = _mm256_set1_pd(erfTaylor.c[nErfTaylor-1]);
+    for(Int_t k=nErfTaylor-2; k>=0; k--) p = _mm256_add_pd(_mm256_mul_pd(p,z2),_mm256_set1_pd(erfTaylor.c[k]));
+    result = _mm256_blendv_pd(result,_mm256_mul_pd(z,p),small);
+  }
+  return _mm256_or_pd(result,sign);
+}
+
+/// full registers of 4, then the tail through a padded register
+#define VECTORMATH_LOOP(kernel,pad)                                       \
+  Int_t i=0;                                                              \
+  for(; i+4<=n; i+=4) _mm256_storeu_pd(out+i,kernel(_mm256_loadu_pd(in+i))); \
+  if(i<n){                                                                \
+    Double_t buffer[4]={pad,pad,pad,pad};                                 \
+    for(Int_t j=0; i+j<n; j++) buffer[j]=in[i+j];                         \
+    _mm256_storeu_pd(buffer,kernel(_mm256_loadu_pd(buffer)));             \
+    for(Int_t j=0; i+j<n; j++) out[i+j]=buffer[j];                        \
+  }
+
+AVX2_TARGET static void exp_avx2_loop (const Double_t* in, Double_t* out, Int_t n){ VECTORMATH_LOOP(exp_avx2,0.) }
+AVX2_TARGET static void log_avx2_loop (const Double_t* in, Double_t* out, Int_t n){ VECTORMATH_LOOP(log_avx2,1.) }
+AVX2_TARGET static void atan_avx2_loop(const Double_t* in, Double_t* out, Int_t n){ VECTORMATH_LOOP(atan_avx2,0.) }
+AVX2_TARGET static void erf_avx2_loop (const Double_t* in, Double_t* out, Int_t n){ VECTORMATH_LOOP(erf_avx2,0.) }
+
+#endif
+
+
+void VecExp(const Double_t* in, Double_t* out, Int_t n){
+#ifdef VECTORMATH_AVX2
+  if(GetVectorMathBackend()==1){ exp_avx2_loop(in,out,n); return; }
+#endif
+  for(Int_t i=0; i<n; i++) out[i]=TMath::Exp(in[i]);
+}
+
+void VecLog(const Double_t* in, Double_t* out, Int_t n){
+#ifdef VECTORMATH_AVX2
+  if(GetVectorMathBackend()==1){ log_avx2_loop(in,out,n); return; }
+#endif
+  for(Int_t i=0; i<n; i++) out[i]=TMath::Log(in[i]);
+}
+
+void VecAtan(const Double_t* in, Double_t* out, Int_t n){
+#ifdef VECTORMATH_AVX2
+  if(GetVectorMathBackend()==1){ atan_avx2_loop(in,out,n); return; }
+#endif
+  for(Int_t i=0; i<n; i++) out[i]=TMath::ATan(in[i]);
+}
+
+void VecErf(const Double_t* in, Double_t* out, Int_t n){
+#ifdef VECTORMATH_AVX2
+  if(GetVectorMathBackend()==1){ erf_avx2_loop(in,out,n); return; }
+#endif
+  for(Int_t i=0; i<n; i++) out[i]=TMath::Erf(in[i]);
+}
@@ -0,0 +1,116 @@
+/*
+ * RooBatchNLL on a weighted pass / fail RooSimultaneous of gaussian + ErfExp extended models: value and analytic
+ * gradient against createNLL (central differences for the gradient), the same value with 0, 1 and 4 threads, and
+ * the binned fit_batch_nll against fitTo on the binnedClone of the data.
+ *   root -l -b -q test_BatchNLL.cxx
+ */
+
+{
+	using namespace RooFit;
+	gROOT->ProcessLine(".L VectorMath.cxx+");
+	gROOT->ProcessLine(".L HWWLVJRooPdfs.cxx+");
+	gROOT->ProcessLine(".L RooBatchNLL.cxx+");
+	RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+
+	RooRealVar x("x","x",40,150);
+	x.setBins(110);
+	RooCategory cat("cat","cat");
+	cat.defineType("pass");
+	cat.defineType("fail");
+
+	RooRealVar mean("mean","mean",84,70,95), sigma("sigma","sigma",8,3,15);
+	RooGaussian gaus("gaus","gaus",x,mean,sigma);
+	RooRealVar c_pass("c_pass","c_pass",-0.03,-0.2,0.), offset_pass("offset_pass","offset_pass",60,30,100), width_pass("width_pass","width_pass",30,10,80);
+	RooRealVar c_fail("c_fail","c_fail",-0.02,-0.2,0.), offset_fail("offset_fail","offset_fail",50,30,100), width_fail("width_fail","width_fail",25,10,80);
+	RooErfExpPdf erfExp_pass("erfExp_pass","erfExp_pass",x,c_pass,offset_pass,width_pass);
+	RooErfExpPdf erfExp_fail("erfExp_fail","erfExp_fail",x,c_fail,offset_fail,width_fail);
+	RooRealVar nsig_pass("nsig_pass","nsig_pass",8000,0,50000), nbkg_pass("nbkg_pass","nbkg_pass",12000,0,50000);
+	RooRealVar nsig_fail("nsig_fail","nsig_fail",3000,0,50000), nbkg_fail("nbkg_fail","nbkg_fail",14000,0,50000);
+	RooAddPdf model_pass("model_pass","model_pass",RooArgList(gaus,erfExp_pass),RooArgList(nsig_pass,nbkg_pass));
+	RooAddPdf model_fail("model_fail","model_fail",RooArgList(gaus,erfExp_fail),RooArgList(nsig_fail,nbkg_fail));
+	RooSimultaneous model("model","model",cat);
+	model.addPdf(model_pass,"pass");
+	model.addPdf(model_fail,"fail");
+
+	//// weighted data: events of both categories with weights in [0.5,1.5]
+	RooRandom::randomGenerator()->SetSeed(4321);
+	RooRealVar w("w","w",0,10);
+	RooDataSet data("data","data",RooArgSet(x,cat,w),WeightVar(w));
+	RooDataSet* generated_pass=model_pass.generate(x,20000);
+	RooDataSet* generated_fail=model_fail.generate(x,17000);
+	for(Int_t i=0; i<generated_pass->numEntries(); i++){
+		x.setVal(generated_pass->get(i)->getRealValue("x"));
+		cat.setLabel("pass");
+		data.add(RooArgSet(x,cat),0.5+RooRandom::uniform());
+	}
+	for(Int_t i=0; i<generated_fail->numEntries(); i++){
+		x.setVal(generated_fail->get(i)->getRealValue("x"));
+		cat.setLabel("fail");
+		data.add(RooArgSet(x,cat),0.5+RooRandom::uniform());
+	}
+
+	RooArgSet* parameters=model.getParameters(data);
+	RooArgSet* initial=(RooArgSet*) parameters->snapshot();
+	RooArgList floatParams;
+	TIterator* iter=parameters->createIterator();
+	for(RooRealVar* par=(RooRealVar*)iter->Next(); par; par=(RooRealVar*)iter->Next()){
+		if(!par->isConstant()) floatParams.add(*par);
+	}
+	delete iter;
+	Int_t npar=floatParams.getSize();
+	Bool_t pass=kTRUE;
+
+	//// value and gradient against createNLL, away from the generated values
+	mean.setVal(86); sigma.setVal(9); c_pass.setVal(-0.025); width_fail.setVal(28); nbkg_pass.setVal(11000);
+	RooAbsReal* nll_roofit=model.createNLL(data,Extended(kTRUE));
+	RooBatchNLL nll("nll","nll",model,data,x);
+	Double_t value=nll.getVal(), value_roofit=nll_roofit->getVal();
+	Double_t valueDiff=TMath::Abs(value-value_roofit)/TMath::Abs(value_roofit);
+	std::cout<<Form("NLL %.10g, createNLL %.10g, rel diff %.2e",value,value_roofit,valueDiff)<<std::endl;
+	if(valueDiff>1e-10) pass=kFALSE;
+
+	std::vector<Double_t> grad(npar);
+	nll.gradient(floatParams,&grad[0]);
+	Double_t maxGradDiff=0;
+	for(Int_t j=0; j<npar; j++){
+		RooRealVar* par=(RooRealVar*)&floatParams[j];
+		Double_t start=par->getVal(), h=1e-5*TMath::Max(1.,TMath::Abs(start));
+		par->setVal(start+h); Double_t up=nll_roofit->getVal();
+		par->setVal(start-h); Double_t down=nll_roofit->getVal();
+		par->setVal(start);
+		Double_t numeric=(up-down)/(2*h);
+		Double_t diff=TMath::Abs(grad[j]-numeric)/TMath::Max(1.,TMath::Abs(numeric));
+		std::cout<<Form("%-12s gradient %12.5g, createNLL differences %12.5g, rel diff %.2e",par->GetName(),grad[j],numeric,diff)<<std::endl;
+		maxGradDiff=TMath::Max(maxGradDiff,diff);
+	}
+	if(maxGradDiff>1e-4) pass=kFALSE;
+	delete nll_roofit;
+
+	//// 0, 1 and 4 threads: the same blocks summed in the same order
+	nll.setThreads(0); Double_t value0=nll.getVal();
+	nll.setThreads(1); Double_t value1=nll.getVal();
+	nll.setThreads(4); Double_t value4=nll.getVal();
+	std::cout<<Form("threads 0 %.17g, 1 %.17g, 4 %.17g",value0,value1,value4)<<std::endl;
+	if(value0!=value1 || value0!=value4) pass=kFALSE;
+
+	//// binned fit against fitTo of the binnedClone, both with the SumW2 correction
+	*parameters=*initial;
+	RooFitResult* rfres_batch=fit_batch_nll(&model,&data,&x,NULL,kTRUE,kTRUE,kTRUE);
+	RooArgSet* fitted_batch=(RooArgSet*) parameters->snapshot();
+	*parameters=*initial;
+	RooDataHist* hist=data.binnedClone();
+	RooFitResult* rfres_roofit=model.fitTo(*hist,Save(kTRUE),Extended(kTRUE),SumW2Error(kTRUE),PrintLevel(-1));
+	for(Int_t j=0; j<npar; j++){
+		const char* name=floatParams[j].GetName();
+		RooRealVar* par_batch=(RooRealVar*)fitted_batch->find(name);
+		RooRealVar* par_roofit=(RooRealVar*)&floatParams[j];
+		Double_t pull=(par_batch->getVal()-par_roofit->getVal())/par_roofit->getError();
+		Double_t errorRatio=par_batch->getError()/par_roofit->getError();
+		std::cout<<Form("%-12s binned %12.5g +- %-10.4g binnedClone fitTo %12.5g +- %-10.4g",name,
+			par_batch->getVal(),par_batch->getError(),par_roofit->getVal(),par_roofit->getError())<<std::endl;
+		if(TMath::Abs(pull)>0.2 || TMath::Abs(errorRatio-1)>0.1) pass=kFALSE;
+	}
+	if(rfres_batch->status()!=0 || rfres_roofit->status()!=0) pass=kFALSE;
+
+	std::cout<<(pass ? "PASS" : "FAIL")<<std::endl;
+}
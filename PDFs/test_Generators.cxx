@@ -0,0 +1,44 @@
+/*
+ * Generate toys from HWWLVJRooPdfs shapes through their inverse CDF generators and compare the toy mean
+ * and rms with the moments of the normalised shape (midpoint sum on a fine grid); prints the generation times.
+ *   root -l -b -q test_Generators.cxx
+ */
+
+{
+	using namespace RooFit;
+	gROOT->ProcessLine(".L VectorMath.cxx+");
+	gROOT->ProcessLine(".L HWWLVJRooPdfs.cxx+");
+	gROOT->ProcessLine(".L TestPdfZoo.cxx+");
+	RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+
+	RooRealVar x("x","x",30,200);
+
+	TestPdfZoo zoo(x);
+	RooArgList pdfs(zoo.pdfs("ErfExp,ErfPowExp,Alpha4ErfPow,ExpTail,GausErfExp"));
+
+	const Int_t nEvents=100000;
+	Double_t maxPull=0;
+	for(Int_t i=0; i<pdfs.getSize(); i++){
+		RooAbsPdf& pdf=(RooAbsPdf&)pdfs[i];
+
+		Double_t sum0=0, sum1=0, sum2=0;
+		for(Double_t m=30.005; m<200; m+=0.01){
+			x.setVal(m);
+			Double_t f=pdf.getVal(x);
+			sum0+=f; sum1+=f*m; sum2+=f*m*m;
+		}
+		Double_t expMean=sum1/sum0, expRms=TMath::Sqrt(sum2/sum0-expMean*expMean);
+
+		TStopwatch time;
+		time.Start();
+		RooDataSet* toy=pdf.generate(x,nEvents);
+		time.Stop();
+		Double_t toyMean=toy->meanVar(x)->getVal(), toyRms=toy->rmsVar(x)->getVal();
+		Double_t pull=(toyMean-expMean)/(expRms/TMath::Sqrt(nEvents));
+		maxPull=TMath::Max(maxPull,TMath::Abs(pull));
+		std::cout<<Form("%-14s mean %-9.4f expected %-9.4f (pull %5.2f)  rms %-9.4f expected %-9.4f  %.3f s",
+		                pdf.GetName(),toyMean,expMean,pull,toyRms,expRms,time.RealTime())<<std::endl;
+		delete toy;
+	}
+	std::cout<<(maxPull<5 ? "PASS" : "FAIL")<<std::endl;
+}
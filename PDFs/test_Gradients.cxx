@@ -0,0 +1,96 @@
+/*
+ * Compare the analytic gradients of the HWWLVJRooPdfs shapes with central differences: RooBatchPdf::gradientBatch
+ * against evaluateBatch of the raw shape, and gradientPdfBatch (RooBatchNLL) against the normalised pdf, alone and
+ * in a RooAddPdf with a gaussian peak, over the jet mass range.
+ *   root -l -b -q test_Gradients.cxx
+ */
+
+{
+	gROOT->ProcessLine(".L VectorMath.cxx+");
+	gROOT->ProcessLine(".L HWWLVJRooPdfs.cxx+");
+	gROOT->ProcessLine(".L RooBatchNLL.cxx+");
+	gROOT->ProcessLine(".L TestPdfZoo.cxx+");
+	RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+
+	RooRealVar x("x","x",30,200);
+	TestPdfZoo zoo(x);
+	RooArgList pdfs(zoo.pdfs("Pow,Pow2,Pow3,ErfExp,ErfPow,ErfPow2,ErfPow3,ErfPowExp,ExpN,ExpTail,2Exp,AnaExpN,"
+	                         "AtanExp,AtanPow,AtanPow2,AtanPow3,AtanPowExp"));
+
+	const Int_t nx=171;
+	Double_t xs[nx], out[nx], up[nx], down[nx];
+	for(Int_t i=0; i<nx; i++) xs[i]=30.5+i*169./(nx-1.);
+	RooArgSet nset(x);
+
+	//// raw shapes: gradientBatch against central differences of evaluateBatch, relative to the largest derivative
+	Double_t maxDiff=0;
+	for(Int_t k=0; k<pdfs.getSize(); k++){
+		RooBatchPdf* pdf=dynamic_cast<RooBatchPdf*>(&pdfs[k]);
+		RooArgList params(pdf->gradientParams());
+		Int_t npar=params.getSize();
+		std::vector<Double_t> grad(npar*nx);
+		std::vector<Double_t*> gradPtr(npar);
+		for(Int_t j=0; j<npar; j++) gradPtr[j]=&grad[j*nx];
+		pdf->gradientBatch(xs,out,&gradPtr[0],nx);
+
+		Double_t diff=0;
+		for(Int_t j=0; j<npar; j++){
+			RooRealVar* par=(RooRealVar*)&params[j];
+			Double_t value=par->getVal(), h=1e-6*TMath::Max(1.,TMath::Abs(value));
+			par->setVal(value+h); pdf->evaluateBatch(xs,up,nx);
+			par->setVal(value-h); pdf->evaluateBatch(xs,down,nx);
+			par->setVal(value);
+			Double_t scale=0, dev=0;
+			for(Int_t i=0; i<nx; i++){
+				Double_t numeric=(up[i]-down[i])/(2*h);
+				scale=TMath::Max(scale,TMath::Abs(numeric));
+				dev=TMath::Max(dev,TMath::Abs(gradPtr[j][i]-numeric));
+			}
+			diff=TMath::Max(diff,dev/TMath::Max(scale,1e-300));
+		}
+		std::cout<<Form("%-12s gradientBatch    %d parameters, max rel diff %.2e",pdfs[k].GetName(),npar,diff)<<std::endl;
+		maxDiff=TMath::Max(maxDiff,diff);
+	}
+
+	//// normalised pdfs, alone and summed with a gaussian: gradientPdfBatch against central differences of getVal
+	RooRealVar fsig("fsig","fsig",0.4);
+	RooAddPdf gausErfExpSum("GausErfExpSum","GausErfExpSum",zoo.gaus,zoo.erfExp,fsig);
+	RooAddPdf gausAtanPowSum("GausAtanPowSum","GausAtanPowSum",zoo.gaus,zoo.atanPow,fsig);
+	RooArgList models;
+	models.add(pdfs);
+	models.add(gausErfExpSum);
+	models.add(gausAtanPowSum);
+	for(Int_t k=0; k<models.getSize(); k++){
+		RooAbsPdf* pdf=(RooAbsPdf*)&models[k];
+		RooArgList params;
+		RooArgSet* vars=pdf->getParameters(nset);
+		params.add(*vars);
+		delete vars;
+		Int_t npar=params.getSize();
+		std::vector<Double_t> grad(npar*nx);
+		std::vector<Double_t*> gradPtr(npar);
+		for(Int_t j=0; j<npar; j++) gradPtr[j]=&grad[j*nx];
+		gradientPdfBatch(*pdf,x,xs,out,&gradPtr[0],nx,&nset,params);
+
+		Double_t diff=0;
+		for(Int_t j=0; j<npar; j++){
+			RooRealVar* par=(RooRealVar*)&params[j];
+			Double_t value=par->getVal(), h=1e-6*TMath::Max(1.,TMath::Abs(value));
+			Double_t scale=0, dev=0;
+			for(Int_t i=0; i<nx; i++){
+				x.setVal(xs[i]);
+				par->setVal(value+h); Double_t valUp=pdf->getVal(&nset);
+				par->setVal(value-h); Double_t valDown=pdf->getVal(&nset);
+				par->setVal(value);
+				Double_t numeric=(valUp-valDown)/(2*h);
+				scale=TMath::Max(scale,TMath::Abs(numeric));
+				dev=TMath::Max(dev,TMath::Abs(gradPtr[j][i]-numeric));
+			}
+			diff=TMath::Max(diff,dev/TMath::Max(scale,1e-300));
+		}
+		std::cout<<Form("%-14s gradientPdfBatch %d parameters, max rel diff %.2e",pdf->GetName(),npar,diff)<<std::endl;
+		maxDiff=TMath::Max(maxDiff,diff);
+	}
+
+	std::cout<<(maxDiff<1e-5 ? "PASS" : "FAIL")<<std::endl;
+}
@@ -0,0 +1,73 @@
+/*
+ * Compare analyticalIntegral of the HWWLVJRooPdfs shapes with RooFit numeric integration,
+ * over the full jet mass range and the sb_lo / signal_region / sb_hi ranges,
+ * and the fused models with the RooAddPdf they replace.
+ *   root -l -b -q test_Integrals.cxx
+ */
+
+{
+	using namespace RooFit;
+	gROOT->ProcessLine(".L VectorMath.cxx+");
+	gROOT->ProcessLine(".L HWWLVJRooPdfs.cxx+");
+	gROOT->ProcessLine(".L TestPdfZoo.cxx+");
+	RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+
+	RooRealVar x("x","x",30,200);
+	x.setRange("sb_lo",30,65);
+	x.setRange("signal_region",65,105);
+	x.setRange("sb_hi",105,200);
+
+	TestPdfZoo zoo(x);
+	RooArgList pdfs(zoo.pdfs("ErfPow,ErfPow2,ErfPow3,ErfPowExp,Alpha4ErfPow,Alpha4ErfPow2,Alpha4ErfPowExp,ExpTail,Alpha4ExpTail,"
+	                         "Alpha4ExpN,Alpha,AlphaExp,2Exp,Alpha42Exp,AtanAlpha,AtanExp,AtanPow,AtanPow2,AtanPow3,AtanPowExp,"
+	                         "Alpha4AtanPow,Alpha4AtanPow2,Alpha4AtanPowExp,GausErfExp,ExpGaus,ErfExpGaus"));
+
+	const char* ranges[4]={0,"sb_lo","signal_region","sb_hi"};
+	Double_t maxDiff=0;
+	TStopwatch timeAnalytic, timeNumeric;
+	timeAnalytic.Reset(); timeNumeric.Reset();
+
+	for(Int_t i=0; i<pdfs.getSize(); i++){
+		RooAbsPdf& pdf=(RooAbsPdf&)pdfs[i];
+		for(Int_t r=0; r<4; r++){
+			timeAnalytic.Start(kFALSE);
+			RooAbsReal* analytic = ranges[r] ? pdf.createIntegral(x,Range(ranges[r])) : pdf.createIntegral(x);
+			Double_t valAnalytic=analytic->getVal();
+			timeAnalytic.Stop();
+
+			pdf.forceNumInt(kTRUE);
+			timeNumeric.Start(kFALSE);
+			RooAbsReal* numeric = ranges[r] ? pdf.createIntegral(x,Range(ranges[r])) : pdf.createIntegral(x);
+			Double_t valNumeric=numeric->getVal();
+			timeNumeric.Stop();
+			pdf.forceNumInt(kFALSE);
+
+			Double_t diff=TMath::Abs(valAnalytic/valNumeric-1);
+			if(diff>maxDiff) maxDiff=diff;
+			std::cout<<Form("%-18s %-14s analytic %-14.8g numeric %-14.8g rel diff %.2e",pdf.GetName(),ranges[r] ? ranges[r] : "full",valAnalytic,valNumeric,diff)<<std::endl;
+			delete analytic;
+			delete numeric;
+		}
+	}
+
+	//// fused models against the RooAddPdf they replace
+	RooExponential expo("expo","expo",x,zoo.c);
+	RooAddPdf addGausErfExp("addGausErfExp","addGausErfExp",RooArgList(zoo.gaus,zoo.erfExp),RooArgList(zoo.frac),1);
+	RooAddPdf addExpGaus("addExpGaus","addExpGaus",RooArgList(expo,zoo.gaus),RooArgList(zoo.frac));
+	RooAddPdf addErfExpGaus("addErfExpGaus","addErfExpGaus",RooArgList(zoo.erfExp,zoo.gaus),RooArgList(zoo.frac));
+	RooAbsPdf* fused[3]={&zoo.gausErfExp,&zoo.expGaus,&zoo.erfExpGaus};
+	RooAbsPdf* added[3]={&addGausErfExp,&addExpGaus,&addErfExpGaus};
+	Double_t maxFusedDiff=0;
+	for(Int_t i=0; i<3; i++){
+		for(Double_t m=30; m<=200; m+=0.5){
+			x.setVal(m);
+			maxFusedDiff=TMath::Max(maxFusedDiff,TMath::Abs(fused[i]->getVal(x)/added[i]->getVal(x)-1));
+		}
+	}
+	std::cout<<"fused models max rel diff to RooAddPdf "<<maxFusedDiff<<std::endl;
+	if(maxFusedDiff>1e-9) maxDiff=TMath::Max(maxDiff,maxFusedDiff);
+
+	std::cout<<"max rel diff "<<maxDiff<<", analytic "<<timeAnalytic.RealTime()<<" s, numeric "<<timeNumeric.RealTime()<<" s"<<std::endl;
+	/// the default numeric integrator is only good to ~1e-7
+	std::cout<<(maxDiff<1e-6 ? "PASS" : "FAIL")<<std::endl;
+}
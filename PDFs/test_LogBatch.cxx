@@ -0,0 +1,39 @@
+/*
+ * Compare the log domain path of the power law shapes (RooBatchPdf::logBatch) with the log of evaluateBatch
+ * from 30 GeV to 1 TeV, and check that it stays finite where the shape underflows.
+ *   root -l -b -q test_LogBatch.cxx
+ */
+
+{
+	gROOT->ProcessLine(".L VectorMath.cxx+");
+	gROOT->ProcessLine(".L HWWLVJRooPdfs.cxx+");
+	gROOT->ProcessLine(".L TestPdfZoo.cxx+");
+
+	RooRealVar x("x","x",30,1000);
+	TestPdfZoo zoo(x);
+	/// power law exponents of the high mass tails
+	zoo.c.setVal(-5); zoo.c0.setVal(20); zoo.c1.setVal(3); zoo.c2.setVal(0.5);
+	RooArgList pdfs(zoo.pdfs("Pow,Pow2,Pow3,ErfPow,ErfPow2,ErfPow3,ErfPowExp,AtanPow,AtanPow2,AtanPow3,AtanPowExp,QCD"));
+
+	const Int_t n=971;
+	Double_t xs[n], shape[n], logShape[n];
+	for(Int_t i=0; i<n; i++) xs[i]=30+i;
+
+	Double_t maxDiff=0;
+	Bool_t finite=kTRUE;
+	for(Int_t k=0; k<pdfs.getSize(); k++){
+		RooBatchPdf* pdf=dynamic_cast<RooBatchPdf*>(&pdfs[k]);
+		pdf->evaluateBatch(xs,shape,n);
+		pdf->logBatch(xs,logShape,n);
+		Double_t diff=0;
+		Int_t underflow=0;
+		for(Int_t i=0; i<n; i++){
+			if(!TMath::Finite(logShape[i])) finite=kFALSE;
+			if(shape[i]<1e-300){ underflow++; continue; }
+			diff=TMath::Max(diff,TMath::Abs(logShape[i]-TMath::Log(shape[i]))/TMath::Max(1.,TMath::Abs(logShape[i])));
+		}
+		std::cout<<Form("%-12s max diff %.2e, %d points where the shape underflows",pdfs[k].GetName(),diff,underflow)<<std::endl;
+		maxDiff=TMath::Max(maxDiff,diff);
+	}
+	std::cout<<(maxDiff<1e-12 && finite ? "PASS" : "FAIL")<<std::endl;
+}
@@ -0,0 +1,62 @@
+/*
+ * Compare RooTabulatedPdf with the pdf it tabulates: values over the jet mass range, integrals over
+ * sb_lo / signal_region / sb_hi, and the mean and width of generated toys; prints the generation times.
+ *   root -l -b -q test_Tabulated.cxx
+ */
+
+{
+	using namespace RooFit;
+	gROOT->ProcessLine(".L VectorMath.cxx+");
+	gROOT->ProcessLine(".L HWWLVJRooPdfs.cxx+");
+	gROOT->ProcessLine(".L TestPdfZoo.cxx+");
+	RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+
+	RooRealVar x("x","x",30,200);
+	x.setRange("sb_lo",30,65);
+	x.setRange("signal_region",65,105);
+	x.setRange("sb_hi",105,200);
+
+	TestPdfZoo zoo(x);
+	RooAddPdf model("model","model",RooArgList(zoo.gaus,zoo.erfExp),RooArgList(zoo.frac));
+
+	Double_t tolerance=1e-4;
+	RooTabulatedPdf tab("model_tab","model_tab",x,model,tolerance);
+
+	Double_t maxDiff=0, maxVal=0;
+	for(Double_t m=30; m<=200; m+=0.1){
+		x.setVal(m);
+		maxDiff=TMath::Max(maxDiff,TMath::Abs(tab.getVal(x)-model.getVal(x)));
+		maxVal=TMath::Max(maxVal,model.getVal(x));
+	}
+	std::cout<<"nodes "<<tab.tableSize()<<", max |tab-pdf|/max(pdf) "<<maxDiff/maxVal<<std::endl;
+
+	const char* ranges[3]={"sb_lo","signal_region","sb_hi"};
+	Double_t maxIntDiff=0;
+	for(Int_t r=0; r<3; r++){
+		RooAbsReal* intTab=tab.createIntegral(x,NormSet(x),Range(ranges[r]));
+		RooAbsReal* intPdf=model.createIntegral(x,NormSet(x),Range(ranges[r]));
+		Double_t diff=TMath::Abs(intTab->getVal()/intPdf->getVal()-1);
+		std::cout<<Form("%-14s tabulated %-12.8g exact %-12.8g rel diff %.2e",ranges[r],intTab->getVal(),intPdf->getVal(),diff)<<std::endl;
+		maxIntDiff=TMath::Max(maxIntDiff,diff);
+		delete intTab;
+		delete intPdf;
+	}
+
+	TStopwatch timeTab, timePdf;
+	timeTab.Start();
+	RooDataSet* toyTab=tab.generate(x,200000);
+	timeTab.Stop();
+	timePdf.Start();
+	RooDataSet* toyPdf=model.generate(x,200000);
+	timePdf.Stop();
+	RooRealVar* meanTab=toyTab->meanVar(x);
+	RooRealVar* meanPdf=toyPdf->meanVar(x);
+	RooRealVar* rmsTab=toyTab->rmsVar(x);
+	RooRealVar* rmsPdf=toyPdf->rmsVar(x);
+	Double_t pullMean=(meanTab->getVal()-meanPdf->getVal())/(rmsPdf->getVal()*TMath::Sqrt(2./200000));
+	std::cout<<"toys: mean "<<meanTab->getVal()<<" / "<<meanPdf->getVal()<<" (pull "<<pullMean<<"), rms "
+	         <<rmsTab->getVal()<<" / "<<rmsPdf->getVal()<<", generation "<<timeTab.RealTime()<<" s / "<<timePdf.RealTime()<<" s"<<std::endl;
+
+	Bool_t pass= maxDiff/maxVal<10*tolerance && maxIntDiff<10*tolerance && TMath::Abs(pullMean)<5;
+	std::cout<<(pass ? "PASS" : "FAIL")<<std::endl;
+}
@@ -0,0 +1,71 @@
+/*
+ * Compare the VectorMath kernels and the batch shapes of HWWLVJRooPdfs with the TMath scalar code,
+ * for the AVX2 backend (if the CPU has it) and the scalar one.
+ *   root -l -b -q test_VectorMath.cxx
+ */
+
+{
+	gROOT->ProcessLine(".L VectorMath.cxx+");
+	gROOT->ProcessLine(".L HWWLVJRooPdfs.cxx+");
+
+	const Int_t n=10001;
+	std::vector<Double_t> in(n), out(n);
+	Bool_t pass=kTRUE;
+
+	for(Int_t backend=1; backend>=0; backend--){
+		SetVectorMathBackend(backend);
+		std::cout<<"===== backend "<<GetVectorMathBackend()<<std::endl;
+
+		//// kernels: relative error for exp, log, erf(x>0.5); absolute for atan, erf
+		Double_t maxExp=0, maxLog=0, maxErf=0, maxAtan=0;
+		for(Int_t i=0; i<n; i++) in[i]=-700+1400.*i/(n-1);
+		VecExp(&in[0],&out[0],n);
+		for(Int_t i=0; i<n; i++) maxExp=TMath::Max(maxExp,TMath::Abs(out[i]/TMath::Exp(in[i])-1));
+		for(Int_t i=0; i<n; i++) in[i]=1e-3+1e4*i/(n-1);
+		VecLog(&in[0],&out[0],n);
+		for(Int_t i=0; i<n; i++) maxLog=TMath::Max(maxLog,TMath::Abs(out[i]-TMath::Log(in[i]))/TMath::Max(1.,TMath::Abs(TMath::Log(in[i]))));
+		for(Int_t i=0; i<n; i++) in[i]=-8+16.*i/(n-1);
+		VecErf(&in[0],&out[0],n);
+		for(Int_t i=0; i<n; i++) maxErf=TMath::Max(maxErf,TMath::Abs(out[i]-TMath::Erf(in[i])));
+		for(Int_t i=0; i<n; i++) in[i]=-100+200.*i/(n-1);
+		VecAtan(&in[0],&out[0],n);
+		for(Int_t i=0; i<n; i++) maxAtan=TMath::Max(maxAtan,TMath::Abs(out[i]-TMath::ATan(in[i])));
+
+		std::cout<<"VecExp  max rel err "<<maxExp<<std::endl;
+		std::cout<<"VecLog  max err     "<<maxLog<<std::endl;
+		std::cout<<"VecErf  max abs err "<<maxErf<<std::endl;
+		std::cout<<"VecAtan max abs err "<<maxAtan<<std::endl;
+		if(maxExp>1e-15 || maxLog>1e-15 || maxErf>1e-15 || maxAtan>1e-15) pass=kFALSE;
+
+		//// shapes over the jet mass range
+		for(Int_t i=0; i<n; i++) in[i]=30+170.*i/(n-1);
+		Double_t maxShape=0;
+		ErfExpBatch(&in[0],&out[0],n,-0.03,80,30);
+		for(Int_t i=0; i<n; i++) maxShape=TMath::Max(maxShape,TMath::Abs(out[i]/ErfExp(in[i],-0.03,80,30)-1));
+		ErfPow2Batch(&in[0],&out[0],n,3,0.5,80,30);
+		for(Int_t i=0; i<n; i++) maxShape=TMath::Max(maxShape,TMath::Abs(out[i]/ErfPow2(in[i],3,0.5,80,30)-1));
+		ErfPowExpBatch(&in[0],&out[0],n,3,0.5,80,30);
+		for(Int_t i=0; i<n; i++) maxShape=TMath::Max(maxShape,TMath::Abs(out[i]/ErfPowExp(in[i],3,0.5,80,30)-1));
+		AtanExpBatch(&in[0],&out[0],n,-0.03,80,30);
+		for(Int_t i=0; i<n; i++) maxShape=TMath::Max(maxShape,TMath::Abs(out[i]/AtanExp(in[i],-0.03,80,30)-1));
+		AtanPow2Batch(&in[0],&out[0],n,3,0.5,80,30);
+		for(Int_t i=0; i<n; i++) maxShape=TMath::Max(maxShape,TMath::Abs(out[i]/AtanPow2(in[i],3,0.5,80,30)-1));
+		ExpTailBatch(&in[0],&out[0],n,30,0.1);
+		for(Int_t i=0; i<n; i++) maxShape=TMath::Max(maxShape,TMath::Abs(out[i]/ExpTail(in[i],30,0.1)-1));
+		std::cout<<"shapes  max rel err "<<maxShape<<std::endl;
+		if(maxShape>1e-13) pass=kFALSE;
+
+		//// timing of the ErfExp batch against the scalar loop
+		TStopwatch timer;
+		timer.Start();
+		for(Int_t r=0; r<200; r++) ErfExpBatch(&in[0],&out[0],n,-0.03,80,30);
+		timer.Stop();
+		Double_t tBatch=timer.RealTime();
+		timer.Start();
+		for(Int_t r=0; r<200; r++) for(Int_t i=0; i<n; i++) out[i]=ErfExp(in[i],-0.03,80,30);
+		timer.Stop();
+		std::cout<<"ErfExp batch "<<tBatch<<" s, scalar "<<timer.RealTime()<<" s"<<std::endl;
+	}
+
+	std::cout<<(pass ? "PASS" : "FAIL")<<std::endl;
+}
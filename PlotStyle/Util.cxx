@@ -1,4 +1,596 @@
 #include "Util.h"
+#include "../PDFs/RooBatchNLL.h"
+
+#include <pthread.h>
+
+////// Toy band envelope
+
+ToyBandEnvelope::ToyBandEnvelope(const int & npoints_, const int & ntoys_, const double & plow, const double & phigh):
+  npoints(npoints_), ntoys(ntoys_), exact(ntoys_ <= exactToys || npoints_ == 1), count(npoints_,0), qlow(npoints_,0.), qhigh(npoints_,0.){
+  p[0] = plow; p[1] = phigh;
+}
+
+/// P-square update of the 5 markers (heights q, positions n) of quantile p with value, count values already seen
+void ToyBandEnvelope::addMarker(double* q, double* n, const double & p, const int & count, const double & value){
+
+  if(count < 5){
+    q[count] = value;
+    if(count == 4){
+      std::sort(q,q+5);
+      for(int m = 0; m < 5; m++) n[m] = m+1;
+    }
+    return;
+  }
+
+  int cell;
+  if(value < q[0]){ q[0] = value; cell = 0; }
+  else if(value >= q[4]){ q[4] = value; cell = 3; }
+  else{
+    cell = 0;
+    while(cell < 3 && value >= q[cell+1]) cell++;
+  }
+  for(int m = cell+1; m < 5; m++) n[m] += 1.;
+
+  const double dn[5] = {0.,p/2.,p,(1.+p)/2.,1.};
+  for(int m = 1; m < 4; m++){
+    double d = 1.+count*dn[m]-n[m];
+    if((d >= 1. && n[m+1]-n[m] > 1.) || (d <= -1. && n[m-1]-n[m] < -1.)){
+      double ds = d > 0 ? 1. : -1.;
+      double qp = q[m]+ds/(n[m+1]-n[m-1])*((n[m]-n[m-1]+ds)*(q[m+1]-q[m])/(n[m+1]-n[m])+(n[m+1]-n[m]-ds)*(q[m]-q[m-1])/(n[m]-n[m-1]));
+      if(q[m-1] < qp && qp < q[m+1]) q[m] = qp;
+      else{
+        int k = m+(int)ds;
+        q[m] = q[m]+ds*(q[k]-q[m])/(n[k]-n[m]);
+      }
+      n[m] += ds;
+    }
+  }
+}
+
+/// middle marker, or the exact quantile if less than 5 values were seen
+double ToyBandEnvelope::marker(double* q, const double & p, const int & count){
+  if(count >= 5) return q[2];
+  if(count == 0) return 0.;
+  std::vector<double> val(q,q+count);
+  std::sort(val.begin(),val.end());
+  return val[Int_t(p*count)];
+}
+
+void ToyBandEnvelope::allocate(){
+  if(!values.empty()) return;
+  if(exact) values.assign(npoints*ntoys,0.);
+  else{
+    values.assign(npoints*2*5,0.);
+    positions.assign(npoints*2*5,0.);
+  }
+}
+
+void ToyBandEnvelope::fill(const int & i, const double & value){
+  /// allocated at the first toy, so that a linear band does not pay for the toys
+  if(values.empty()) allocate();
+  if(exact){
+    if(count[i] < ntoys) values[i*ntoys+count[i]] = value;
+  }
+  else{
+    for(int k = 0; k < 2; k++) addMarker(&values[(i*2+k)*5],&positions[(i*2+k)*5],p[k],count[i],value);
+  }
+  count[i]++;
+}
+
+void ToyBandEnvelope::finish(){
+
+  /// exact quantiles on one reused buffer, same entries as sorting all the toys
+  std::vector<double> val;
+  for(int i = 0; i < npoints; i++){
+    if(count[i] == 0) continue;
+    if(exact){
+      int n = TMath::Min(count[i],ntoys);
+      val.assign(values.begin()+i*ntoys,values.begin()+i*ntoys+n);
+      std::nth_element(val.begin(),val.begin()+Int_t(p[0]*n),val.end());
+      qlow[i] = val[Int_t(p[0]*n)];
+      std::nth_element(val.begin(),val.begin()+Int_t(p[1]*n),val.end());
+      qhigh[i] = val[Int_t(p[1]*n)];
+    }
+    else{
+      qlow[i]  = marker(&values[(i*2+0)*5],p[0],count[i]);
+      qhigh[i] = marker(&values[(i*2+1)*5],p[1],count[i]);
+    }
+  }
+  std::vector<double>().swap(values);
+  std::vector<double>().swap(positions);
+}
+
+////// Range integrals
+
+RangeFraction::RangeFraction(RooAbsPdf* pdf_, RooRealVar* x_, const std::string & range): pdf(pdf_), x(x_), integral(0), nset(*x_){
+
+  const char* rangeName = range.empty() ? 0 : range.c_str();
+  double xlow  = rangeName ? x->getMin(rangeName) : x->getMin();
+  double xhigh = rangeName ? x->getMax(rangeName) : x->getMax();
+
+  if(binIntegralsClosed(*pdf,*x)){
+    edges.push_back(x->getMin());
+    edges.push_back(TMath::Max(xlow,x->getMin()));
+    edges.push_back(TMath::Min(xhigh,x->getMax()));
+    edges.push_back(x->getMax());
+    if(edges[2] < edges[1]) edges[2] = edges[1];
+    bins.resize(3);
+    return;
+  }
+
+  RooArgSet allVars(*x), analVars;
+  if(pdf->getAnalyticalIntegralWN(allVars,analVars,&nset,rangeName) != 0 && analVars.find(x->GetName())){
+    integral = pdf->createIntegral(*x,*x,rangeName);
+    return;
+  }
+
+  /// 5 point Gauss-Legendre rule in each of the cells of the range
+  static const double glNodes[5]   = {-0.9061798459386640,-0.5384693101056831,0.,0.5384693101056831,0.9061798459386640};
+  static const double glWeights[5] = {0.2369268850561891,0.4786286704993665,0.5688888888888889,0.4786286704993665,0.2369268850561891};
+  double width = (xhigh-xlow)/cells;
+  for(int c = 0; c < cells; c++){
+    for(int m = 0; m < 5; m++){
+      nodes.push_back(xlow+width*(c+0.5+0.5*glNodes[m]));
+      weights.push_back(0.5*width*glWeights[m]);
+    }
+  }
+}
+
+RangeFraction::~RangeFraction(){ delete integral; }
+
+double RangeFraction::getVal(){
+  if(!edges.empty()){
+    binIntegralsPdf(*pdf,*x,&edges[0],&bins[0],3,&nset);
+    return bins[1];
+  }
+  if(integral) return integral->getVal();
+  double value = x->getVal(), sum = 0.;
+  for(unsigned int i = 0; i < nodes.size(); i++){
+    x->setVal(nodes[i]);
+    sum += weights[i]*pdf->getVal(&nset);
+  }
+  x->setVal(value);
+  return sum;
+}
+
+////// Toy band engine
+
+#if !defined(__CINT__) && !defined(__MAKECINT__)
+
+/// best values of the floating parameters of rfres and the lower triangle of its covariance (diagonal if not positive definite)
+static void fit_covariance_lower(RooFitResult* rfres, std::vector<double> & best, TMatrixD & lower, const char* caller){
+  const RooArgList & floatPars = rfres->floatParsFinal();
+  int npar = floatPars.getSize();
+  best.resize(npar);
+  for(int k = 0; k < npar; k++) best[k] = ((RooRealVar&) floatPars[k]).getVal();
+  lower.ResizeTo(npar,npar);
+  lower.Zero();
+  TDecompChol chol(rfres->covarianceMatrix());
+  if(chol.Decompose()) lower.Transpose(chol.GetU());
+  else{
+    std::cout<<" "<<caller<<": covariance is not positive definite, using the diagonal only"<<std::endl;
+    for(int k = 0; k < npar; k++) lower(k,k) = ((RooRealVar&) floatPars[k]).getError();
+  }
+}
+
+void fit_parameter_toys(RooFitResult* rfres, const int & number_toys, std::vector<double> & toys){
+  std::vector<double> best;
+  TMatrixD lower;
+  fit_covariance_lower(rfres,best,lower,"fit_parameter_toys");
+  int npar = best.size();
+  TRandom3 rand(0);
+  std::vector<double> z(npar);
+  toys.assign(number_toys*npar,0.);
+  for(int j = 0; j < number_toys; j++){
+    for(int k = 0; k < npar; k++) z[k] = rand.Gaus(0.,1.);
+    for(int k = 0; k < npar; k++){
+      double value = best[k];
+      for(int l = 0; l <= k; l++) value += lower(k,l)*z[l];
+      toys[j*npar+k] = value;
+    }
+  }
+}
+
+static int toyBandThreads = 1 ;
+
+void SetToyBandThreads(const int & nthreads){ toyBandThreads = TMath::Max(nthreads,1); }
+
+static unsigned int toyBandSeed = 0 ;
+
+void SetToyBandSeed(const unsigned int & seed){ toyBandSeed = seed; }
+
+/// toys prepared on the calling thread before the threads evaluate them
+static const int toyBandBlockSize = 64 ;
+
+/// one toy: the leaves of the pdf (RooBatchNLL's BatchPdfTerm) and its scale, read from RooFit on the calling thread
+struct ToyBandToy {
+  std::vector<BatchPdfTerm> terms ;
+  std::vector<double> values ;           // grid values of the leaves without array path, one grid per leaf
+  double scale ;
+};
+
+/// grid points [first,last) of the toys of a block, filled into the envelope in toy order
+struct ToyBandSlice {
+  const std::vector<ToyBandToy>* toys ;
+  const std::vector<double>* grid ;
+  ToyBandEnvelope* envelope ;
+  double width_x ;
+  int ntoys, first, last ;
+};
+
+/// array code on the toys only: no RooFit object is read here
+static void* toy_band_worker(void* arg){
+  ToyBandSlice & slice = *(ToyBandSlice*) arg;
+  int n = slice.last-slice.first;
+  if(n <= 0) return 0;
+  std::vector<double> out(n), shape(n);
+  const double* xs = &(*slice.grid)[slice.first];
+  for(int j = 0; j < slice.ntoys; j++){
+    const ToyBandToy & toy = (*slice.toys)[j];
+    evaluatePdfTerms(toy.terms,xs,&out[0],n,slice.first,&shape[0]);
+    for(int i = 0; i < n; i++) slice.envelope->fill(slice.first+i,toy.scale*out[i]*slice.width_x);
+  }
+  return 0;
+}
+
+/// parameters of one toy set on the pdf, then its leaves and scale taken; leaves without array path evaluated on the grid here
+static void toy_band_prepare(RooAbsPdf* pdf, RooRealVar* x, const std::vector<RooRealVar*> & pars, const std::vector<double> & best, const TMatrixD & lower, TRandom3 & rand, const std::vector<double> & grid, const double & number_events_mean, const double & number_events_sigma, std::vector<double> & z, ToyBandToy & toy){
+  int npar = pars.size();
+  for(int k = 0; k < npar; k++) z[k] = rand.Gaus(0.,1.);
+  for(int k = 0; k < npar; k++){
+    if(!pars[k]) continue;
+    double value = best[k];
+    for(int l = 0; l <= k; l++) value += lower(k,l)*z[l];
+    pars[k]->setVal(value); /// clipped to the range, as randomizePars does
+  }
+  RooArgSet nset(*x);
+  toy.scale = number_events_mean < 0 ? pdf->expectedEvents(&nset) : rand.Gaus(number_events_mean,number_events_sigma);
+  toy.terms.clear();
+  flattenPdfTerms(*pdf,*x,1.,toy.terms,&nset);
+
+  int ngrid = grid.size(), nother = 0;
+  for(unsigned int t = 0; t < toy.terms.size(); t++) if(!toy.terms[t].batchPdf && !toy.terms[t].gaussian) nother++;
+  toy.values.resize(nother*ngrid);
+  int o = 0;
+  for(unsigned int t = 0; t < toy.terms.size(); t++){
+    BatchPdfTerm & term = toy.terms[t];
+    if(term.batchPdf || term.gaussian) continue;
+    evaluatePdfBatch(*term.pdf,*x,&grid[0],&toy.values[o*ngrid],ngrid,&nset);
+    term.values = &toy.values[o*ngrid];
+    o++;
+  }
+}
+
+/// one toy (or linear) campaign for the fit result on the grid. Each block of toys is drawn and read from the pdf on the
+/// calling thread (RooFit is not thread safe); the threads then evaluate the whole grid of every toy of the block from
+/// these copies, each on its own slice of grid points, so the envelope gets the same values in the same order for any
+/// number of threads.
+static void toy_band_campaign(RooAbsPdf* rpdf, RooRealVar* rrv_x, RooFitResult* rfres, RooRealVar* rrv_number_events, const std::vector<double> & grid, const double & width_x, const int & number_toys, ToyBandEnvelope & envelope){
+
+  double number_events_mean  = rrv_number_events ? rrv_number_events->getVal()   : -1.;
+  double number_events_sigma = rrv_number_events ? rrv_number_events->getError() : 0.;
+  if(linear_band_envelope(rpdf,rrv_x,rfres->floatParsFinal(),rfres->covarianceMatrix(),number_events_mean,number_events_sigma,grid,width_x,envelope)) return;
+
+  const RooArgList & floatPars = rfres->floatParsFinal();
+  int npar = floatPars.getSize();
+  int ngrid = grid.size();
+
+  /// one Cholesky factorisation of the covariance for all the toys
+  std::vector<double> best;
+  TMatrixD lower;
+  fit_covariance_lower(rfres,best,lower,"toy_band_envelope");
+
+  /// the parameters of the pdf itself, put back at the end
+  RooArgSet* pdfPars = rpdf->getParameters(RooArgSet(*rrv_x));
+  std::vector<RooRealVar*> pars(npar,(RooRealVar*)0);
+  std::vector<double> saved(npar,0.);
+  for(int k = 0; k < npar; k++){
+    pars[k] = dynamic_cast<RooRealVar*>(pdfPars->find(floatPars[k].GetName()));
+    if(pars[k]) saved[k] = pars[k]->getVal();
+  }
+  double x_saved = rrv_x->getVal();
+
+  int nthreads = TMath::Max(1,TMath::Min(toyBandThreads,ngrid));
+  std::vector<ToyBandToy> toys(toyBandBlockSize);
+  std::vector<ToyBandSlice> slices(nthreads);
+  for(int t = 0; t < nthreads; t++){
+    ToyBandSlice & slice = slices[t];
+    slice.toys = &toys; slice.grid = &grid; slice.envelope = &envelope; slice.width_x = width_x;
+    slice.first = (t*ngrid)/nthreads; slice.last = ((t+1)*ngrid)/nthreads;
+  }
+
+  TRandom3 rand(toyBandSeed);
+  std::vector<double> z(npar);
+  std::vector<pthread_t> threads(nthreads);
+  std::vector<int> started(nthreads,0);
+  envelope.allocate();
+  for(int first = 0; first < number_toys; first += toyBandBlockSize){
+    int ntoys = TMath::Min(toyBandBlockSize,number_toys-first);
+    for(int j = 0; j < ntoys; j++) toy_band_prepare(rpdf,rrv_x,pars,best,lower,rand,grid,number_events_mean,number_events_sigma,z,toys[j]);
+    for(int t = 0; t < nthreads; t++) slices[t].ntoys = ntoys;
+    for(int t = 1; t < nthreads; t++) started[t] = (pthread_create(&threads[t],0,toy_band_worker,&slices[t]) == 0);
+    toy_band_worker(&slices[0]);
+    for(int t = 1; t < nthreads; t++){
+      if(started[t]) pthread_join(threads[t],0);
+      else toy_band_worker(&slices[t]);
+    }
+  }
+  envelope.finish();
+
+  for(int k = 0; k < npar; k++) if(pars[k]) pars[k]->setVal(saved[k]);
+  rrv_x->setVal(x_saved);
+  delete pdfPars;
+}
+
+////// Linear error propagation
+
+static int errorBandMode = 0 ;
+static double errorBandMaxNonLinearity = 0.2 ;
+
+void SetErrorBandMode(const int & mode, const double & maxNonLinearity){
+  errorBandMode = mode;
+  errorBandMaxNonLinearity = maxNonLinearity;
+}
+
+/// quantity whose error is propagated: a vector of values at the current parameters
+struct LinearValues {
+  virtual ~LinearValues(){}
+  virtual void values(std::vector<double> & out) = 0;
+  /// out[i*npar+k] = d values[i] / d pars[k] (0 for pars[k] == 0) at the current parameters; false without a gradient path
+  virtual bool jacobian(const std::vector<RooRealVar*> & /*pars*/, std::vector<double> & /*out*/){ return false; }
+};
+
+/// pdf on the grid, times width_x and the expected events (scale < 0) or scale
+struct LinearGridValues : public LinearValues {
+  RooAbsPdf* pdf ;
+  RooRealVar* x ;
+  const std::vector<double>* grid ;
+  double width_x, scale ;
+  bool normalised ;
+  void values(std::vector<double> & out){
+    RooArgSet nset(*x);
+    double norm = scale < 0 ? pdf->expectedEvents(&nset) : scale;
+    out.resize(grid->size());
+    for(unsigned int i = 0; i < grid->size(); i++){
+      x->setVal((*grid)[i]);
+      out[i] = norm*(normalised ? pdf->getVal(&nset) : pdf->getVal())*width_x;
+    }
+  }
+  /// gradientPdfBatch on the grid (analytic for the RooBatchPdf shapes with gradients, gaussians and sums of them), the
+  /// expected events by a central difference
+  bool jacobian(const std::vector<RooRealVar*> & pars, std::vector<double> & out){
+    if(!normalised || grid->empty()) return false;
+    RooArgSet nset(*x);
+    int n = grid->size(), npar = pars.size();
+    RooArgList list;
+    std::vector<int> index;
+    for(int k = 0; k < npar; k++) if(pars[k]){ list.add(*pars[k]); index.push_back(k); }
+    int nlist = list.getSize();
+    std::vector<double> prob(n), grad(TMath::Max(nlist,1)*n);
+    std::vector<double*> gradPtr(TMath::Max(nlist,1));
+    for(int l = 0; l < nlist; l++) gradPtr[l] = &grad[l*n];
+    double x_saved = x->getVal();
+    gradientPdfBatch(*pdf,*x,&(*grid)[0],&prob[0],&gradPtr[0],n,&nset,list);
+    x->setVal(x_saved);
+
+    double norm = scale < 0 ? pdf->expectedEvents(&nset) : scale;
+    out.assign(n*npar,0.);
+    for(int l = 0; l < nlist; l++){
+      int k = index[l];
+      double dnorm = 0.;
+      if(scale < 0){
+        RooRealVar* par = pars[k];
+        double value = par->getVal(), step = 1e-6*(1.+TMath::Abs(value));
+        double up = par->hasMax() ? TMath::Min(value+step,par->getMax()) : value+step;
+        double down = par->hasMin() ? TMath::Max(value-step,par->getMin()) : value-step;
+        if(up > down){
+          par->setVal(up);
+          double nup = pdf->expectedEvents(&nset);
+          par->setVal(down);
+          dnorm = (nup-pdf->expectedEvents(&nset))/(up-down);
+          par->setVal(value);
+        }
+      }
+      for(int i = 0; i < n; i++) out[i*npar+k] = (norm*gradPtr[l][i]+dnorm*prob[i])*width_x;
+    }
+    return true;
+  }
+};
+
+/// fraction of the pdf in a range, times the expected events if extended
+struct LinearRangeValues : public LinearValues {
+  RooAbsPdf* pdf ;
+  RooRealVar* x ;
+  RangeFraction* fraction ;
+  bool extended ;
+  void values(std::vector<double> & out){
+    out.assign(1,fraction->getVal());
+    if(extended) out[0] *= pdf->expectedEvents(*x);
+  }
+};
+
+/// value and variance J C J^T of the quantity. J is the analytic jacobian of the quantity if it has one, with one more
+/// evaluation at +1 sigma of each parameter for the non-linearity check; otherwise central differences at +-1 sigma.
+/// False in toy mode, or if the one sided slopes of some parameter differ by more than errorBandMaxNonLinearity.
+static bool linear_propagation(RooAbsPdf* pdf, RooRealVar* x, const RooArgList & pars, const TMatrixDSym & cov, LinearValues & quantity, std::vector<double> & value, std::vector<double> & variance){
+
+  if(errorBandMode == 0) return false;
+
+  RooArgSet* pdfPars = pdf->getParameters(RooArgSet(*x));
+  int npar = pars.getSize();
+  std::vector<RooRealVar*> vars(npar,(RooRealVar*)0);
+  for(int k = 0; k < npar; k++) vars[k] = dynamic_cast<RooRealVar*>(pdfPars->find(pars[k].GetName()));
+  quantity.values(value);
+  int n = value.size();
+  std::vector<double> jacobian, up, down(n), slopes(n);
+  bool analytic = quantity.jacobian(vars,jacobian);
+  if(!analytic) jacobian.assign(n*npar,0.);
+
+  for(int k = 0; k < npar; k++){
+    RooRealVar* par = vars[k];
+    if(!par || cov(k,k) <= 0) continue;
+    if(analytic && errorBandMaxNonLinearity <= 0) continue;
+    double best = par->getVal(), sigma = TMath::Sqrt(cov(k,k));
+    par->setVal(best+sigma);
+    double hup = par->getVal()-best, hdown = 0.;
+    quantity.values(up);
+    if(!analytic){
+      par->setVal(best-sigma);
+      hdown = best-par->getVal();
+      quantity.values(down);
+    }
+    par->setVal(best);
+
+    if(analytic){
+      if(hup <= 0) continue;
+      /// down side of the quadratic through the value and up with the analytic slope: its slope is 2 J - up slope
+      hdown = hup;
+      for(int i = 0; i < n; i++) down[i] = value[i]-hdown*(2.*jacobian[i*npar+k]-(up[i]-value[i])/hup);
+    }
+    else{
+      if(hup+hdown <= 0) continue;
+      for(int i = 0; i < n; i++) jacobian[i*npar+k] = (up[i]-down[i])/(hup+hdown);
+    }
+    if(errorBandMaxNonLinearity <= 0 || hup <= 0 || hdown <= 0) continue;
+
+    /// difference of the one sided slopes relative to their mean (slopes[i] is the sum of their sizes), where the slope
+    /// is not negligible
+    double maxSlope = 0.;
+    for(int i = 0; i < n; i++){
+      slopes[i] = TMath::Abs(up[i]-value[i])/hup+TMath::Abs(value[i]-down[i])/hdown;
+      maxSlope = TMath::Max(maxSlope,slopes[i]);
+    }
+    for(int i = 0; i < n; i++){
+      if(slopes[i] <= 1e-2*maxSlope) continue;
+      double nonLinearity = TMath::Abs((up[i]-value[i])/hup-(value[i]-down[i])/hdown)/(0.5*slopes[i]);
+      if(nonLinearity > errorBandMaxNonLinearity){
+        std::cout<<" linear_propagation: "<<par->GetName()<<" non-linear within 1 sigma ("<<nonLinearity<<"), using the toys"<<std::endl;
+        delete pdfPars;
+        return false;
+      }
+    }
+  }
+  delete pdfPars;
+
+  variance.assign(n,0.);
+  for(int i = 0; i < n; i++){
+    const double* J = &jacobian[i*npar];
+    for(int k = 0; k < npar; k++){
+      if(J[k] == 0) continue;
+      for(int l = 0; l < npar; l++) variance[i] += J[k]*cov(k,l)*J[l];
+    }
+  }
+  return true;
+}
+
+bool linear_band_envelope(RooAbsPdf* rpdf, RooRealVar* rrv_x, const RooArgList & pars, const TMatrixDSym & cov, const double & number_events, const double & number_events_sigma, const std::vector<double> & grid, const double & width_x, ToyBandEnvelope & envelope, const bool & normalised){
+
+  LinearGridValues quantity;
+  quantity.pdf = rpdf; quantity.x = rrv_x; quantity.grid = &grid;
+  quantity.width_x = width_x; quantity.scale = number_events; quantity.normalised = normalised;
+
+  std::vector<double> value, variance;
+  if(!linear_propagation(rpdf,rrv_x,pars,cov,quantity,value,variance)) return false;
+
+  for(unsigned int i = 0; i < grid.size(); i++){
+    if(number_events > 0) variance[i] += TMath::Power(number_events_sigma*value[i]/number_events,2);
+    double error = TMath::Sqrt(variance[i]);
+    envelope.setBand(i,value[i]-error,value[i]+error);
+  }
+  return true;
+}
+
+bool linear_range_error(RooAbsPdf* rpdf, RooRealVar* rrv_x, const std::string & range, const RooArgList & pars, const TMatrixDSym & cov, const bool & extended, double & value, double & error){
+
+  if(errorBandMode == 0) return false;
+  RangeFraction fraction(rpdf,rrv_x,range);
+  LinearRangeValues quantity;
+  quantity.pdf = rpdf; quantity.x = rrv_x; quantity.fraction = &fraction; quantity.extended = extended;
+
+  std::vector<double> values, variance;
+  if(!linear_propagation(rpdf,rrv_x,pars,cov,quantity,values,variance)) return false;
+  value = values[0];
+  error = TMath::Sqrt(variance[0]);
+  return true;
+}
+
+////// Cache of the bands
+
+/// band of one fit at unit bin width: the main, pull and ratio panels of the same fit share it
+struct ToyBandCacheEntry {
+  const RooAbsPdf* pdf ;
+  const RooFitResult* rfres ;
+  const RooRealVar* number_events ;
+  std::vector<double> fingerprint ;   // fit result and normalisation values, in case a new object reuses the address
+  int number_toys, mode ;
+  std::vector<double> grid, low, high ;
+};
+
+static const unsigned int toyBandCacheSize = 8 ;
+static std::vector<ToyBandCacheEntry> toyBandCache ;
+
+void ClearToyBandCache(){ toyBandCache.clear(); }
+
+static std::vector<double> toy_band_fingerprint(RooFitResult* rfres, RooRealVar* rrv_number_events){
+  std::vector<double> fingerprint;
+  fingerprint.push_back(rfres->minNll());
+  fingerprint.push_back(rfres->edm());
+  const RooArgList & floatPars = rfres->floatParsFinal();
+  for(int k = 0; k < floatPars.getSize(); k++) fingerprint.push_back(((RooRealVar&) floatPars[k]).getVal());
+  if(rrv_number_events){
+    fingerprint.push_back(rrv_number_events->getVal());
+    fingerprint.push_back(rrv_number_events->getError());
+  }
+  fingerprint.push_back(errorBandMaxNonLinearity);
+  return fingerprint;
+}
+
+/// linear interpolation of a cached band on grid, if the cached grid covers it and is at least as fine
+static bool toy_band_interpolate(const ToyBandCacheEntry & entry, const std::vector<double> & grid, const double & width_x, ToyBandEnvelope & envelope){
+  if(entry.grid.size() < 2 || entry.grid.size() < grid.size()) return false;
+  double tolerance = 1e-9*(entry.grid.back()-entry.grid.front());
+  if(grid.front() < entry.grid.front()-tolerance || grid.back() > entry.grid.back()+tolerance) return false;
+  for(unsigned int i = 0; i < grid.size(); i++){
+    unsigned int k = std::upper_bound(entry.grid.begin(),entry.grid.end(),grid[i])-entry.grid.begin();
+    k = TMath::Max(1u,TMath::Min(k,(unsigned int) entry.grid.size()-1));
+    double f = (grid[i]-entry.grid[k-1])/(entry.grid[k]-entry.grid[k-1]);
+    f = TMath::Max(0.,TMath::Min(f,1.));
+    envelope.setBand(i,width_x*((1-f)*entry.low[k-1]+f*entry.low[k]),width_x*((1-f)*entry.high[k-1]+f*entry.high[k]));
+  }
+  return true;
+}
+
+void toy_band_envelope(RooAbsPdf* rpdf, RooRealVar* rrv_x, RooFitResult* rfres, RooRealVar* rrv_number_events, const std::vector<double> & grid, const double & width_x, const int & number_toys, ToyBandEnvelope & envelope){
+
+  std::vector<double> fingerprint = toy_band_fingerprint(rfres,rrv_number_events);
+  for(unsigned int e = 0; e < toyBandCache.size(); e++){
+    const ToyBandCacheEntry & entry = toyBandCache[e];
+    if(entry.pdf != rpdf || entry.rfres != rfres || entry.number_events != rrv_number_events) continue;
+    if(entry.number_toys != number_toys || entry.mode != errorBandMode || entry.fingerprint != fingerprint) continue;
+    if(toy_band_interpolate(entry,grid,width_x,envelope)){
+      std::cout<<" toy_band_envelope: band of "<<rpdf->GetName()<<" taken from the cache"<<std::endl;
+      return;
+    }
+  }
+
+  /// new campaign at unit bin width, kept for the other panels of the same fit
+  ToyBandEnvelope unit(grid.size(),number_toys);
+  toy_band_campaign(rpdf,rrv_x,rfres,rrv_number_events,grid,1.,number_toys,unit);
+
+  ToyBandCacheEntry entry;
+  entry.pdf = rpdf; entry.rfres = rfres; entry.number_events = rrv_number_events;
+  entry.fingerprint = fingerprint; entry.number_toys = number_toys; entry.mode = errorBandMode;
+  entry.grid = grid;
+  entry.low.resize(grid.size()); entry.high.resize(grid.size());
+  for(unsigned int i = 0; i < grid.size(); i++){
+    entry.low[i] = unit.low(i); entry.high[i] = unit.high(i);
+    envelope.setBand(i,width_x*entry.low[i],width_x*entry.high[i]);
+  }
+  if(toyBandCache.size() >= toyBandCacheSize) toyBandCache.erase(toyBandCache.begin());
+  toyBandCache.push_back(entry);
+}
+
+#endif
 
 /// function used to draw an error band around a RooAbsPdf -> used to draw the band after each fit around the pdf
 void draw_error_band( RooAbsData *rdata,  RooAbsPdf *rpdf,  RooRealVar *rrv_number_events , RooFitResult *rfres, RooPlot *mplot, const int & kcolor, const std::string & opt, const int & number_point, const int & number_errorband){
@@ -39,30 +631,13 @@ void draw_error_band( RooAbsData *rdata,  RooAbsPdf *rpdf,  RooRealVar *rrv_numb
   bkgpred->SetLineWidth(2);
   bkgpred->SetLineColor(kcolor);
 
-  /// Set of parameters
-  RooArgSet* par_pdf  = rpdf->getParameters(RooArgSet(*rrv_x)) ;
-       
-  /// Build a envelope using number_errorband toys
-  TGraph* syst[number_errorband];
-  for(int j=0;j<number_errorband;j++){
-   syst[j] = new TGraph(number_point+1);
-   /// paramters value are randomized using rfres and this can be done also if they are not decorrelate
-   RooArgList par_tmp = rfres->randomizePars();
-   *par_pdf = par_tmp;
-   Double_t number_events_tmp = rand.Gaus(number_events_mean,number_events_sigma); /// new poisson random number of events
-   for(int i =0 ; i<=number_point ; i++){
-	rrv_x->setVal(x_min+delta_x*i); 
-	syst[j]->SetPoint(i,x_min+delta_x*i,number_events_tmp*rpdf->getVal(*rrv_x)*width_x);
-   }
-  }
-
-  /// re-take the initial parameters
-  RooArgList par_tmp = rfres->floatParsFinal();
-  *par_pdf = par_tmp;
+  /// Build a envelope using number_errorband toys, parameters drawn from the covariance of rfres
+  std::vector<double> grid(number_point+1);
+  for(int i =0 ; i<= number_point ; i++) grid[i] = x_min+delta_x*i;
+  ToyBandEnvelope envelope(number_point+1,number_errorband);
+  toy_band_envelope(rpdf,rrv_x,rfres,rrv_number_events,grid,width_x,number_errorband,envelope);
 
   // build the uncertainty band at 68% CL 
-  std::vector<double> val;
-  val.resize(number_errorband);
 
   // Try to build and find max and minimum for each point --> not the curve but the value to do a real envelope -> take one sigma interval
   TGraph *ap = new TGraph(number_point+1);
@@ -74,18 +649,12 @@ void draw_error_band( RooAbsData *rdata,  RooAbsPdf *rpdf,  RooRealVar *rrv_numb
   errorband->SetName("errorband");
 
   for(int i =0 ; i<= number_point ; i++){
-   for(int j=0;j<number_errorband;j++){ 
-    val[j]=(syst[j])->GetY()[i];
-   }
-
-   std::sort(val.begin(),val.end());
-
-   ap->SetPoint(i,x_min+delta_x*i,val[Int_t(0.16*number_errorband)]);
-   am->SetPoint(i,x_min+delta_x*i,val[Int_t(0.84*number_errorband)]);
+   ap->SetPoint(i,x_min+delta_x*i,envelope.low(i));
+   am->SetPoint(i,x_min+delta_x*i,envelope.high(i));
 
    errorband->SetPoint(i,x_min+delta_x*i,bkgpred->GetY()[i] );
-   double errYLow = val[Int_t(0.84*number_errorband)]-bkgpred->GetY()[i];
-   double errYHi  = bkgpred->GetY()[i]-val[Int_t(0.16*number_errorband)];
+   double errYLow = envelope.high(i)-bkgpred->GetY()[i];
+   double errYHi  = bkgpred->GetY()[i]-envelope.low(i);
    errorband->SetPointError(i, 0.,0.,errYLow , errYHi);
 
   }
@@ -146,47 +715,20 @@ void draw_error_band_extendPdf( RooAbsData *rdata,  RooAbsPdf* rpdf, RooFitResul
  double x0,y0;
  for(int i =0 ; i <= number_point ; i++){
 	rrv_x->setVal(x_min+delta_x*i); 
-//	rpdf->Print("v");
 	bkgpred->SetPoint(i,x_min+delta_x*i,rpdf->expectedEvents(*rrv_x)*rpdf->getVal(*rrv_x)*width_x);
-//	std::cout<<"PDF value: " << rpdf->expectedEvents(*rrv_x)*rpdf->getVal(*rrv_x)*width_x << std::endl;
 
  }
  bkgpred->SetLineWidth(2);
  bkgpred->SetLineColor(kcolor);
 
 
-// Take the parameters
- RooArgSet* par_pdf  = rpdf->getParameters(RooArgSet(*rrv_x));
- std::cout<<"WHERE AM I" << std::endl;
- par_pdf->Print("v");
- 
-// Make the envelope
- TGraph* syst[number_errorband];
- 
- for(int j=0;j<number_errorband;j++){
-        syst[j] = new TGraph(number_point+1);
-	RooArgList par_tmp = rfres->randomizePars();
-	*par_pdf = par_tmp;
-	par_pdf->Print("v");
-	for(int i =0 ; i <= number_point ; i++){
-		rrv_x->setVal(x_min+delta_x*i); 
-		syst[j]->SetPoint(i,x_min+delta_x*i,rpdf->expectedEvents(*rrv_x)*rpdf->getVal(*rrv_x)*width_x);
-/*		std::cout<<"x_min+delta_x*i: " << x_min+delta_x*i << std::endl;
-		std::cout<<"rpdf->expectedEvents(*rrv_x): " << rpdf->expectedEvents(*rrv_x) << std::endl;
-		std::cout<<"rpdf->getVal(*rrv_x): " << rpdf->getVal(*rrv_x) << std::endl;
-		std::cout<<"width_x: " << width_x << std::endl;
-		std::cout<<"SetValue: " << rpdf->expectedEvents(*rrv_x)*rpdf->getVal(*rrv_x)*width_x << std::endl;*/
-	}
- }
-
- RooArgList par_tmp = rfres->floatParsFinal();
- *par_pdf = par_tmp;
+ /// Make the envelope, parameters drawn from the covariance of rfres
+ std::vector<double> grid(number_point+1);
+ for(int i =0 ; i<= number_point ; i++) grid[i] = x_min+delta_x*i;
+ ToyBandEnvelope envelope(number_point+1,number_errorband);
+ toy_band_envelope(rpdf,rrv_x,rfres,NULL,grid,width_x,number_errorband,envelope);
 
  /// now extract the error curve at 2sigma 
- std::vector<double> val;
- val.resize(number_errorband);
-// std::cout<<"number_errorband: " << number_errorband << std::endl;
-
  TGraph *ap = new TGraph(number_point+1);
  TGraph *am = new TGraph(number_point+1);
  ap->SetName("error_up");
@@ -196,19 +738,10 @@ void draw_error_band_extendPdf( RooAbsData *rdata,  RooAbsPdf* rpdf, RooFitResul
  errorband->SetName("errorband");
 
  for(int i =0 ; i<= number_point ; i++){
-    for(int j=0;j<number_errorband;j++){
-      val[j] = (syst[j])->GetY()[i];
-//      std::cout<<"val[j]: " << val[j] << std::endl;
-    }
-    std::sort(val.begin(),val.end());
-    ap->SetPoint(i,x_min+delta_x*i,val[Int_t(0.84*number_errorband)]);
-    am->SetPoint(i,x_min+delta_x*i,val[Int_t(0.16*number_errorband)]);
-//    std::cout<<"number_errorband: " << number_errorband << std::endl;
-//    std::cout<<"Int_t(0.84*number_errorband): " << Int_t(0.84*number_errorband) << std::endl;
-//    std::cout<<"val[Int_t(0.84*number_errorband)]: " << val[Int_t(0.84*number_errorband)] << endl;
-//    std::cout<<"val[Int_t(0.16*number_errorband)]: " << val[Int_t(0.16*number_errorband)] << endl;
+    ap->SetPoint(i,x_min+delta_x*i,envelope.high(i));
+    am->SetPoint(i,x_min+delta_x*i,envelope.low(i));
     errorband->SetPoint(i,x_min+delta_x*i,bkgpred->GetY()[i]);
-    errorband->SetPointError(i,0.,0.,bkgpred->GetY()[i]-val[Int_t(0.16*number_errorband)],val[Int_t(0.84*number_errorband)]-bkgpred->GetY()[i]);
+    errorband->SetPointError(i,0.,0.,bkgpred->GetY()[i]-envelope.low(i),envelope.high(i)-bkgpred->GetY()[i]);
  }
 
  ap->SetLineWidth(2);
@@ -265,24 +798,27 @@ std::vector<TGraphAsymmErrors*>* draw_error_band_ws(RooAbsData* rdata, RooAbsPdf
     std::cout<<" name "<<paras->at(ipara)->GetName()<<std::endl;
   }
          
-  TGraph* syst[number_errorband];
-  for(int j=0;j<number_errorband;j++){
+  ToyBandEnvelope envelope(number_point+1,number_errorband);
+  TMatrixDSym cov(paras->getSize());
+  for(Int_t ipara=0;ipara<paras->getSize();ipara++) cov(ipara,ipara) = TMath::Power(ws->var(paras->at(ipara)->GetName())->getError(),2);
+  std::vector<double> grid(number_point+1);
+  for(int i =0 ; i<= number_point ; i++) grid[i] = x_min+delta_x*i;
+  bool linear = linear_band_envelope(rpdf,rrv_x,*paras,cov,number_events_mean,number_events_sigma,grid,width_x,envelope);
+  for(int j=0;!linear && j<number_errorband;j++){
 	for(Int_t ipara=0;ipara<paras->getSize();ipara++){
           ws->var(paras->at(ipara)->GetName())->setConstant(0);           
           ws->var(paras->at(ipara)->GetName())->setVal( rand.Gaus(0.,ws->var(paras->at(ipara)->GetName())->getError()) );
 	}
 
 	Double_t number_events_tmp = rand.Gaus(number_events_mean,number_events_sigma);
-	syst[j]=new TGraph(number_point+1);
 	for(int i =0 ; i<=number_point ; i++){
 		rrv_x->setVal(x_min+delta_x*i); 
-		syst[j]->SetPoint(i,x_min+delta_x*i,number_events_tmp*rpdf->getVal(*rrv_x)*width_x);
+		envelope.fill(i,number_events_tmp*rpdf->getVal(*rrv_x)*width_x);
 	}
    }
 
    /// Now look for the envelop at 2sigma CL
-   std::vector<double> val;
-   val.resize(number_errorband);
+   if(!linear) envelope.finish();
 
    TGraphAsymmErrors* errorband = new TGraphAsymmErrors(number_point+1);
    errorband->SetName("errorband");
@@ -307,17 +843,13 @@ std::vector<TGraphAsymmErrors*>* draw_error_band_ws(RooAbsData* rdata, RooAbsPdf
    const double alpha = 1 - 0.6827;
    
    for(int i =0 ; i<= number_point ; i++){
-	for(int j=0;j<number_errorband;j++){
-		val[j]=(syst[j])->GetY()[i];
-	}
-	std::sort(val.begin(),val.end());
-	ap->SetPoint(i,x_min+delta_x*i,val[Int_t(0.84*number_errorband)]);
-	am->SetPoint(i,x_min+delta_x*i,val[Int_t(0.16*number_errorband)]);
+	ap->SetPoint(i,x_min+delta_x*i,envelope.high(i));
+	am->SetPoint(i,x_min+delta_x*i,envelope.low(i));
 	errorband->SetPoint(i,x_min+delta_x*i,bkgpred->GetY()[i] );
-	errorband->SetPointError(i, 0.,0., bkgpred->GetY()[i]-val[Int_t(0.16*number_errorband)],val[Int_t(0.84*number_errorband)]-bkgpred->GetY()[i]);
+	errorband->SetPointError(i, 0.,0., bkgpred->GetY()[i]-envelope.low(i),envelope.high(i)-bkgpred->GetY()[i]);
 
-	double errYLow   = bkgpred->GetY()[i]-val[Int_t(0.16*number_errorband)];
-	double errYHi    = val[Int_t(0.84*number_errorband)]-bkgpred->GetY()[i];                
+	double errYLow   = bkgpred->GetY()[i]-envelope.low(i);
+	double errYHi    = envelope.high(i)-bkgpred->GetY()[i];                
         int N = hdata->GetBinContent(hdata->FindBin(x_min+delta_x*i));
         if (i == number_point) N = hdata->GetBinContent(hdata->FindBin(x_min+delta_x*(i-1)));
 
@@ -402,23 +934,26 @@ void draw_error_band_Decor( std::string pdf_name, std::string xaxis_name,  RooAr
  bkgpred->SetLineColor(kcolor+3);
 
  /// error band -> each parameter can be randomly gaus generated
- TGraph* syst[number_errorband];
- for(int j=0;j<number_errorband;j++){
+ ToyBandEnvelope envelope(number_point+1,number_errorband);
+ TMatrixDSym cov(paras->getSize());
+ for(Int_t ipara=0;ipara<paras->getSize();ipara++) cov(ipara,ipara) = 1.;
+ std::vector<double> grid(number_point+1);
+ for(int i =0 ; i<= number_point ; i++) grid[i] = x_min+delta_x*i;
+ bool linear = linear_band_envelope(ws->pdf(pdf_name.c_str()),rrv_x,*paras,cov,shape_scale,shape_scale_error,grid,width_x,envelope,false);
+ for(int j=0;!linear && j<number_errorband;j++){
 	for(Int_t ipara=0;ipara<paras->getSize();ipara++){
 	  ws->var(paras->at(ipara)->GetName())->setVal(rand.Gaus(0.,1.));
 	}
 
   /// Change the scaling value
   Double_t shape_scale_tmp = rand.Gaus(shape_scale,shape_scale_error);
-  syst[j] = new TGraph(number_point+1);
   for(int i =0 ; i<=number_point ; i++){
 	rrv_x->setVal(x_min+delta_x*i); 
-	syst[j]->SetPoint(i,x_min+delta_x*i,shape_scale_tmp*ws->pdf(pdf_name.c_str())->getVal()*width_x);
+	envelope.fill(i,shape_scale_tmp*ws->pdf(pdf_name.c_str())->getVal()*width_x);
   }
  }
 
- std::vector<double> val;
- val.resize(number_errorband);
+ if(!linear) envelope.finish();
 
  TGraph *ap=new TGraph(number_point+1);
  TGraph *am=new TGraph(number_point+1);
@@ -428,14 +963,10 @@ void draw_error_band_Decor( std::string pdf_name, std::string xaxis_name,  RooAr
  errorband->SetName("errorband");
 
  for(int i =0 ; i<= number_point ; i++){
-	for(int j=0;j<number_errorband;j++){
-		val[j]=(syst[j])->GetY()[i];
-	}
-	std::sort(val.begin(),val.end());
-	ap->SetPoint(i,x_min+delta_x*i,val[Int_t(0.84*number_errorband)]);
-	am->SetPoint(i,x_min+delta_x*i,val[Int_t(0.16*number_errorband)]);
+	ap->SetPoint(i,x_min+delta_x*i,envelope.high(i));
+	am->SetPoint(i,x_min+delta_x*i,envelope.low(i));
 	errorband->SetPoint(i,x_min+delta_x*i,bkgpred->GetY()[i] );
-	errorband->SetPointError(i,0.,0.,bkgpred->GetY()[i]-val[Int_t(0.16*number_errorband)],val[Int_t(0.84*number_errorband)]-bkgpred->GetY()[i]);
+	errorband->SetPointError(i,0.,0.,bkgpred->GetY()[i]-envelope.low(i),envelope.high(i)-bkgpred->GetY()[i]);
  }
 
  ap->SetLineWidth(2);
@@ -486,20 +1017,23 @@ void draw_error_band_shape_Decor( std::string pdf_name, std::string xaxis_name,
  bkgpred->SetLineColor(kcolor+3);
 
  // make the envelope
- TGraph* syst[number_errorband];
- for(int j = 0; j < number_errorband;j++){
+ ToyBandEnvelope envelope(number_point+1,number_errorband);
+ TMatrixDSym cov(paras->getSize());
+ for(Int_t ipara = 0;ipara<paras->getSize();ipara++) cov(ipara,ipara) = sigma*sigma;
+ std::vector<double> grid(number_point+1);
+ for(int i =0 ; i <= number_point ; i++) grid[i] = x_min+delta_x*i;
+ bool linear = linear_band_envelope(ws->pdf(pdf_name.c_str()),rrv_x,*paras,cov,1.,0.,grid,width_x,envelope);
+ for(int j = 0; !linear && j < number_errorband;j++){
 	for(Int_t ipara = 0;ipara<paras->getSize();ipara++){
 	  ws->var(paras->at(ipara)->GetName())->setVal(rand.Gaus(0.,sigma)); // choose how many sigma on the parameters you wamt
 	}
-	syst[j]=new TGraph(number_point+1);
 	for(int i =0 ; i <= number_point ; i++){
 		rrv_x->setVal(x_min+delta_x*i); 
-		syst[j]->SetPoint(i,x_min+delta_x*i,ws->pdf(pdf_name.c_str())->getVal(*rrv_x)*width_x);
+		envelope.fill(i,ws->pdf(pdf_name.c_str())->getVal(*rrv_x)*width_x);
 	}
  }
 
- std::vector<double> val;
- val.resize(number_errorband);
+ if(!linear) envelope.finish();
  TGraph *ap=new TGraph(number_point+1);
  TGraph *am=new TGraph(number_point+1);
  TGraphAsymmErrors* errorband=new TGraphAsymmErrors(number_point+1);
@@ -508,14 +1042,10 @@ void draw_error_band_shape_Decor( std::string pdf_name, std::string xaxis_name,
  errorband->SetName("errorband");
 
  for(int i =0 ; i<= number_point ; i++){
-	for(int j=0;j<number_errorband;j++){
-		val[j]=(syst[j])->GetY()[i];
-	}
-	std::sort(val.begin(),val.end());
-	ap->SetPoint(i, x_min+delta_x*i,val[Int_t(0.16*number_errorband)]);
-	am->SetPoint(i, x_min+delta_x*i,val[Int_t(0.84*number_errorband)]);
+	ap->SetPoint(i, x_min+delta_x*i,envelope.low(i));
+	am->SetPoint(i, x_min+delta_x*i,envelope.high(i));
 	errorband->SetPoint(i,x_min+delta_x*i,bkgpred->GetY()[i]);
-	errorband->SetPointError(i,0.,0.,bkgpred->GetY()[i]-val[Int_t(0.16*number_errorband)],val[Int_t(0.84*number_errorband)]-bkgpred->GetY()[i]);
+	errorband->SetPointError(i,0.,0.,bkgpred->GetY()[i]-envelope.low(i),envelope.high(i)-bkgpred->GetY()[i]);
  }
 
  ap->SetLineWidth(2);
@@ -569,28 +1099,12 @@ void draw_error_band_extendPdf_pull( RooAbsData *rdata, RooAbsPdf *rpdf, RooFitR
  bkgpred->SetLineWidth(2);
  bkgpred->SetLineColor(kcolor);
 
- /// Set of parameters
- RooArgSet* par_pdf  = rpdf->getParameters(RooArgSet(*rrv_x)) ;
-       
- /// Build a envelope using number_errorband toys
- TGraph* syst[number_errorband];
- for(int j=0;j<number_errorband;j++){
-   syst[j] = new TGraph(number_point+1);
-   /// paramters value are randomized using rfres and this can be done also if they are not decorrelate
-   RooArgList par_tmp = rfres->randomizePars();
-   *par_pdf = par_tmp;
-   for(int i =0 ; i<=number_point ; i++){
-	rrv_x->setVal(x_min+delta_x*i); 
-	syst[j]->SetPoint(i,x_min+delta_x*i,rpdf->expectedEvents(*rrv_x)*rpdf->getVal(*rrv_x)*width_x);
-   }
- }
-
- /// re-take the initial parameters
- RooArgList par_tmp = rfres->floatParsFinal();
- *par_pdf = par_tmp;
+ /// Build a envelope using number_errorband toys, parameters drawn from the covariance of rfres
+ std::vector<double> grid(number_point+1);
+ for(int i =0 ; i<= number_point ; i++) grid[i] = x_min+delta_x*i;
+ ToyBandEnvelope envelope(number_point+1,number_errorband);
+ toy_band_envelope(rpdf,rrv_x,rfres,NULL,grid,width_x,number_errorband,envelope);
  // build the uncertainty band at 68% CL 
- std::vector<double> val;
- val.resize(number_errorband);
 
  // Try to build and find max and minimum for each point --> not the curve but the value to do a real envelope -> take one sigma interval
  TGraphAsymmErrors* errorband_pull = new TGraphAsymmErrors(number_point+1);
@@ -606,13 +1120,8 @@ void draw_error_band_extendPdf_pull( RooAbsData *rdata, RooAbsPdf *rpdf, RooFitR
  const double alpha = 1 - 0.6827;
  
  for(int i =0 ; i<= number_point ; i++){
-	for(int j=0;j<number_errorband;j++){
-		val[j]=(syst[j])->GetY()[i];
-	}
-	std::sort(val.begin(),val.end());
-
-	double errYLow   = (bkgpred->GetY()[i]-val[Int_t(0.16*number_errorband)]);
-	double errYHi    = (val[Int_t(0.84*number_errorband)]-bkgpred->GetY()[i]);
+	double errYLow   = (bkgpred->GetY()[i]-envelope.low(i));
+	double errYHi    = (envelope.high(i)-bkgpred->GetY()[i]);
         int N = hdata->GetBinContent(hdata->FindBin(x_min+delta_x*i));
 
         if (i == number_point) N = hdata->GetBinContent(hdata->FindBin(x_min+delta_x*(i-1)));
@@ -686,29 +1195,13 @@ void draw_error_band_extendPdf_ratio( RooAbsData *rdata, RooAbsPdf *rpdf, RooFit
  bkgpred->SetLineWidth(2);
  bkgpred->SetLineColor(kcolor);
 
- /// Set of parameters
- RooArgSet* par_pdf  = rpdf->getParameters(RooArgSet(*rrv_x)) ;
-       
- /// Build a envelope using number_errorband toys
- TGraph* syst[number_errorband];
- for(int j=0;j<number_errorband;j++){
-   syst[j] = new TGraph(number_point+1);
-   /// paramters value are randomized using rfres and this can be done also if they are not decorrelate
-   RooArgList par_tmp = rfres->randomizePars();
-   *par_pdf = par_tmp;
-   for(int i =0 ; i<=number_point ; i++){
-	rrv_x->setVal(x_min+delta_x*i); 
-	syst[j]->SetPoint(i,x_min+delta_x*i,rpdf->expectedEvents(*rrv_x)*rpdf->getVal(*rrv_x)*width_x);
-   }
- }
-
- /// re-take the initial parameters
- RooArgList par_tmp = rfres->floatParsFinal();
- *par_pdf = par_tmp;
+ /// Build a envelope using number_errorband toys, parameters drawn from the covariance of rfres
+ std::vector<double> grid(number_point+1);
+ for(int i =0 ; i<= number_point ; i++) grid[i] = x_min+delta_x*i;
+ ToyBandEnvelope envelope(number_point+1,number_errorband);
+ toy_band_envelope(rpdf,rrv_x,rfres,NULL,grid,width_x,number_errorband,envelope);
  
  // build the uncertainty band at 68% CL 
- std::vector<double> val;
- val.resize(number_errorband);
 
  // Try to build and find max and minimum for each point --> not the curve but the value to do a real envelope -> take one sigma interval
  TGraphAsymmErrors* errorband_ratio = new TGraphAsymmErrors(number_point+1);
@@ -719,12 +1212,8 @@ void draw_error_band_extendPdf_ratio( RooAbsData *rdata, RooAbsPdf *rpdf, RooFit
  errorband_ratio_up->SetName("errorband_pull_up");
   
  for(int i =0 ; i<= number_point ; i++){
-	for(int j=0;j<number_errorband;j++){
-		val[j]=(syst[j])->GetY()[i];
-	}
-        std::sort(val.begin(),val.end());
-	double errYLow   = bkgpred->GetY()[i]-val[Int_t(0.16*number_errorband)];
-	double errYHi    = val[Int_t(0.84*number_errorband)]-bkgpred->GetY()[i];
+	double errYLow   = bkgpred->GetY()[i]-envelope.low(i);
+	double errYHi    = envelope.high(i)-bkgpred->GetY()[i];
       	errorband_ratio->SetPoint(i,x_min+delta_x*i+width_x/2,1.0);
 	errorband_ratio->SetPointError(i,width_x/2,width_x/2,errYLow/bkgpred->GetY()[i],errYHi/bkgpred->GetY()[i]);
 
@@ -793,30 +1282,13 @@ void draw_error_band_pull( RooAbsData *rdata,  RooAbsPdf *rpdf,  RooRealVar *rrv
   bkgpred->SetLineWidth(2);
   bkgpred->SetLineColor(kcolor);
 
-  /// Set of parameters
-  RooArgSet* par_pdf  = rpdf->getParameters(RooArgSet(*rrv_x)) ;
-       
-  /// Build a envelope using number_errorband toys
-  TGraph* syst[number_errorband];
-  for(int j=0;j<number_errorband;j++){
-	syst[j] = new TGraph(number_point+1);
-        /// paramters value are randomized using rfres and this can be done also if they are not decorrelate
-	RooArgList par_tmp = rfres->randomizePars();
-	*par_pdf = par_tmp;
-	Double_t number_events_tmp = rand.Gaus(number_events_mean,number_events_sigma); /// new poisson random number of events
-	for(int i =0 ; i<=number_point ; i++){
-		rrv_x->setVal(x_min+delta_x*i); 
-		syst[j]->SetPoint(i,x_min+delta_x*i,number_events_tmp*rpdf->getVal(*rrv_x)*width_x);
-	}
-  }
-
-  /// re-take the initial parameters
-  RooArgList par_tmp = rfres->floatParsFinal();
-  *par_pdf = par_tmp;
+  /// Build a envelope using number_errorband toys, parameters drawn from the covariance of rfres
+  std::vector<double> grid(number_point+1);
+  for(int i =0 ; i<= number_point ; i++) grid[i] = x_min+delta_x*i;
+  ToyBandEnvelope envelope(number_point+1,number_errorband);
+  toy_band_envelope(rpdf,rrv_x,rfres,rrv_number_events,grid,width_x,number_errorband,envelope);
 
   // build the uncertainty band at 68% CL 
-  std::vector<double> val;
-  val.resize(number_errorband);
 
   // Try to build and find max and minimum for each point --> not the curve but the value to do a real envelope -> take one sigma interval
   TGraphAsymmErrors* errorband_pull = new TGraphAsymmErrors(number_point+1);
@@ -830,12 +1302,8 @@ void draw_error_band_pull( RooAbsData *rdata,  RooAbsPdf *rpdf,  RooRealVar *rrv
   const double alpha = 1 - 0.6827;
 
   for(int i =0 ; i<= number_point ; i++){
-	for(int j=0;j<number_errorband;j++){
-		val[j]=(syst[j])->GetY()[i];
-	}
-        std::sort(val.begin(),val.end());
-	double errYLow   = (bkgpred->GetY()[i]-val[Int_t(0.16*number_errorband)]);
-	double errYHi    = (val[Int_t(0.84*number_errorband)]-bkgpred->GetY()[i]);
+	double errYLow   = (bkgpred->GetY()[i]-envelope.low(i));
+	double errYHi    = (envelope.high(i)-bkgpred->GetY()[i]);
         int N = hdata->GetBinContent(hdata->FindBin(x_min+delta_x*i));
         if (i == number_point) N = hdata->GetBinContent(hdata->FindBin(x_min+delta_x*(i-1)));
 	double errData_dw =  (N==0) ? 0  : (ROOT::Math::gamma_quantile(alpha/2,N,1.));
@@ -910,30 +1378,13 @@ void draw_error_band_ratio(RooAbsData* rdata, RooAbsPdf *rpdf,  RooRealVar *rrv_
   }
   bkgpred->SetLineWidth(2);
   bkgpred->SetLineColor(kcolor);
-  /// Set of parameters
-  RooArgSet* par_pdf  = rpdf->getParameters(RooArgSet(*rrv_x)) ;
-       
-  /// Build a envelope using number_errorband toys
-  TGraph* syst[number_errorband];
-  for(int j=0;j<number_errorband;j++){
-	syst[j] = new TGraph(number_point+1);
-        /// paramters value are randomized using rfres and this can be done also if they are not decorrelate
-	RooArgList par_tmp = rfres->randomizePars();
-	*par_pdf = par_tmp;
-	Double_t number_events_tmp = rand.Gaus(number_events_mean,number_events_sigma); /// new poisson random number of events
-	for(int i =0 ; i<=number_point ; i++){
-		rrv_x->setVal(x_min+delta_x*i); 
-		syst[j]->SetPoint(i,x_min+delta_x*i,number_events_tmp*rpdf->getVal(*rrv_x)*width_x);
-	}
-  }
-
-  /// re-take the initial parameters
-  RooArgList par_tmp = rfres->floatParsFinal();
-  *par_pdf = par_tmp;
+  /// Build a envelope using number_errorband toys, parameters drawn from the covariance of rfres
+  std::vector<double> grid(number_point+1);
+  for(int i =0 ; i<= number_point ; i++) grid[i] = x_min+delta_x*i;
+  ToyBandEnvelope envelope(number_point+1,number_errorband);
+  toy_band_envelope(rpdf,rrv_x,rfres,rrv_number_events,grid,width_x,number_errorband,envelope);
 
   // build the uncertainty band at 68% CL 
-  std::vector<double> val;
-  val.resize(number_errorband);
 
   // Try to build and find max and minimum for each point --> not the curve but the value to do a real envelope -> take one sigma interval
   TGraphAsymmErrors* errorband_ratio = new TGraphAsymmErrors(number_point+1);
@@ -944,14 +1395,8 @@ void draw_error_band_ratio(RooAbsData* rdata, RooAbsPdf *rpdf,  RooRealVar *rrv_
   errorband_ratio_up->SetName("errorband_pull_up");
   
   for(int i =0 ; i<= number_point ; i++){
-	for(int j=0;j<number_errorband;j++){
-		val[j]=(syst[j])->GetY()[i];
-	}
-
-        std::sort(val.begin(),val.end());
-
-	double errYLow   = bkgpred->GetY()[i]-val[Int_t(0.16*number_errorband)];
-	double errYHi    = (val[Int_t(0.84*number_errorband)]-bkgpred->GetY()[i]);
+	double errYLow   = bkgpred->GetY()[i]-envelope.low(i);
+	double errYHi    = (envelope.high(i)-bkgpred->GetY()[i]);
 
       	errorband_ratio->SetPoint(i,x_min+delta_x*i+width_x/2,1.0);
 	errorband_ratio->SetPointError(i,width_x/2,width_x/2,errYLow/bkgpred->GetY()[i],errYHi/bkgpred->GetY()[i]);
@@ -987,8 +1432,6 @@ void draw_error_band_ratio(RooAbsData* rdata, RooAbsPdf *rpdf,  RooRealVar *rrv_
 /// Calculate the error when intgrating a pdf in a range -> take the error not as a single fit result but from toys randomizing the parameters
 double Calc_error_extendPdf( RooAbsData* rdata,  RooExtendPdf* rpdf, RooFitResult *rfres, const std::string & range, const int & calc_times){
 
- TRandom3 rand(1234);
- rand.SetSeed(); 
  std::cout<<" <<<<<<<<<<<<<<<  Calc_error_extendPdf <<<<<<<<<<<<<<<< "<<std::endl;
  /// Get the observable on the x-axis
  RooArgSet* argset_obs = rpdf->getObservables(rdata);
@@ -997,35 +1440,36 @@ double Calc_error_extendPdf( RooAbsData* rdata,  RooExtendPdf* rpdf, RooFitResul
  RooRealVar *rrv_x=(RooRealVar*)par->Next();
  rrv_x->Print();
 
- /// Create integral of the whole function and in a given range
- RooAbsReal* fullInt   = rpdf->createIntegral(*rrv_x,*rrv_x);
- RooAbsReal* signalInt = rpdf->createIntegral(*rrv_x,*rrv_x,range.c_str());
- double fullInt_var    = fullInt->getVal();
- double signalInt_var  = signalInt->getVal()/fullInt_var;
+ /// Fraction of the pdf in the range: analytic integral or fixed quadrature nodes, cheap to re-evaluate in the toys
+ RangeFraction fraction(rpdf,rrv_x,range);
+ double signal_number_media = fraction.getVal()*rpdf->expectedEvents(*rrv_x);
 
- double signal_number_media = signalInt_var*rpdf->expectedEvents(*rrv_x);
+ /// linear propagation of the fit covariance, if selected
+ double linear_error = 0.;
+ if(linear_range_error(rpdf,rrv_x,range,rfres->floatParsFinal(),rfres->covarianceMatrix(),true,signal_number_media,linear_error)) return linear_error;
 
- /// Take the parameters and randomize them within uncertainty and do a lot of toys
+ /// Take the parameters and randomize them within uncertainty and do a lot of toys, all drawn at once
  RooArgSet* par_pdf  = rpdf->getParameters(RooArgSet(*rrv_x)) ;
  par_pdf->Print("v");
-
- std::vector<double> val;
- val.resize(calc_times);
+ const RooArgList & floatPars = rfres->floatParsFinal();
+ int npar = floatPars.getSize();
+ std::vector<RooRealVar*> pars(npar);
+ for(int k = 0; k < npar; k++) pars[k] = dynamic_cast<RooRealVar*>(par_pdf->find(floatPars[k].GetName()));
+ std::vector<double> toys;
+ fit_parameter_toys(rfres,calc_times,toys);
+
+ ToyBandEnvelope envelope(1,calc_times);
  for(int j=0;j<calc_times;j++){
-	RooArgList par_tmp = rfres->randomizePars();
-	*par_pdf = par_tmp;
-
-        fullInt_var = fullInt->getVal();
-        signalInt_var = signalInt->getVal()/fullInt_var;
-        signal_number_media = signalInt_var*rpdf->expectedEvents(*rrv_x);
-        val[j] = signal_number_media;
+	for(int k = 0; k < npar; k++) if(pars[k]) pars[k]->setVal(toys[j*npar+k]);
+        envelope.fill(0,fraction.getVal()*rpdf->expectedEvents(*rrv_x));
  }
+ envelope.finish();
 
  RooArgList par_tmp = rfres->floatParsFinal();
  *par_pdf = par_tmp;
+ delete par_pdf;
 
- std::sort(val.begin(),val.end());
- return (val[Int_t(0.84*calc_times)]-val[Int_t(0.16*calc_times)])/2.; /// return a doble value 
+ return (envelope.high(0)-envelope.low(0))/2.; /// return a doble value 
 
 }
 
@@ -1040,31 +1484,37 @@ double Calc_error(std::string rpdfname, std::string xaxis_name ,  RooArgList* pa
  rrv_x->Print();
  RooAbsPdf*rpdf=ws->pdf(rpdfname.c_str());
 
- RooAbsReal* fullInt = rpdf->createIntegral(*rrv_x,*rrv_x);
- RooAbsReal* signalInt = rpdf->createIntegral(*rrv_x,*rrv_x,range.c_str());
- double fullInt_var = fullInt->getVal();
- double signalInt_var = signalInt->getVal()/fullInt_var;
-
- double signal_number_media=signalInt_var;
-
- std::vector<double> val;
- val.resize(calc_times);
+ RangeFraction fraction(rpdf,rrv_x,range);
+ double signal_number_media=fraction.getVal();
+
+ /// linear propagation, the decorrelated parameters have their own errors
+ TMatrixDSym cov(paras->getSize());
+ for(Int_t ipara=0;ipara<paras->getSize();ipara++) cov(ipara,ipara) = TMath::Power(ws->var(paras->at(ipara)->GetName())->getError(),2);
+ double linear_error = 0.;
+ if(linear_range_error(rpdf,rrv_x,range,*paras,cov,false,signal_number_media,linear_error)) return linear_error/signal_number_media;
+
+ /// all the toys drawn at once, then one range fraction each
+ int npar = paras->getSize();
+ std::vector<RooRealVar*> pars(npar);
+ for(Int_t ipara=0;ipara<npar;ipara++){
+   pars[ipara] = ws->var(paras->at(ipara)->GetName());
+   pars[ipara]->setConstant(0);
+ }
+ std::vector<double> toys(calc_times*npar);
  for(int j=0;j<calc_times;j++){
-    for(Int_t ipara=0;ipara<paras->getSize();ipara++){
-      ws->var(paras->at(ipara)->GetName())->setConstant(0);
-      ws->var(paras->at(ipara)->GetName())->setVal( rand.Gaus(0.,ws->var(paras->at(ipara)->GetName())->getError()) );
-     }
-
-     fullInt_var=fullInt->getVal();
-     signalInt_var=signalInt->getVal()/fullInt_var;
+   for(Int_t ipara=0;ipara<npar;ipara++) toys[j*npar+ipara] = rand.Gaus(0.,pars[ipara]->getError());
+ }
 
-     signal_number_media=signalInt_var;
-     val[j]=signal_number_media;
+ ToyBandEnvelope envelope(1,calc_times);
+ for(int j=0;j<calc_times;j++){
+    for(Int_t ipara=0;ipara<npar;ipara++) pars[ipara]->setVal(toys[j*npar+ipara]);
+    envelope.fill(0,fraction.getVal());
  }
+ envelope.finish();
  
-for(Int_t ipara=0;ipara<paras->getSize();ipara++){ ws->var(paras->at(ipara)->GetName())->setVal(0.); }
+for(Int_t ipara=0;ipara<npar;ipara++){ pars[ipara]->setVal(0.); }
 
-std::sort(val.begin(),val.end());
-double number_error=(val[Int_t(0.84*calc_times)]-val[Int_t(0.16*calc_times)])/2./signal_number_media;
+/// relative to the central value
+double number_error=(envelope.high(0)-envelope.low(0))/2./signal_number_media;
 return number_error;
 }
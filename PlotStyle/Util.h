@@ -16,6 +16,9 @@
 #include "TRandom.h"
 #include "TGraph.h"
 #include "TGraphAsymmErrors.h"
+#include "TMatrixD.h"
+#include "TMatrixDSym.h"
+#include "TDecompChol.h"
 
 #include "RooPlot.h"
 #include "RooHist.h"
@@ -44,6 +47,101 @@ using namespace TMath;
 
 //////////////////////////////////////////////////////////////
 
+/// 16% and 84% envelope of the toys at each grid point, filled one toy value at a time. Up to exactToys toys (well above
+/// the 2000 toys of the error bands) or for a single point the values are kept and the quantiles are exact (nth_element);
+/// above, each point keeps only a P-square estimator per quantile, so the memory does not scale as toys x grid points.
+/// See test_ToyBandEnvelope.cxx for the P-square accuracy.
+class ToyBandEnvelope {
+
+ public:
+  ToyBandEnvelope(const int & npoints, const int & ntoys, const double & plow = 0.16, const double & phigh = 0.84);
+  void fill(const int & i, const double & value);
+  /// toy storage, otherwise allocated by the first fill; call it before filling different points from several threads
+  void allocate();
+  void finish();
+  void setBand(const int & i, const double & low, const double & high){ qlow[i] = low; qhigh[i] = high; }
+  double low(const int & i) const { return qlow[i]; }
+  double high(const int & i) const { return qhigh[i]; }
+
+  static const int exactToys = 10000;
+
+ private:
+  void addMarker(double* q, double* n, const double & p, const int & count, const double & value);
+  double marker(double* q, const double & p, const int & count);
+
+  int npoints, ntoys;
+  double p[2];
+  bool exact;
+  std::vector<int> count;
+  std::vector<double> values;     // exact: toy values, point by point; streaming: 5 heights per point and quantile
+  std::vector<double> positions;  // streaming: 5 marker positions per point and quantile
+  std::vector<double> qlow, qhigh;
+};
+
+/// Fraction of the normalised pdf in a named range of x (whole range if empty). Gaussians, exponentials and RooBatchPdf
+/// shapes under RooAddPdf / RooExtendPdf go through binIntegralsPdf on the edges {min, range, max} of x: closed forms of
+/// the CDF where the shape has one, batchIntegral otherwise, no RooFit integral object. Other pdfs that integrate x
+/// analytically build the integral object once; the rest are summed on fixed Gauss-Legendre nodes of the range, with no
+/// adaptive integration per call. Meant to be called again after each change of the parameters (toys).
+class RangeFraction {
+
+ public:
+  RangeFraction(RooAbsPdf* pdf, RooRealVar* x, const std::string & range = "");
+  ~RangeFraction();
+  double getVal();
+  bool analytic() const { return integral != 0; }
+  bool batched() const { return !edges.empty(); }
+
+  static const int cells = 20;
+
+ private:
+  RangeFraction(const RangeFraction &);
+  RangeFraction & operator=(const RangeFraction &);
+
+  RooAbsPdf* pdf;
+  RooRealVar* x;
+  RooAbsReal* integral;
+  RooArgSet nset;
+  std::vector<double> nodes, weights;
+  std::vector<double> edges, bins;
+};
+
+/// number_toys sets of the floating parameters of rfres, toys[j*npar+k], drawn from one Cholesky factorisation
+void fit_parameter_toys(RooFitResult*, const int &, std::vector<double> &);
+
+/// Threads of toy_band_envelope (1 by default). The band does not depend on it: see toy_band_envelope.
+void SetToyBandThreads(const int &);
+
+/// Seed of the toys of toy_band_envelope: 0 (default) takes a new seed for each band
+void SetToyBandSeed(const unsigned int &);
+
+/// Fill envelope with the values at each grid point of number_toys toys, times width_x: parameters drawn from the
+/// covariance of the fit result (one Cholesky factorisation), scaled by the expected events of the pdf, or by a gaussian
+/// draw of rrv_number_events if given. The calling thread sets each toy on the pdf and copies its leaves (fractions,
+/// norms, RooBatchPdf snapshots: flattenPdfTerms of RooBatchNLL); the SetToyBandThreads threads evaluate the whole grid
+/// of each toy through the array path, each on a slice of the grid points. The parameters of the pdf are put back.
+/// The band is cached per fit at unit bin width: drawing the same fit again (pull, ratio panels) rescales it, or
+/// interpolates it if the new grid is coarser over the same range.
+void toy_band_envelope(RooAbsPdf*, RooRealVar*, RooFitResult*, RooRealVar*, const std::vector<double> &, const double &, const int &, ToyBandEnvelope &);
+
+/// Forget the cached bands
+void ClearToyBandCache();
+
+/// Error bands and Calc_error*: 0 = toys (default), 1 = linear propagation J C J^T. On the grid of a normalised pdf J comes
+/// from gradientPdfBatch (analytic for the RooBatchPdf shapes with gradients, gaussians and their sums, central differences
+/// for the rest) plus one evaluation at +1 sigma per parameter for the check below; range fractions and unnormalised pdfs
+/// use one finite difference pass at +-1 sigma. The toys are still used when the one sided slopes differ by more than
+/// maxNonLinearity (relative) somewhere, maxNonLinearity <= 0 never goes back to the toys.
+void SetErrorBandMode(const int &, const double & = 0.2);
+
+/// Linear band at +-1 sigma of the pdf (parameters pars, with covariance cov, looked up by name in the pdf) on the grid,
+/// times width_x and number_events (expected events if number_events < 0), number_events_sigma added in quadrature.
+/// The parameters are put back at their values. Returns false in toy mode or for a non-linear pdf: use the toys.
+bool linear_band_envelope(RooAbsPdf*, RooRealVar*, const RooArgList &, const TMatrixDSym &, const double &, const double &, const std::vector<double> &, const double &, ToyBandEnvelope &, const bool & = true);
+
+/// Same for the fraction of the pdf in the named range (times the expected events if extended): value and its 1 sigma error
+bool linear_range_error(RooAbsPdf*, RooRealVar*, const std::string &, const RooArgList &, const TMatrixDSym &, const bool &, double &, double &);
+
 void draw_error_band(RooAbsData*, RooAbsPdf*,  RooRealVar*, RooFitResult*, RooPlot*, const int & = 6, const std::string & ="F", const int & = 100, const int & = 2000);
 
 void draw_error_band_extendPdf(RooAbsData *, RooAbsPdf*, RooFitResult*, RooPlot*, const int & = 6, const std::string & = "F", const int & = 100,  const int & = 2000);
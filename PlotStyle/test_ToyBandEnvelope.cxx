@@ -0,0 +1,47 @@
+/*
+ * Compare the P-square quantiles of ToyBandEnvelope (more than exactToys toys) with the exact 16% and 84% quantiles
+ * of the same toys, for a gaussian, an exponential and a log-normal distribution at each point.
+ *   root -l -b -q test_ToyBandEnvelope.cxx
+ */
+
+{
+	gROOT->ProcessLine(".L ../PDFs/VectorMath.cxx+");
+	gROOT->ProcessLine(".L ../PDFs/HWWLVJRooPdfs.cxx+");
+	gROOT->ProcessLine(".L ../PDFs/RooBatchNLL.cxx+");
+	gROOT->ProcessLine(".L Util.cxx+");
+
+	const Int_t npoints=3;
+	const Int_t ntoys=4*ToyBandEnvelope::exactToys;
+	ToyBandEnvelope streaming(npoints,ntoys);
+	ToyBandEnvelope single(1,ntoys);
+	std::vector<Double_t> toys(npoints*ntoys);
+
+	TRandom3 rand(4357);
+	for(Int_t j=0; j<ntoys; j++){
+		toys[0*ntoys+j]=rand.Gaus(100.,10.);
+		toys[1*ntoys+j]=rand.Exp(20.);
+		toys[2*ntoys+j]=TMath::Exp(rand.Gaus(0.,0.5));
+		for(Int_t i=0; i<npoints; i++) streaming.fill(i,toys[i*ntoys+j]);
+		single.fill(0,toys[0*ntoys+j]);
+	}
+	streaming.finish();
+	single.finish();
+
+	//// exact quantiles, with the same entries as ToyBandEnvelope: the P-square ones within 1% of the 16-84% width
+	Bool_t pass=kTRUE;
+	for(Int_t i=0; i<npoints; i++){
+		std::vector<Double_t> val(toys.begin()+i*ntoys,toys.begin()+(i+1)*ntoys);
+		std::sort(val.begin(),val.end());
+		Double_t low=val[Int_t(0.16*ntoys)], high=val[Int_t(0.84*ntoys)];
+		Double_t errLow=TMath::Abs(streaming.low(i)-low)/(high-low), errHigh=TMath::Abs(streaming.high(i)-high)/(high-low);
+		std::cout<<"point "<<i<<" exact ["<<low<<","<<high<<"] P-square ["<<streaming.low(i)<<","<<streaming.high(i)<<"]"
+			<<" rel err "<<errLow<<" "<<errHigh<<std::endl;
+		if(errLow>0.01 || errHigh>0.01) pass=kFALSE;
+		if(i==0 && (single.low(0)!=low || single.high(0)!=high)){
+			std::cout<<"single point not exact ["<<single.low(0)<<","<<single.high(0)<<"]"<<std::endl;
+			pass=kFALSE;
+		}
+	}
+
+	std::cout<<(pass ? "PASS" : "FAIL")<<std::endl;
+}
@@ -0,0 +1,60 @@
+/*
+ * Toy band of a fitted Gaussian + ErfExp extended model with 1 and 4 threads (SetToyBandThreads), same seed: the two
+ * envelopes must be identical, and the parameters of the pdf back at their fitted values.
+ *   root -l -b -q test_ToyBandThreads.cxx
+ */
+
+{
+	using namespace RooFit;
+	gROOT->ProcessLine(".L ../PDFs/VectorMath.cxx+");
+	gROOT->ProcessLine(".L ../PDFs/HWWLVJRooPdfs.cxx+");
+	gROOT->ProcessLine(".L ../PDFs/RooBatchNLL.cxx+");
+	gROOT->ProcessLine(".L Util.cxx+");
+	RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+
+	RooRealVar x("x","x",30,200);
+	RooRealVar mean("mean","mean",84,70,95), sigma("sigma","sigma",8,3,15);
+	RooRealVar c("c","c",-0.03,-0.2,0.), offset("offset","offset",60,30,100), width("width","width",30,10,80);
+	RooRealVar fsig("fsig","fsig",0.4,0.,1.), nevents("nevents","nevents",5000,0,20000);
+	RooGaussian gaus("gaus","gaus",x,mean,sigma);
+	RooErfExpPdf erfExp("erfExp","erfExp",x,c,offset,width);
+	RooAddPdf sum("sum","sum",gaus,erfExp,fsig);
+	RooExtendPdf model("model","model",sum,nevents);
+
+	RooDataSet* data=model.generate(x,5000);
+	RooFitResult* rfres=model.fitTo(*data,Save(kTRUE),Extended(kTRUE),PrintLevel(-1));
+	RooArgSet* fitted=(RooArgSet*) model.getParameters(x)->snapshot();
+
+	const Int_t npoints=101, ntoys=500;
+	std::vector<double> grid(npoints);
+	for(Int_t i=0; i<npoints; i++) grid[i]=30.+170.*i/(npoints-1);
+
+	SetToyBandSeed(1234);
+	ToyBandEnvelope single(npoints,ntoys), threaded(npoints,ntoys);
+	SetToyBandThreads(1);
+	toy_band_envelope(&model,&x,rfres,NULL,grid,1.,ntoys,single);
+	ClearToyBandCache();
+	SetToyBandThreads(4);
+	toy_band_envelope(&model,&x,rfres,NULL,grid,1.,ntoys,threaded);
+
+	Bool_t pass=kTRUE;
+	for(Int_t i=0; i<npoints; i++){
+		if(single.low(i)!=threaded.low(i) || single.high(i)!=threaded.high(i)){
+			std::cout<<"point "<<i<<" 1 thread ["<<single.low(i)<<","<<single.high(i)<<"] 4 threads ["
+				<<threaded.low(i)<<","<<threaded.high(i)<<"]"<<std::endl;
+			pass=kFALSE;
+		}
+		if(!(single.low(i)<single.high(i))) pass=kFALSE;
+	}
+	RooArgSet* after=model.getParameters(x);
+	TIterator* iter=fitted->createIterator();
+	for(RooRealVar* par=(RooRealVar*)iter->Next(); par; par=(RooRealVar*)iter->Next()){
+		if(after->getRealValue(par->GetName())!=par->getVal()){
+			std::cout<<par->GetName()<<" not put back"<<std::endl;
+			pass=kFALSE;
+		}
+	}
+	delete iter;
+	std::cout<<"band at the peak ["<<single.low(npoints/3)<<","<<single.high(npoints/3)<<"]"<<std::endl;
+	std::cout<<(pass ? "PASS" : "FAIL")<<std::endl;
+}
@@ -28,13 +28,17 @@ ROOT.gSystem.Load("/cvmfs/cms.cern.ch/slc6_amd64_gcc491/lcg/roofit/5.34.22-cms3/
 #ROOT.gSystem.Load("/cvmfs/cms.cern.ch/slc6_amd64_gcc491/cms/cmssw/CMSSW_7_4_7/external/slc6_amd64_gcc491/lib/libHist.so")
 ROOT.gSystem.Load("/cvmfs/cms.cern.ch/slc6_amd64_gcc491/lcg/roofit/5.34.22-cms3/lib/libRooFit.so")
 
-ROOT.gSystem.Load(".//PlotStyle/Util_cxx.so")
-ROOT.gSystem.Load(".//PlotStyle/PlotUtils_cxx.so")
 ROOT.gSystem.Load(".//PDFs/PdfDiagonalizer_cc.so")
+ROOT.gSystem.Load(".//PDFs/VectorMath_cxx.so")
 ROOT.gSystem.Load(".//PDFs/HWWLVJRooPdfs_cxx.so")
+ROOT.gSystem.Load(".//PDFs/RooBatchNLL_cxx.so")
+ROOT.gSystem.Load(".//PlotStyle/Util_cxx.so")
+ROOT.gSystem.Load(".//PlotStyle/PlotUtils_cxx.so")
 ROOT.gSystem.Load(".//PDFs/MakePdf_cxx.so")
 ROOT.gSystem.Load(".//BiasStudy/BiasUtils_cxx.so")
 ROOT.gSystem.Load(".//FitUtils/FitUtils_cxx.so")
+# per working point model parameters, see the header of the file
+if ROOT.LoadModelConfig("PDFs/config/N2DDT.txt") < 0: sys.exit(1)
 
 tdrstyle.setTDRStyle()
 CMS_lumi.lumi_13TeV = "27.2 fb^{-1}"
@@ -540,6 +544,9 @@ class initialiseFits:
       rrv_mass_j = RooRealVar("rrv_mass_j", jetMass ,(in_mj_min+in_mj_max)/2.,in_mj_min,in_mj_max,"GeV")
       rrv_mass_j.setBins(nbins_mj)
  
+      # A new fitter is a new job: forget the models MakePdf.cxx cached for earlier workspaces
+      ROOT.ClearModelCache()
+
       # Create workspace and import fit variable
       if input_workspace is None:
           self.workspace4fit_ = RooWorkspace("workspace4fit_","Workspace4fit_")
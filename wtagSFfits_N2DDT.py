@@ -4,6 +4,10 @@ import sys
 import os
 import time
 import math
+import hashlib
+import tempfile
+import shutil
+import traceback
 import CMS_lumi, tdrstyle
 from ROOT import *
 
@@ -20,6 +24,19 @@ parser.add_option('--76X',dest="use76X", default=False, action="store_true", hel
 parser.add_option('--useDDT',dest="useDDT", default=False, action="store_true", help="Use DDT tagger")
 parser.add_option('--useN2DDT',dest="useN2DDT", default=False, action="store_true", help="Use N_2^DDT tagger")
 parser.add_option('--usePuppiSD',dest="usePuppiSD", default=False, action="store_true", help="Use PUPPI+softdrop")
+parser.add_option('--noBatchNLL',dest="noBatchNLL", default=False, action="store_true", help="Use RooFit fitTo instead of the batch NLL for the simultaneous fits")
+parser.add_option('--noAnalyticGradient',dest="noAnalyticGradient", default=False, action="store_true", help="Let Minuit2 compute the batch NLL derivatives numerically instead of using the analytic gradients")
+parser.add_option('--fusedModels',dest="fusedModels", default=False, action="store_true", help="Build GausErfExp_ttbar, ExpGaus_sp and ErfExpGaus_sp as single fused pdfs (no component plots)")
+parser.add_option('--tabulatedPdfs',dest="tabulatedPdfs", default=0., type="float", help="Plot the fitted curves from RooTabulatedPdf tables with this tolerance (0 = exact pdfs)")
+parser.add_option('--modelConfig',dest="modelConfig", default="PDFs/config/N2DDT.txt", type="string", help="Text file of model parameter values per working point and sample, read once at startup")
+parser.add_option('--snapshotDir',dest="snapshotDir", default="", type="string", help="Directory of mj dataset snapshots: datasets are loaded from a snapshot matching the input file and cuts, or built from the trees and saved there")
+parser.add_option('--rebuildSnapshot',dest="rebuildSnapshot", default=False, action="store_true", help="Loop over the trees even if a matching snapshot exists, and overwrite it")
+parser.add_option('--warmStart',dest="warmStart", default="", type="string", help="ROOT file of converged fit results: fits start from the nearest stored result (same sample, model and tagger) and store theirs")
+parser.add_option('--minos',dest="minos", default=False, action="store_true", help="MINOS errors on the scale factor parameters (eff_ttbar, mean and sigma of the W peak) of the batch NLL simultaneous fits")
+parser.add_option('--threads',dest="threads", default=0, type="int", help="Worker threads of the batch NLL fits, e.g. the simultaneous pass/fail fits (0 = single threaded; any value >= 1 gives the same NLL; forked --jobs workers stay single threaded)")
+parser.add_option('--bandThreads',dest="bandThreads", default=1, type="int", help="Threads of the toy error bands drawn on the plots (the band does not depend on it)")
+parser.add_option('--linearBands', action='store_true', dest='linearBands', default=False, help='Error bands from linear propagation of the fit covariance instead of toys (toys are kept for pdfs non-linear within 1 sigma)')
+parser.add_option('--jobs',dest="jobs", default=1, type="int", help="Number of forked workers for the single MC component fits (1 = in process, one after the other)")
 
 (options, args) = parser.parse_args()
 
@@ -27,13 +44,27 @@ parser.add_option('--usePuppiSD',dest="usePuppiSD", default=False, action="store
 ROOT.gSystem.Load("/cvmfs/cms.cern.ch/slc6_amd64_gcc491/lcg/roofit/5.34.22-cms3/lib/libRooFitCore.so")
 ROOT.gSystem.Load("/cvmfs/cms.cern.ch/slc6_amd64_gcc491/lcg/roofit/5.34.22-cms3/lib/libRooFit.so")
 
-ROOT.gSystem.Load(".//PlotStyle/Util_cxx.so")
-ROOT.gSystem.Load(".//PlotStyle/PlotUtils_cxx.so")
 ROOT.gSystem.Load(".//PDFs/PdfDiagonalizer_cc.so")
+ROOT.gSystem.Load(".//PDFs/VectorMath_cxx.so")
 ROOT.gSystem.Load(".//PDFs/HWWLVJRooPdfs_cxx.so")
+ROOT.gSystem.Load(".//PDFs/RooBatchNLL_cxx.so")
+ROOT.gSystem.Load(".//PlotStyle/Util_cxx.so")
+ROOT.gSystem.Load(".//PlotStyle/PlotUtils_cxx.so")
 ROOT.gSystem.Load(".//PDFs/MakePdf_cxx.so")
 ROOT.gSystem.Load(".//BiasStudy/BiasUtils_cxx.so")
 ROOT.gSystem.Load(".//FitUtils/FitUtils_cxx.so")
+if options.fusedModels: ROOT.SetFusedModels(True)
+if ROOT.LoadModelConfig(options.modelConfig) < 0: sys.exit(1)
+if options.warmStart: ROOT.SetWarmStartFile(options.warmStart)
+if options.threads > 0: ROOT.SetBatchNLLThreads(options.threads)
+if options.bandThreads > 1: ROOT.SetToyBandThreads(options.bandThreads)
+if options.linearBands: ROOT.SetErrorBandMode(1)
+
+# bump when get_mj_dataset changes what it fills, so older snapshots are not loaded
+MJ_SNAPSHOT_VERSION = 2
+
+# parameters of the simultaneous fits with MINOS errors when --minos is given (substrings of the names)
+minos_params = "eff_ttbar,rrv_mean1_gaus,rrv_sigma1_gaus" if options.minos else ""
 
 tdrstyle.setTDRStyle()
 CMS_lumi.lumi_13TeV = "35.8 fb^{-1}"
@@ -75,7 +106,7 @@ def getPavetext():
   addInfo.SetTextAlign(12)
   return addInfo
     
-def drawFrameGetChi2(variable,fitResult,dataset,pdfModel,isData):
+def drawFrameGetChi2(variable,fitResult,dataset,pdfModel,isData,workspace=None):
     
     wpForPlotting ="%.2f"%options.tau2tau1cutHP
     wpForPlotting = wpForPlotting.replace(".","v")
@@ -91,7 +122,7 @@ def drawFrameGetChi2(variable,fitResult,dataset,pdfModel,isData):
     if(isData): dataset.plotOn(frame,RooFit.DataError(RooAbsData.Poisson),RooFit.Name(dataset.GetName ()))
     else: dataset.plotOn(frame,RooFit.DataError(RooAbsData.SumW2),RooFit.Name(dataset.GetName ()))
     pdfModel.plotOn(frame,RooFit.VisualizeError(fitResult,1), RooFit.Name("Fit error"),RooFit.FillColor(kGray),RooFit.LineColor(kGray)) #,RooFit.Normalization(1.0,RooAbsReal.RelativeExpected))
-    pdfModel.plotOn(frame,RooFit.LineColor(kBlack),RooFit.Name(pdfModel.GetName())) #,RooFit.Normalization(1.0,RooAbsReal.RelativeExpected))
+    ROOT.GetTabulatedPdf(workspace,pdfModel,variable).plotOn(frame,RooFit.LineColor(kBlack),RooFit.Name(pdfModel.GetName())) #,RooFit.Normalization(1.0,RooAbsReal.RelativeExpected))
     chi2 = frame.chiSquare(pdfModel.GetName(), dataset.GetName ())
     pdfModel.plotOn(frame,RooFit.Name( "Gaussian 2" ),RooFit.Components("gaus2*"),RooFit.LineStyle(kSolid),RooFit.LineColor(kBlue+3),RooFit.Normalization(1.0,RooAbsReal.RelativeExpected))
     pdfModel.plotOn(frame,RooFit.Name( "ErfExp comp." ),RooFit.Components("model_bkg*"),RooFit.LineStyle(9),RooFit.LineColor(kBlue+2),RooFit.Normalization(1.0,RooAbsReal.RelativeExpected))
@@ -131,7 +162,7 @@ def drawFrameGetChi2(variable,fitResult,dataset,pdfModel,isData):
     c1.SaveAs("plots/%s_%s.root"%(cname,options.sample))
     return chi2
 
-def drawDataAndMC(variable,fitResult,dataset,pdfModel,isData,variable2,fitResult2,dataset2,pdfModel2,isData2):
+def drawDataAndMC(variable,fitResult,dataset,pdfModel,isData,variable2,fitResult2,dataset2,pdfModel2,isData2,workspace=None):
 
     wpForPlotting ="%.2f"%options.tau2tau1cutHP
     wpForPlotting = wpForPlotting.replace(".","v")
@@ -147,7 +178,7 @@ def drawDataAndMC(variable,fitResult,dataset,pdfModel,isData,variable2,fitResult
     if(isData): dataset.plotOn(frame,RooFit.DataError(RooAbsData.Poisson),RooFit.Name(dataset.GetName ()))
     else: dataset.plotOn(frame,RooFit.DataError(RooAbsData.SumW2),RooFit.Name(dataset.GetName ()))
 #    pdfModel.plotOn(frame,RooFit.VisualizeError(fitResult,1), RooFit.Name("Fit error"),RooFit.FillColor(kGray),RooFit.LineColor(kGray)) #,RooFit.Normalization(1.0,RooAbsReal.RelativeExpected))
-    pdfModel.plotOn(frame,RooFit.LineColor(kBlack),RooFit.Name(pdfModel.GetName())) #,RooFit.Normalization(1.0,RooAbsReal.RelativeExpected))
+    ROOT.GetTabulatedPdf(workspace,pdfModel,variable).plotOn(frame,RooFit.LineColor(kBlack),RooFit.Name(pdfModel.GetName())) #,RooFit.Normalization(1.0,RooAbsReal.RelativeExpected))
     chi2 = frame.chiSquare(pdfModel.GetName(), dataset.GetName ())
     pdfModel.plotOn(frame,RooFit.Name( "Gaussian 2" ),RooFit.Components("gaus2*"),RooFit.LineStyle(kSolid),RooFit.LineColor(kBlue+3),RooFit.Normalization(1.0,RooAbsReal.RelativeExpected))
     pdfModel.plotOn(frame,RooFit.Name( "ErfExp Data comp." ),RooFit.Components("model_bkg*"),RooFit.LineStyle(9),RooFit.LineColor(kBlue+2),RooFit.Normalization(1.0,RooAbsReal.RelativeExpected))
@@ -160,7 +191,7 @@ def drawDataAndMC(variable,fitResult,dataset,pdfModel,isData,variable2,fitResult
     if(isData2): dataset2.plotOn(frame,RooFit.DataError(RooAbsData.Poisson),RooFit.Name(dataset2.GetName ()),RooFit.MarkerColor(kBlue),RooFit.LineColor(kBlue))
     else: dataset2.plotOn(frame,RooFit.DataError(RooAbsData.SumW2),RooFit.Name(dataset2.GetName ()),RooFit.MarkerColor(kBlue),RooFit.LineColor(kBlue))
 #    pdfModel2.plotOn(frame,RooFit.VisualizeError(fitResult2,1), RooFit.Name("Fit error"),RooFit.FillColor(kGray),RooFit.LineColor(kGray)) #,RooFit.Normalization(1.0,RooAbsReal.RelativeExpected))
-    pdfModel2.plotOn(frame,RooFit.LineColor(kGreen),RooFit.Name(pdfModel2.GetName())) #,RooFit.Normalization(1.0,RooAbsReal.RelativeExpected))
+    ROOT.GetTabulatedPdf(workspace,pdfModel2,variable2).plotOn(frame,RooFit.LineColor(kGreen),RooFit.Name(pdfModel2.GetName())) #,RooFit.Normalization(1.0,RooAbsReal.RelativeExpected))
     chi2_2 = frame.chiSquare(pdfModel2.GetName(), dataset2.GetName ())
     pdfModel2.plotOn(frame,RooFit.Name( "Gaussian 2 MC" ),RooFit.Components("gaus2*"),RooFit.LineStyle(kSolid),RooFit.LineColor(kBlue+3),RooFit.Normalization(1.0,RooAbsReal.RelativeExpected))
     pdfModel2.plotOn(frame,RooFit.Name( "ErfExp MC comp." ),RooFit.Components("model_bkg*"),RooFit.LineStyle(9),RooFit.LineColor(kMagenta+2),RooFit.Normalization(1.0,RooAbsReal.RelativeExpected))
@@ -208,6 +239,69 @@ def drawDataAndMC(variable,fitResult,dataset,pdfModel,isData,variable2,fitResult
     return chi2
 
     
+def run_component_fits(workspace,tasks):
+    # Runs fit_mj_single_MC(workspace,*task) for each (file, label, model, channel, wtagger_label) task. With --jobs > 1
+    # the fits run in forked workers on their copy of the workspace; the models, constraints and fit results each
+    # worker adds are merged back into workspace in task order, and stored in the warm start database from here.
+    if options.jobs <= 1 or len(tasks) <= 1:
+        for task in tasks: fit_mj_single_MC(workspace,*task)
+        return
+
+    tmp_dir = tempfile.mkdtemp(prefix="component_fits_")
+    outputs = [os.path.join(tmp_dir,"task%d.root"%i) for i in range(len(tasks))]
+    running = {}
+    failed  = []
+    next_task = 0
+    while next_task < len(tasks) or running:
+        if next_task < len(tasks) and len(running) < options.jobs:
+            sys.stdout.flush(); sys.stderr.flush()
+            pid = os.fork()
+            if pid == 0:
+                status = 1
+                try:
+                    ROOT.SetWarmStartStore(False)
+                    ROOT.SetBatchNLLThreads(0)
+                    fit_mj_single_MC(workspace,*tasks[next_task])
+                    workspace.writeToFile(outputs[next_task])
+                    status = 0
+                except:
+                    traceback.print_exc()
+                finally:
+                    sys.stdout.flush(); sys.stderr.flush()
+                    os._exit(status)
+            running[pid] = next_task
+            next_task += 1
+            continue
+        pid, status = os.wait()
+        if pid in running:
+            if status != 0: failed.append(tasks[running[pid]][1])
+            del running[pid]
+
+    if failed:
+        shutil.rmtree(tmp_dir)
+        raise RuntimeError("component fits failed: %s"%", ".join(failed))
+
+    for task, output in zip(tasks,outputs):
+        fileIn = TFile(output)
+        worker = fileIn.Get(workspace.GetName())
+        pdfs = worker.allPdfs().createIterator()
+        pdf  = pdfs.Next()
+        while pdf:
+            if not workspace.pdf(pdf.GetName()): getattr(workspace,"import")(pdf,RooFit.RecycleConflictNodes(),RooFit.Silence())
+            pdf = pdfs.Next()
+        variables = worker.allVars().createIterator()
+        var       = variables.Next()
+        while var:
+            if not workspace.var(var.GetName()): getattr(workspace,"import")(var,RooFit.Silence())
+            var = variables.Next()
+        known = set(obj.GetName() for obj in workspace.allGenericObjects())
+        for obj in worker.allGenericObjects():
+            if obj.GetName() in known: continue
+            getattr(workspace,"import")(obj)
+            if obj.InheritsFrom("RooFitResult"): ROOT.StoreFitResult(obj,task[1],task[2],task[4])
+        fileIn.Close()
+    shutil.rmtree(tmp_dir)
+
 def getSF():
     print "Getting W-tagging SF for cut " ,options.tau2tau1cutHP
     if options.useDDT: 
@@ -227,10 +321,11 @@ def doFitsToMatchedTT():
     print ttMC_fitter.channel
     print ttMC_fitter.wtagger_label
 
-    fit_mj_single_MC(ttMC_fitter.workspace4fit_,ttMC_fitter.file_TTbar_mc,"_TTbar_realW",ttMC_fitter.mj_shape["TTbar_realW"],ttMC_fitter.channel,ttMC_fitter.wtagger_label)
-    fit_mj_single_MC(ttMC_fitter.workspace4fit_,ttMC_fitter.file_TTbar_mc,"_TTbar_realW_failN2DDTcut",ttMC_fitter.mj_shape["TTbar_realW_fail"],ttMC_fitter.channel,ttMC_fitter.wtagger_label)
-    fit_mj_single_MC(ttMC_fitter.workspace4fit_,ttMC_fitter.file_TTbar_mc,"_TTbar_fakeW",ttMC_fitter.mj_shape["TTbar_fakeW"],ttMC_fitter.channel,ttMC_fitter.wtagger_label)
-    fit_mj_single_MC(ttMC_fitter.workspace4fit_,ttMC_fitter.file_TTbar_mc,"_TTbar_fakeW_failN2DDTcut",ttMC_fitter.mj_shape["TTbar_fakeW_fail"],ttMC_fitter.channel,ttMC_fitter.wtagger_label)
+    run_component_fits(ttMC_fitter.workspace4fit_,[
+        (ttMC_fitter.file_TTbar_mc,"_TTbar_realW",ttMC_fitter.mj_shape["TTbar_realW"],ttMC_fitter.channel,ttMC_fitter.wtagger_label),
+        (ttMC_fitter.file_TTbar_mc,"_TTbar_realW_failN2DDTcut",ttMC_fitter.mj_shape["TTbar_realW_fail"],ttMC_fitter.channel,ttMC_fitter.wtagger_label),
+        (ttMC_fitter.file_TTbar_mc,"_TTbar_fakeW",ttMC_fitter.mj_shape["TTbar_fakeW"],ttMC_fitter.channel,ttMC_fitter.wtagger_label),
+        (ttMC_fitter.file_TTbar_mc,"_TTbar_fakeW_failN2DDTcut",ttMC_fitter.mj_shape["TTbar_fakeW_fail"],ttMC_fitter.channel,ttMC_fitter.wtagger_label)])
     
     print "Finished fitting matched tt MC! Plots can be found in plots_*_MCfits. Printing workspace:"
     workspace4fit_.Print()
@@ -372,6 +467,7 @@ def GetWtagScalefactors(workspace,fitter):
 class doWtagFits:
     def __init__(self):
         self.workspace4fit_ = RooWorkspace("workspace4fit_","workspace4fit_")                           # create workspace
+        if options.tabulatedPdfs > 0: ROOT.SetTabulatedMode(self.workspace4fit_,True,options.tabulatedPdfs) # plotted curves from tables, fits exact
         self.boostedW_fitter_em = initialiseFits("em", options.sample, 40, 130, self.workspace4fit_)    # Define all shapes to be used for Mj, define regions (SB,signal) and input files. 
         self.boostedW_fitter_em.get_datasets_fit_minor_bkg()                                            # Loop over intrees to create datasets om Mj and fit the single MCs.
        
@@ -392,7 +488,8 @@ class doWtagFits:
         rdataset_data_em_mj_fail = self.workspace4fit_.data("rdataset_data_failN2DDTcut_em_mj")
 
         #For binned fit (shorter computing time, more presise when no SumW2Error is used!)
-        if options.doBinnedFit:
+        #The batch NLL sums the events into the bins itself (sumW and sumW2 per bin), only fitTo needs the round trip
+        if options.doBinnedFit and options.noBatchNLL:
           #Converting to RooDataHist
           rdatahist_data_em_mj      = RooDataHist(rdataset_data_em_mj.binnedClone())
           rdatahist_data_em_mj_fail = RooDataHist(rdataset_data_em_mj_fail.binnedClone())
@@ -418,7 +515,7 @@ class doWtagFits:
         rdataset_TotalMC_em_mj      = self.workspace4fit_.data("rdataset_TotalMC_em_mj")
         rdataset_TotalMC_em_mj_fail = self.workspace4fit_.data("rdataset_TotalMC_failN2DDTcut_em_mj")
 
-        if options.doBinnedFit:
+        if options.doBinnedFit and options.noBatchNLL:
           #Converting to RooDataHist
           rdatahist_TotalMC_em_mj      = RooDataHist(rdataset_TotalMC_em_mj.binnedClone())
           rdatahist_TotalMC_em_mj_fail = RooDataHist(rdataset_TotalMC_em_mj_fail.binnedClone())
@@ -458,17 +555,23 @@ class doWtagFits:
           pdfconstrainslist_data_em.Print()
 
         # Perform simoultaneous fit to data
-        if options.doBinnedFit:
+        sim_model_data = self.boostedW_fitter_em.mj_shape["signal_data"]+"+"+self.boostedW_fitter_em.mj_shape["bkg_data"]
+        ROOT.WarmStartParameters(simPdf_data.getParameters(combData_data),"_data_sim",sim_model_data,self.boostedW_fitter_em.wtagger_label)
+        if not options.noBatchNLL:
+          rfresult_data = fit_batch_nll(simPdf_data,combData_data,rrv_mass_j,pdfconstrainslist_data_em,kTRUE,not options.noAnalyticGradient,options.doBinnedFit,minos_params)
+        elif options.doBinnedFit:
           rfresult_data = simPdf_data.fitTo(combData_data,RooFit.Save(kTRUE),RooFit.Verbose(kFALSE), RooFit.Minimizer("Minuit2"),RooFit.ExternalConstraints(pdfconstrainslist_data_em))#, RooFit.SumW2Error(kTRUE))
           rfresult_data = simPdf_data.fitTo(combData_data,RooFit.Save(kTRUE),RooFit.Verbose(kFALSE), RooFit.Minimizer("Minuit2"),RooFit.ExternalConstraints(pdfconstrainslist_data_em))#, RooFit.SumW2Error(kTRUE))
         else:
           rfresult_data = simPdf_data.fitTo(combData_data,RooFit.Save(kTRUE),RooFit.Verbose(kFALSE), RooFit.Minimizer("Minuit2"),RooFit.ExternalConstraints(pdfconstrainslist_data_em), RooFit.SumW2Error(kTRUE))
           rfresult_data = simPdf_data.fitTo(combData_data,RooFit.Save(kTRUE),RooFit.Verbose(kFALSE), RooFit.Minimizer("Minuit2"),RooFit.ExternalConstraints(pdfconstrainslist_data_em), RooFit.SumW2Error(kTRUE))
 
+        ROOT.StoreFitResult(rfresult_data,"_data_sim",sim_model_data,self.boostedW_fitter_em.wtagger_label)
+
         #Draw       
         isData = True
-        chi2FailData = drawFrameGetChi2(rrv_mass_j,rfresult_data,rdataset_data_em_mj_fail,model_data_fail_em,isData)
-        chi2PassData = drawFrameGetChi2(rrv_mass_j,rfresult_data,rdataset_data_em_mj,model_data_em,isData)
+        chi2FailData = drawFrameGetChi2(rrv_mass_j,rfresult_data,rdataset_data_em_mj_fail,model_data_fail_em,isData,self.workspace4fit_)
+        chi2PassData = drawFrameGetChi2(rrv_mass_j,rfresult_data,rdataset_data_em_mj,model_data_em,isData,self.workspace4fit_)
 
         #Print final data fit results
         print "FIT parameters (DATA) :"; print ""
@@ -493,25 +596,31 @@ class doWtagFits:
           pdfconstrainslist_TotalMC_em.add(self.workspace4fit_.pdf(constrainslist_TotalMC_em[i]) )
 
         # Perform simoultaneous fit to MC
-        if options.doBinnedFit:
+        sim_model_TotalMC = self.boostedW_fitter_em.mj_shape["signal_mc"]+"+"+self.boostedW_fitter_em.mj_shape["bkg_mc"]
+        ROOT.WarmStartParameters(simPdf_TotalMC.getParameters(combData_TotalMC),"_TotalMC_sim",sim_model_TotalMC,self.boostedW_fitter_em.wtagger_label)
+        if not options.noBatchNLL:
+          rfresult_TotalMC = fit_batch_nll(simPdf_TotalMC,combData_TotalMC,rrv_mass_j,pdfconstrainslist_TotalMC_em,kTRUE,not options.noAnalyticGradient,options.doBinnedFit,minos_params)
+        elif options.doBinnedFit:
           rfresult_TotalMC = simPdf_TotalMC.fitTo(combData_TotalMC,RooFit.Save(kTRUE),RooFit.Verbose(kFALSE), RooFit.Minimizer("Minuit2"),RooFit.ExternalConstraints(pdfconstrainslist_TotalMC_em))#, RooFit.SumW2Error(kTRUE))--> Removing due to unexected behaviour. See https://root.cern.ch/phpBB3/viewtopic.php?t=16917, https://root.cern.ch/phpBB3/viewtopic.php?t=16917
           rfresult_TotalMC = simPdf_TotalMC.fitTo(combData_TotalMC,RooFit.Save(kTRUE),RooFit.Verbose(kFALSE), RooFit.Minimizer("Minuit2"),RooFit.ExternalConstraints(pdfconstrainslist_TotalMC_em))#, RooFit.SumW2Error(kTRUE))        
         else:
           rfresult_TotalMC = simPdf_TotalMC.fitTo(combData_TotalMC,RooFit.Save(kTRUE),RooFit.Verbose(kFALSE), RooFit.Minimizer("Minuit2"),RooFit.ExternalConstraints(pdfconstrainslist_TotalMC_em), RooFit.SumW2Error(kTRUE))
           rfresult_TotalMC = simPdf_TotalMC.fitTo(combData_TotalMC,RooFit.Save(kTRUE),RooFit.Verbose(kFALSE), RooFit.Minimizer("Minuit2"),RooFit.ExternalConstraints(pdfconstrainslist_TotalMC_em), RooFit.SumW2Error(kTRUE))
           
+        ROOT.StoreFitResult(rfresult_TotalMC,"_TotalMC_sim",sim_model_TotalMC,self.boostedW_fitter_em.wtagger_label)
+
         isData = False  
-        chi2FailMC = drawFrameGetChi2(rrv_mass_j,rfresult_TotalMC,rdataset_TotalMC_em_mj_fail,model_TotalMC_fail_em,isData)
-        chi2PassMC = drawFrameGetChi2(rrv_mass_j,rfresult_TotalMC,rdataset_TotalMC_em_mj,model_TotalMC_em,isData)
+        chi2FailMC = drawFrameGetChi2(rrv_mass_j,rfresult_TotalMC,rdataset_TotalMC_em_mj_fail,model_TotalMC_fail_em,isData,self.workspace4fit_)
+        chi2PassMC = drawFrameGetChi2(rrv_mass_j,rfresult_TotalMC,rdataset_TotalMC_em_mj,model_TotalMC_em,isData,self.workspace4fit_)
         
         #Print final MC fit results
         print "FIT Par. (MC) :"; print ""
         print "CHI2 PASS = %.3f    CHI2 FAIL = %.3f" %(chi2PassMC,chi2FailMC)
         print ""; print rfresult_TotalMC.Print("v"); print ""
 
-	drawDataAndMC(rrv_mass_j,rfresult_data,rdataset_data_em_mj_fail,model_data_fail_em,True,rrv_mass_j,rfresult_TotalMC,rdataset_TotalMC_em_mj_fail,model_TotalMC_fail_em,False)
+	drawDataAndMC(rrv_mass_j,rfresult_data,rdataset_data_em_mj_fail,model_data_fail_em,True,rrv_mass_j,rfresult_TotalMC,rdataset_TotalMC_em_mj_fail,model_TotalMC_fail_em,False,self.workspace4fit_)
 
-        drawDataAndMC(rrv_mass_j,rfresult_data,rdataset_data_em_mj,model_data_em,True,rrv_mass_j,rfresult_TotalMC,rdataset_TotalMC_em_mj,model_TotalMC_em,False)
+        drawDataAndMC(rrv_mass_j,rfresult_data,rdataset_data_em_mj,model_data_em,True,rrv_mass_j,rfresult_TotalMC,rdataset_TotalMC_em_mj,model_TotalMC_em,False,self.workspace4fit_)
         
         # draw the final fit results
         DrawScaleFactorTTbarControlSample(self.workspace4fit_,self.boostedW_fitter_em.color_palet,"","em",self.boostedW_fitter_em.wtagger_label,self.boostedW_fitter_em.AK8_pt_min,self.boostedW_fitter_em.AK8_pt_max,options.sample)
@@ -650,6 +759,9 @@ class initialiseFits:
       rrv_mass_j = RooRealVar("rrv_mass_j", jetMass ,(in_mj_min+in_mj_max)/2.,in_mj_min,in_mj_max,"GeV")
       rrv_mass_j.setBins(nbins_mj)
  
+      # A new fitter is a new job: forget the models MakePdf.cxx cached for earlier workspaces
+      ROOT.ClearModelCache()
+
       # Create workspace and import fit variable
       if input_workspace is None:
           self.workspace4fit_ = RooWorkspace("workspace4fit_","Workspace4fit_")
@@ -733,6 +845,7 @@ class initialiseFits:
       self.lpt_cut      = 53.    # lepton pT
       self.AK8_pt_min   = 200
       self.AK8_pt_max   = 5000  
+      ROOT.SetWarmStartPtBin(self.AK8_pt_min,self.AK8_pt_max)
       if self.channel  == "el":
         self.pfMET_cut = 80
         self.lpt_cut = 120      
@@ -754,8 +867,8 @@ class initialiseFits:
         print ""
 
         self.get_mj_dataset(self.file_STop_mc,"_STop")
-        fit_mj_single_MC(self.workspace4fit_,self.file_STop_mc,"_STop"                        ,self.mj_shape["STop"],self.channel,self.wtagger_label) #Start value and range of parameters defined in PDFs/MakePDF.cxx
-        fit_mj_single_MC(self.workspace4fit_,self.file_STop_mc,"_STop_failN2DDTcut"        ,self.mj_shape["STop_fail"],self.channel,self.wtagger_label)
+        component_fits = [(self.file_STop_mc,"_STop"                        ,self.mj_shape["STop"],self.channel,self.wtagger_label), #Start value and range of parameters defined in PDFs/MakePDF.cxx
+                          (self.file_STop_mc,"_STop_failN2DDTcut"        ,self.mj_shape["STop_fail"],self.channel,self.wtagger_label)]
 
         ### Build WJet fit pass and fail distributions
         print "###########################################"
@@ -764,8 +877,8 @@ class initialiseFits:
         print ""
 
         self.get_mj_dataset(self.file_WJets0_mc,"_WJets0")
-        fit_mj_single_MC(self.workspace4fit_,self.file_WJets0_mc,"_WJets0",self.mj_shape["WJets0"],self.channel,self.wtagger_label)
-        fit_mj_single_MC(self.workspace4fit_,self.file_WJets0_mc,"_WJets0_failN2DDTcut",self.mj_shape["WJets0_fail"],self.channel,self.wtagger_label)
+        component_fits += [(self.file_WJets0_mc,"_WJets0",self.mj_shape["WJets0"],self.channel,self.wtagger_label),
+                           (self.file_WJets0_mc,"_WJets0_failN2DDTcut",self.mj_shape["WJets0_fail"],self.channel,self.wtagger_label)]
 
 
         # Build VV fit pass and fail distributions
@@ -791,6 +904,8 @@ class initialiseFits:
 #        fit_mj_single_MC(self.workspace4fit_,self.file_VV_mc,"_QCD",self.mj_shape["QCD"],self.channel,self.wtagger_label)
 #        fit_mj_single_MC(self.workspace4fit_,self.file_VV_mc,"_QCD_failN2DDTcut",self.mj_shape["QCD_fail"],self.channel,self.wtagger_label)
         
+        # the component fits share only rrv_mass_j: run them together (in parallel with --jobs)
+        run_component_fits(self.workspace4fit_,component_fits)
 
         if options.fitMC:
             return
@@ -899,6 +1014,54 @@ class initialiseFits:
         self.file_out_ttbar_control.write("wtagger_eff_reweight   = %s +/- %s\n"%(wtagger_eff_reweight, wtagger_eff_reweight_err))
             
     # Loop over trees
+    # Names of the objects get_mj_dataset imports for label
+    def get_mj_dataset_objects(self,label):
+      datasets = []
+      for cut in ["","_beforetau2tau1cut","_failN2DDTcut","_extremefailN2DDTcut"]:
+        datasets += ["rdataset"+label+cut+"_"+self.channel+"_mj","rdataset4fit"+label+cut+"_"+self.channel+"_mj"]
+      datasets.append("combData_p_f"+label+"_"+self.channel)
+      datasets += ["rdataset"+label+cut+"_"+self.channel+"_mj_template" for cut in ["","_failN2DDTcut"]]
+      variables  = ["rrv_scale_to_lumi"+label+cut+"_"+self.channel for cut in ["","_failN2DDTcut","_extremefailN2DDTcut"]]
+      variables += ["rrv_number_ttbar"+label+cut+"_em_mj" for cut in ["_passtau2tau1cut","_beforetau2tau1cut","_failN2DDTcut","_extremefailN2DDTcut"]]
+      variables += ["rrv_number_dataset_"+region+label+"_"+self.channel+"_mj" for region in ["sb_lo","signal_region","signal_region_error2","signal_region_before_cut","signal_region_before_cut_error2","sb_hi"]]
+      return datasets, variables
+
+    # Snapshot file of the datasets of label, keyed by the input file (UUID and size) and everything the tree loop depends on
+    def get_mj_snapshot_name(self,fileIn,label,jet_mass):
+      rrv_mass_j = self.workspace4fit_.var("rrv_mass_j")
+      key = [MJ_SNAPSHOT_VERSION, fileIn.GetName(), fileIn.GetUUID().AsString(), fileIn.GetSize(), label, self.channel, jet_mass,
+             options.tau2tau1cutHP, options.tau2tau1cutLP, options.usePuppiSD, options.useDDT, options.useN2DDT, options.fitTT, self.Lumi,
+             rrv_mass_j.getMin(), rrv_mass_j.getMax(), rrv_mass_j.getBins(),
+             self.mj_sideband_lo_min, self.mj_sideband_lo_max, self.mj_signal_min, self.mj_signal_max, self.mj_sideband_hi_min, self.mj_sideband_hi_max]
+      return os.path.join(options.snapshotDir,"mj_dataset%s_%s_%s.root"%(label,self.channel,hashlib.md5(repr(key)).hexdigest()[:16]))
+
+    def load_mj_snapshot(self,snapshot_name,label):
+      if options.rebuildSnapshot or not os.path.exists(snapshot_name): return False
+      snapshotFile = TFile(snapshot_name)
+      snapshot = snapshotFile.Get("mj_snapshot")
+      if not snapshot: return False
+      print "Loading datasets for %s from snapshot %s"%(label,snapshot_name)
+      category_name = "category_p_f"+"_"+self.channel
+      if not self.workspace4fit_.cat(category_name): getattr(self.workspace4fit_,"import")(snapshot.cat(category_name))
+      datasets, variables = self.get_mj_dataset_objects(label)
+      for name in variables: getattr(self.workspace4fit_,"import")(snapshot.var(name))
+      for name in datasets:  getattr(self.workspace4fit_,"import")(snapshot.data(name))
+      snapshotFile.Close()
+      return True
+
+    def save_mj_snapshot(self,snapshot_name,label):
+      if not os.path.isdir(options.snapshotDir): os.makedirs(options.snapshotDir)
+      snapshot = RooWorkspace("mj_snapshot","mj_snapshot")
+      getattr(snapshot,"import")(self.workspace4fit_.var("rrv_mass_j"))
+      getattr(snapshot,"import")(self.workspace4fit_.cat("category_p_f"+"_"+self.channel))
+      datasets, variables = self.get_mj_dataset_objects(label)
+      for name in variables: getattr(snapshot,"import")(self.workspace4fit_.var(name))
+      for name in datasets:  getattr(snapshot,"import")(self.workspace4fit_.data(name))
+      # written next to the final name and renamed, so a job never reads a half written snapshot
+      snapshot.writeToFile(snapshot_name+".tmp")
+      os.rename(snapshot_name+".tmp",snapshot_name)
+      print "Saved datasets for %s in snapshot %s"%(label,snapshot_name)
+
     def get_mj_dataset(self,in_file_name, label, jet_mass="Whadr_pruned"): 
 
       if options.usePuppiSD or options.useDDT or options.useN2DDT: 
@@ -911,6 +1074,10 @@ class initialiseFits:
       print "Using file " ,fileIn_name
       
       fileIn      = TFile(fileIn_name.Data())
+      snapshot_name = None
+      if options.snapshotDir:
+        snapshot_name = self.get_mj_snapshot_name(fileIn,label,jet_mass)
+        if self.load_mj_snapshot(snapshot_name,label): return
       treeIn      = fileIn.Get("myTree")
       
       rrv_mass_j = self.workspace4fit_.var("rrv_mass_j")
@@ -928,6 +1095,10 @@ class initialiseFits:
  
       ### Mj dataset failed tau2tau1 cut :
       rdataset_failN2DDTcut_mj     = RooDataSet("rdataset"     +label+"_failN2DDTcut_"+self.channel+"_mj","rdataset"    +label+"_failN2DDTcut_"+self.channel+"_mj",RooArgSet(rrv_mass_j,rrv_weight),RooFit.WeightVar(rrv_weight) )
+
+      # Binned templates of rdataset_mj and rdataset_failN2DDTcut_mj, filled in the same loop (change_dataset_to_histpdf)
+      rdatahist_template_mj              = RooDataHist("rdataset"+label+"_"+self.channel+"_mj_template","rdataset"+label+"_"+self.channel+"_mj_template",RooArgSet(rrv_mass_j))
+      rdatahist_template_failN2DDTcut_mj = RooDataHist("rdataset"+label+"_failN2DDTcut_"+self.channel+"_mj_template","rdataset"+label+"_failN2DDTcut_"+self.channel+"_mj_template",RooArgSet(rrv_mass_j))
       rdataset4fit_failN2DDTcut_mj = RooDataSet("rdataset4fit" +label+"_failN2DDTcut_"+self.channel+"_mj","rdataset4fit"+label+"_failN2DDTcut_"+self.channel+"_mj",RooArgSet(rrv_mass_j,rrv_weight),RooFit.WeightVar(rrv_weight) )
       rrv_number_fail = RooRealVar("rrv_number_ttbar"+label+"_failN2DDTcut_em_mj","rrv_number_ttbar"+label+"_failN2DDTcut_em_mj",0.,10000000.) #LUCA
 
@@ -1065,6 +1236,7 @@ class initialiseFits:
              rrv_mass_j.setVal(tmp_jet_mass)
              
              rdataset_mj    .add(RooArgSet(rrv_mass_j), tmp_event_weight)
+             rdatahist_template_mj.add(RooArgSet(rrv_mass_j), tmp_event_weight)
              rdataset4fit_mj.add(RooArgSet(rrv_mass_j), tmp_event_weight4fit)
 
              if tmp_jet_mass >= self.mj_sideband_lo_min and tmp_jet_mass < self.mj_sideband_lo_max:
@@ -1100,6 +1272,7 @@ class initialiseFits:
               rrv_mass_j.setVal(tmp_jet_mass)
 
               rdataset_failN2DDTcut_mj     .add(RooArgSet(rrv_mass_j), tmp_event_weight)
+              rdatahist_template_failN2DDTcut_mj.add(RooArgSet(rrv_mass_j), tmp_event_weight)
               rdataset4fit_failN2DDTcut_mj .add(RooArgSet(rrv_mass_j), tmp_event_weight4fit )
     
               category_p_f.setLabel("fail");
@@ -1163,6 +1336,8 @@ class initialiseFits:
       getattr(self.workspace4fit_,"import")(rdataset_beforetau2tau1cut_mj)
       getattr(self.workspace4fit_,"import")(rdataset4fit_beforetau2tau1cut_mj)
       getattr(self.workspace4fit_,"import")(rdataset_failN2DDTcut_mj)
+      getattr(self.workspace4fit_,"import")(rdatahist_template_mj)
+      getattr(self.workspace4fit_,"import")(rdatahist_template_failN2DDTcut_mj)
       getattr(self.workspace4fit_,"import")(rdataset4fit_failN2DDTcut_mj)
       getattr(self.workspace4fit_,"import")(rdataset_extremefailN2DDTcut_mj)
       getattr(self.workspace4fit_,"import")(rdataset4fit_extremefailN2DDTcut_mj)
@@ -1190,6 +1365,8 @@ class initialiseFits:
       rrv_number_dataset_signal_region_before_cut_error2_mj.Print()
       print "WHAT!!!"
       combData_p_f.Print("v")
+
+      if snapshot_name: self.save_mj_snapshot(snapshot_name,label)
       
 ### Start  main
 if __name__ == '__main__':